@@ -271,6 +271,7 @@ PETSC_STATIC_INLINE PetscErrorCode KSPSetNoisy_Private(Vec v)
 PETSC_INTERN PetscErrorCode KSPSetUpNorms_Private(KSP,PetscBool,KSPNormType*,PCSide*);
 
 PETSC_INTERN PetscErrorCode KSPPlotEigenContours_Private(KSP,PetscInt,const PetscReal*,const PetscReal*);
+PETSC_INTERN PetscErrorCode KSPSStepBasisCoefficients_Private(KSPSStepBasisType,PetscInt,PetscScalar*,PetscInt,PetscInt,PetscScalar*,PetscScalar*,PetscScalar*);
 
 typedef struct _p_DMKSP *DMKSP;
 typedef struct _DMKSPOps *DMKSPOps;
@@ -349,12 +349,14 @@ struct _MatStash {
 
   /* The following variables are used for BTS communication */
   PetscBool      first_assembly_done;   /* Is the first time matrix assembly done? */
+  PetscBool      persistent;            /* Keep the communication pattern and reuse it while the off-process entries fit in it */
   PetscBool      use_status;            /* Use MPI_Status to determine number of items in each message */
   PetscMPIInt    nsendranks;
   PetscMPIInt    nrecvranks;
   PetscMPIInt    *sendranks;
   PetscMPIInt    *recvranks;
   MatStashHeader *sendhdr,*recvhdr;
+  PetscInt       *sendcap;        /* Number of blocks each send rank can receive with the current pattern */
   MatStashFrame  *sendframes;   /* pointers to the main messages */
   MatStashFrame  *recvframes;
   MatStashFrame  *recvframe_active;
@@ -373,6 +375,9 @@ struct _MatStash {
   MPI_Datatype   blocktype;
   size_t         blocktype_size;
   InsertMode     *insertmode;   /* Pointer to check mat->insertmode and set upon message arrival in case no local values have been set. */
+  PetscInt       *recvrows,*recvcols; /* A received frame unpacked so that whole rows are inserted with one call */
+  PetscScalar    *recvvals;
+  PetscInt       nrecvmax;        /* Number of blocks the unpacked arrays can hold */
 };
 
 #if !defined(PETSC_HAVE_MPIUNI)
@@ -657,6 +662,17 @@ struct _p_MatColoring {
   PetscBool             valid_iscoloring; /* check to see if matcoloring is produced a valid iscoloring */
 };
 
+/* coloring of the local rows used by the SOR_MULTICOLOR sweeps of MatSOR() */
+typedef struct {
+  PetscObjectState nonzerostate;            /* nonzero state of the matrix when the coloring was computed */
+  PetscInt         ncolors;
+  PetscInt         *color;                  /* [ncolors+1]: rows[color[c]] to rows[color[c+1]-1] have color c */
+  PetscInt         *rows;
+} MatSORColoring;
+
+PETSC_INTERN PetscErrorCode MatSORColoringSetUp_Private(Mat,PetscInt,const PetscInt[],const PetscInt[],MatSORColoring*);
+PETSC_INTERN PetscErrorCode MatSORColoringReset_Private(MatSORColoring*);
+
 struct  _p_MatTransposeColoring{
   PETSCHEADER(int);
   PetscInt       M,N,m;            /* total rows, columns; local rows */
@@ -1800,6 +1816,7 @@ PETSC_EXTERN PetscLogEvent MAT_DenseCopyToGPU;
 PETSC_EXTERN PetscLogEvent MAT_DenseCopyFromGPU;
 PETSC_EXTERN PetscLogEvent MAT_Merge;
 PETSC_EXTERN PetscLogEvent MAT_Residual;
+PETSC_EXTERN PetscLogEvent MAT_ResidualJacobiUpdate;
 PETSC_EXTERN PetscLogEvent MAT_SetRandom;
 PETSC_EXTERN PetscLogEvent MAT_FactorFactS;
 PETSC_EXTERN PetscLogEvent MAT_FactorInvS;
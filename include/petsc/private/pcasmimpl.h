@@ -20,6 +20,7 @@ typedef struct {
   PetscBool  type_set;            /* if user set this value (so won't change it for symmetric problems) */
   PetscBool  sort_indices;        /* flag to sort subdomain indices */
   PetscBool  dm_subdomains;       /* whether DM is allowed to define subdomains */
+  PetscBool  reuse_pattern;       /* reuse the submatrices (and so the subdomain symbolic factorizations) for new operators with the same pattern */
   PCCompositeType loctype;        /* the type of composition for local solves */
   MatType    sub_mat_type;        /* the type of Mat used for subdomain solves (can be MATSAME or NULL) */
   /* For multiplicative solve */
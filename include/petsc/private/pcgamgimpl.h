@@ -50,6 +50,8 @@ typedef struct gamg_TAG {
   PetscInt   esteig_max_it;
   PetscInt   use_sa_esteig;
   PetscReal  emin,emax;
+  Mat       ptap_mat[PETSC_MG_MAXLEVELS];  /* Galerkin products of repartitioned levels, kept for the numeric refresh of reuse_prol */
+  IS        ptap_perm[PETSC_MG_MAXLEVELS]; /* new layout of these products, NULL when the level was not repartitioned */
 } PC_GAMG;
 
 PetscErrorCode PCReset_MG(PC);
@@ -41,6 +41,14 @@ typedef struct {
   Mat           restrct;                       /* restrict is a reserved word in C99 and on Cray */
   Mat           inject;                        /* Used for moving state if provided. */
   Vec           rscale;                        /* scaling of restriction matrix */
+  Vec           l1inv;                         /* inverse l1 row sums of A, used by PC_MG_MULTADDITIVE to smooth the transfers */
+  Vec           work;                          /* work vector for PC_MG_MULTADDITIVE */
+  Mat           W;                             /* work matrix for PC_MG_MULTADDITIVE with multiple right hand sides */
+  PetscSubcomm  aggsubcomm;                    /* the level solves run on the child of this subcomm, see PCMGSetProcEqLim() */
+  PetscSF       aggsf;                         /* moves the level vectors to and from the agglomerated layout */
+  Vec           aggb,aggx;                     /* rhs and solution in the agglomerated layout, on the active processes */
+  Mat           aggA,aggB;                     /* the level operators redistributed onto the subcommunicator */
+  KSP           aggsmoothd,aggsmoothu;         /* the smoothers used on the subcommunicator */
   PetscLogEvent eventsmoothsetup;              /* if logging times for each level */
   PetscLogEvent eventsmoothsolve;
   PetscLogEvent eventresidual;
@@ -53,6 +61,7 @@ typedef struct {
 typedef struct {
   PCMGType            am;                     /* Multiplicative, additive or full */
   PetscInt            cyclesperpcapply;       /* Number of cycles to use in each PCApply(), multiplicative only*/
+  PetscInt            min_eq_proc;            /* agglomerate the coarser level solves so that each process has about this many rows */
   PetscInt            maxlevels;              /* total number of levels allocated */
   PCMGGalerkinType    galerkin;               /* use Galerkin process to compute coarser matrices */
   PetscBool           usedmfornumberoflevels; /* sets the number of levels by getting this information out of the DM */
@@ -90,7 +99,14 @@ PETSC_INTERN PetscErrorCode DMSetBasisFunction_Internal(PetscInt, PetscBool, Pet
 PETSC_INTERN PetscErrorCode PCMGComputeCoarseSpace_Internal(PC, PetscInt, PCMGCoarseSpaceType, PetscInt, const Vec[], Vec *[]);
 PETSC_INTERN PetscErrorCode PCMGAdaptInterpolator_Internal(PC, PetscInt, KSP, KSP, PetscInt, Vec[], Vec[]);
 PETSC_INTERN PetscErrorCode PCMGRecomputeLevelOperators_Internal(PC, PetscInt);
+PETSC_INTERN PetscErrorCode PCMGAgglomerateSetUp_Private(PC);
+PETSC_INTERN PetscErrorCode PCMGAgglomerateReset_Private(PC_MG_Levels*);
+PETSC_INTERN PetscErrorCode PCMGLevelSetUp_Private(PC,PC_MG_Levels*,KSP);
+PETSC_INTERN PetscErrorCode PCMGLevelSolve_Private(PC,PC_MG_Levels*,KSP,PetscBool,Vec,Vec);
+PETSC_INTERN PetscErrorCode PCMGLevelView_Private(PC,PC_MG_Levels*,KSP,PetscViewer);
 PETSC_INTERN PetscErrorCode PCMGACycle_Private(PC,PC_MG_Levels**,PetscBool,PetscBool);
+PETSC_INTERN PetscErrorCode PCMGMultAdditiveSetUp_Private(PC,PC_MG_Levels**);
+PETSC_INTERN PetscErrorCode PCMGMultAdditiveCycle_Private(PC,PC_MG_Levels**,PetscBool,PetscBool);
 PETSC_INTERN PetscErrorCode PCMGFCycle_Private(PC,PC_MG_Levels**,PetscBool,PetscBool);
 PETSC_INTERN PetscErrorCode PCMGKCycle_Private(PC,PC_MG_Levels**,PetscBool,PetscBool);
 PETSC_INTERN PetscErrorCode PCMGMCycle_Private(PC,PC_MG_Levels**,PetscBool,PetscBool,PCRichardsonConvergedReason*);
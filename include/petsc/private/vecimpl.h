@@ -16,6 +16,23 @@ PETSC_EXTERN PetscErrorCode VecRegisterAll(void);
 PETSC_EXTERN MPI_Op MPIU_MAXLOC;
 PETSC_EXTERN MPI_Op MPIU_MINLOC;
 
+#if defined(PETSC_HAVE_OPENMP)
+PETSC_INTERN PetscBool VecOMPUse;     /* use OpenMP threads in the kernels of VECSEQ and VECMPI, set with -vec_omp */
+PETSC_INTERN PetscInt  VecOMPMinSize; /* smallest local length for which the threads are used, set with -vec_omp_min_size */
+
+#define VecOMPUseThreads(n) (VecOMPUse && PetscNumOMPThreads > 1 && (n) >= VecOMPMinSize)
+/*
+   Thread t of a team of nt threads owns the entries lo to hi-1 of a local array of length n. All the threaded
+   vector kernels (including VecSet() called at creation, which first touches the array) use this static split so
+   the same thread always accesses the same entries; it matches the row blocks of the threaded SeqAIJ MatMult()
+   when the rows have about the same number of nonzeros.
+*/
+#define VecOMPGetChunk(n,t,nt,lo,hi) do {                         \
+    (lo) = (PetscInt)(((PetscInt64)(n)*(t))/(nt));                \
+    (hi) = (PetscInt)(((PetscInt64)(n)*((t)+1))/(nt));            \
+  } while (0)
+#endif
+
 /* ----------------------------------------------------------------------------*/
 
 typedef struct _VecOps *VecOps;
@@ -103,6 +120,10 @@ struct _VecOps {
   PetscErrorCode (*restorearrayreadandmemtype)(Vec,const PetscScalar**);
   PetscErrorCode (*concatenate)(PetscInt,const Vec[],Vec*,IS*[]);
   PetscErrorCode (*sum)(Vec,PetscScalar*);
+  PetscErrorCode (*axpynorm)(Vec,PetscScalar,Vec,PetscReal*);
+  PetscErrorCode (*waxpynorm)(Vec,PetscScalar,Vec,Vec,PetscReal*);
+  PetscErrorCode (*maxpynorm)(Vec,PetscInt,const PetscScalar*,Vec*,PetscReal*);
+  PetscErrorCode (*maxpymdot)(Vec,PetscInt,const PetscScalar*,Vec*,PetscScalar*);
 };
 
 /*
@@ -188,6 +209,10 @@ PETSC_EXTERN PetscLogEvent VEC_Swap;
 PETSC_EXTERN PetscLogEvent VEC_AssemblyBegin;
 PETSC_EXTERN PetscLogEvent VEC_DotNorm2;
 PETSC_EXTERN PetscLogEvent VEC_AXPBYPCZ;
+PETSC_EXTERN PetscLogEvent VEC_AXPYNorm;
+PETSC_EXTERN PetscLogEvent VEC_WAXPYNorm;
+PETSC_EXTERN PetscLogEvent VEC_MAXPYNorm;
+PETSC_EXTERN PetscLogEvent VEC_MAXPYMDot;
 PETSC_EXTERN PetscLogEvent VEC_Ops;
 PETSC_EXTERN PetscLogEvent VEC_ViennaCLCopyToGPU;
 PETSC_EXTERN PetscLogEvent VEC_ViennaCLCopyFromGPU;
@@ -38,6 +38,7 @@ typedef const char* KSPType;
 #define KSPPIPELCG     "pipelcg"
 #define KSPPIPEPRCG    "pipeprcg"
 #define KSPPIPECG2     "pipecg2"
+#define KSPSSTEPCG     "sstepcg"
 #define   KSPCGNE       "cgne"
 #define   KSPNASH       "nash"
 #define   KSPSTCG       "stcg"
@@ -53,6 +54,7 @@ typedef const char* KSPType;
 #define   KSPLGMRES     "lgmres"
 #define   KSPDGMRES     "dgmres"
 #define   KSPPGMRES     "pgmres"
+#define   KSPSSTEPGMRES "sstepgmres"
 #define KSPTCQMR      "tcqmr"
 #define KSPBCGS       "bcgs"
 #define   KSPIBCGS      "ibcgs"
@@ -184,6 +186,7 @@ PETSC_EXTERN PetscErrorCode KSPChebyshevSetEigenvalues(KSP,PetscReal,PetscReal);
 PETSC_EXTERN PetscErrorCode KSPChebyshevEstEigSet(KSP,PetscReal,PetscReal,PetscReal,PetscReal);
 PETSC_EXTERN PetscErrorCode KSPChebyshevEstEigSetUseNoisy(KSP,PetscBool);
 PETSC_EXTERN PetscErrorCode KSPChebyshevEstEigGetKSP(KSP,KSP*);
+PETSC_EXTERN PetscErrorCode KSPChebyshevSetFused(KSP,PetscBool);
 PETSC_EXTERN PetscErrorCode KSPComputeExtremeSingularValues(KSP,PetscReal*,PetscReal*);
 PETSC_EXTERN PetscErrorCode KSPComputeEigenvalues(KSP,PetscInt,PetscReal[],PetscReal[],PetscInt*);
 PETSC_EXTERN PetscErrorCode KSPComputeEigenvaluesExplicitly(KSP,PetscInt,PetscReal[],PetscReal[]);
@@ -236,12 +239,37 @@ PETSC_EXTERN PetscErrorCode KSPGMRESSetOrthogonalization(KSP,PetscErrorCode (*)(
 PETSC_EXTERN PetscErrorCode KSPGMRESGetOrthogonalization(KSP,PetscErrorCode (**)(KSP,PetscInt));
 PETSC_EXTERN PetscErrorCode KSPGMRESModifiedGramSchmidtOrthogonalization(KSP,PetscInt);
 PETSC_EXTERN PetscErrorCode KSPGMRESClassicalGramSchmidtOrthogonalization(KSP,PetscInt);
+PETSC_EXTERN PetscErrorCode KSPGMRESLowSyncModifiedGramSchmidtOrthogonalization(KSP,PetscInt);
+PETSC_EXTERN PetscErrorCode KSPGMRESLowSyncClassicalGramSchmidtOrthogonalization(KSP,PetscInt);
 
 PETSC_EXTERN PetscErrorCode KSPLGMRESSetAugDim(KSP,PetscInt);
 PETSC_EXTERN PetscErrorCode KSPLGMRESSetConstant(KSP);
 
 PETSC_EXTERN PetscErrorCode KSPPIPEFGMRESSetShift(KSP,PetscScalar);
 
+/*E
+    KSPSStepBasisType - The polynomial basis used by the s-step Krylov methods to generate s Krylov directions at once
+
+$  KSP_SSTEP_BASIS_MONOMIAL  - the power basis, only stable for small s
+$  KSP_SSTEP_BASIS_NEWTON    - a Newton basis whose shifts are Leja ordered Ritz values
+$  KSP_SSTEP_BASIS_CHEBYSHEV - a Chebyshev basis for the interval spanned by the real parts of the Ritz values
+
+   Notes:
+   For the Newton and Chebyshev bases the Ritz values are estimated with a monomial basis during the first s steps (KSPSSTEPCG)
+   or the first restart cycle (KSPSSTEPGMRES).
+
+   Level: intermediate
+
+.seealso: KSPSSTEPCG, KSPSSTEPGMRES, KSPSStepSetBasisType(), KSPSStepSetSteps()
+E*/
+typedef enum {KSP_SSTEP_BASIS_MONOMIAL,KSP_SSTEP_BASIS_NEWTON,KSP_SSTEP_BASIS_CHEBYSHEV} KSPSStepBasisType;
+PETSC_EXTERN const char *const KSPSStepBasisTypes[];
+
+PETSC_EXTERN PetscErrorCode KSPSStepSetSteps(KSP,PetscInt);
+PETSC_EXTERN PetscErrorCode KSPSStepGetSteps(KSP,PetscInt*);
+PETSC_EXTERN PetscErrorCode KSPSStepSetBasisType(KSP,KSPSStepBasisType);
+PETSC_EXTERN PetscErrorCode KSPSStepGetBasisType(KSP,KSPSStepBasisType*);
+
 PETSC_EXTERN PetscErrorCode KSPGCRSetRestart(KSP,PetscInt);
 PETSC_EXTERN PetscErrorCode KSPGCRGetRestart(KSP,PetscInt*);
 PETSC_EXTERN PetscErrorCode KSPGCRSetModifyPC(KSP,PetscErrorCode (*)(KSP,PetscInt,PetscReal,void*),void*,PetscErrorCode(*)(void*));
@@ -539,6 +539,7 @@ PETSC_EXTERN PetscErrorCode MatMatSolve(Mat,Mat,Mat);
 PETSC_EXTERN PetscErrorCode MatMatSolveTranspose(Mat,Mat,Mat);
 PETSC_EXTERN PetscErrorCode MatMatTransposeSolve(Mat,Mat,Mat);
 PETSC_EXTERN PetscErrorCode MatResidual(Mat,Vec,Vec,Vec);
+PETSC_EXTERN PetscErrorCode MatResidualJacobiUpdate(Mat,Vec,Vec,PetscScalar,Vec,PetscScalar,Vec,PetscScalar,Vec,PetscReal*);
 
 /*E
     MatDuplicateOption - Indicates if a duplicated sparse matrix should have
@@ -1273,6 +1274,7 @@ PETSC_EXTERN PetscErrorCode MatSolves(Mat,Vecs,Vecs);
 PETSC_EXTERN PetscErrorCode MatSetUnfactored(Mat);
 
 typedef enum {MAT_FACTOR_SCHUR_UNFACTORED, MAT_FACTOR_SCHUR_FACTORED, MAT_FACTOR_SCHUR_INVERTED} MatFactorSchurStatus;
+PETSC_EXTERN PetscErrorCode MatFactorSetIterativeSweeps(Mat,PetscInt,PetscInt);
 PETSC_EXTERN PetscErrorCode MatFactorSetSchurIS(Mat,IS);
 PETSC_EXTERN PetscErrorCode MatFactorGetSchurComplement(Mat,Mat*,MatFactorSchurStatus*);
 PETSC_EXTERN PetscErrorCode MatFactorRestoreSchurComplement(Mat,Mat*,MatFactorSchurStatus);
@@ -1298,7 +1300,7 @@ E*/
 typedef enum {SOR_FORWARD_SWEEP=1,SOR_BACKWARD_SWEEP=2,SOR_SYMMETRIC_SWEEP=3,
               SOR_LOCAL_FORWARD_SWEEP=4,SOR_LOCAL_BACKWARD_SWEEP=8,
               SOR_LOCAL_SYMMETRIC_SWEEP=12,SOR_ZERO_INITIAL_GUESS=16,
-              SOR_EISENSTAT=32,SOR_APPLY_UPPER=64,SOR_APPLY_LOWER=128} MatSORType;
+              SOR_EISENSTAT=32,SOR_APPLY_UPPER=64,SOR_APPLY_LOWER=128,SOR_MULTICOLOR=256} MatSORType;
 PETSC_EXTERN PetscErrorCode MatSOR(Mat,Vec,PetscReal,MatSORType,PetscReal,PetscInt,PetscInt,Vec);
 
 /*
@@ -1662,7 +1664,7 @@ typedef enum { MATOP_SET_VALUES=0,
                MATOP_FIND_NONZERO_ROWS=124,
                MATOP_GET_COLUMN_NORMS=125,
                MATOP_INVERT_BLOCK_DIAGONAL=126,
-               /* MATOP_PLACEHOLDER_127=127, */
+               MATOP_INVERT_VBLOCK_DIAGONAL=127,
                MATOP_CREATE_SUB_MATRICES_MPI=128,
                MATOP_SET_VALUES_BATCH=129,
                MATOP_TRANSPOSE_MAT_MULT=130,
@@ -27,6 +27,7 @@ J*/
 typedef const char* MatCoarsenType;
 #define MATCOARSENMIS  "mis"
 #define MATCOARSENHEM  "hem"
+#define MATCOARSENMIS2 "mis2"
 
 /* linked list for aggregates */
 typedef struct _PetscCDIntNd{
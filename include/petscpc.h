@@ -126,6 +126,8 @@ PETSC_EXTERN PetscErrorCode PCSORSetOmega(PC,PetscReal);
 PETSC_EXTERN PetscErrorCode PCSORGetOmega(PC,PetscReal*);
 PETSC_EXTERN PetscErrorCode PCSORSetIterations(PC,PetscInt,PetscInt);
 PETSC_EXTERN PetscErrorCode PCSORGetIterations(PC,PetscInt*,PetscInt*);
+PETSC_EXTERN PetscErrorCode PCSORSetMultiColor(PC,PetscBool);
+PETSC_EXTERN PetscErrorCode PCSORGetMultiColor(PC,PetscBool*);
 
 PETSC_EXTERN PetscErrorCode PCEisenstatSetOmega(PC,PetscReal);
 PETSC_EXTERN PetscErrorCode PCEisenstatGetOmega(PC,PetscReal*);
@@ -136,6 +138,8 @@ PETSC_EXTERN PetscErrorCode PCBJacobiSetTotalBlocks(PC,PetscInt,const PetscInt[]
 PETSC_EXTERN PetscErrorCode PCBJacobiGetTotalBlocks(PC,PetscInt*,const PetscInt*[]);
 PETSC_EXTERN PetscErrorCode PCBJacobiSetLocalBlocks(PC,PetscInt,const PetscInt[]);
 PETSC_EXTERN PetscErrorCode PCBJacobiGetLocalBlocks(PC,PetscInt*,const PetscInt*[]);
+PETSC_EXTERN PetscErrorCode PCBJacobiSetBatched(PC,PetscBool);
+PETSC_EXTERN PetscErrorCode PCBJacobiGetBatched(PC,PetscBool*);
 
 PETSC_EXTERN PetscErrorCode PCShellSetApply(PC,PetscErrorCode (*)(PC,Vec,Vec));
 PETSC_EXTERN PetscErrorCode PCShellSetMatApply(PC,PetscErrorCode (*)(PC,Mat,Mat));
@@ -180,6 +184,7 @@ PETSC_EXTERN PetscErrorCode PCFactorSetPivotInBlocks(PC,PetscBool);
 PETSC_EXTERN PetscErrorCode PCFactorSetLevels(PC,PetscInt);
 PETSC_EXTERN PetscErrorCode PCFactorGetLevels(PC,PetscInt*);
 PETSC_EXTERN PetscErrorCode PCFactorSetDropTolerance(PC,PetscReal,PetscReal,PetscInt);
+PETSC_EXTERN PetscErrorCode PCFactorSetIterativeSweeps(PC,PetscInt,PetscInt);
 PETSC_EXTERN PetscErrorCode PCFactorGetZeroPivot(PC,PetscReal*);
 PETSC_EXTERN PetscErrorCode PCFactorGetShiftAmount(PC,PetscReal*);
 PETSC_EXTERN PetscErrorCode PCFactorGetShiftType(PC,MatFactorShiftType*);
@@ -190,6 +195,8 @@ PETSC_EXTERN PetscErrorCode PCASMSetOverlap(PC,PetscInt);
 PETSC_EXTERN PetscErrorCode PCASMSetDMSubdomains(PC,PetscBool);
 PETSC_EXTERN PetscErrorCode PCASMGetDMSubdomains(PC,PetscBool*);
 PETSC_EXTERN PetscErrorCode PCASMSetSortIndices(PC,PetscBool);
+PETSC_EXTERN PetscErrorCode PCASMSetReuseSubdomainPattern(PC,PetscBool);
+PETSC_EXTERN PetscErrorCode PCASMGetReuseSubdomainPattern(PC,PetscBool*);
 
 PETSC_EXTERN PetscErrorCode PCASMSetType(PC,PCASMType);
 PETSC_EXTERN PetscErrorCode PCASMGetType(PC,PCASMType*);
@@ -311,6 +318,7 @@ PETSC_EXTERN PetscErrorCode PCGAMGSetNlevels(PC,PetscInt);
 PETSC_EXTERN PetscErrorCode PCGAMGSetNSmooths(PC,PetscInt);
 PETSC_EXTERN PetscErrorCode PCGAMGSetSymGraph(PC,PetscBool);
 PETSC_EXTERN PetscErrorCode PCGAMGSetSquareGraph(PC,PetscInt);
+PETSC_EXTERN PetscErrorCode PCGAMGSetMatFreeProlongator(PC,PetscBool);
 PETSC_EXTERN PetscErrorCode PCGAMGSetReuseInterpolation(PC,PetscBool);
 PETSC_EXTERN PetscErrorCode PCGAMGFinalizePackage(void);
 PETSC_EXTERN PetscErrorCode PCGAMGInitializePackage(void);
@@ -362,6 +370,7 @@ PETSC_EXTERN PetscErrorCode PCMGSetCycleType(PC,PCMGCycleType);
 PETSC_EXTERN PetscErrorCode PCMGSetCycleTypeOnLevel(PC,PetscInt,PCMGCycleType);
 PETSC_DEPRECATED_FUNCTION("Use PCMGSetCycleTypeOnLevel() (since version 3.5)") PETSC_STATIC_INLINE PetscErrorCode PCMGSetCyclesOnLevel(PC pc,PetscInt l,PetscInt t) {return PCMGSetCycleTypeOnLevel(pc,l,(PCMGCycleType)t);}
 PETSC_EXTERN PetscErrorCode PCMGMultiplicativeSetCycles(PC,PetscInt);
+PETSC_EXTERN PetscErrorCode PCMGSetProcEqLim(PC,PetscInt);
 PETSC_EXTERN PetscErrorCode PCMGSetGalerkin(PC,PCMGGalerkinType);
 PETSC_EXTERN PetscErrorCode PCMGGetGalerkin(PC,PCMGGalerkinType*);
 PETSC_EXTERN PetscErrorCode PCMGSetAdaptInterpolation(PC,PetscBool);
@@ -255,13 +255,17 @@ typedef const char *PCGAMGClassicalType;
             to the next, performs a cycle etc. This is much like the F-cycle presented in "Multigrid" by Trottenberg, Oosterlee, Schuller page 49, but that
             algorithm supports smoothing on before the restriction on each level in the initial restriction to the coarsest stage. In addition that algorithm
             calls the V-cycle only on the coarser level and has a post-smoother instead.
--  PC_MG_KASKADE - like full multigrid except one never goes back to a coarser level
+.  PC_MG_KASKADE - like full multigrid except one never goes back to a coarser level
                from a finer
+-  PC_MG_MULTADDITIVE - the mult-additive preconditioner of Vassilevski and Yang; an additive
+               method whose transfer operators are smoothed with l1-Jacobi, so its convergence is close
+               to that of a V-cycle. PCMG applies it sequentially, one level after the other on the
+               communicator of each level, so it does not reduce the time spent on the coarse levels
 
 .seealso: PCMGSetType(), PCMGSetCycleType(), PCMGSetCycleTypeOnLevel()
 
 E*/
-typedef enum { PC_MG_MULTIPLICATIVE,PC_MG_ADDITIVE,PC_MG_FULL,PC_MG_KASKADE } PCMGType;
+typedef enum { PC_MG_MULTIPLICATIVE,PC_MG_ADDITIVE,PC_MG_FULL,PC_MG_KASKADE,PC_MG_MULTADDITIVE } PCMGType;
 #define PC_MG_CASCADE PC_MG_KASKADE;
 
 /*E
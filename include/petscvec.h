@@ -291,6 +291,10 @@ PETSC_EXTERN PetscErrorCode VecSwap(Vec,Vec);
 PETSC_EXTERN PetscErrorCode VecAXPY(Vec,PetscScalar,Vec);
 PETSC_EXTERN PetscErrorCode VecAXPBY(Vec,PetscScalar,PetscScalar,Vec);
 PETSC_EXTERN PetscErrorCode VecMAXPY(Vec,PetscInt,const PetscScalar[],Vec[]);
+PETSC_EXTERN PetscErrorCode VecAXPYNorm(Vec,PetscScalar,Vec,PetscReal*);
+PETSC_EXTERN PetscErrorCode VecWAXPYNorm(Vec,PetscScalar,Vec,Vec,PetscReal*);
+PETSC_EXTERN PetscErrorCode VecMAXPYNorm(Vec,PetscInt,const PetscScalar[],Vec[],PetscReal*);
+PETSC_EXTERN PetscErrorCode VecMAXPYMDot(Vec,PetscInt,const PetscScalar[],Vec[],PetscScalar[]);
 PETSC_EXTERN PetscErrorCode VecAYPX(Vec,PetscScalar,Vec);
 PETSC_EXTERN PetscErrorCode VecWAXPY(Vec,PetscScalar,Vec,Vec);
 PETSC_EXTERN PetscErrorCode VecAXPBYPCZ(Vec,PetscScalar,PetscScalar,PetscScalar,Vec,Vec);
@@ -0,0 +1,651 @@
+
+/*
+    This file implements the s-step preconditioned conjugate gradient method of Chronopoulos and Gear.
+    It also holds the interface and the polynomial basis shared by all the s-step methods, see KSPSSTEPGMRES.
+*/
+#include <petsc/private/kspimpl.h>  /*I "petscksp.h" I*/
+#include <petscblaslapack.h>
+
+typedef struct {
+  PetscInt          s;                        /* number of directions generated in each outer iteration */
+  KSPSStepBasisType basis;                    /* polynomial basis used to generate the directions */
+  Vec               *S,*Q;                    /* the new basis and its image under the operator */
+  Vec               *P,*AP;                   /* the directions of the previous outer iteration and their image */
+  PetscScalar       *diag,*sub,*sup;          /* recurrence of the basis */
+  PetscScalar       *G,*C,*W,*Wold,*beta,*K;  /* s x s matrices stored by columns */
+  PetscScalar       *g,*h,*alpha,*work;
+} KSP_SSTEPCG;
+
+static PetscErrorCode KSPReset_SSTEPCG(KSP ksp)
+{
+  KSP_SSTEPCG    *cg = (KSP_SSTEPCG*)ksp->data;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  ierr = PetscFree4(cg->S,cg->Q,cg->P,cg->AP);CHKERRQ(ierr);
+  ierr = PetscFree3(cg->diag,cg->sub,cg->sup);CHKERRQ(ierr);
+  ierr = PetscFree6(cg->G,cg->C,cg->W,cg->Wold,cg->beta,cg->K);CHKERRQ(ierr);
+  ierr = PetscFree4(cg->g,cg->h,cg->alpha,cg->work);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+/*
+   KSPSStepBasisCoefficients_Private - Computes the three term recurrence that defines the polynomial basis of the s-step Krylov methods
+
+   Input Parameters:
++  type - the basis type
+.  n - the size of the projected operator, with n = 0 the monomial basis is returned
+.  H - the projected operator, whose eigenvalues are the Ritz values, it is overwritten
+.  ldh - the leading dimension of H
+-  s - the number of basis vectors to generate
+
+   Output Parameters:
+.  diag, sub, sup - the recurrence coefficients, the basis vectors satisfy Op v_j = sub[j] v_{j+1} + diag[j] v_j + sup[j] v_{j-1}
+
+   Notes:
+   The Newton basis uses the Ritz values in Leja order as shifts, for real scalars a complex conjugate pair of shifts is
+   applied as two real steps. The Chebyshev basis uses the interval spanned by the real parts of the Ritz values.
+   All the recurrences are scaled by the largest Ritz value in magnitude.
+*/
+PetscErrorCode KSPSStepBasisCoefficients_Private(KSPSStepBasisType type,PetscInt n,PetscScalar *H,PetscInt ldh,PetscInt s,PetscScalar *diag,PetscScalar *sub,PetscScalar *sup)
+{
+  PetscErrorCode ierr;
+  PetscInt       i,j,k,best,nchosen = 0,ncand = 0;
+  PetscReal      emin,emax,scale = 0.0,val,bestval = 0.0,dist,*re,*im,*cre,*cim;
+  PetscScalar    *work,sdummy = 0.0;
+  PetscBLASInt   bn,bld,lwork,idummy = 1,lierr;
+  PetscBool      *used;
+
+  PetscFunctionBegin;
+  for (j=0; j<s; j++) {
+    diag[j] = 0.0;
+    sub[j]  = 1.0;
+    sup[j]  = 0.0;
+  }
+  if (!n || type == KSP_SSTEP_BASIS_MONOMIAL) PetscFunctionReturn(0);
+
+  ierr = PetscBLASIntCast(n,&bn);CHKERRQ(ierr);
+  ierr = PetscBLASIntCast(ldh,&bld);CHKERRQ(ierr);
+  ierr = PetscBLASIntCast(5*n,&lwork);CHKERRQ(ierr);
+  ierr = PetscMalloc5(2*n,&re,n,&im,5*n,&work,s,&cre,s,&cim);CHKERRQ(ierr); /* re doubles as the real workspace of the complex geev */
+  ierr = PetscFPTrapPush(PETSC_FP_TRAP_OFF);CHKERRQ(ierr);
+#if !defined(PETSC_USE_COMPLEX)
+  PetscStackCallBLAS("LAPACKgeev",LAPACKgeev_("N","N",&bn,H,&bld,re,im,&sdummy,&idummy,&sdummy,&idummy,work,&lwork,&lierr));
+#else
+  {
+    PetscScalar *eigs;
+
+    ierr = PetscMalloc1(n,&eigs);CHKERRQ(ierr);
+    PetscStackCallBLAS("LAPACKgeev",LAPACKgeev_("N","N",&bn,H,&bld,eigs,&sdummy,&idummy,&sdummy,&idummy,work,&lwork,re,&lierr));
+    for (i=0; i<n; i++) {
+      re[i] = PetscRealPart(eigs[i]);
+      im[i] = PetscImaginaryPart(eigs[i]);
+    }
+    ierr = PetscFree(eigs);CHKERRQ(ierr);
+  }
+#endif
+  ierr = PetscFPTrapPop();CHKERRQ(ierr);
+  if (lierr) SETERRQ1(PETSC_COMM_SELF,PETSC_ERR_LIB,"Error in LAPACK routine %d",(int)lierr);
+
+  emin = emax = re[0];
+  for (i=0; i<n; i++) {
+    if (PetscIsInfOrNanReal(re[i]) || PetscIsInfOrNanReal(im[i])) {scale = 0.0; break;}
+    if (PetscDefined(USE_COMPLEX) || im[i] >= 0.0) ncand++;
+    emin  = PetscMin(emin,re[i]);
+    emax  = PetscMax(emax,re[i]);
+    scale = PetscMax(scale,PetscSqrtReal(re[i]*re[i] + im[i]*im[i]));
+  }
+  if (scale == 0.0 || !ncand) { /* keep the monomial basis */
+    ierr = PetscFree5(re,im,work,cre,cim);CHKERRQ(ierr);
+    PetscFunctionReturn(0);
+  }
+  if (type == KSP_SSTEP_BASIS_CHEBYSHEV) {
+    PetscReal c = 0.5*(emax + emin),d = 0.5*(emax - emin);
+
+    if (d > PETSC_SQRT_MACHINE_EPSILON*scale) {
+      for (j=0; j<s; j++) {
+        diag[j] = c;
+        sub[j]  = j ? 0.5*d : d;
+        sup[j]  = j ? 0.5*d : 0.0;
+      }
+      ierr = PetscFree5(re,im,work,cre,cim);CHKERRQ(ierr);
+      PetscFunctionReturn(0);
+    }
+    /* the Ritz values are (nearly) a single point, the Newton basis is then better defined */
+  }
+
+  ierr = PetscCalloc1(n,&used);CHKERRQ(ierr);
+  for (j=0; j<s;) {
+    best = -1;
+    for (i=0; i<n; i++) {
+      if (used[i] || (!PetscDefined(USE_COMPLEX) && im[i] < 0.0)) continue;
+      if (!nchosen) val = PetscSqrtReal(re[i]*re[i] + im[i]*im[i]);
+      else {
+        for (k=0,val=0.0; k<nchosen; k++) {
+          dist = PetscSqrtReal((re[i]-cre[k])*(re[i]-cre[k]) + (im[i]-cim[k])*(im[i]-cim[k]));
+          if (dist == 0.0) {val = PETSC_MIN_REAL; break;}
+          val += PetscLogReal(dist/scale);
+        }
+      }
+      if (best < 0 || val > bestval) {best = i; bestval = val;}
+    }
+    if (best < 0) { /* fewer Ritz values than steps, cycle through them again */
+      ierr = PetscArrayzero(used,n);CHKERRQ(ierr);
+      continue;
+    }
+    used[best] = PETSC_TRUE;
+#if defined(PETSC_USE_COMPLEX)
+    diag[j]        = PetscCMPLX(re[best],im[best]);
+    sub[j]         = scale;
+    cre[nchosen]   = re[best];
+    cim[nchosen++] = im[best];
+    j++;
+#else
+    diag[j] = re[best];
+    sub[j]  = scale;
+    if (im[best] == 0.0 || j == s-1) { /* a real shift, or the real part of a pair that does not fit */
+      cre[nchosen]   = re[best];
+      cim[nchosen++] = 0.0;
+      j++;
+    } else {
+      diag[j+1]      = re[best];
+      sub[j+1]       = scale;
+      sup[j+1]       = -im[best]*im[best]/scale;
+      cre[nchosen]   = re[best];
+      cim[nchosen++] = im[best];
+      cre[nchosen]   = re[best];
+      cim[nchosen++] = -im[best];
+      j += 2;
+    }
+#endif
+  }
+  ierr = PetscFree(used);CHKERRQ(ierr);
+  ierr = PetscFree5(re,im,work,cre,cim);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+/*
+     KSPSetUp_SSTEPCG - Sets up the workspace needed by the s-step CG method
+
+     The work vectors are the residual, the preconditioned residual, one extra basis vector used to estimate the
+     Ritz values and 4 s vectors for the basis and the directions.
+*/
+static PetscErrorCode KSPSetUp_SSTEPCG(KSP ksp)
+{
+  KSP_SSTEPCG    *cg = (KSP_SSTEPCG*)ksp->data;
+  PetscInt       s = cg->s,j;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  ierr = KSPSetWorkVecs(ksp,4*s+3);CHKERRQ(ierr);
+  ierr = PetscMalloc4(s+1,&cg->S,s+1,&cg->Q,s+1,&cg->P,s+1,&cg->AP);CHKERRQ(ierr);
+  for (j=0; j<s; j++) {
+    cg->S[j]  = ksp->work[3+j];
+    cg->Q[j]  = ksp->work[3+s+j];
+    cg->P[j]  = ksp->work[3+2*s+j];
+    cg->AP[j] = ksp->work[3+3*s+j];
+  }
+  /* the extra vector stays in the last slot when the arrays are swapped */
+  cg->S[s] = cg->Q[s] = cg->P[s] = cg->AP[s] = ksp->work[2];
+  ierr = PetscMalloc3(s,&cg->diag,s,&cg->sub,s,&cg->sup);CHKERRQ(ierr);
+  ierr = PetscMalloc6(s*s,&cg->G,s*s,&cg->C,s*s,&cg->W,s*s,&cg->Wold,s*s,&cg->beta,s*s,&cg->K);CHKERRQ(ierr);
+  ierr = PetscMalloc4(s,&cg->g,s,&cg->h,s,&cg->alpha,s,&cg->work);CHKERRQ(ierr);
+  ierr = PetscLogObjectMemory((PetscObject)ksp,(6*s*s+7*s)*sizeof(PetscScalar));CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+/*
+   KSPSolve_SSTEPCG - Each outer iteration generates a basis S of the Krylov space K_s(BA,z) (with the chosen polynomial
+   basis), A-orthogonalizes it against the directions P of the previous outer iteration and minimizes the A-norm of the
+   error over the new directions.
+
+   All the inner products of an outer iteration only involve S, AS, AP and r, and are computed with a single global reduction
+$     G = S^H A S, C = (AP)^H S, g = S^H r, h = P^H r
+   from which follow
+$     beta = Wold^{-1} C, P = S - Pold beta, W = P^H A P = G - C^H beta, P^H r = g - beta^H h
+$     alpha = W^{-1} P^H r, x = x + P alpha, r = r - AP alpha
+*/
+static PetscErrorCode KSPSolve_SSTEPCG(KSP ksp)
+{
+  KSP_SSTEPCG    *cg = (KSP_SSTEPCG*)ksp->data;
+  PetscErrorCode ierr;
+  PetscInt       s = cg->s,ns,nsold = 0,i,j,k;
+  PetscScalar    *G = cg->G,*C = cg->C,*K = cg->K,*beta = cg->beta,*g = cg->g,*h = cg->h,*alpha = cg->alpha,*work = cg->work;
+  PetscScalar    *diag = cg->diag,*sub = cg->sub,*sup = cg->sup,*stmp;
+  PetscReal      dp = 0.0;
+  Vec            X,B,R,Z,*vtmp;
+  Mat            Amat,Pmat;
+  PetscBool      diagonalscale,estimate,redo = PETSC_FALSE;
+  PetscBLASInt   bn,bnold,bs,one = 1,info;
+
+  PetscFunctionBegin;
+  ierr = PCGetDiagonalScale(ksp->pc,&diagonalscale);CHKERRQ(ierr);
+  if (diagonalscale) SETERRQ1(PetscObjectComm((PetscObject)ksp),PETSC_ERR_SUP,"Krylov method %s does not support diagonal scaling",((PetscObject)ksp)->type_name);
+
+  X = ksp->vec_sol;
+  B = ksp->vec_rhs;
+  R = ksp->work[0];
+  Z = ksp->work[1];
+  ierr = PCGetOperators(ksp->pc,&Amat,&Pmat);CHKERRQ(ierr);
+  ierr = PetscBLASIntCast(s,&bs);CHKERRQ(ierr);
+
+  /* the Ritz values needed by the Newton and Chebyshev bases are estimated during the first outer iteration */
+  estimate = (PetscBool)(cg->basis != KSP_SSTEP_BASIS_MONOMIAL && s > 1);
+  ierr     = KSPSStepBasisCoefficients_Private(KSP_SSTEP_BASIS_MONOMIAL,0,NULL,0,s,diag,sub,sup);CHKERRQ(ierr);
+
+  ksp->its = 0;
+  if (!ksp->guess_zero) {
+    ierr = KSP_MatMult(ksp,Amat,X,R);CHKERRQ(ierr);            /*   r <- b - Ax   */
+    ierr = VecAYPX(R,-1.0,B);CHKERRQ(ierr);
+  } else {
+    ierr = VecCopy(B,R);CHKERRQ(ierr);                         /*   r <- b (x is 0)   */
+  }
+  ierr = KSP_PCApply(ksp,R,Z);CHKERRQ(ierr);                   /*   z <- Br   */
+
+  while (1) {
+    Vec *S = cg->S,*Q = cg->Q,*P = cg->P,*AP = cg->AP;
+
+    ns = PetscMin(s,ksp->max_it - ksp->its); /* with ns = 0 only the final residual norm is computed */
+    if (ns < s) estimate = PETSC_FALSE;
+    if (ns) {
+      ierr = VecCopy(Z,S[0]);CHKERRQ(ierr);
+      for (j=0; j<ns; j++) {
+        ierr = KSP_MatMult(ksp,Amat,S[j],Q[j]);CHKERRQ(ierr);
+        if (j < ns-1 || estimate) {
+          ierr = KSP_PCApply(ksp,Q[j],S[j+1]);CHKERRQ(ierr);
+          if (diag[j] != (PetscScalar)0.0) {ierr = VecAXPY(S[j+1],-diag[j],S[j]);CHKERRQ(ierr);}
+          if (j && sup[j] != (PetscScalar)0.0) {ierr = VecAXPY(S[j+1],-sup[j],S[j-1]);CHKERRQ(ierr);}
+          if (sub[j] != (PetscScalar)1.0) {ierr = VecScale(S[j+1],1.0/sub[j]);CHKERRQ(ierr);}
+        }
+      }
+    }
+
+    /* the only global reduction of the outer iteration */
+    for (j=0; j<ns; j++) {
+      ierr = VecMDotBegin(Q[j],ns,S,G+j*s);CHKERRQ(ierr);
+      if (nsold) {ierr = VecMDotBegin(S[j],nsold,AP,C+j*s);CHKERRQ(ierr);}
+    }
+    if (ns) {ierr = VecMDotBegin(R,ns,S,g);CHKERRQ(ierr);}
+    else if (ksp->normtype == KSP_NORM_NATURAL) {ierr = VecDotBegin(R,Z,g);CHKERRQ(ierr);}
+    if (ns && nsold) {ierr = VecMDotBegin(R,nsold,P,h);CHKERRQ(ierr);}
+    if (estimate) {ierr = VecMDotBegin(S[ns],ns,Q,K+(ns-1)*s);CHKERRQ(ierr);}
+    if (ksp->normtype == KSP_NORM_UNPRECONDITIONED) {ierr = VecNormBegin(R,NORM_2,&dp);CHKERRQ(ierr);}
+    else if (ksp->normtype == KSP_NORM_PRECONDITIONED) {ierr = VecNormBegin(Z,NORM_2,&dp);CHKERRQ(ierr);}
+    ierr = PetscCommSplitReductionBegin(PetscObjectComm((PetscObject)R));CHKERRQ(ierr);
+    for (j=0; j<ns; j++) {
+      ierr = VecMDotEnd(Q[j],ns,S,G+j*s);CHKERRQ(ierr);
+      if (nsold) {ierr = VecMDotEnd(S[j],nsold,AP,C+j*s);CHKERRQ(ierr);}
+    }
+    if (ns) {ierr = VecMDotEnd(R,ns,S,g);CHKERRQ(ierr);}
+    else if (ksp->normtype == KSP_NORM_NATURAL) {ierr = VecDotEnd(R,Z,g);CHKERRQ(ierr);}
+    if (ns && nsold) {ierr = VecMDotEnd(R,nsold,P,h);CHKERRQ(ierr);}
+    if (estimate) {ierr = VecMDotEnd(S[ns],ns,Q,K+(ns-1)*s);CHKERRQ(ierr);}
+    if (ksp->normtype == KSP_NORM_UNPRECONDITIONED) {ierr = VecNormEnd(R,NORM_2,&dp);CHKERRQ(ierr);}
+    else if (ksp->normtype == KSP_NORM_PRECONDITIONED) {ierr = VecNormEnd(Z,NORM_2,&dp);CHKERRQ(ierr);}
+    else if (ksp->normtype == KSP_NORM_NATURAL) {
+      KSPCheckDot(ksp,g[0]);
+      dp = PetscSqrtReal(PetscAbsScalar(g[0]));                 /*   dp <- sqrt(z'*r) = sqrt(r'*B*r)   */
+    } else dp = 0.0;
+    KSPCheckNorm(ksp,dp);
+
+    if (!redo) {
+      ierr       = PetscObjectSAWsTakeAccess((PetscObject)ksp);CHKERRQ(ierr);
+      ksp->rnorm = dp;
+      ierr       = PetscObjectSAWsGrantAccess((PetscObject)ksp);CHKERRQ(ierr);
+      ierr = KSPLogResidualHistory(ksp,dp);CHKERRQ(ierr);
+      ierr = KSPMonitor(ksp,ksp->its,dp);CHKERRQ(ierr);
+      ierr = (*ksp->converged)(ksp,ksp->its,dp,&ksp->reason,ksp->cnvP);CHKERRQ(ierr);
+      if (ksp->reason) break;
+    }
+    redo = PETSC_FALSE;
+    if (!ns) {
+      ksp->reason = KSP_DIVERGED_ITS;
+      break;
+    }
+    ierr = PetscBLASIntCast(ns,&bn);CHKERRQ(ierr);
+
+    if (estimate) {
+      PetscBLASInt bm;
+
+      /* Rayleigh-Ritz for BA in the A inner product with the monomial basis: (S^H A BA S) y = theta (S^H A S) y,
+         restricted to the leading directions that are numerically linearly independent */
+      ierr = PetscArraycpy(cg->W,G,s*s);CHKERRQ(ierr);
+      ierr = PetscFPTrapPush(PETSC_FP_TRAP_OFF);CHKERRQ(ierr);
+      PetscStackCallBLAS("LAPACKpotrf",LAPACKpotrf_("L",&bn,cg->W,&bs,&info));
+      ierr = PetscFPTrapPop();CHKERRQ(ierr);
+      if (info < 0) SETERRQ1(PETSC_COMM_SELF,PETSC_ERR_LIB,"Error in LAPACK routine %d",(int)info);
+      bm       = info ? info-1 : bn;
+      estimate = PETSC_FALSE;
+      if (bm > 1) {
+        for (j=0; j<bm-1; j++) {ierr = PetscArraycpy(K+j*s,G+(j+1)*s,bm);CHKERRQ(ierr);}
+        if (bm < bn) {ierr = PetscArraycpy(K+(bm-1)*s,G+bm*s,bm);CHKERRQ(ierr);}
+        PetscStackCallBLAS("LAPACKpotrs",LAPACKpotrs_("L",&bm,&bm,cg->W,&bs,K,&bs,&info));
+        if (info) SETERRQ1(PETSC_COMM_SELF,PETSC_ERR_LIB,"Error in LAPACK routine %d",(int)info);
+        ierr = KSPSStepBasisCoefficients_Private(cg->basis,bm,K,s,s,diag,sub,sup);CHKERRQ(ierr);
+        /* the directions of the monomial basis are too inaccurate to be used, generate them again with the new basis */
+        redo = PETSC_TRUE;
+        continue;
+      } else {
+        ierr = PetscInfo(ksp,"Monomial basis is numerically rank deficient, keeping it instead of estimating the Ritz values\n");CHKERRQ(ierr);
+      }
+    }
+
+    if (nsold) {
+      /* beta = Wold^{-1} C, with Wold already factored */
+      ierr = PetscBLASIntCast(nsold,&bnold);CHKERRQ(ierr);
+      for (j=0; j<ns; j++) {ierr = PetscArraycpy(beta+j*s,C+j*s,nsold);CHKERRQ(ierr);}
+      PetscStackCallBLAS("LAPACKpotrs",LAPACKpotrs_("L",&bnold,&bn,cg->Wold,&bs,beta,&bs,&info));
+      if (info) SETERRQ1(PETSC_COMM_SELF,PETSC_ERR_LIB,"Error in LAPACK routine %d",(int)info);
+      for (j=0; j<ns; j++) {
+        for (i=j; i<ns; i++) {
+          PetscScalar t = G[i+j*s];
+          for (k=0; k<nsold; k++) t -= PetscConj(C[k+i*s])*beta[k+j*s];
+          cg->W[i+j*s] = t;
+        }
+        for (k=0; k<nsold; k++) g[j] -= PetscConj(beta[k+j*s])*h[k];
+      }
+      /* P = S - Pold beta and AP = AS - APold beta, computed in place of S and AS */
+      for (j=0; j<ns; j++) {
+        for (k=0; k<nsold; k++) work[k] = -beta[k+j*s];
+        ierr = VecMAXPY(S[j],nsold,work,P);CHKERRQ(ierr);
+        ierr = VecMAXPY(Q[j],nsold,work,AP);CHKERRQ(ierr);
+      }
+    } else {
+      for (j=0; j<ns; j++) {ierr = PetscArraycpy(cg->W+j*s+j,G+j*s+j,ns-j);CHKERRQ(ierr);}
+    }
+
+    /* alpha = W^{-1} P^H r; if W is numerically singular only its leading positive definite block is used */
+    ierr = PetscFPTrapPush(PETSC_FP_TRAP_OFF);CHKERRQ(ierr);
+    PetscStackCallBLAS("LAPACKpotrf",LAPACKpotrf_("L",&bn,cg->W,&bs,&info));
+    ierr = PetscFPTrapPop();CHKERRQ(ierr);
+    if (info < 0) SETERRQ1(PETSC_COMM_SELF,PETSC_ERR_LIB,"Error in LAPACK routine %d",(int)info);
+    else if (info == 1 && nsold) {
+      /* the conjugacy with the previous directions is lost, restart from the current residual */
+      ierr  = PetscInfo1(ksp,"Restarting the s-step iteration after a breakdown of the directions at iteration %D\n",ksp->its);CHKERRQ(ierr);
+      nsold = 0;
+      redo  = PETSC_TRUE;
+      continue;
+    } else if (info == 1) {
+      ierr = PetscInfo1(ksp,"Breakdown of the s-step directions at iteration %D\n",ksp->its);CHKERRQ(ierr);
+      ksp->reason = KSP_DIVERGED_BREAKDOWN;
+      break;
+    } else if (info) {
+      ierr = PetscInfo3(ksp,"Only %D of the %D s-step directions are numerically independent at iteration %D\n",(PetscInt)info-1,ns,ksp->its);CHKERRQ(ierr);
+      ns = info-1;
+      bn = info-1;
+    }
+    ierr = PetscArraycpy(alpha,g,ns);CHKERRQ(ierr);
+    PetscStackCallBLAS("LAPACKpotrs",LAPACKpotrs_("L",&bn,&one,cg->W,&bs,alpha,&bs,&info));
+    if (info) SETERRQ1(PETSC_COMM_SELF,PETSC_ERR_LIB,"Error in LAPACK routine %d",(int)info);
+
+    ierr = VecMAXPY(X,ns,alpha,S);CHKERRQ(ierr);               /*   x <- x + P alpha   */
+    for (j=0; j<ns; j++) work[j] = -alpha[j];
+    ierr = VecMAXPY(R,ns,work,Q);CHKERRQ(ierr);                /*   r <- r - AP alpha   */
+    ierr = KSP_PCApply(ksp,R,Z);CHKERRQ(ierr);                 /*   z <- Br   */
+
+    /* the new directions become the old ones */
+    vtmp = cg->P;    cg->P    = cg->S; cg->S = vtmp;
+    vtmp = cg->AP;   cg->AP   = cg->Q; cg->Q = vtmp;
+    stmp = cg->Wold; cg->Wold = cg->W; cg->W = stmp;
+    nsold     = ns;
+    ksp->its += ns;
+  }
+  PetscFunctionReturn(0);
+}
+
+static PetscErrorCode KSPDestroy_SSTEPCG(KSP ksp)
+{
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  ierr = KSPReset_SSTEPCG(ksp);CHKERRQ(ierr);
+  ierr = PetscObjectComposeFunction((PetscObject)ksp,"KSPSStepSetSteps_C",NULL);CHKERRQ(ierr);
+  ierr = PetscObjectComposeFunction((PetscObject)ksp,"KSPSStepGetSteps_C",NULL);CHKERRQ(ierr);
+  ierr = PetscObjectComposeFunction((PetscObject)ksp,"KSPSStepSetBasisType_C",NULL);CHKERRQ(ierr);
+  ierr = PetscObjectComposeFunction((PetscObject)ksp,"KSPSStepGetBasisType_C",NULL);CHKERRQ(ierr);
+  ierr = KSPDestroyDefault(ksp);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+static PetscErrorCode KSPView_SSTEPCG(KSP ksp,PetscViewer viewer)
+{
+  KSP_SSTEPCG    *cg = (KSP_SSTEPCG*)ksp->data;
+  PetscErrorCode ierr;
+  PetscBool      iascii;
+
+  PetscFunctionBegin;
+  ierr = PetscObjectTypeCompare((PetscObject)viewer,PETSCVIEWERASCII,&iascii);CHKERRQ(ierr);
+  if (iascii) {
+    ierr = PetscViewerASCIIPrintf(viewer,"  steps per global reduction: %D, %s basis\n",cg->s,KSPSStepBasisTypes[cg->basis]);CHKERRQ(ierr);
+  }
+  PetscFunctionReturn(0);
+}
+
+static PetscErrorCode KSPSStepSetSteps_SSTEPCG(KSP ksp,PetscInt s)
+{
+  KSP_SSTEPCG    *cg = (KSP_SSTEPCG*)ksp->data;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  if (s < 1) SETERRQ1(PetscObjectComm((PetscObject)ksp),PETSC_ERR_ARG_OUTOFRANGE,"Number of steps %D must be positive",s);
+  if (!ksp->setupstage) {
+    cg->s = s;
+  } else if (cg->s != s) {
+    cg->s           = s;
+    ksp->setupstage = KSP_SETUP_NEW;
+    /* free the data structures, then create them again */
+    ierr = KSPReset_SSTEPCG(ksp);CHKERRQ(ierr);
+  }
+  PetscFunctionReturn(0);
+}
+
+static PetscErrorCode KSPSStepGetSteps_SSTEPCG(KSP ksp,PetscInt *s)
+{
+  PetscFunctionBegin;
+  *s = ((KSP_SSTEPCG*)ksp->data)->s;
+  PetscFunctionReturn(0);
+}
+
+static PetscErrorCode KSPSStepSetBasisType_SSTEPCG(KSP ksp,KSPSStepBasisType type)
+{
+  PetscFunctionBegin;
+  ((KSP_SSTEPCG*)ksp->data)->basis = type;
+  PetscFunctionReturn(0);
+}
+
+static PetscErrorCode KSPSStepGetBasisType_SSTEPCG(KSP ksp,KSPSStepBasisType *type)
+{
+  PetscFunctionBegin;
+  *type = ((KSP_SSTEPCG*)ksp->data)->basis;
+  PetscFunctionReturn(0);
+}
+
+static PetscErrorCode KSPSetFromOptions_SSTEPCG(PetscOptionItems *PetscOptionsObject,KSP ksp)
+{
+  KSP_SSTEPCG       *cg = (KSP_SSTEPCG*)ksp->data;
+  PetscErrorCode    ierr;
+  PetscInt          s;
+  KSPSStepBasisType basis;
+  PetscBool         flg;
+
+  PetscFunctionBegin;
+  ierr = PetscOptionsHead(PetscOptionsObject,"KSP s-step CG options");CHKERRQ(ierr);
+  ierr = PetscOptionsInt("-ksp_sstep_steps","Number of directions generated for each global reduction","KSPSStepSetSteps",cg->s,&s,&flg);CHKERRQ(ierr);
+  if (flg) {ierr = KSPSStepSetSteps(ksp,s);CHKERRQ(ierr);}
+  ierr = PetscOptionsEnum("-ksp_sstep_basis","Polynomial basis of the directions","KSPSStepSetBasisType",KSPSStepBasisTypes,(PetscEnum)cg->basis,(PetscEnum*)&basis,&flg);CHKERRQ(ierr);
+  if (flg) {ierr = KSPSStepSetBasisType(ksp,basis);CHKERRQ(ierr);}
+  ierr = PetscOptionsTail();CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+/*MC
+    KSPSSTEPCG - s-step preconditioned conjugate gradient method, also known as communication avoiding CG
+
+    Options Database Keys:
++   -ksp_sstep_steps <s> - number of directions generated for each global reduction, see KSPSStepSetSteps()
+-   -ksp_sstep_basis <monomial,newton,chebyshev> - the polynomial basis of the directions, see KSPSStepSetBasisType()
+
+    Level: intermediate
+
+    Notes:
+    Each outer iteration generates s new Krylov directions with s applications of the operator and of the preconditioner,
+    A-orthogonalizes them as a block against the s previous directions and minimizes the error over the s directions. All
+    the inner products of an outer iteration are computed with a single global reduction, whereas KSPCG needs 2 s of them.
+    The convergence is only tested every s iterations.
+
+    The monomial basis [z, BAz, ..., (BA)^{s-1} z] quickly becomes ill-conditioned, which limits s to about 5. The Newton and
+    Chebyshev bases use the Ritz values computed from the first outer iteration of each solve, whose directions are then
+    regenerated in the new basis, and allow s up to about 10. If the directions lose their conjugacy the method restarts
+    the A-orthogonalization from the current residual, which slows down the convergence.
+
+    The operator and the preconditioner must be symmetric positive definite. Only left preconditioning is supported.
+
+    Reference:
+    A. T. Chronopoulos and C. W. Gear, "s-step iterative methods for symmetric linear systems",
+    Journal of Computational and Applied Mathematics, 25(2), pp. 153-168, 1989.
+
+.seealso: KSPCreate(), KSPSetType(), KSPCG, KSPPIPECG, KSPGROPPCG, KSPSSTEPGMRES, KSPSStepSetSteps(), KSPSStepSetBasisType()
+M*/
+PETSC_EXTERN PetscErrorCode KSPCreate_SSTEPCG(KSP ksp)
+{
+  KSP_SSTEPCG    *cg;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  ierr = PetscNewLog(ksp,&cg);CHKERRQ(ierr);
+  cg->s     = 4;
+  cg->basis = KSP_SSTEP_BASIS_NEWTON;
+  ksp->data = (void*)cg;
+
+  ierr = KSPSetSupportedNorm(ksp,KSP_NORM_PRECONDITIONED,PC_LEFT,3);CHKERRQ(ierr);
+  ierr = KSPSetSupportedNorm(ksp,KSP_NORM_UNPRECONDITIONED,PC_LEFT,2);CHKERRQ(ierr);
+  ierr = KSPSetSupportedNorm(ksp,KSP_NORM_NATURAL,PC_LEFT,2);CHKERRQ(ierr);
+  ierr = KSPSetSupportedNorm(ksp,KSP_NORM_NONE,PC_LEFT,1);CHKERRQ(ierr);
+
+  ksp->ops->setup          = KSPSetUp_SSTEPCG;
+  ksp->ops->solve          = KSPSolve_SSTEPCG;
+  ksp->ops->reset          = KSPReset_SSTEPCG;
+  ksp->ops->destroy        = KSPDestroy_SSTEPCG;
+  ksp->ops->view           = KSPView_SSTEPCG;
+  ksp->ops->setfromoptions = KSPSetFromOptions_SSTEPCG;
+  ksp->ops->buildsolution  = KSPBuildSolutionDefault;
+  ksp->ops->buildresidual  = KSPBuildResidualDefault;
+
+  ierr = PetscObjectComposeFunction((PetscObject)ksp,"KSPSStepSetSteps_C",KSPSStepSetSteps_SSTEPCG);CHKERRQ(ierr);
+  ierr = PetscObjectComposeFunction((PetscObject)ksp,"KSPSStepGetSteps_C",KSPSStepGetSteps_SSTEPCG);CHKERRQ(ierr);
+  ierr = PetscObjectComposeFunction((PetscObject)ksp,"KSPSStepSetBasisType_C",KSPSStepSetBasisType_SSTEPCG);CHKERRQ(ierr);
+  ierr = PetscObjectComposeFunction((PetscObject)ksp,"KSPSStepGetBasisType_C",KSPSStepGetBasisType_SSTEPCG);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+/*@
+   KSPSStepSetSteps - Sets the number of Krylov directions generated at once by the s-step Krylov methods
+
+   Logically Collective on ksp
+
+   Input Parameters:
++  ksp - the KSP context
+-  s - the number of steps
+
+   Options Database Key:
+.  -ksp_sstep_steps <s> - the number of steps
+
+   Notes:
+   The s-step methods perform one global reduction for every s iterations. The basis generated for large s is
+   ill-conditioned unless a Newton or Chebyshev basis is used, see KSPSStepSetBasisType().
+
+   For KSPSSTEPGMRES the restart is rounded up to a multiple of s.
+
+   Level: intermediate
+
+.seealso: KSPSSTEPCG, KSPSSTEPGMRES, KSPSStepGetSteps(), KSPSStepSetBasisType()
+@*/
+PetscErrorCode KSPSStepSetSteps(KSP ksp,PetscInt s)
+{
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  PetscValidHeaderSpecific(ksp,KSP_CLASSID,1);
+  PetscValidLogicalCollectiveInt(ksp,s,2);
+  ierr = PetscTryMethod(ksp,"KSPSStepSetSteps_C",(KSP,PetscInt),(ksp,s));CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+/*@
+   KSPSStepGetSteps - Gets the number of Krylov directions generated at once by the s-step Krylov methods
+
+   Not Collective
+
+   Input Parameter:
+.  ksp - the KSP context
+
+   Output Parameter:
+.  s - the number of steps
+
+   Level: intermediate
+
+.seealso: KSPSSTEPCG, KSPSSTEPGMRES, KSPSStepSetSteps()
+@*/
+PetscErrorCode KSPSStepGetSteps(KSP ksp,PetscInt *s)
+{
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  PetscValidHeaderSpecific(ksp,KSP_CLASSID,1);
+  PetscValidIntPointer(s,2);
+  ierr = PetscUseMethod(ksp,"KSPSStepGetSteps_C",(KSP,PetscInt*),(ksp,s));CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+/*@
+   KSPSStepSetBasisType - Sets the polynomial basis used by the s-step Krylov methods
+
+   Logically Collective on ksp
+
+   Input Parameters:
++  ksp - the KSP context
+-  type - the basis type, KSP_SSTEP_BASIS_MONOMIAL, KSP_SSTEP_BASIS_NEWTON or KSP_SSTEP_BASIS_CHEBYSHEV
+
+   Options Database Key:
+.  -ksp_sstep_basis <monomial,newton,chebyshev> - the basis type
+
+   Level: intermediate
+
+.seealso: KSPSSTEPCG, KSPSSTEPGMRES, KSPSStepBasisType, KSPSStepGetBasisType(), KSPSStepSetSteps()
+@*/
+PetscErrorCode KSPSStepSetBasisType(KSP ksp,KSPSStepBasisType type)
+{
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  PetscValidHeaderSpecific(ksp,KSP_CLASSID,1);
+  PetscValidLogicalCollectiveEnum(ksp,type,2);
+  ierr = PetscTryMethod(ksp,"KSPSStepSetBasisType_C",(KSP,KSPSStepBasisType),(ksp,type));CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+/*@
+   KSPSStepGetBasisType - Gets the polynomial basis used by the s-step Krylov methods
+
+   Not Collective
+
+   Input Parameter:
+.  ksp - the KSP context
+
+   Output Parameter:
+.  type - the basis type
+
+   Level: intermediate
+
+.seealso: KSPSSTEPCG, KSPSSTEPGMRES, KSPSStepBasisType, KSPSStepSetBasisType()
+@*/
+PetscErrorCode KSPSStepGetBasisType(KSP ksp,KSPSStepBasisType *type)
+{
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  PetscValidHeaderSpecific(ksp,KSP_CLASSID,1);
+  PetscValidPointer(type,2);
+  ierr = PetscUseMethod(ksp,"KSPSStepGetBasisType_C",(KSP,KSPSStepBasisType*),(ksp,type));CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
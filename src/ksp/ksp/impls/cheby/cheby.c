@@ -10,6 +10,9 @@ static PetscErrorCode KSPReset_Chebyshev(KSP ksp)
   if (cheb->kspest) {
     ierr = KSPReset(cheb->kspest);CHKERRQ(ierr);
   }
+  ierr = VecDestroy(&cheb->dinv);CHKERRQ(ierr);
+  cheb->dinvid    = 0;
+  cheb->dinvstate = -1;
   PetscFunctionReturn(0);
 }
 
@@ -329,6 +332,52 @@ static PetscErrorCode KSPChebyshevEstEigGetKSP_Chebyshev(KSP ksp, KSP *kspest)
   PetscFunctionReturn(0);
 }
 
+static PetscErrorCode KSPChebyshevSetFused_Chebyshev(KSP ksp,PetscBool fused)
+{
+  KSP_Chebyshev *cheb = (KSP_Chebyshev*)ksp->data;
+
+  PetscFunctionBegin;
+  cheb->fused = fused;
+  PetscFunctionReturn(0);
+}
+
+/*@
+   KSPChebyshevSetFused - Use a single pass over the matrix for each Chebyshev step with PCJACOBI: the residual, its
+   scaling by the inverse diagonal and the update of the iterate are computed together by MatResidualJacobiUpdate()
+
+   Logically Collective on ksp
+
+   Input Parameters:
++  ksp - the Krylov space context
+-  fused - PETSC_TRUE to fuse the steps
+
+   Options Database:
+.  -ksp_chebyshev_fused <true,false>
+
+   Notes:
+   The fused steps are used when the preconditioner is PCJACOBI, the operator provides MatResidualJacobiUpdate()
+   (the AIJ format) and the norm type is KSP_NORM_NONE or KSP_NORM_UNPRECONDITIONED; otherwise the standard
+   iteration is used. This is the typical configuration of the smoothers of PCMG and PCGAMG, use
+   -mg_levels_ksp_chebyshev_fused to select it there.
+
+   The inverse diagonal is obtained by applying the preconditioner to a vector of ones and recomputed when
+   the preconditioning matrix changes.
+
+   Level: intermediate
+
+.seealso: KSPCHEBYSHEV, MatResidualJacobiUpdate(), PCJACOBI, PCMG
+@*/
+PetscErrorCode KSPChebyshevSetFused(KSP ksp,PetscBool fused)
+{
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  PetscValidHeaderSpecific(ksp,KSP_CLASSID,1);
+  PetscValidLogicalCollectiveBool(ksp,fused,2);
+  ierr = PetscTryMethod(ksp,"KSPChebyshevSetFused_C",(KSP,PetscBool),(ksp,fused));CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
 static PetscErrorCode KSPSetFromOptions_Chebyshev(PetscOptionItems *PetscOptionsObject,KSP ksp)
 {
   KSP_Chebyshev  *cheb = (KSP_Chebyshev*)ksp->data;
@@ -367,6 +416,7 @@ static PetscErrorCode KSPSetFromOptions_Chebyshev(PetscOptionItems *PetscOptions
    ierr = KSPChebyshevEstEigSet(ksp,PETSC_DECIDE,PETSC_DECIDE,PETSC_DECIDE,PETSC_DECIDE);CHKERRQ(ierr);
   }
 
+  ierr = PetscOptionsBool("-ksp_chebyshev_fused","Fuse the residual, the Jacobi scaling and the update of each step","KSPChebyshevSetFused",cheb->fused,&cheb->fused,NULL);CHKERRQ(ierr);
   if (cheb->kspest) {
     ierr = PetscOptionsBool("-ksp_chebyshev_esteig_noisy","Use noisy right hand side for estimate","KSPChebyshevEstEigSetUseNoisy",cheb->usenoisy,&cheb->usenoisy,NULL);CHKERRQ(ierr);
     ierr = KSPSetFromOptions(cheb->kspest);CHKERRQ(ierr);
@@ -375,6 +425,156 @@ static PetscErrorCode KSPSetFromOptions_Chebyshev(PetscOptionItems *PetscOptions
   PetscFunctionReturn(0);
 }
 
+/*
+   Decides if the fused iteration can be used and computes the inverse diagonal of PCJACOBI for it
+*/
+static PetscErrorCode KSPChebyshevFusedSetUp_Private(KSP ksp,PetscBool *use)
+{
+  KSP_Chebyshev    *cheb = (KSP_Chebyshev*)ksp->data;
+  PetscErrorCode   ierr;
+  Mat              Amat,Pmat;
+  PetscBool        isjac;
+  PetscObjectId    id;
+  PetscObjectState state;
+  PetscErrorCode   (*f)(Mat,Vec,Vec,PetscScalar,Vec,PetscScalar,Vec,PetscScalar,Vec,PetscReal*);
+
+  PetscFunctionBegin;
+  *use = PETSC_FALSE;
+  if (ksp->transpose_solve || ksp->max_it < 1) PetscFunctionReturn(0);
+  if (ksp->normtype != KSP_NORM_NONE && ksp->normtype != KSP_NORM_UNPRECONDITIONED) PetscFunctionReturn(0);
+  ierr = PetscObjectTypeCompare((PetscObject)ksp->pc,PCJACOBI,&isjac);CHKERRQ(ierr);
+  if (!isjac) PetscFunctionReturn(0);
+  ierr = PCGetOperators(ksp->pc,&Amat,&Pmat);CHKERRQ(ierr);
+  ierr = PetscObjectQueryFunction((PetscObject)Amat,"MatResidualJacobiUpdate_C",&f);CHKERRQ(ierr);
+  if (!f) PetscFunctionReturn(0);
+  ierr = PetscObjectGetId((PetscObject)Pmat,&id);CHKERRQ(ierr);
+  ierr = PetscObjectStateGet((PetscObject)Pmat,&state);CHKERRQ(ierr);
+  if (!cheb->dinv || id != cheb->dinvid || state != cheb->dinvstate) {
+    if (!cheb->dinv) {ierr = VecDuplicate(ksp->vec_rhs,&cheb->dinv);CHKERRQ(ierr);}
+    ierr = VecSet(ksp->work[2],1.0);CHKERRQ(ierr);
+    ierr = KSP_PCApply(ksp,ksp->work[2],cheb->dinv);CHKERRQ(ierr);
+    cheb->dinvid    = id;
+    cheb->dinvstate = state;
+  }
+  *use = PETSC_TRUE;
+  PetscFunctionReturn(0);
+}
+
+/*
+   The iteration of KSPSolve_Chebyshev() with PCJACOBI where the residual, the preconditioning and the update
+   of each step are done by a single MatResidualJacobiUpdate()
+*/
+static PetscErrorCode KSPSolve_Chebyshev_Fused(KSP ksp)
+{
+  KSP_Chebyshev  *cheb = (KSP_Chebyshev*)ksp->data;
+  PetscErrorCode ierr;
+  PetscInt       k,kp1,km1,ktmp,i;
+  PetscScalar    alpha,omegaprod,mu,omega,Gamma,c[3],scale;
+  PetscReal      rnorm = 0.0,*nrm = ksp->normtype ? &rnorm : NULL;
+  Vec            sol_orig,b,p[3],r;
+  Mat            Amat,Pmat;
+
+  PetscFunctionBegin;
+  ierr = PCGetOperators(ksp->pc,&Amat,&Pmat);CHKERRQ(ierr);
+  ierr = PetscObjectSAWsTakeAccess((PetscObject)ksp);CHKERRQ(ierr);
+  ksp->its = 0;
+  ierr   = PetscObjectSAWsGrantAccess((PetscObject)ksp);CHKERRQ(ierr);
+  km1      = 0; k = 1; kp1 = 2;
+  sol_orig = ksp->vec_sol;
+  b        = ksp->vec_rhs;
+  p[km1]   = sol_orig;
+  p[k]     = ksp->work[0];
+  p[kp1]   = ksp->work[1];
+  r        = ksp->work[2];
+
+  scale     = 2.0/(cheb->emax + cheb->emin);
+  alpha     = 1.0 - scale*(cheb->emin);
+  Gamma     = 1.0;
+  mu        = 1.0/alpha;
+  omegaprod = 2.0/alpha;
+
+  c[km1] = 1.0;
+  c[k]   = mu;
+
+  /* p[k] = p[km1] + scale D^{-1} (b - A p[km1]) */
+  if (!ksp->guess_zero) {
+    ierr = MatResidualJacobiUpdate(Amat,b,cheb->dinv,1.0,p[km1],0.0,p[km1],scale,p[k],nrm);CHKERRQ(ierr);
+  } else {
+    ierr = VecPointwiseMult(p[k],cheb->dinv,b);CHKERRQ(ierr);
+    ierr = VecScale(p[k],scale);CHKERRQ(ierr);
+    if (nrm) {ierr = VecNorm(b,NORM_2,nrm);CHKERRQ(ierr);}
+  }
+  if (ksp->normtype) {
+    ierr         = PetscObjectSAWsTakeAccess((PetscObject)ksp);CHKERRQ(ierr);
+    ksp->rnorm   = rnorm;
+    ierr = PetscObjectSAWsGrantAccess((PetscObject)ksp);CHKERRQ(ierr);
+    ierr = KSPLogResidualHistory(ksp,rnorm);CHKERRQ(ierr);
+    ierr = KSPLogErrorHistory(ksp);CHKERRQ(ierr);
+    ierr = KSPMonitor(ksp,0,rnorm);CHKERRQ(ierr);
+    ierr = (*ksp->converged)(ksp,0,rnorm,&ksp->reason,ksp->cnvP);CHKERRQ(ierr);
+  } else ksp->reason = KSP_CONVERGED_ITERATING;
+  if (ksp->reason) PetscFunctionReturn(0);
+  ierr = PetscObjectSAWsTakeAccess((PetscObject)ksp);CHKERRQ(ierr);
+  ksp->its = 1;
+  ierr   = PetscObjectSAWsGrantAccess((PetscObject)ksp);CHKERRQ(ierr);
+
+  for (i=1; i<ksp->max_it; i++) {
+    ierr = PetscObjectSAWsTakeAccess((PetscObject)ksp);CHKERRQ(ierr);
+    ksp->its++;
+    ierr   = PetscObjectSAWsGrantAccess((PetscObject)ksp);CHKERRQ(ierr);
+
+    c[kp1] = 2.0*mu*c[k] - c[km1];
+    omega  = omegaprod*c[k]/c[kp1];
+
+    /* p[kp1] = omega(p[k] - p[km1] + Gamma scale D^{-1} (b - A p[k])) + p[km1] */
+    ierr = MatResidualJacobiUpdate(Amat,b,cheb->dinv,1.0-omega,p[km1],omega,p[k],omega*Gamma*scale,p[kp1],nrm);CHKERRQ(ierr);
+    if (ksp->normtype) {
+      KSPCheckNorm(ksp,rnorm);
+      ierr         = PetscObjectSAWsTakeAccess((PetscObject)ksp);CHKERRQ(ierr);
+      ksp->rnorm   = rnorm;
+      ierr = PetscObjectSAWsGrantAccess((PetscObject)ksp);CHKERRQ(ierr);
+      ierr = KSPLogResidualHistory(ksp,rnorm);CHKERRQ(ierr);
+      ierr = KSPMonitor(ksp,i,rnorm);CHKERRQ(ierr);
+      ierr = (*ksp->converged)(ksp,i,rnorm,&ksp->reason,ksp->cnvP);CHKERRQ(ierr);
+      if (ksp->reason) break;
+    }
+    ksp->vec_sol = p[k];
+    ierr = KSPLogErrorHistory(ksp);CHKERRQ(ierr);
+
+    ktmp = km1;
+    km1  = k;
+    k    = kp1;
+    kp1  = ktmp;
+  }
+  if (!ksp->reason) {
+    if (ksp->normtype) {
+      ierr = MatResidual(Amat,b,p[k],r);CHKERRQ(ierr);
+      ierr = VecNorm(r,NORM_2,&rnorm);CHKERRQ(ierr);
+      KSPCheckNorm(ksp,rnorm);
+      ierr         = PetscObjectSAWsTakeAccess((PetscObject)ksp);CHKERRQ(ierr);
+      ksp->rnorm   = rnorm;
+      ierr         = PetscObjectSAWsGrantAccess((PetscObject)ksp);CHKERRQ(ierr);
+      ierr = KSPLogResidualHistory(ksp,rnorm);CHKERRQ(ierr);
+      ierr = KSPMonitor(ksp,i,rnorm);CHKERRQ(ierr);
+    }
+    if (ksp->its >= ksp->max_it) {
+      if (ksp->normtype != KSP_NORM_NONE) {
+        ierr = (*ksp->converged)(ksp,i,rnorm,&ksp->reason,ksp->cnvP);CHKERRQ(ierr);
+        if (!ksp->reason) ksp->reason = KSP_DIVERGED_ITS;
+      } else ksp->reason = KSP_CONVERGED_ITS;
+    }
+  }
+
+  ksp->vec_sol = sol_orig;
+  if (k) {
+    ierr = VecCopy(p[k],sol_orig);CHKERRQ(ierr);
+  }
+  if (ksp->reason == KSP_CONVERGED_ITS) {
+    ierr = KSPLogErrorHistory(ksp);CHKERRQ(ierr);
+  }
+  PetscFunctionReturn(0);
+}
+
 static PetscErrorCode KSPSolve_Chebyshev(KSP ksp)
 {
   KSP_Chebyshev  *cheb = (KSP_Chebyshev*)ksp->data;
@@ -389,6 +589,15 @@ static PetscErrorCode KSPSolve_Chebyshev(KSP ksp)
   PetscFunctionBegin;
   ierr = PCGetDiagonalScale(ksp->pc,&diagonalscale);CHKERRQ(ierr);
   if (diagonalscale) SETERRQ1(PetscObjectComm((PetscObject)ksp),PETSC_ERR_SUP,"Krylov method %s does not support diagonal scaling",((PetscObject)ksp)->type_name);
+  if (cheb->fused) {
+    PetscBool use;
+
+    ierr = KSPChebyshevFusedSetUp_Private(ksp,&use);CHKERRQ(ierr);
+    if (use) {
+      ierr = KSPSolve_Chebyshev_Fused(ksp);CHKERRQ(ierr);
+      PetscFunctionReturn(0);
+    }
+  }
 
   ierr = PCGetOperators(ksp->pc,&Amat,&Pmat);CHKERRQ(ierr);
   ierr = PetscObjectSAWsTakeAccess((PetscObject)ksp);CHKERRQ(ierr);
@@ -559,6 +768,7 @@ static  PetscErrorCode KSPView_Chebyshev(KSP ksp,PetscViewer viewer)
   ierr = PetscObjectTypeCompare((PetscObject)viewer,PETSCVIEWERASCII,&iascii);CHKERRQ(ierr);
   if (iascii) {
     ierr = PetscViewerASCIIPrintf(viewer,"  eigenvalue estimates used:  min = %g, max = %g\n",(double)cheb->emin,(double)cheb->emax);CHKERRQ(ierr);
+    if (cheb->fused) {ierr = PetscViewerASCIIPrintf(viewer,"  fused residual, Jacobi scaling and update when possible\n");CHKERRQ(ierr);}
     if (cheb->kspest) {
       ierr = PetscViewerASCIIPrintf(viewer,"  eigenvalues estimate via %s min %g, max %g\n",((PetscObject)(cheb->kspest))->type_name,(double)cheb->emin_computed,(double)cheb->emax_computed);CHKERRQ(ierr);
       ierr = PetscViewerASCIIPrintf(viewer,"  eigenvalues estimated using %s with translations  [%g %g; %g %g]\n",((PetscObject) cheb->kspest)->type_name,(double)cheb->tform[0],(double)cheb->tform[1],(double)cheb->tform[2],(double)cheb->tform[3]);CHKERRQ(ierr);
@@ -580,10 +790,12 @@ static PetscErrorCode KSPDestroy_Chebyshev(KSP ksp)
 
   PetscFunctionBegin;
   ierr = KSPDestroy(&cheb->kspest);CHKERRQ(ierr);
+  ierr = VecDestroy(&cheb->dinv);CHKERRQ(ierr);
   ierr = PetscObjectComposeFunction((PetscObject)ksp,"KSPChebyshevSetEigenvalues_C",NULL);CHKERRQ(ierr);
   ierr = PetscObjectComposeFunction((PetscObject)ksp,"KSPChebyshevEstEigSet_C",NULL);CHKERRQ(ierr);
   ierr = PetscObjectComposeFunction((PetscObject)ksp,"KSPChebyshevEstEigSetUseNoisy_C",NULL);CHKERRQ(ierr);
   ierr = PetscObjectComposeFunction((PetscObject)ksp,"KSPChebyshevEstEigGetKSP_C",NULL);CHKERRQ(ierr);
+  ierr = PetscObjectComposeFunction((PetscObject)ksp,"KSPChebyshevSetFused_C",NULL);CHKERRQ(ierr);
   ierr = KSPDestroyDefault(ksp);CHKERRQ(ierr);
   PetscFunctionReturn(0);
 }
@@ -597,7 +809,8 @@ static PetscErrorCode KSPDestroy_Chebyshev(KSP ksp)
 .   -ksp_chebyshev_esteig <a,b,c,d> - estimate eigenvalues using a Krylov method, then use this
                          transform for Chebyshev eigenvalue bounds (KSPChebyshevEstEigSet())
 .   -ksp_chebyshev_esteig_steps - number of estimation steps
--   -ksp_chebyshev_esteig_noisy - use noisy number generator to create right hand side for eigenvalue estimator
+.   -ksp_chebyshev_esteig_noisy - use noisy number generator to create right hand side for eigenvalue estimator
+-   -ksp_chebyshev_fused - with PCJACOBI and AIJ matrices do each step in a single pass over the matrix (KSPChebyshevSetFused())
 
    Level: beginner
 
@@ -610,7 +823,7 @@ static PetscErrorCode KSPDestroy_Chebyshev(KSP ksp)
           The user should call KSPChebyshevSetEigenvalues() if they have eigenvalue estimates.
 
 .seealso:  KSPCreate(), KSPSetType(), KSPType (for list of available types), KSP,
-           KSPChebyshevSetEigenvalues(), KSPChebyshevEstEigSet(), KSPChebyshevEstEigSetUseNoisy()
+           KSPChebyshevSetEigenvalues(), KSPChebyshevEstEigSet(), KSPChebyshevEstEigSetUseNoisy(), KSPChebyshevSetFused()
            KSPRICHARDSON, KSPCG, PCMG
 
 M*/
@@ -653,5 +866,6 @@ PETSC_EXTERN PetscErrorCode KSPCreate_Chebyshev(KSP ksp)
   ierr = PetscObjectComposeFunction((PetscObject)ksp,"KSPChebyshevEstEigSet_C",KSPChebyshevEstEigSet_Chebyshev);CHKERRQ(ierr);
   ierr = PetscObjectComposeFunction((PetscObject)ksp,"KSPChebyshevEstEigSetUseNoisy_C",KSPChebyshevEstEigSetUseNoisy_Chebyshev);CHKERRQ(ierr);
   ierr = PetscObjectComposeFunction((PetscObject)ksp,"KSPChebyshevEstEigGetKSP_C",KSPChebyshevEstEigGetKSP_Chebyshev);CHKERRQ(ierr);
+  ierr = PetscObjectComposeFunction((PetscObject)ksp,"KSPChebyshevSetFused_C",KSPChebyshevSetFused_Chebyshev);CHKERRQ(ierr);
   PetscFunctionReturn(0);
 }
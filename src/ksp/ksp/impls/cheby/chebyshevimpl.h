@@ -17,6 +17,11 @@ typedef struct {
   /* For tracking when to update the eigenvalue estimates */
   PetscObjectId    amatid,    pmatid;
   PetscObjectState amatstate, pmatstate;
+  /* For the fused iteration with PCJACOBI, see KSPChebyshevSetFused() */
+  PetscBool        fused;
+  Vec              dinv;         /* inverse diagonal applied by PCJACOBI */
+  PetscObjectId    dinvid;       /* id and state of the matrix dinv was computed for */
+  PetscObjectState dinvstate;
 } KSP_Chebyshev;
 
 #endif
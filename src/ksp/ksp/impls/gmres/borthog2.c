@@ -39,16 +39,17 @@ PetscErrorCode  KSPGMRESClassicalGramSchmidtOrthogonalization(KSP ksp,PetscInt i
   KSP_GMRES      *gmres = (KSP_GMRES*)(ksp->data);
   PetscErrorCode ierr;
   PetscInt       j;
-  PetscScalar    *hh,*hes,*lhh;
+  PetscScalar    *hh,*hes,*lhh,*rhh;
   PetscReal      hnrm, wnrm;
   PetscBool      refine = (PetscBool)(gmres->cgstype == KSP_GMRES_CGS_REFINE_ALWAYS);
 
   PetscFunctionBegin;
   ierr = PetscLogEventBegin(KSP_GMRESOrthogonalization,ksp,0,0,0);CHKERRQ(ierr);
   if (!gmres->orthogwork) {
-    ierr = PetscMalloc1(gmres->max_k + 2,&gmres->orthogwork);CHKERRQ(ierr);
+    ierr = PetscMalloc1(2*(gmres->max_k + 2),&gmres->orthogwork);CHKERRQ(ierr);
   }
   lhh = gmres->orthogwork;
+  rhh = gmres->orthogwork + gmres->max_k + 2;
 
   /* update Hessenberg matrix and do unmodified Gram-Schmidt */
   hh  = HH(0,it);
@@ -74,8 +75,15 @@ PetscErrorCode  KSPGMRESClassicalGramSchmidtOrthogonalization(KSP ksp,PetscInt i
   /*
          This is really a matrix vector product:
          [h[0],h[1],...]*[ v[0]; v[1]; ...] subtracted from v[it+1].
+
+     The update is fused with what comes next: the dot products of the refinement step when it is always done,
+     otherwise the norm of v[it+1], which is then cached for the normalization done by the caller.
   */
-  ierr = VecMAXPY(VEC_VV(it+1),it+1,lhh,&VEC_VV(0));CHKERRQ(ierr);
+  if (refine) {
+    ierr = VecMAXPYMDot(VEC_VV(it+1),it+1,lhh,&VEC_VV(0),rhh);CHKERRQ(ierr); /* <v,vnew> for the refinement */
+  } else {
+    ierr = VecMAXPYNorm(VEC_VV(it+1),it+1,lhh,&VEC_VV(0),&wnrm);CHKERRQ(ierr);
+  }
   /* note lhh[j] is -<v,vnew> , hence the subtraction */
   for (j=0; j<=it; j++) {
     hh[j]  -= lhh[j];     /* hh += <v,vnew> */
@@ -91,23 +99,22 @@ PetscErrorCode  KSPGMRESClassicalGramSchmidtOrthogonalization(KSP ksp,PetscInt i
     for (j=0; j<=it; j++) hnrm +=  PetscRealPart(lhh[j] * PetscConj(lhh[j]));
 
     hnrm = PetscSqrtReal(hnrm);
-    ierr = VecNorm(VEC_VV(it+1),NORM_2, &wnrm);CHKERRQ(ierr);
     KSPCheckNorm(ksp,wnrm);
     if (ksp->reason) goto done;
     if (wnrm < hnrm) {
+      ierr = PetscInfo2(ksp,"Performing iterative refinement wnorm %g hnorm %g\n",(double)wnrm,(double)hnrm);CHKERRQ(ierr);
+      ierr = VecMDot(VEC_VV(it+1),it+1,&(VEC_VV(0)),rhh);CHKERRQ(ierr); /* <v,vnew> */
       refine = PETSC_TRUE;
-      ierr   = PetscInfo2(ksp,"Performing iterative refinement wnorm %g hnorm %g\n",(double)wnrm,(double)hnrm);CHKERRQ(ierr);
     }
   }
 
   if (refine) {
-    ierr = VecMDot(VEC_VV(it+1),it+1,&(VEC_VV(0)),lhh);CHKERRQ(ierr); /* <v,vnew> */
     for (j=0; j<=it; j++) {
-       KSPCheckDot(ksp,lhh[j]);
+       KSPCheckDot(ksp,rhh[j]);
        if (ksp->reason) goto done;
-       lhh[j] = -lhh[j];
+       lhh[j] = -rhh[j];
     }
-    ierr = VecMAXPY(VEC_VV(it+1),it+1,lhh,&VEC_VV(0));CHKERRQ(ierr);
+    ierr = VecMAXPYNorm(VEC_VV(it+1),it+1,lhh,&VEC_VV(0),&wnrm);CHKERRQ(ierr);
     /* note lhh[j] is -<v,vnew> , hence the subtraction */
     for (j=0; j<=it; j++) {
       hh[j]  -= lhh[j];     /* hh += <v,vnew> */
@@ -0,0 +1,224 @@
+/*
+    Low-synchronization routines used for the orthogonalization of the Hessenberg matrix.
+
+    All the inner products of one Gram-Schmidt pass, including the norm of the new direction,
+    are computed with a single global reduction using the split-phase VecMDotBegin()/VecNormBegin().
+    The inner products of the last basis vector with the previous ones, i.e. a new row of the Gram
+    matrix V^H V of the basis, are computed with a lag of one iteration in the same reduction; they
+    give the norm of the orthogonalized direction without another reduction.
+
+    Note that for the complex numbers version, the VecMDot() arguments within the code MUST
+    remain in the order given for correct computation of inner products.
+*/
+#include <../src/ksp/ksp/impls/gmres/gmresimpl.h>
+
+/*
+   Computes z = V^H w and ||w|| and, when gram is true, the row it of the lower triangular part of G = V^H V
+   with a single reduction. The work space holds G by rows, then z, then a work array
+*/
+static PetscErrorCode KSPGMRESLowSyncReduce_Private(KSP ksp,PetscInt it,PetscBool gram,PetscReal *wnrm)
+{
+  KSP_GMRES      *gmres = (KSP_GMRES*)(ksp->data);
+  PetscErrorCode ierr;
+  PetscInt       j,ldg = gmres->max_k + 1;
+  PetscScalar    *G = gmres->orthogwork,*z = G + ldg*ldg,*work = z + gmres->max_k + 2;
+  MPI_Comm       comm;
+
+  PetscFunctionBegin;
+  ierr = PetscObjectGetComm((PetscObject)VEC_VV(it+1),&comm);CHKERRQ(ierr);
+  ierr = VecMDotBegin(VEC_VV(it+1),it+1,&(VEC_VV(0)),z);CHKERRQ(ierr);
+  if (gram) {ierr = VecMDotBegin(VEC_VV(it),it+1,&(VEC_VV(0)),work);CHKERRQ(ierr);}
+  ierr = VecNormBegin(VEC_VV(it+1),NORM_2,wnrm);CHKERRQ(ierr);
+  ierr = PetscCommSplitReductionBegin(comm);CHKERRQ(ierr);
+  ierr = VecMDotEnd(VEC_VV(it+1),it+1,&(VEC_VV(0)),z);CHKERRQ(ierr);
+  if (gram) {ierr = VecMDotEnd(VEC_VV(it),it+1,&(VEC_VV(0)),work);CHKERRQ(ierr);}
+  ierr = VecNormEnd(VEC_VV(it+1),NORM_2,wnrm);CHKERRQ(ierr);
+  /* G(it,j) = <v(j),v(it)> */
+  if (gram) for (j=0; j<=it; j++) G[it*ldg+j] = PetscConj(work[j]);
+  PetscFunctionReturn(0);
+}
+
+/*
+   Subtracts V h from w and sets gmres->orthognorm to ||w - V h|| = sqrt(||w||^2 - 2 Re(h^H z) + h^H G h) when there is
+   little cancellation in this expression, otherwise to a negative value so the norm is computed directly
+*/
+static PetscErrorCode KSPGMRESLowSyncUpdate_Private(KSP ksp,PetscInt it,const PetscScalar h[],PetscReal wnrm)
+{
+  KSP_GMRES      *gmres = (KSP_GMRES*)(ksp->data);
+  PetscErrorCode ierr;
+  PetscInt       i,j,ldg = gmres->max_k + 1;
+  PetscScalar    *G = gmres->orthogwork,*z = G + ldg*ldg,*work = z + gmres->max_k + 2,s;
+  PetscReal      nrm2 = wnrm*wnrm;
+
+  PetscFunctionBegin;
+  for (i=0; i<=it; i++) {
+    s = 0.0;
+    for (j=0; j<i; j++) s += G[i*ldg+j]*h[j];
+    nrm2   += PetscRealPart(G[i*ldg+i]*h[i]*PetscConj(h[i])) + 2.0*PetscRealPart(PetscConj(h[i])*(s - z[i]));
+    work[i] = -h[i];
+  }
+  ierr = VecMAXPY(VEC_VV(it+1),it+1,work,&VEC_VV(0));CHKERRQ(ierr);
+  if (nrm2 > PETSC_SQRT_MACHINE_EPSILON*wnrm*wnrm) gmres->orthognorm = PetscSqrtReal(nrm2);
+  else {
+    ierr = PetscInfo1(ksp,"Cancellation in the norm of the orthogonalized direction at iteration %D, computing it directly\n",ksp->its);CHKERRQ(ierr);
+    gmres->orthognorm = -1.0;
+  }
+  PetscFunctionReturn(0);
+}
+
+static PetscErrorCode KSPGMRESLowSyncGetWork_Private(KSP ksp)
+{
+  KSP_GMRES      *gmres = (KSP_GMRES*)(ksp->data);
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  if (!gmres->orthogwork) {
+    ierr = PetscMalloc1((gmres->max_k + 1)*(gmres->max_k + 1) + 2*(gmres->max_k + 2),&gmres->orthogwork);CHKERRQ(ierr);
+  }
+  PetscFunctionReturn(0);
+}
+
+/*@C
+     KSPGMRESLowSyncClassicalGramSchmidtOrthogonalization -  Orthogonalization routine using classical Gram-Schmidt
+                with a single global reduction for each pass
+
+     Collective on ksp
+
+  Input Parameters:
++   ksp - KSP object, must be associated with GMRES, FGMRES, or LGMRES Krylov method
+-   its - one less then the current GMRES restart iteration, i.e. the size of the Krylov space
+
+   Options Database Keys:
++   -ksp_gmres_lowsync_classicalgramschmidt - Activates KSPGMRESLowSyncClassicalGramSchmidtOrthogonalization()
+-   -ksp_gmres_cgs_refinement_type <refine_never,refine_ifneeded,refine_always> - determine if iterative refinement is
+                                   used to increase the stability of the classical Gram-Schmidt  orthogonalization.
+
+    Notes:
+    The projections h = V^H w of the new direction w on the Krylov basis V, the norm of w and, with a lag of one iteration, the
+    inner products of the last basis vector with the previous ones are computed with a single reduction. The norm of the
+    orthogonalized direction is then obtained from ||w - V h||^2 = ||w||^2 - 2 ||h||^2 + h^H (V^H V) h, which GMRES and FGMRES
+    use to normalize the direction, so each iteration needs one global reduction instead of two for
+    KSPGMRESClassicalGramSchmidtOrthogonalization(). When this expression suffers from cancellation, the norm is computed
+    directly with a second reduction. The refinement step, when it is requested, costs one more reduction, which again gives
+    the norm.
+
+   Level: intermediate
+
+.seealso:  KSPGMRESSetOrthogonalization(), KSPGMRESClassicalGramSchmidtOrthogonalization(), KSPGMRESSetCGSRefinementType(),
+           KSPGMRESLowSyncModifiedGramSchmidtOrthogonalization(), KSPGMRESGetOrthogonalization()
+
+@*/
+PetscErrorCode  KSPGMRESLowSyncClassicalGramSchmidtOrthogonalization(KSP ksp,PetscInt it)
+{
+  KSP_GMRES      *gmres = (KSP_GMRES*)(ksp->data);
+  PetscErrorCode ierr;
+  PetscInt       j,pass;
+  PetscScalar    *hh,*hes,*z;
+  PetscReal      wnrm,hnrm2;
+
+  PetscFunctionBegin;
+  ierr = PetscLogEventBegin(KSP_GMRESOrthogonalization,ksp,0,0,0);CHKERRQ(ierr);
+  ierr = KSPGMRESLowSyncGetWork_Private(ksp);CHKERRQ(ierr);
+  z    = gmres->orthogwork + (gmres->max_k + 1)*(gmres->max_k + 1);
+
+  hh  = HH(0,it);
+  hes = HES(0,it);
+  for (j=0; j<=it; j++) {
+    hh[j]  = 0.0;
+    hes[j] = 0.0;
+  }
+
+  gmres->orthognorm = -1.0;
+  for (pass=0; pass<2; pass++) {
+    /* <v,vnew>, ||vnew|| and on the first pass the new row of the Gram matrix, with one reduction */
+    ierr = KSPGMRESLowSyncReduce_Private(ksp,it,(PetscBool)!pass,&wnrm);CHKERRQ(ierr);
+    KSPCheckNorm(ksp,wnrm);
+    if (ksp->reason) goto done;
+    hnrm2 = 0.0;
+    for (j=0; j<=it; j++) {
+      KSPCheckDot(ksp,z[j]);
+      if (ksp->reason) goto done;
+      hh[j]  += z[j];
+      hes[j] += z[j];
+      hnrm2  += PetscRealPart(z[j] * PetscConj(z[j]));
+    }
+    ierr = KSPGMRESLowSyncUpdate_Private(ksp,it,z,wnrm);CHKERRQ(ierr);
+
+    if (pass || gmres->cgstype == KSP_GMRES_CGS_REFINE_NEVER) break;
+    /* the same test as KSPGMRESClassicalGramSchmidtOrthogonalization(), with the norm of the orthogonalized direction estimated */
+    if (gmres->cgstype == KSP_GMRES_CGS_REFINE_IFNEEDED) {
+      if (wnrm*wnrm >= 2.0*hnrm2) break;
+      ierr = PetscInfo2(ksp,"Performing iterative refinement wnorm %g hnorm %g\n",(double)PetscSqrtReal(PetscMax(wnrm*wnrm-hnrm2,0.0)),(double)PetscSqrtReal(hnrm2));CHKERRQ(ierr);
+    }
+  }
+done:
+  ierr = PetscLogEventEnd(KSP_GMRESOrthogonalization,ksp,0,0,0);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+/*@C
+     KSPGMRESLowSyncModifiedGramSchmidtOrthogonalization -  Orthogonalization routine equivalent to modified Gram-Schmidt
+                with a single global reduction for each iteration
+
+     Collective on ksp
+
+  Input Parameters:
++   ksp - KSP object, must be associated with GMRES, FGMRES, or LGMRES Krylov method
+-   its - one less then the current GMRES restart iteration, i.e. the size of the Krylov space
+
+   Options Database Keys:
+.  -ksp_gmres_lowsync_modifiedgramschmidt - Activates KSPGMRESLowSyncModifiedGramSchmidtOrthogonalization()
+
+    Notes:
+    The modified Gram-Schmidt projector is applied in its inverse compact WY form I - V (I + L)^{-1} V^H, where L is the strictly
+    lower triangular part of V^H V. The new row of L, i.e. the inner products of the last basis vector with the previous ones,
+    is computed in the same reduction as the projections and the norm of the new direction, so the loss of orthogonality is that
+    of modified Gram-Schmidt with a single global reduction per iteration, instead of one per basis vector for
+    KSPGMRESModifiedGramSchmidtOrthogonalization(). The norm of the orthogonalized direction is obtained as for
+    KSPGMRESLowSyncClassicalGramSchmidtOrthogonalization().
+
+    Reference:
+    K. Swirydowicz, J. Langou, S. Ananthan, U. Yang and S. Thomas, "Low synchronization Gram-Schmidt and generalized minimal
+    residual algorithms", Numerical Linear Algebra with Applications, 28(2), e2343, 2021.
+
+   Level: intermediate
+
+.seealso:  KSPGMRESSetOrthogonalization(), KSPGMRESModifiedGramSchmidtOrthogonalization(), KSPGMRESLowSyncClassicalGramSchmidtOrthogonalization(),
+           KSPGMRESGetOrthogonalization()
+
+@*/
+PetscErrorCode  KSPGMRESLowSyncModifiedGramSchmidtOrthogonalization(KSP ksp,PetscInt it)
+{
+  KSP_GMRES      *gmres = (KSP_GMRES*)(ksp->data);
+  PetscErrorCode ierr;
+  PetscInt       i,j,ldg = gmres->max_k + 1;
+  PetscScalar    *hh,*hes,*G,*z;
+  PetscReal      wnrm;
+
+  PetscFunctionBegin;
+  ierr = PetscLogEventBegin(KSP_GMRESOrthogonalization,ksp,0,0,0);CHKERRQ(ierr);
+  ierr = KSPGMRESLowSyncGetWork_Private(ksp);CHKERRQ(ierr);
+  G    = gmres->orthogwork;
+  z    = G + ldg*ldg;
+
+  /* <v,vnew>, the new row of the Gram matrix and ||vnew|| with one reduction */
+  gmres->orthognorm = -1.0;
+  ierr = KSPGMRESLowSyncReduce_Private(ksp,it,PETSC_TRUE,&wnrm);CHKERRQ(ierr);
+  KSPCheckNorm(ksp,wnrm);
+  if (ksp->reason) goto done;
+
+  /* the modified Gram-Schmidt coefficients solve (I + L) h = z */
+  hh  = HH(0,it);
+  hes = HES(0,it);
+  for (i=0; i<=it; i++) {
+    KSPCheckDot(ksp,z[i]);
+    if (ksp->reason) goto done;
+    hh[i] = z[i];
+    for (j=0; j<i; j++) hh[i] -= G[i*ldg+j]*hh[j];
+    hes[i] = hh[i];
+  }
+  ierr = KSPGMRESLowSyncUpdate_Private(ksp,it,hh,wnrm);CHKERRQ(ierr);
+done:
+  ierr = PetscLogEventEnd(KSP_GMRESOrthogonalization,ksp,0,0,0);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
@@ -5,10 +5,14 @@
 #define kspgmressetorthogonalization_                  KSPGMRESSETORTHOGONALIZATION
 #define kspgmresmodifiedgramschmidtorthogonalization_  KSPGMRESMODIFIEDGRAMSCHMIDTORTHOGONALIZATION
 #define kspgmresclassicalgramschmidtorthogonalization_ KSPGMRESCLASSICALGRAMSCHMIDTORTHOGONALIZATION
+#define kspgmreslowsyncmodifiedgramschmidtorthogonalization_  KSPGMRESLOWSYNCMODIFIEDGRAMSCHMIDTORTHOGONALIZATION
+#define kspgmreslowsyncclassicalgramschmidtorthogonalization_ KSPGMRESLOWSYNCCLASSICALGRAMSCHMIDTORTHOGONALIZATION
 #elif !defined(PETSC_HAVE_FORTRAN_UNDERSCORE)
 #define kspgmressetorthogonalization_                  kspgmressetorthogonalization
 #define kspgmresmodifiedgramschmidtorthogonalization_  kspgmresmodifiedgramschmidtorthogonalization
 #define kspgmresclassicalgramschmidtorthogonalization_ kspgmresclassicalgramschmidtorthogonalization
+#define kspgmreslowsyncmodifiedgramschmidtorthogonalization_  kspgmreslowsyncmodifiedgramschmidtorthogonalization
+#define kspgmreslowsyncclassicalgramschmidtorthogonalization_ kspgmreslowsyncclassicalgramschmidtorthogonalization
 #endif
 
 static struct {
@@ -25,6 +29,16 @@ PETSC_EXTERN void kspgmresclassicalgramschmidtorthogonalization_(KSP *ksp,PetscI
   *ierr = KSPGMRESClassicalGramSchmidtOrthogonalization(*ksp,*n);
 }
 
+PETSC_EXTERN void kspgmreslowsyncmodifiedgramschmidtorthogonalization_(KSP *ksp,PetscInt *n,PetscErrorCode *ierr)
+{
+  *ierr = KSPGMRESLowSyncModifiedGramSchmidtOrthogonalization(*ksp,*n);
+}
+
+PETSC_EXTERN void kspgmreslowsyncclassicalgramschmidtorthogonalization_(KSP *ksp,PetscInt *n,PetscErrorCode *ierr)
+{
+  *ierr = KSPGMRESLowSyncClassicalGramSchmidtOrthogonalization(*ksp,*n);
+}
+
 static PetscErrorCode ourorthog(KSP ksp,PetscInt n)
 {
   PetscObjectUseFortranCallback(ksp,_cb.orthog,(KSP*,PetscInt*,PetscErrorCode*),(&ksp,&n,&ierr));
@@ -37,6 +51,10 @@ PETSC_EXTERN void kspgmressetorthogonalization_(KSP *ksp,void (*orthog)(KSP*,Pet
     *ierr = KSPGMRESSetOrthogonalization(*ksp,KSPGMRESModifiedGramSchmidtOrthogonalization);
   } else if ((PetscVoidFunction)orthog == (PetscVoidFunction)kspgmresclassicalgramschmidtorthogonalization_) {
     *ierr = KSPGMRESSetOrthogonalization(*ksp,KSPGMRESClassicalGramSchmidtOrthogonalization);
+  } else if ((PetscVoidFunction)orthog == (PetscVoidFunction)kspgmreslowsyncmodifiedgramschmidtorthogonalization_) {
+    *ierr = KSPGMRESSetOrthogonalization(*ksp,KSPGMRESLowSyncModifiedGramSchmidtOrthogonalization);
+  } else if ((PetscVoidFunction)orthog == (PetscVoidFunction)kspgmreslowsyncclassicalgramschmidtorthogonalization_) {
+    *ierr = KSPGMRESSetOrthogonalization(*ksp,KSPGMRESLowSyncClassicalGramSchmidtOrthogonalization);
   } else {
     *ierr = PetscObjectSetFortranCallback((PetscObject)*ksp,PETSC_FORTRAN_CALLBACK_CLASS,&_cb.orthog,(PetscVoidFunction)orthog,NULL); if (*ierr) return;
     *ierr = KSPGMRESSetOrthogonalization(*ksp,ourorthog);
@@ -162,11 +162,17 @@ PetscErrorCode KSPGMRESCycle(PetscInt *itcount,KSP ksp)
     ierr = KSP_PCApplyBAorAB(ksp,VEC_VV(it),VEC_VV(1+it),VEC_TEMP_MATOP);CHKERRQ(ierr);
 
     /* update hessenberg matrix and do Gram-Schmidt */
+    gmres->orthognorm = -1.0;
     ierr = (*gmres->orthog)(ksp,it);CHKERRQ(ierr);
     if (ksp->reason) break;
 
-    /* vv(i+1) . vv(i+1) */
-    ierr = VecNormalize(VEC_VV(it+1),&tt);CHKERRQ(ierr);
+    /* vv(i+1) . vv(i+1), unless the orthogonalization computed it along with the projections */
+    if (gmres->orthognorm < 0.0) {
+      ierr = VecNormalize(VEC_VV(it+1),&tt);CHKERRQ(ierr);
+    } else {
+      tt = gmres->orthognorm;
+      if (tt > 0.0) {ierr = VecScale(VEC_VV(it+1),1.0/tt);CHKERRQ(ierr);}
+    }
     KSPCheckNorm(ksp,tt);
 
     /* save the magnitude */
@@ -526,6 +532,22 @@ PetscErrorCode KSPView_GMRES(KSP ksp,PetscViewer viewer)
     }
   } else if (gmres->orthog == KSPGMRESModifiedGramSchmidtOrthogonalization) {
     cstr = "Modified Gram-Schmidt Orthogonalization";
+  } else if (gmres->orthog == KSPGMRESLowSyncClassicalGramSchmidtOrthogonalization) {
+    switch (gmres->cgstype) {
+    case (KSP_GMRES_CGS_REFINE_NEVER):
+      cstr = "Low-synchronization Classical (unmodified) Gram-Schmidt Orthogonalization with no iterative refinement";
+      break;
+    case (KSP_GMRES_CGS_REFINE_ALWAYS):
+      cstr = "Low-synchronization Classical (unmodified) Gram-Schmidt Orthogonalization with one step of iterative refinement";
+      break;
+    case (KSP_GMRES_CGS_REFINE_IFNEEDED):
+      cstr = "Low-synchronization Classical (unmodified) Gram-Schmidt Orthogonalization with one step of iterative refinement when needed";
+      break;
+    default:
+      SETERRQ(PetscObjectComm((PetscObject)ksp),PETSC_ERR_ARG_OUTOFRANGE,"Unknown orthogonalization");
+    }
+  } else if (gmres->orthog == KSPGMRESLowSyncModifiedGramSchmidtOrthogonalization) {
+    cstr = "Low-synchronization Modified Gram-Schmidt Orthogonalization";
   } else {
     cstr = "unknown orthogonalization";
   }
@@ -600,8 +622,12 @@ PetscErrorCode KSPSetFromOptions_GMRES(PetscOptionItems *PetscOptionsObject,KSP
   if (flg) {ierr = KSPGMRESSetPreAllocateVectors(ksp);CHKERRQ(ierr);}
   ierr = PetscOptionsBoolGroupBegin("-ksp_gmres_classicalgramschmidt","Classical (unmodified) Gram-Schmidt (fast)","KSPGMRESSetOrthogonalization",&flg);CHKERRQ(ierr);
   if (flg) {ierr = KSPGMRESSetOrthogonalization(ksp,KSPGMRESClassicalGramSchmidtOrthogonalization);CHKERRQ(ierr);}
-  ierr = PetscOptionsBoolGroupEnd("-ksp_gmres_modifiedgramschmidt","Modified Gram-Schmidt (slow,more stable)","KSPGMRESSetOrthogonalization",&flg);CHKERRQ(ierr);
+  ierr = PetscOptionsBoolGroup("-ksp_gmres_modifiedgramschmidt","Modified Gram-Schmidt (slow,more stable)","KSPGMRESSetOrthogonalization",&flg);CHKERRQ(ierr);
   if (flg) {ierr = KSPGMRESSetOrthogonalization(ksp,KSPGMRESModifiedGramSchmidtOrthogonalization);CHKERRQ(ierr);}
+  ierr = PetscOptionsBoolGroup("-ksp_gmres_lowsync_classicalgramschmidt","Classical Gram-Schmidt with one reduction per iteration","KSPGMRESSetOrthogonalization",&flg);CHKERRQ(ierr);
+  if (flg) {ierr = KSPGMRESSetOrthogonalization(ksp,KSPGMRESLowSyncClassicalGramSchmidtOrthogonalization);CHKERRQ(ierr);}
+  ierr = PetscOptionsBoolGroupEnd("-ksp_gmres_lowsync_modifiedgramschmidt","Modified Gram-Schmidt with one reduction per iteration","KSPGMRESSetOrthogonalization",&flg);CHKERRQ(ierr);
+  if (flg) {ierr = KSPGMRESSetOrthogonalization(ksp,KSPGMRESLowSyncModifiedGramSchmidtOrthogonalization);CHKERRQ(ierr);}
   ierr = PetscOptionsEnum("-ksp_gmres_cgs_refinement_type","Type of iterative refinement for classical (unmodified) Gram-Schmidt","KSPGMRESSetCGSRefinementType",
                           KSPGMRESCGSRefinementTypes,(PetscEnum)gmres->cgstype,(PetscEnum*)&gmres->cgstype,&flg);CHKERRQ(ierr);
   flg  = PETSC_FALSE;
@@ -668,8 +694,13 @@ PetscErrorCode  KSPGMRESSetRestart_GMRES(KSP ksp,PetscInt max_k)
 
 PetscErrorCode  KSPGMRESSetOrthogonalization_GMRES(KSP ksp,FCN fcn)
 {
+  KSP_GMRES      *gmres = (KSP_GMRES*)ksp->data;
+  PetscErrorCode ierr;
+
   PetscFunctionBegin;
-  ((KSP_GMRES*)ksp->data)->orthog = fcn;
+  /* each orthogonalization routine lays out its work space differently */
+  if (fcn != gmres->orthog) {ierr = PetscFree(gmres->orthogwork);CHKERRQ(ierr);}
+  gmres->orthog = fcn;
   PetscFunctionReturn(0);
 }
 
@@ -892,6 +923,8 @@ PetscErrorCode  KSPGMRESSetBreakdownTolerance(KSP ksp,PetscReal tol)
                              vectors are allocated as needed)
 .   -ksp_gmres_classicalgramschmidt - use classical (unmodified) Gram-Schmidt to orthogonalize against the Krylov space (fast) (the default)
 .   -ksp_gmres_modifiedgramschmidt - use modified Gram-Schmidt in the orthogonalization (more stable, but slower)
+.   -ksp_gmres_lowsync_classicalgramschmidt - use classical Gram-Schmidt with one global reduction per iteration, including the norm
+.   -ksp_gmres_lowsync_modifiedgramschmidt - use modified Gram-Schmidt in inverse compact WY form with one global reduction per iteration
 .   -ksp_gmres_cgs_refinement_type <refine_never,refine_ifneeded,refine_always> - determine if iterative refinement is used to increase the
                                    stability of the classical Gram-Schmidt  orthogonalization.
 -   -ksp_gmres_krylov_monitor - plot the Krylov space generated
@@ -16,22 +16,28 @@ $   it is one minus the number of GMRES iterations since last restart;
 $    i.e. the size of Krylov space minus one
 
    Notes:
-   Two orthogonalization routines are predefined, including
+   Four orthogonalization routines are predefined, including
 
    KSPGMRESModifiedGramSchmidtOrthogonalization()
 
    KSPGMRESClassicalGramSchmidtOrthogonalization() - Default. Use KSPGMRESSetCGSRefinementType() to determine if
      iterative refinement is used to increase stability.
 
+   KSPGMRESLowSyncModifiedGramSchmidtOrthogonalization() and KSPGMRESLowSyncClassicalGramSchmidtOrthogonalization() - variants
+     that need a single global reduction per iteration (per refinement step for the classical one)
+
    Options Database Keys:
 
 +  -ksp_gmres_classicalgramschmidt - Activates KSPGMRESClassicalGramSchmidtOrthogonalization() (default)
--  -ksp_gmres_modifiedgramschmidt - Activates KSPGMRESModifiedGramSchmidtOrthogonalization()
+.  -ksp_gmres_modifiedgramschmidt - Activates KSPGMRESModifiedGramSchmidtOrthogonalization()
+.  -ksp_gmres_lowsync_classicalgramschmidt - Activates KSPGMRESLowSyncClassicalGramSchmidtOrthogonalization()
+-  -ksp_gmres_lowsync_modifiedgramschmidt - Activates KSPGMRESLowSyncModifiedGramSchmidtOrthogonalization()
 
    Level: intermediate
 
 .seealso: KSPGMRESSetRestart(), KSPGMRESSetPreAllocateVectors(), KSPGMRESSetCGSRefinementType(), KSPGMRESSetOrthogonalization(),
-          KSPGMRESModifiedGramSchmidtOrthogonalization(), KSPGMRESClassicalGramSchmidtOrthogonalization(), KSPGMRESGetCGSRefinementType()
+          KSPGMRESModifiedGramSchmidtOrthogonalization(), KSPGMRESClassicalGramSchmidtOrthogonalization(), KSPGMRESGetCGSRefinementType(),
+          KSPGMRESLowSyncModifiedGramSchmidtOrthogonalization(), KSPGMRESLowSyncClassicalGramSchmidtOrthogonalization()
 @*/
 PetscErrorCode  KSPGMRESSetOrthogonalization(KSP ksp,PetscErrorCode (*fcn)(KSP,PetscInt))
 {
@@ -60,22 +66,28 @@ $   it is one minus the number of GMRES iterations since last restart;
 $    i.e. the size of Krylov space minus one
 
    Notes:
-   Two orthogonalization routines are predefined, including
+   Four orthogonalization routines are predefined, including
 
    KSPGMRESModifiedGramSchmidtOrthogonalization()
 
    KSPGMRESClassicalGramSchmidtOrthogonalization() - Default. Use KSPGMRESSetCGSRefinementType() to determine if
      iterative refinement is used to increase stability.
 
+   KSPGMRESLowSyncModifiedGramSchmidtOrthogonalization() and KSPGMRESLowSyncClassicalGramSchmidtOrthogonalization() - variants
+     that need a single global reduction per iteration (per refinement step for the classical one)
+
    Options Database Keys:
 
 +  -ksp_gmres_classicalgramschmidt - Activates KSPGMRESClassicalGramSchmidtOrthogonalization() (default)
--  -ksp_gmres_modifiedgramschmidt - Activates KSPGMRESModifiedGramSchmidtOrthogonalization()
+.  -ksp_gmres_modifiedgramschmidt - Activates KSPGMRESModifiedGramSchmidtOrthogonalization()
+.  -ksp_gmres_lowsync_classicalgramschmidt - Activates KSPGMRESLowSyncClassicalGramSchmidtOrthogonalization()
+-  -ksp_gmres_lowsync_modifiedgramschmidt - Activates KSPGMRESLowSyncModifiedGramSchmidtOrthogonalization()
 
    Level: intermediate
 
 .seealso: KSPGMRESSetRestart(), KSPGMRESSetPreAllocateVectors(), KSPGMRESSetCGSRefinementType(), KSPGMRESSetOrthogonalization(),
-          KSPGMRESModifiedGramSchmidtOrthogonalization(), KSPGMRESClassicalGramSchmidtOrthogonalization(), KSPGMRESGetCGSRefinementType()
+          KSPGMRESModifiedGramSchmidtOrthogonalization(), KSPGMRESClassicalGramSchmidtOrthogonalization(), KSPGMRESGetCGSRefinementType(),
+          KSPGMRESLowSyncModifiedGramSchmidtOrthogonalization(), KSPGMRESLowSyncClassicalGramSchmidtOrthogonalization()
 @*/
 PetscErrorCode  KSPGMRESGetOrthogonalization(KSP ksp,PetscErrorCode (**fcn)(KSP,PetscInt))
 {
@@ -18,6 +18,7 @@
   PetscScalar *rs_origin;   /* holds the right-hand-side of the Hessenberg system */ \
                                                                         \
   PetscScalar *orthogwork; /* holds dot products computed in orthogonalization */ \
+  PetscReal   orthognorm;  /* norm of the new direction when the orthogonalization computed it, negative otherwise */ \
                                                                         \
   /* Work space for computing eigenvalues/singular values */            \
   PetscReal   *Dsvd;                                                    \
@@ -0,0 +1,618 @@
+
+/*
+    This file implements s-step GMRES, also known as communication avoiding GMRES
+*/
+
+#include <../src/ksp/ksp/impls/gmres/sstepgmres/sstepgmresimpl.h>       /*I  "petscksp.h"  I*/
+#include <petscblaslapack.h>
+#define SSTEPGMRES_DEFAULT_MAXK  30
+#define SSTEPGMRES_DEFAULT_STEPS 5
+
+static PetscErrorCode KSPSStepGMRESUpdateHessenberg(KSP,PetscInt,PetscBool*,PetscReal*);
+static PetscErrorCode KSPSStepGMRESBuildSoln(PetscScalar*,Vec,Vec,KSP,PetscInt);
+
+static PetscErrorCode KSPSStepGMRESFree_Private(KSP ksp)
+{
+  KSP_SSTEPGMRES *sgmres = (KSP_SSTEPGMRES*)ksp->data;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  ierr = PetscFree3(sgmres->diag,sgmres->sub,sgmres->sup);CHKERRQ(ierr);
+  ierr = PetscFree6(sgmres->Cb,sgmres->Gb,sgmres->Rb,sgmres->Tb,sgmres->Hritz,sgmres->swork);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+/*
+    KSPSetUp_SSTEPGMRES - Sets up the workspace needed by s-step GMRES.
+
+    The restart is rounded up to a multiple of s and all the Krylov vectors are preallocated since they are generated s at a time.
+*/
+static PetscErrorCode KSPSetUp_SSTEPGMRES(KSP ksp)
+{
+  KSP_SSTEPGMRES *sgmres = (KSP_SSTEPGMRES*)ksp->data;
+  PetscInt       s = sgmres->s,max_k;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  if (sgmres->max_k % s) {
+    ierr = PetscInfo2(ksp,"Rounding the restart %D up to a multiple of the number of steps %D\n",sgmres->max_k,s);CHKERRQ(ierr);
+    sgmres->max_k = (sgmres->max_k/s + 1)*s;
+  }
+  max_k = sgmres->max_k;
+  ierr  = KSPSetUp_GMRES(ksp);CHKERRQ(ierr);
+  /* KSPGMRESSetRestart() only resets the GMRES part of the data structure */
+  ierr = KSPSStepGMRESFree_Private(ksp);CHKERRQ(ierr);
+  ierr = PetscMalloc3(s,&sgmres->diag,s,&sgmres->sub,s,&sgmres->sup);CHKERRQ(ierr);
+  ierr = PetscMalloc6((max_k+1)*s,&sgmres->Cb,s*s,&sgmres->Gb,(max_k+2)*(s+1),&sgmres->Rb,(max_k+2)*s,&sgmres->Tb,max_k*max_k,&sgmres->Hritz,max_k+2,&sgmres->swork);CHKERRQ(ierr);
+  ierr = PetscLogObjectMemory((PetscObject)ksp,(3*s+(max_k+1)*s+s*s+(max_k+2)*(2*s+1)+max_k*max_k+max_k+2)*sizeof(PetscScalar));CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+/*
+    KSPSStepGMRESBlock - Extends the Arnoldi relation Op V_{0:n-1} = V_{0:n} H_n by s columns with a single global reduction
+
+    The directions W_0 = V_n, W_{j+1} = (Op W_j - diag_j W_j - sup_j W_{j-1})/sub_j satisfy Op W_{0:s-1} = W_{0:s} B with B
+    tridiagonal. One reduction computes C = V_{0:n}^H W_{1:s} and G = W_{1:s}^H W_{1:s}; the Cholesky factor R of G - C^H C
+    gives the new orthonormal vectors V_{n+1:n+s} = (W_{1:s} - V_{0:n} C) R^{-1} (block classical Gram-Schmidt followed by
+    a Cholesky QR). With W_{0:s} = V_{0:n+s} Rf, the new columns of the Hessenberg matrix are
+$      H_{:,n:n+s-1} = (Rf B - [H_n Rf_{0:n-1,0:s-1}; 0]) Rf_{n:n+s-1,0:s-1}^{-1}
+
+    Output Parameter:
+.   nb - the number of new columns, smaller than s if the directions are numerically linearly dependent
+*/
+static PetscErrorCode KSPSStepGMRESBlock(KSP ksp,PetscInt n,PetscInt s,PetscInt *nb)
+{
+  KSP_SSTEPGMRES *sgmres = (KSP_SSTEPGMRES*)ksp->data;
+  PetscErrorCode ierr;
+  PetscInt       ldc = sgmres->max_k+1,ldr = sgmres->max_k+2,lds = sgmres->s,i,j,k,m;
+  PetscScalar    *C = sgmres->Cb,*G = sgmres->Gb,*Rf = sgmres->Rb,*T = sgmres->Tb,*work = sgmres->swork;
+  PetscScalar    *diag = sgmres->diag,*sub = sgmres->sub,*sup = sgmres->sup,t;
+  PetscReal      nrm;
+  PetscBLASInt   bs,blds,info;
+
+  PetscFunctionBegin;
+  /* generate the new directions */
+  for (j=0; j<s; j++) {
+    ierr = KSP_PCApplyBAorAB(ksp,VEC_VV(n+j),VEC_VV(n+j+1),VEC_TEMP_MATOP);CHKERRQ(ierr);
+    if (diag[j] != (PetscScalar)0.0) {ierr = VecAXPY(VEC_VV(n+j+1),-diag[j],VEC_VV(n+j));CHKERRQ(ierr);}
+    if (j && sup[j] != (PetscScalar)0.0) {ierr = VecAXPY(VEC_VV(n+j+1),-sup[j],VEC_VV(n+j-1));CHKERRQ(ierr);}
+    if (sub[j] != (PetscScalar)1.0) {ierr = VecScale(VEC_VV(n+j+1),1.0/sub[j]);CHKERRQ(ierr);}
+  }
+
+  /* the only global reduction of the block */
+  for (j=0; j<s; j++) {
+    ierr = VecMDotBegin(VEC_VV(n+1+j),n+1,&VEC_VV(0),C+j*ldc);CHKERRQ(ierr);
+    ierr = VecMDotBegin(VEC_VV(n+1+j),j+1,&VEC_VV(n+1),G+j*lds);CHKERRQ(ierr);
+  }
+  ierr = PetscCommSplitReductionBegin(PetscObjectComm((PetscObject)VEC_VV(0)));CHKERRQ(ierr);
+  for (j=0; j<s; j++) {
+    ierr = VecMDotEnd(VEC_VV(n+1+j),n+1,&VEC_VV(0),C+j*ldc);CHKERRQ(ierr);
+    ierr = VecMDotEnd(VEC_VV(n+1+j),j+1,&VEC_VV(n+1),G+j*lds);CHKERRQ(ierr);
+  }
+
+  /* Cholesky factorization of the Gram matrix of the directions projected out of the current basis */
+  for (j=0; j<s; j++) {
+    for (i=0; i<=j; i++) {
+      for (k=0; k<=n; k++) G[i+j*lds] -= PetscConj(C[k+i*ldc])*C[k+j*ldc];
+    }
+  }
+  ierr = PetscBLASIntCast(s,&bs);CHKERRQ(ierr);
+  ierr = PetscBLASIntCast(lds,&blds);CHKERRQ(ierr);
+  ierr = PetscFPTrapPush(PETSC_FP_TRAP_OFF);CHKERRQ(ierr);
+  PetscStackCallBLAS("LAPACKpotrf",LAPACKpotrf_("U",&bs,G,&blds,&info));
+  ierr = PetscFPTrapPop();CHKERRQ(ierr);
+  if (info < 0) SETERRQ1(PETSC_COMM_SELF,PETSC_ERR_LIB,"Error in LAPACK routine %d",(int)info);
+  *nb = info ? PetscMax(info-1,1) : s;
+  if (info) {ierr = PetscInfo3(ksp,"Only %D of the %D s-step directions are numerically independent after %D iterations\n",(PetscInt)info-1,s,ksp->its);CHKERRQ(ierr);}
+
+  if (info == 1) {
+    /* the first direction is (numerically) in the span of the basis, orthogonalize it explicitly with one more pass */
+    for (k=0; k<=n; k++) work[k] = -C[k];
+    ierr = VecMAXPY(VEC_VV(n+1),n+1,work,&VEC_VV(0));CHKERRQ(ierr);
+    ierr = VecMDot(VEC_VV(n+1),n+1,&VEC_VV(0),work);CHKERRQ(ierr);
+    for (k=0; k<=n; k++) {
+      C[k]   += work[k];
+      work[k] = -work[k];
+    }
+    ierr = VecMAXPY(VEC_VV(n+1),n+1,work,&VEC_VV(0));CHKERRQ(ierr);
+    ierr = VecNormalize(VEC_VV(n+1),&nrm);CHKERRQ(ierr);
+    KSPCheckNorm(ksp,nrm);
+    G[0] = nrm;
+  } else {
+    /* V_{n+1+m} = (W_{1+m} - V_{0:n} C_{:,m} - sum_{i<m} V_{n+1+i} R_{i,m})/R_{m,m} */
+    for (m=0; m<*nb; m++) {
+      for (k=0; k<=n; k++) work[k] = -C[k+m*ldc];
+      for (i=0; i<m; i++) work[n+1+i] = -G[i+m*lds];
+      ierr = VecMAXPY(VEC_VV(n+1+m),n+1+m,work,&VEC_VV(0));CHKERRQ(ierr);
+      ierr = VecScale(VEC_VV(n+1+m),1.0/G[m+m*lds]);CHKERRQ(ierr);
+    }
+  }
+
+  /* W_{0:nb} = V_{0:n+nb} Rf */
+  ierr = PetscArrayzero(Rf,ldr*(*nb+1));CHKERRQ(ierr);
+  Rf[n] = 1.0;
+  for (m=0; m<*nb; m++) {
+    for (k=0; k<=n; k++) Rf[k+(m+1)*ldr] = C[k+m*ldc];
+    for (i=0; i<=m; i++) Rf[n+1+i+(m+1)*ldr] = G[i+m*lds];
+  }
+  /* T = Rf B - [H_n Rf_{0:n-1,:}; 0] */
+  for (j=0; j<*nb; j++) {
+    for (k=0; k<=n+*nb; k++) {
+      t = diag[j]*Rf[k+j*ldr] + sub[j]*Rf[k+(j+1)*ldr];
+      if (j) t += sup[j]*Rf[k+(j-1)*ldr];
+      T[k+j*ldr] = t;
+    }
+    for (k=0; k<=n; k++) {
+      for (i=PetscMax(k-1,0); i<n; i++) T[k+j*ldr] -= *HES(k,i)*Rf[i+j*ldr];
+    }
+  }
+  /* T = T Rf_{n:n+nb-1,0:nb-1}^{-1}, the triangular matrix has a unit first diagonal entry */
+  for (j=0; j<*nb; j++) {
+    for (i=0; i<j; i++) {
+      t = Rf[n+i+j*ldr];
+      if (t != (PetscScalar)0.0) {
+        for (k=0; k<=n+*nb; k++) T[k+j*ldr] -= t*T[k+i*ldr];
+      }
+    }
+    if (j) {
+      t = 1.0/Rf[n+j+j*ldr];
+      for (k=0; k<=n+*nb; k++) T[k+j*ldr] *= t;
+    }
+  }
+  PetscFunctionReturn(0);
+}
+
+/*
+    KSPSStepGMRESCycle - Run s-step GMRES, possibly with restart.
+
+    output parameters:
+.        itcount - number of iterations used.  If null, ignored.
+
+    Notes:
+    On entry, the value in vector VEC_VV(0) should be the initial residual.
+ */
+static PetscErrorCode KSPSStepGMRESCycle(PetscInt *itcount,KSP ksp)
+{
+  KSP_SSTEPGMRES *sgmres = (KSP_SSTEPGMRES*)(ksp->data);
+  PetscReal      res;
+  PetscErrorCode ierr;
+  PetscInt       it = 0,max_k = sgmres->max_k,s = sgmres->estimate ? 1 : sgmres->s,nb = 0,j,k;
+  PetscBool      hapend = PETSC_FALSE;
+
+  PetscFunctionBegin;
+  if (itcount) *itcount = 0;
+  ierr = VecNormalize(VEC_VV(0),&res);CHKERRQ(ierr);
+  KSPCheckNorm(ksp,res);
+  *RS(0) = res;
+
+  /* check for the convergence */
+  ierr       = PetscObjectSAWsTakeAccess((PetscObject)ksp);CHKERRQ(ierr);
+  ksp->rnorm = res;
+  ierr       = PetscObjectSAWsGrantAccess((PetscObject)ksp);CHKERRQ(ierr);
+  sgmres->it = it-1;
+  ierr = KSPLogResidualHistory(ksp,res);CHKERRQ(ierr);
+  ierr = KSPMonitor(ksp,ksp->its,res);CHKERRQ(ierr);
+  if (!res) {
+    ksp->reason = KSP_CONVERGED_ATOL;
+    ierr        = PetscInfo(ksp,"Converged due to zero residual norm on entry\n");CHKERRQ(ierr);
+    PetscFunctionReturn(0);
+  }
+  ierr = (*ksp->converged)(ksp,ksp->its,res,&ksp->reason,ksp->cnvP);CHKERRQ(ierr);
+
+  while (!ksp->reason && it < max_k && ksp->its < ksp->max_it) {
+    ierr = KSPSStepGMRESBlock(ksp,it,PetscMin(s,max_k-it),&nb);CHKERRQ(ierr);
+    if (ksp->reason) break;
+    for (j=0; j<nb; j++) {
+      for (k=0; k<=it+1; k++) *HH(k,it) = sgmres->Tb[k+j*(max_k+2)];
+      ierr = KSPSStepGMRESUpdateHessenberg(ksp,it,&hapend,&res);CHKERRQ(ierr);
+      sgmres->it = it;
+      it++;
+      ksp->its++;
+      ksp->rnorm = res;
+      if (ksp->reason) break;
+
+      ierr = (*ksp->converged)(ksp,ksp->its,res,&ksp->reason,ksp->cnvP);CHKERRQ(ierr);
+      if (it < max_k || ksp->reason || ksp->its >= ksp->max_it) { /* monitor if we are done or still iterating, but not before a restart */
+        ierr = KSPLogResidualHistory(ksp,res);CHKERRQ(ierr);
+        ierr = KSPMonitor(ksp,ksp->its,res);CHKERRQ(ierr);
+      }
+      /* Catch error in happy breakdown and signal convergence and break from loop */
+      if (hapend) {
+        if (ksp->normtype == KSP_NORM_NONE) { /* convergence test was skipped in this case */
+          ksp->reason = KSP_CONVERGED_HAPPY_BREAKDOWN;
+        } else if (!ksp->reason) {
+          if (ksp->errorifnotconverged) SETERRQ1(PetscObjectComm((PetscObject)ksp),PETSC_ERR_NOT_CONVERGED,"You reached the happy break down, but convergence was not indicated. Residual norm = %g",(double)res);
+          else ksp->reason = KSP_DIVERGED_BREAKDOWN;
+        }
+      }
+      if (ksp->reason || ksp->its >= ksp->max_it) break;
+    }
+  }
+
+  if (itcount) *itcount = it;
+
+  /*
+    Down here we have to solve for the "best" coefficients of the Krylov
+    columns, add the solution values together, and possibly unwind the
+    preconditioning from the solution
+   */
+  /* Form the solution (or the solution so far) */
+  ierr = KSPSStepGMRESBuildSoln(RS(0),ksp->vec_sol,ksp->vec_sol,ksp,it-1);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+/*
+    KSPSolve_SSTEPGMRES - This routine applies the s-step GMRES method.
+
+    For the Newton and Chebyshev bases the first restart cycle generates one direction at a time, and the Ritz values of its
+    Hessenberg matrix define the basis of the following cycles.
+*/
+static PetscErrorCode KSPSolve_SSTEPGMRES(KSP ksp)
+{
+  PetscErrorCode ierr;
+  PetscInt       its,itcount,max_k,i;
+  KSP_SSTEPGMRES *sgmres    = (KSP_SSTEPGMRES*)ksp->data;
+  PetscBool      guess_zero = ksp->guess_zero;
+
+  PetscFunctionBegin;
+  if (ksp->calc_sings && !sgmres->Rsvd) SETERRQ(PetscObjectComm((PetscObject)ksp),PETSC_ERR_ORDER,"Must call KSPSetComputeSingularValues() before KSPSetUp() is called");
+  ierr     = PetscObjectSAWsTakeAccess((PetscObject)ksp);CHKERRQ(ierr);
+  ksp->its = 0;
+  ierr     = PetscObjectSAWsGrantAccess((PetscObject)ksp);CHKERRQ(ierr);
+
+  max_k            = sgmres->max_k;
+  sgmres->estimate = (PetscBool)(sgmres->basis != KSP_SSTEP_BASIS_MONOMIAL && sgmres->s > 1);
+  ierr = KSPSStepBasisCoefficients_Private(KSP_SSTEP_BASIS_MONOMIAL,0,NULL,0,sgmres->s,sgmres->diag,sgmres->sub,sgmres->sup);CHKERRQ(ierr);
+
+  itcount     = 0;
+  ksp->reason = KSP_CONVERGED_ITERATING;
+  while (!ksp->reason) {
+    ierr     = KSPInitialResidual(ksp,ksp->vec_sol,VEC_TEMP,VEC_TEMP_MATOP,VEC_VV(0),ksp->vec_rhs);CHKERRQ(ierr);
+    ierr     = KSPSStepGMRESCycle(&its,ksp);CHKERRQ(ierr);
+    itcount += its;
+    if (itcount >= ksp->max_it) {
+      if (!ksp->reason) ksp->reason = KSP_DIVERGED_ITS;
+      break;
+    }
+    if (sgmres->estimate && its == max_k) {
+      for (i=0; i<max_k; i++) {ierr = PetscArraycpy(sgmres->Hritz+i*max_k,HES(0,i),max_k);CHKERRQ(ierr);}
+      ierr = KSPSStepBasisCoefficients_Private(sgmres->basis,max_k,sgmres->Hritz,max_k,sgmres->s,sgmres->diag,sgmres->sub,sgmres->sup);CHKERRQ(ierr);
+      sgmres->estimate = PETSC_FALSE;
+    }
+    ksp->guess_zero = PETSC_FALSE; /* every future call to KSPInitialResidual() will have nonzero guess */
+  }
+  ksp->guess_zero = guess_zero; /* restore if user provided nonzero initial guess */
+  PetscFunctionReturn(0);
+}
+
+static PetscErrorCode KSPReset_SSTEPGMRES(KSP ksp)
+{
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  ierr = KSPSStepGMRESFree_Private(ksp);CHKERRQ(ierr);
+  ierr = KSPReset_GMRES(ksp);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+static PetscErrorCode KSPDestroy_SSTEPGMRES(KSP ksp)
+{
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  ierr = KSPSStepGMRESFree_Private(ksp);CHKERRQ(ierr);
+  ierr = PetscObjectComposeFunction((PetscObject)ksp,"KSPSStepSetSteps_C",NULL);CHKERRQ(ierr);
+  ierr = PetscObjectComposeFunction((PetscObject)ksp,"KSPSStepGetSteps_C",NULL);CHKERRQ(ierr);
+  ierr = PetscObjectComposeFunction((PetscObject)ksp,"KSPSStepSetBasisType_C",NULL);CHKERRQ(ierr);
+  ierr = PetscObjectComposeFunction((PetscObject)ksp,"KSPSStepGetBasisType_C",NULL);CHKERRQ(ierr);
+  ierr = KSPDestroy_GMRES(ksp);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+/*
+    KSPSStepGMRESBuildSoln - create the solution from the starting vector and the
+                      current iterates.
+
+    Input parameters:
+        nrs - work area of size it + 1.
+        vguess  - index of initial guess
+        vdest - index of result.  Note that vguess may == vdest (replace
+                guess with the solution).
+        it - HH upper triangular part is a block of size (it+1) x (it+1)
+
+     This is an internal routine that knows about the s-step GMRES internals.
+ */
+static PetscErrorCode KSPSStepGMRESBuildSoln(PetscScalar *nrs,Vec vguess,Vec vdest,KSP ksp,PetscInt it)
+{
+  PetscScalar    tt;
+  PetscErrorCode ierr;
+  PetscInt       k,j;
+  KSP_SSTEPGMRES *sgmres = (KSP_SSTEPGMRES*)(ksp->data);
+
+  PetscFunctionBegin;
+  /* Solve for solution vector that minimizes the residual */
+
+  if (it < 0) {                                 /* no s-step GMRES steps have been performed */
+    ierr = VecCopy(vguess,vdest);CHKERRQ(ierr); /* VecCopy() is smart, exits immediately if vguess == vdest */
+    PetscFunctionReturn(0);
+  }
+
+  /* solve the upper triangular system - RS is the right side and HH is
+     the upper triangular matrix  - put soln in nrs */
+  if (*HH(it,it) != 0.0) nrs[it] = *RS(it) / *HH(it,it);
+  else nrs[it] = 0.0;
+
+  for (k=it-1; k>=0; k--) {
+    tt = *RS(k);
+    for (j=k+1; j<=it; j++) tt -= *HH(k,j) * nrs[j];
+    nrs[k] = tt / *HH(k,k);
+  }
+
+  /* Accumulate the correction to the solution of the preconditioned problem in TEMP */
+  ierr = VecZeroEntries(VEC_TEMP);CHKERRQ(ierr);
+  ierr = VecMAXPY(VEC_TEMP,it+1,nrs,&VEC_VV(0));CHKERRQ(ierr);
+  ierr = KSPUnwindPreconditioner(ksp,VEC_TEMP,VEC_TEMP_MATOP);CHKERRQ(ierr);
+  /* add solution to previous solution */
+  if (vdest == vguess) {
+    ierr = VecAXPY(vdest,1.0,VEC_TEMP);CHKERRQ(ierr);
+  } else {
+    ierr = VecWAXPY(vdest,1.0,VEC_TEMP,vguess);CHKERRQ(ierr);
+  }
+  PetscFunctionReturn(0);
+}
+
+/*
+    KSPSStepGMRESUpdateHessenberg - Applies the plane rotations to the new column of the Hessenberg matrix.
+                                    Return new residual.
+
+    input parameters:
+
+.        ksp -    Krylov space object
+.        it  -    plane rotations are applied to the (it+1)th column of the
+                  modified hessenberg (i.e. HH(:,it))
+.        hapend - PETSC_FALSE not happy breakdown ending.
+
+    output parameters:
+.        res - the new residual
+ */
+static PetscErrorCode KSPSStepGMRESUpdateHessenberg(KSP ksp,PetscInt it,PetscBool *hapend,PetscReal *res)
+{
+  PetscScalar    *hh,*cc,*ss,*rs;
+  PetscInt       j;
+  PetscReal      hapbnd;
+  KSP_SSTEPGMRES *sgmres = (KSP_SSTEPGMRES*)(ksp->data);
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  hh = HH(0,it);   /* pointer to beginning of column to update */
+  cc = CC(0);      /* beginning of cosine rotations */
+  ss = SS(0);      /* beginning of sine rotations */
+  rs = RS(0);      /* right hand side of least squares system */
+
+  /* The Hessenberg matrix is now correct through column it, save that form for the next blocks and for spectral analysis */
+  for (j=0; j<=it+1; j++) *HES(j,it) = hh[j];
+
+  /* check for the happy breakdown */
+  hapbnd = PetscMin(PetscAbsScalar(hh[it+1] / rs[it]),sgmres->haptol);
+  if (PetscAbsScalar(hh[it+1]) < hapbnd) {
+    ierr    = PetscInfo4(ksp,"Detected happy breakdown, current hapbnd = %14.12e H(%D,%D) = %14.12e\n",(double)hapbnd,it+1,it,(double)PetscAbsScalar(*HH(it+1,it)));CHKERRQ(ierr);
+    *hapend = PETSC_TRUE;
+  }
+
+  /* Apply all the previously computed plane rotations to the new column
+     of the Hessenberg matrix */
+  /* Note: this uses the rotation [conj(c)  s ; -s   c], c= cos(theta), s= sin(theta) */
+  for (j=0; j<it; j++) {
+    PetscScalar hhj = hh[j];
+    hh[j]   = PetscConj(cc[j])*hhj + ss[j]*hh[j+1];
+    hh[j+1] =          -ss[j] *hhj + cc[j]*hh[j+1];
+  }
+
+  /* compute the new plane rotation and apply it to the right-hand-side of the Hessenberg system and to the new column */
+  if (!*hapend) {
+    PetscReal delta = PetscSqrtReal(PetscSqr(PetscAbsScalar(hh[it])) + PetscSqr(PetscAbsScalar(hh[it+1])));
+    if (delta == 0.0) {
+      ksp->reason = KSP_DIVERGED_NULL;
+      PetscFunctionReturn(0);
+    }
+
+    cc[it] = hh[it] / delta;    /* new cosine value */
+    ss[it] = hh[it+1] / delta;  /* new sine value */
+
+    hh[it]   = PetscConj(cc[it])*hh[it] + ss[it]*hh[it+1];
+    rs[it+1] = -ss[it]*rs[it];
+    rs[it]   = PetscConj(cc[it])*rs[it];
+    *res     = PetscAbsScalar(rs[it+1]);
+  } else { /* happy breakdown: HH(it+1, it) = 0, therefore we don't need to apply another rotation matrix */
+    *res = 0.0;
+  }
+  PetscFunctionReturn(0);
+}
+
+/*
+   KSPBuildSolution_SSTEPGMRES
+
+     Input Parameter:
+.     ksp - the Krylov space object
+.     ptr-
+
+   Output Parameter:
+.     result - the solution
+
+   Note: this calls KSPSStepGMRESBuildSoln - the same function that KSPSStepGMRESCycle
+   calls directly.
+*/
+static PetscErrorCode KSPBuildSolution_SSTEPGMRES(KSP ksp,Vec ptr,Vec *result)
+{
+  KSP_SSTEPGMRES *sgmres = (KSP_SSTEPGMRES*)ksp->data;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  if (!ptr) {
+    if (!sgmres->sol_temp) {
+      ierr = VecDuplicate(ksp->vec_sol,&sgmres->sol_temp);CHKERRQ(ierr);
+      ierr = PetscLogObjectParent((PetscObject)ksp,(PetscObject)sgmres->sol_temp);CHKERRQ(ierr);
+    }
+    ptr = sgmres->sol_temp;
+  }
+  if (!sgmres->nrs) {
+    /* allocate the work area */
+    ierr = PetscMalloc1(sgmres->max_k,&sgmres->nrs);CHKERRQ(ierr);
+    ierr = PetscLogObjectMemory((PetscObject)ksp,sgmres->max_k*sizeof(PetscScalar));CHKERRQ(ierr);
+  }
+
+  ierr = KSPSStepGMRESBuildSoln(sgmres->nrs,ksp->vec_sol,ptr,ksp,sgmres->it);CHKERRQ(ierr);
+  if (result) *result = ptr;
+  PetscFunctionReturn(0);
+}
+
+static PetscErrorCode KSPView_SSTEPGMRES(KSP ksp,PetscViewer viewer)
+{
+  KSP_SSTEPGMRES *sgmres = (KSP_SSTEPGMRES*)ksp->data;
+  PetscErrorCode ierr;
+  PetscBool      iascii;
+
+  PetscFunctionBegin;
+  ierr = PetscObjectTypeCompare((PetscObject)viewer,PETSCVIEWERASCII,&iascii);CHKERRQ(ierr);
+  if (iascii) {
+    ierr = PetscViewerASCIIPrintf(viewer,"  restart=%D, steps per global reduction: %D, %s basis\n",sgmres->max_k,sgmres->s,KSPSStepBasisTypes[sgmres->basis]);CHKERRQ(ierr);
+    ierr = PetscViewerASCIIPrintf(viewer,"  happy breakdown tolerance %g\n",(double)sgmres->haptol);CHKERRQ(ierr);
+  }
+  PetscFunctionReturn(0);
+}
+
+static PetscErrorCode KSPSStepSetSteps_SSTEPGMRES(KSP ksp,PetscInt s)
+{
+  KSP_SSTEPGMRES *sgmres = (KSP_SSTEPGMRES*)ksp->data;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  if (s < 1) SETERRQ1(PetscObjectComm((PetscObject)ksp),PETSC_ERR_ARG_OUTOFRANGE,"Number of steps %D must be positive",s);
+  if (!ksp->setupstage) {
+    sgmres->s = s;
+  } else if (sgmres->s != s) {
+    sgmres->s       = s;
+    ksp->setupstage = KSP_SETUP_NEW;
+    /* free the data structures, then create them again */
+    ierr = KSPReset_SSTEPGMRES(ksp);CHKERRQ(ierr);
+  }
+  PetscFunctionReturn(0);
+}
+
+static PetscErrorCode KSPSStepGetSteps_SSTEPGMRES(KSP ksp,PetscInt *s)
+{
+  PetscFunctionBegin;
+  *s = ((KSP_SSTEPGMRES*)ksp->data)->s;
+  PetscFunctionReturn(0);
+}
+
+static PetscErrorCode KSPSStepSetBasisType_SSTEPGMRES(KSP ksp,KSPSStepBasisType type)
+{
+  PetscFunctionBegin;
+  ((KSP_SSTEPGMRES*)ksp->data)->basis = type;
+  PetscFunctionReturn(0);
+}
+
+static PetscErrorCode KSPSStepGetBasisType_SSTEPGMRES(KSP ksp,KSPSStepBasisType *type)
+{
+  PetscFunctionBegin;
+  *type = ((KSP_SSTEPGMRES*)ksp->data)->basis;
+  PetscFunctionReturn(0);
+}
+
+static PetscErrorCode KSPSetFromOptions_SSTEPGMRES(PetscOptionItems *PetscOptionsObject,KSP ksp)
+{
+  KSP_SSTEPGMRES    *sgmres = (KSP_SSTEPGMRES*)ksp->data;
+  PetscErrorCode    ierr;
+  PetscInt          s;
+  KSPSStepBasisType basis;
+  PetscBool         flg;
+
+  PetscFunctionBegin;
+  ierr = KSPSetFromOptions_GMRES(PetscOptionsObject,ksp);CHKERRQ(ierr);
+  ierr = PetscOptionsHead(PetscOptionsObject,"KSP s-step GMRES Options");CHKERRQ(ierr);
+  ierr = PetscOptionsInt("-ksp_sstep_steps","Number of directions generated for each global reduction","KSPSStepSetSteps",sgmres->s,&s,&flg);CHKERRQ(ierr);
+  if (flg) {ierr = KSPSStepSetSteps(ksp,s);CHKERRQ(ierr);}
+  ierr = PetscOptionsEnum("-ksp_sstep_basis","Polynomial basis of the directions","KSPSStepSetBasisType",KSPSStepBasisTypes,(PetscEnum)sgmres->basis,(PetscEnum*)&basis,&flg);CHKERRQ(ierr);
+  if (flg) {ierr = KSPSStepSetBasisType(ksp,basis);CHKERRQ(ierr);}
+  ierr = PetscOptionsTail();CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+/*MC
+     KSPSSTEPGMRES - Implements s-step GMRES, also known as communication avoiding GMRES.
+
+   Options Database Keys:
++   -ksp_gmres_restart <restart> - the number of Krylov directions to orthogonalize against, rounded up to a multiple of s
+.   -ksp_gmres_haptol <tol> - sets the tolerance for "happy ending" (exact convergence)
+.   -ksp_sstep_steps <s> - number of directions generated for each global reduction, see KSPSStepSetSteps()
+-   -ksp_sstep_basis <monomial,newton,chebyshev> - the polynomial basis of the directions, see KSPSStepSetBasisType()
+
+   Level: intermediate
+
+   Notes:
+   Each block of s iterations applies the operator s times to generate s new directions, then orthogonalizes them against
+   the current Krylov basis and against each other with a single global reduction, using block classical Gram-Schmidt
+   followed by a Cholesky QR factorization. GMRES with classical Gram-Schmidt needs 2 s reductions for the same iterations.
+
+   The monomial basis quickly becomes ill-conditioned, which limits s to about 5. For the Newton and Chebyshev bases the
+   first restart cycle of each solve generates one direction at a time, the Ritz values of its Hessenberg matrix then
+   define the basis of the following cycles and allow larger s.
+
+   If the directions of a block are numerically linearly dependent, only the leading independent ones are kept.
+
+   Reference:
+   M. Hoemmen, "Communication-avoiding Krylov subspace methods", PhD thesis, University of California, Berkeley, 2010.
+
+   Developer Notes:
+    This object is subclassed off of KSPGMRES
+
+.seealso:  KSPCreate(), KSPSetType(), KSPType (for list of available types), KSP, KSPGMRES, KSPPGMRES, KSPSSTEPCG,
+           KSPSStepSetSteps(), KSPSStepSetBasisType(), KSPGMRESSetRestart(), KSPGMRESSetHapTol()
+M*/
+
+PETSC_EXTERN PetscErrorCode KSPCreate_SSTEPGMRES(KSP ksp)
+{
+  KSP_SSTEPGMRES *sgmres;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  ierr = PetscNewLog(ksp,&sgmres);CHKERRQ(ierr);
+
+  ksp->data                              = (void*)sgmres;
+  ksp->ops->buildsolution                = KSPBuildSolution_SSTEPGMRES;
+  ksp->ops->setup                        = KSPSetUp_SSTEPGMRES;
+  ksp->ops->solve                        = KSPSolve_SSTEPGMRES;
+  ksp->ops->reset                        = KSPReset_SSTEPGMRES;
+  ksp->ops->destroy                      = KSPDestroy_SSTEPGMRES;
+  ksp->ops->view                         = KSPView_SSTEPGMRES;
+  ksp->ops->setfromoptions               = KSPSetFromOptions_SSTEPGMRES;
+  ksp->ops->computeextremesingularvalues = KSPComputeExtremeSingularValues_GMRES;
+  ksp->ops->computeeigenvalues           = KSPComputeEigenvalues_GMRES;
+
+  ierr = KSPSetSupportedNorm(ksp,KSP_NORM_PRECONDITIONED,PC_LEFT,3);CHKERRQ(ierr);
+  ierr = KSPSetSupportedNorm(ksp,KSP_NORM_UNPRECONDITIONED,PC_RIGHT,2);CHKERRQ(ierr);
+  ierr = KSPSetSupportedNorm(ksp,KSP_NORM_NONE,PC_RIGHT,1);CHKERRQ(ierr);
+
+  ierr = PetscObjectComposeFunction((PetscObject)ksp,"KSPGMRESSetRestart_C",KSPGMRESSetRestart_GMRES);CHKERRQ(ierr);
+  ierr = PetscObjectComposeFunction((PetscObject)ksp,"KSPGMRESGetRestart_C",KSPGMRESGetRestart_GMRES);CHKERRQ(ierr);
+  ierr = PetscObjectComposeFunction((PetscObject)ksp,"KSPGMRESSetHapTol_C",KSPGMRESSetHapTol_GMRES);CHKERRQ(ierr);
+  ierr = PetscObjectComposeFunction((PetscObject)ksp,"KSPSStepSetSteps_C",KSPSStepSetSteps_SSTEPGMRES);CHKERRQ(ierr);
+  ierr = PetscObjectComposeFunction((PetscObject)ksp,"KSPSStepGetSteps_C",KSPSStepGetSteps_SSTEPGMRES);CHKERRQ(ierr);
+  ierr = PetscObjectComposeFunction((PetscObject)ksp,"KSPSStepSetBasisType_C",KSPSStepSetBasisType_SSTEPGMRES);CHKERRQ(ierr);
+  ierr = PetscObjectComposeFunction((PetscObject)ksp,"KSPSStepGetBasisType_C",KSPSStepGetBasisType_SSTEPGMRES);CHKERRQ(ierr);
+
+  sgmres->haptol         = 1.0e-30;
+  sgmres->q_preallocate  = 1;
+  sgmres->delta_allocate = SSTEPGMRES_DEFAULT_MAXK;
+  sgmres->orthog         = NULL;
+  sgmres->nrs            = NULL;
+  sgmres->sol_temp       = NULL;
+  sgmres->max_k          = SSTEPGMRES_DEFAULT_MAXK;
+  sgmres->Rsvd           = NULL;
+  sgmres->orthogwork     = NULL;
+  sgmres->cgstype        = KSP_GMRES_CGS_REFINE_NEVER;
+  sgmres->s              = SSTEPGMRES_DEFAULT_STEPS;
+  sgmres->basis          = KSP_SSTEP_BASIS_NEWTON;
+  PetscFunctionReturn(0);
+}
@@ -0,0 +1,39 @@
+#if !defined(__SSTEPGMRES)
+#define __SSTEPGMRES
+
+#define KSPGMRES_NO_MACROS
+#include <../src/ksp/ksp/impls/gmres/gmresimpl.h>
+
+typedef struct {
+  KSPGMRESHEADER
+
+  /* s-step specific data */
+  PetscInt          s;                 /* number of Krylov directions generated for each global reduction */
+  KSPSStepBasisType basis;             /* polynomial basis used to generate the directions */
+  PetscBool         estimate;          /* the current cycle estimates the Ritz values with one direction at a time */
+  PetscScalar       *diag,*sub,*sup;   /* recurrence of the basis, length s */
+  PetscScalar       *Cb;               /* projections of the new directions on the orthonormal basis, (max_k+1) x s */
+  PetscScalar       *Gb;               /* Gram matrix of the new directions and then its Cholesky factor, s x s */
+  PetscScalar       *Rb;               /* change of basis from the new directions to the orthonormal ones, (max_k+2) x (s+1) */
+  PetscScalar       *Tb;               /* the new columns of the Hessenberg matrix, (max_k+2) x s */
+  PetscScalar       *Hritz;            /* square Hessenberg matrix used to compute the Ritz values */
+  PetscScalar       *swork;            /* work array of length max_k+2 */
+} KSP_SSTEPGMRES;
+
+#define HH(a,b)  (sgmres->hh_origin + (b)*(sgmres->max_k+2)+(a))
+/* HH will be size (max_k+2)*(max_k+1)  -  think of HH as
+   being stored columnwise for access purposes. */
+#define HES(a,b) (sgmres->hes_origin + (b)*(sgmres->max_k+1)+(a))
+/* HES will be size (max_k + 1) * (max_k + 1) -
+   again, think of HES as being stored columnwise */
+#define CC(a)    (sgmres->cc_origin + (a)) /* CC will be length (max_k+1) - cosines */
+#define SS(a)    (sgmres->ss_origin + (a)) /* SS will be length (max_k+1) - sines */
+#define RS(a)    (sgmres->rs_origin + (a)) /* RS will be length (max_k+2) - rt side */
+
+/* vector names */
+#define VEC_OFFSET     2
+#define VEC_TEMP       sgmres->vecs[0]               /* work space */
+#define VEC_TEMP_MATOP sgmres->vecs[1]               /* work space */
+#define VEC_VV(i)      sgmres->vecs[VEC_OFFSET+i]    /* use to access
+                                                        othog basis vectors */
+#endif
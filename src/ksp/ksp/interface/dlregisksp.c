@@ -122,6 +122,7 @@ const char *const KSPConvergedReasons_Shifted[] = {"DIVERGED_PC_FAILED","DIVERGE
                                                    "CONVERGED_HAPPY_BREAKDOWN","CONVERGED_ATOL_NORMAL","KSPConvergedReason","KSP_",NULL};
 const char *const*KSPConvergedReasons = KSPConvergedReasons_Shifted + 11;
 const char *const KSPFCDTruncationTypes[] = {"STANDARD","NOTAY","KSPFCDTruncationTypes","KSP_FCD_TRUNC_TYPE_",NULL};
+const char *const KSPSStepBasisTypes[] = {"MONOMIAL","NEWTON","CHEBYSHEV","KSPSStepBasisType","KSP_SSTEP_BASIS_",NULL};
 
 static PetscBool KSPPackageInitialized = PETSC_FALSE;
 /*@C
@@ -238,6 +238,50 @@ int main(int argc,char **args)
       args: -ksp_monitor_short -m 5 -n 5 -mat_view draw -ksp_gmres_cgs_refinement_type refine_always -nox
       output_file: output/ex2_2.out
 
+   testset:
+      nsize: 2
+      args: -ksp_monitor_short -m 5 -n 5
+      output_file: output/ex2_2.out
+      test:
+         suffix: lowsync_cgs
+         args: -ksp_gmres_lowsync_classicalgramschmidt
+      test:
+         suffix: lowsync_cgs_refine
+         args: -ksp_gmres_lowsync_classicalgramschmidt -ksp_gmres_cgs_refinement_type refine_always
+      test:
+         suffix: lowsync_mgs
+         args: -ksp_gmres_lowsync_modifiedgramschmidt
+      test:
+         suffix: lowsync_mgs_fgmres
+         args: -ksp_type fgmres -ksp_gmres_lowsync_modifiedgramschmidt
+
+   # one VecReduceBegin per iteration, two with the refinement, and no VecNormalize/VecMDot inside the Arnoldi steps
+   testset:
+      nsize: 2
+      requires: defined(PETSC_USE_LOG)
+      args: -m 5 -n 5 -ksp_converged_reason -log_view
+      filter: grep -E "^(Linear solve|VecMDot|VecNorm|VecNormalize|VecReduceBegin) " | sed -e "s/ 1.0 .\{1,\}//"
+      test:
+         suffix: lowsync_cgs_reductions
+         args: -ksp_gmres_lowsync_classicalgramschmidt
+      test:
+         suffix: lowsync_cgs_refine_reductions
+         args: -ksp_gmres_lowsync_classicalgramschmidt -ksp_gmres_cgs_refinement_type refine_always
+      test:
+         suffix: lowsync_mgs_reductions
+         args: -ksp_gmres_lowsync_modifiedgramschmidt
+      test:
+         suffix: lowsync_mgs_fgmres_reductions
+         args: -ksp_type fgmres -ksp_gmres_lowsync_modifiedgramschmidt
+
+   # the Krylov space is exhausted, the cancellation in the norm estimate is detected and the norm is computed directly
+   test:
+      suffix: lowsync_cgs_fallback
+      nsize: 2
+      requires: defined(PETSC_USE_LOG) double
+      args: -m 3 -n 3 -ksp_rtol 1e-15 -ksp_atol 0 -ksp_converged_reason -ksp_gmres_lowsync_classicalgramschmidt -log_view -info
+      filter: grep -E "Cancellation|^(Linear solve|VecNormalize|VecReduceBegin) " | sed -e "s/ 1.0 .\{1,\}//"
+
    test:
       suffix: bjacobi
       nsize: 4
@@ -342,4 +386,117 @@ int main(int argc,char **args)
       nsize: 4
       args: -ksp_monitor_short -ksp_type pipecg2 -m 15 -n 9 -ksp_norm_type {{preconditioned unpreconditioned natural}}
 
+   testset:
+      args: -m 12 -n 12 -ksp_type bicg -ksp_monitor_short -mat_aij_level_solve {{0 1}}
+      test:
+         suffix: level_solve_lu
+         args: -pc_type lu -pc_factor_mat_ordering_type nd
+         filter: sed -e "s/Norm of error [0-9.e-]\{1,\}/Norm of error < 1.e-12/g"
+      test:
+         suffix: level_solve_ilu
+         args: -pc_type ilu -pc_factor_mat_ordering_type natural
+      test:
+         suffix: level_solve_ilu_2
+         args: -pc_type ilu -pc_factor_mat_ordering_type rcm -pc_factor_levels 2
+
+   test:
+      suffix: level_solve_omp
+      requires: openmp
+      args: -m 12 -n 12 -ksp_type bicg -pc_type ilu -pc_factor_levels 2 -mat_aij_level_solve -omp_num_threads 3 -ksp_view
+      filter: grep -E "level scheduled|Norm of error"
+
+   testset:
+      args: -m 12 -n 12 -ksp_monitor_short -pc_type ilu -pc_factor_iterative_sweeps {{0 60}} -pc_factor_iterative_solve_sweeps {{0 120}}
+      test:
+         suffix: iterative_ilu
+         args: -pc_factor_mat_ordering_type natural
+      test:
+         suffix: iterative_ilu_2
+         args: -pc_factor_mat_ordering_type rcm -pc_factor_levels 1
+
+   testset:
+      args: -m 12 -n 12 -ksp_converged_reason -pc_type ilu -pc_factor_levels 1 -pc_factor_iterative_sweeps 3 -pc_factor_iterative_solve_sweeps 4 -ksp_view
+      filter: grep -E "Linear solve|sweeps"
+      output_file: output/ex2_iterative_ilu_approx.out
+      test:
+         suffix: iterative_ilu_approx
+      test:
+         suffix: iterative_ilu_approx_omp
+         requires: openmp
+         args: -omp_num_threads 3
+
+   testset:
+      args: -m 12 -n 12 -ksp_type cg -ksp_monitor_short -pc_type cholesky
+      filter: sed -e "s/Norm of error [0-9.e-]\{1,\}/Norm of error < 1.e-12/g"
+      output_file: output/ex2_level_solve_lu.out
+      test:
+         suffix: supernodal_aij
+         args: -mat_type aij -mat_aij_supernodal {{0 1}} -pc_factor_mat_ordering_type {{natural nd rcm}}
+      test:
+         suffix: supernodal_sbaij
+         args: -mat_type sbaij -mat_sbaij_supernodal {{0 1}}
+
+   test:
+      suffix: supernodal_view
+      args: -m 12 -n 12 -ksp_type cg -pc_type cholesky -pc_factor_mat_ordering_type nd -mat_aij_supernodal -ksp_view
+      filter: grep supernodal
+
+   testset:
+      args: -m 24 -n 24 -ksp_type bicg -ksp_converged_reason -pc_type bjacobi -sub_pc_type lu -sub_ksp_type preonly -pc_bjacobi_batched {{0 1}} -options_left no
+      test:
+         suffix: bjacobi_batched
+         args: -pc_bjacobi_blocks 200
+      test:
+         suffix: bjacobi_batched_omp
+         requires: openmp
+         args: -pc_bjacobi_blocks 200 -omp_num_threads 3
+         output_file: output/ex2_bjacobi_batched.out
+      test:
+         suffix: bjacobi_batched_2
+         nsize: 2
+         args: -pc_bjacobi_blocks 50
+
+   test:
+      suffix: bjacobi_batched_view
+      nsize: 2
+      args: -m 24 -n 24 -pc_type bjacobi -pc_bjacobi_blocks 200 -pc_bjacobi_batched -ksp_view
+      filter: grep -E "batched|local blocks"
+
+   # the event counts show the global reductions: one VecReduceBegin per s-step outer iteration
+   testset:
+      nsize: 2
+      requires: defined(PETSC_USE_LOG)
+      args: -m 30 -n 30 -pc_type jacobi -ksp_converged_reason -log_view
+      filter: grep -E "^(Linear solve|VecTDot|VecNorm|VecMDot|VecNormalize|VecReduceBegin) " | sed -e "s/ 1.0 .\{1,\}//"
+      test:
+         suffix: cg_reductions
+         args: -ksp_type cg
+      test:
+         suffix: sstepcg
+         args: -ksp_type sstepcg
+      test:
+         suffix: sstepcg_2
+         args: -ksp_type sstepcg -ksp_sstep_steps 6
+      test:
+         suffix: sstepcg_monomial
+         args: -ksp_type sstepcg -ksp_sstep_steps 6 -ksp_sstep_basis monomial -ksp_norm_type unpreconditioned
+      test:
+         suffix: sstepcg_chebyshev
+         args: -ksp_type sstepcg -ksp_sstep_steps 6 -ksp_sstep_basis chebyshev -ksp_norm_type natural
+      test:
+         suffix: gmres_reductions
+         args: -ksp_type gmres
+      test:
+         suffix: sstepgmres
+         args: -ksp_type sstepgmres -ksp_sstep_steps 6
+      test:
+         suffix: sstepgmres_2
+         args: -ksp_type sstepgmres -ksp_gmres_restart 20
+      test:
+         suffix: sstepgmres_monomial
+         args: -ksp_type sstepgmres -ksp_sstep_basis monomial -ksp_sstep_steps 3
+      test:
+         suffix: sstepgmres_right
+         args: -ksp_type sstepgmres -ksp_sstep_basis chebyshev -ksp_pc_side right
+
  TEST*/
@@ -157,6 +157,32 @@ PetscErrorCode ComputeMatrix(KSP ksp,Mat jac,Mat B,void *ctx)
       nsize: 4
       args: -ksp_monitor_short -da_grid_x 21 -da_grid_y 21 -da_grid_z 21 -pc_type mg -pc_mg_levels 3 -mg_levels_ksp_type richardson -mg_levels_ksp_max_it 1 -mg_levels_pc_type bjacobi
 
+   test:
+      suffix: multadditive
+      nsize: 4
+      args: -ksp_monitor_short -da_grid_x 21 -da_grid_y 21 -da_grid_z 21 -pc_type mg -pc_mg_levels 3 -pc_mg_type multadditive -ksp_type cg -mg_levels_pc_type jacobi
+
+   test:
+      suffix: multadditive_bicg
+      nsize: 4
+      args: -ksp_monitor_short -da_grid_x 21 -da_grid_y 21 -da_grid_z 21 -pc_type mg -pc_mg_levels 3 -pc_mg_type multadditive -ksp_type bicg -mg_levels_pc_type jacobi
+
+   test:
+      suffix: agglomerate
+      nsize: 4
+      args: -ksp_monitor_short -da_grid_x 21 -da_grid_y 21 -da_grid_z 21 -pc_type mg -pc_mg_levels 3 -pc_mg_galerkin pmat -pc_mg_process_eq_limit 400 -mg_levels_ksp_type richardson -mg_levels_pc_type jacobi -ksp_view
+
+   test:
+      suffix: agglomerate_failure
+      nsize: 4
+      filter: sed -e "s/-nan/nan/g"
+      args: -da_grid_x 21 -da_grid_y 21 -da_grid_z 21 -pc_type mg -pc_mg_levels 3 -pc_mg_galerkin pmat -pc_mg_process_eq_limit 400 -mg_levels_ksp_type richardson -mg_levels_pc_type jacobi -mg_coarse_ksp_type cg -mg_coarse_pc_type jacobi -mg_coarse_ksp_max_it 5 -mg_coarse_ksp_divtol 1e-30 -ksp_converged_reason
+
+   test:
+      suffix: agglomerate_dm
+      nsize: 4
+      args: -ksp_monitor_short -da_grid_x 21 -da_grid_y 21 -da_grid_z 21 -pc_type mg -pc_mg_levels 3 -pc_mg_process_eq_limit 400 -mg_levels_ksp_type richardson -mg_levels_pc_type jacobi -ksp_view
+
    test:
       suffix: telescope
       nsize: 4
@@ -167,4 +193,24 @@ PetscErrorCode ComputeMatrix(KSP ksp,Mat jac,Mat B,void *ctx)
       nsize: 4
       args: -ksp_type fgmres -ksp_monitor_short -pc_type mg -mg_levels_ksp_type richardson -mg_levels_pc_type jacobi -pc_mg_levels 2 -da_grid_x 65 -da_grid_y 65 -da_grid_z 65 -mg_coarse_pc_type telescope -mg_coarse_pc_telescope_reduction_factor 2 -mg_coarse_telescope_pc_type mg -mg_coarse_telescope_pc_mg_galerkin pmat -mg_coarse_telescope_pc_mg_levels 3 -mg_coarse_telescope_mg_levels_ksp_type richardson -mg_coarse_telescope_mg_levels_pc_type jacobi -mg_levels_ksp_type richardson -mg_coarse_telescope_mg_levels_ksp_type richardson -ksp_rtol 1.0e-4
 
+   testset:
+      args: -da_refine 1 -pc_type mg -pc_mg_levels 2 -mg_levels_pc_type jacobi -ksp_monitor_short -ksp_rtol 1e-8 -mg_levels_ksp_chebyshev_fused {{0 1}}
+      output_file: output/ex45_chebyshev_fused.out
+      test:
+         suffix: chebyshev_fused
+      test:
+         suffix: chebyshev_fused_2
+         nsize: 2
+
+   test:
+      suffix: chebyshev_fused_unpreconditioned
+      nsize: 2
+      args: -da_refine 1 -pc_type mg -pc_mg_levels 2 -mg_levels_pc_type jacobi -ksp_rtol 1e-8 -mg_levels_ksp_norm_type unpreconditioned -mg_levels_ksp_monitor_short -mg_levels_ksp_chebyshev_fused {{0 1}}
+
+   test:
+      suffix: chebyshev_fused_omp
+      requires: openmp
+      args: -da_refine 1 -pc_type mg -pc_mg_levels 2 -mg_levels_pc_type jacobi -ksp_monitor_short -ksp_rtol 1e-8 -mg_levels_ksp_chebyshev_fused -omp_num_threads 3 -ksp_view
+      filter: grep -E "fused residual|KSP Residual norm"
+
 TEST*/
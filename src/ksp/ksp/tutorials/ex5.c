@@ -358,6 +358,25 @@ int main(int argc,char **args)
       args: -pc_type asm -mat_type baij
       output_file: output/ex5_asm.out
 
+   # the second system is given in a new matrix with the same nonzero pattern
+   testset:
+      nsize: 2
+      args: -pc_type asm -test_newMat -ksp_monitor_short -pc_asm_reuse_subdomain_pattern {{0 1}}
+
+      test:
+         suffix: asm_reuse
+         args: -sub_pc_type ilu
+
+      test:
+         suffix: asm_reuse_2
+         args: -sub_pc_type lu -pc_asm_local_blocks 2 -pc_asm_local_type multiplicative
+
+   test:
+      suffix: asm_reuse_info
+      nsize: 2
+      args: -pc_type asm -test_newMat -pc_asm_reuse_subdomain_pattern -info
+      filter: grep "Reusing subdomain"
+
    test:
       suffix: redundant_0
       args: -m 1000 -pc_type redundant -pc_redundant_number 1 -redundant_ksp_type gmres -redundant_pc_type jacobi
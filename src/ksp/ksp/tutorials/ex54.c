@@ -225,6 +225,11 @@ int main(int argc,char **args)
       requires: mkl_sparse
       args: -ne 19 -alpha 1.e-3 -pc_type gamg -pc_gamg_agg_nsmooths 1  -mg_levels_ksp_max_it 3 -ksp_monitor -ksp_converged_reason -ksp_type cg -mat_seqaij_type seqaijmkl
 
+   test:
+      suffix: mis2
+      nsize: 4
+      args: -ne 19 -alpha 1.e-3 -pc_type gamg -pc_gamg_agg_nsmooths 1 -mat_coarsen_type mis2 -pc_gamg_asm_use_agg -mg_levels_pc_type asm -mg_levels_ksp_max_it 3 -ksp_monitor_short -ksp_converged_reason -ksp_type cg
+
    test:
       suffix: Classical
       args: -ne 49 -alpha 1.e-3 -ksp_type cg -pc_type gamg -pc_gamg_type classical -mg_levels_ksp_chebyshev_esteig 0,0.05,0,1.05 -ksp_converged_reason
@@ -34,6 +34,7 @@ static PetscErrorCode PCView_ASM(PC pc,PetscViewer viewer)
     ierr = PetscViewerASCIIPrintf(viewer,"  restriction/interpolation type - %s\n",PCASMTypes[osm->type]);CHKERRQ(ierr);
     if (osm->dm_subdomains) {ierr = PetscViewerASCIIPrintf(viewer,"  Additive Schwarz: using DM to define subdomains\n");CHKERRQ(ierr);}
     if (osm->loctype != PC_COMPOSITE_ADDITIVE) {ierr = PetscViewerASCIIPrintf(viewer,"  Additive Schwarz: local solve composition type - %s\n",PCCompositeTypes[osm->loctype]);CHKERRQ(ierr);}
+    if (osm->reuse_pattern) {ierr = PetscViewerASCIIPrintf(viewer,"  Additive Schwarz: reusing subdomain nonzero pattern for new operators\n");CHKERRQ(ierr);}
     ierr = MPI_Comm_rank(PetscObjectComm((PetscObject)pc),&rank);CHKERRMPI(ierr);
     ierr = PetscViewerGetFormat(viewer,&format);CHKERRQ(ierr);
     if (format != PETSC_VIEWER_ASCII_INFO_DETAIL) {
@@ -291,8 +292,14 @@ static PetscErrorCode PCSetUp_ASM(PC pc)
        Destroy the blocks from the previous iteration
     */
     if (pc->flag == DIFFERENT_NONZERO_PATTERN) {
-      ierr = MatDestroyMatrices(osm->n_local_true,&osm->pmat);CHKERRQ(ierr);
-      scall = MAT_INITIAL_MATRIX;
+      if (osm->reuse_pattern && !osm->sub_mat_type) {
+        /* the caller guarantees the nonzero pattern is unchanged so the extraction plan cached in the submatrices is still valid */
+        ierr = PetscInfo(pc,"Reusing subdomain submatrices and their nonzero pattern for the new operator\n");CHKERRQ(ierr);
+      } else {
+        ierr = MatDestroyMatrices(osm->n_local_true,&osm->pmat);CHKERRQ(ierr);
+        if (osm->lmats) {ierr = MatDestroyMatrices(osm->n_local_true,&osm->lmats);CHKERRQ(ierr);}
+        scall = MAT_INITIAL_MATRIX;
+      }
     }
   }
 
@@ -731,6 +738,8 @@ static PetscErrorCode PCDestroy_ASM(PC pc)
   ierr = PetscObjectComposeFunction((PetscObject)pc,"PCASMSetLocalType_C",NULL);CHKERRQ(ierr);
   ierr = PetscObjectComposeFunction((PetscObject)pc,"PCASMGetLocalType_C",NULL);CHKERRQ(ierr);
   ierr = PetscObjectComposeFunction((PetscObject)pc,"PCASMSetSortIndices_C",NULL);CHKERRQ(ierr);
+  ierr = PetscObjectComposeFunction((PetscObject)pc,"PCASMSetReuseSubdomainPattern_C",NULL);CHKERRQ(ierr);
+  ierr = PetscObjectComposeFunction((PetscObject)pc,"PCASMGetReuseSubdomainPattern_C",NULL);CHKERRQ(ierr);
   ierr = PetscObjectComposeFunction((PetscObject)pc,"PCASMGetSubKSP_C",NULL);CHKERRQ(ierr);
   ierr = PetscObjectComposeFunction((PetscObject)pc,"PCASMGetSubMatType_C",NULL);CHKERRQ(ierr);
   ierr = PetscObjectComposeFunction((PetscObject)pc,"PCASMSetSubMatType_C",NULL);CHKERRQ(ierr);
@@ -775,6 +784,7 @@ static PetscErrorCode PCSetFromOptions_ASM(PetscOptionItems *PetscOptionsObject,
   if (flg) {
     ierr = PCASMSetSubMatType(pc,sub_mat_type);CHKERRQ(ierr);
   }
+  ierr = PetscOptionsBool("-pc_asm_reuse_subdomain_pattern","Reuse the subdomain submatrices and their factorization pattern when a new operator is given","PCASMSetReuseSubdomainPattern",osm->reuse_pattern,&osm->reuse_pattern,NULL);CHKERRQ(ierr);
   ierr = PetscOptionsTail();CHKERRQ(ierr);
   PetscFunctionReturn(0);
 }
@@ -916,6 +926,24 @@ static PetscErrorCode  PCASMSetSortIndices_ASM(PC pc,PetscBool  doSort)
   PetscFunctionReturn(0);
 }
 
+static PetscErrorCode  PCASMSetReuseSubdomainPattern_ASM(PC pc,PetscBool flg)
+{
+  PC_ASM *osm = (PC_ASM*)pc->data;
+
+  PetscFunctionBegin;
+  osm->reuse_pattern = flg;
+  PetscFunctionReturn(0);
+}
+
+static PetscErrorCode  PCASMGetReuseSubdomainPattern_ASM(PC pc,PetscBool *flg)
+{
+  PC_ASM *osm = (PC_ASM*)pc->data;
+
+  PetscFunctionBegin;
+  *flg = osm->reuse_pattern;
+  PetscFunctionReturn(0);
+}
+
 static PetscErrorCode  PCASMGetSubKSP_ASM(PC pc,PetscInt *n_local,PetscInt *first_local,KSP **ksp)
 {
   PC_ASM         *osm = (PC_ASM*)pc->data;
@@ -1265,6 +1293,70 @@ PetscErrorCode  PCASMSetSortIndices(PC pc,PetscBool doSort)
   PetscFunctionReturn(0);
 }
 
+/*@
+    PCASMSetReuseSubdomainPattern - Indicates that later operators given to the PC have the same nonzero
+    pattern as the one used at the first setup, so the subdomain submatrices and the symbolic factorizations
+    of the subdomain solvers may be reused.
+
+    Logically Collective on pc
+
+    Input Parameters:
++   pc  - the preconditioner context
+-   flg - PETSC_TRUE to reuse the subdomain pattern
+
+    Options Database Key:
+.   -pc_asm_reuse_subdomain_pattern - reuse the subdomain pattern
+
+    Notes:
+    When a new matrix object is passed to KSPSetOperators() the PC is normally rebuilt from scratch: the subdomain
+    submatrices, together with the communication plan used to extract them, are recreated and each subdomain solver
+    redoes its ordering and symbolic factorization. With this flag only the numerical values of the submatrices are
+    extracted again and the subdomain solvers only perform a numerical factorization.
+
+    It is the caller's responsibility to ensure that the nonzero pattern of the operator has not changed;
+    results are undefined otherwise. The flag is ignored when PCASMSetSubMatType() has been used.
+
+    Level: intermediate
+
+.seealso: PCASMGetReuseSubdomainPattern(), PCSetReusePreconditioner(), PCFactorSetReuseOrdering(), PCASMSetOverlap()
+@*/
+PetscErrorCode  PCASMSetReuseSubdomainPattern(PC pc,PetscBool flg)
+{
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  PetscValidHeaderSpecific(pc,PC_CLASSID,1);
+  PetscValidLogicalCollectiveBool(pc,flg,2);
+  ierr = PetscTryMethod(pc,"PCASMSetReuseSubdomainPattern_C",(PC,PetscBool),(pc,flg));CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+/*@
+    PCASMGetReuseSubdomainPattern - Returns the flag set with PCASMSetReuseSubdomainPattern()
+
+    Not Collective
+
+    Input Parameter:
+.   pc  - the preconditioner context
+
+    Output Parameter:
+.   flg - PETSC_TRUE if the subdomain pattern is reused
+
+    Level: intermediate
+
+.seealso: PCASMSetReuseSubdomainPattern()
+@*/
+PetscErrorCode  PCASMGetReuseSubdomainPattern(PC pc,PetscBool *flg)
+{
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  PetscValidHeaderSpecific(pc,PC_CLASSID,1);
+  PetscValidBoolPointer(flg,2);
+  ierr = PetscUseMethod(pc,"PCASMGetReuseSubdomainPattern_C",(PC,PetscBool*),(pc,flg));CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
 /*@C
    PCASMGetSubKSP - Gets the local KSP contexts for all blocks on
    this processor.
@@ -1312,7 +1404,8 @@ PetscErrorCode  PCASMGetSubKSP(PC pc,PetscInt *n_local,PetscInt *first_local,KSP
 +  -pc_asm_blocks <blks> - Sets total blocks
 .  -pc_asm_overlap <ovl> - Sets overlap
 .  -pc_asm_type [basic,restrict,interpolate,none] - Sets ASM type, default is restrict
--  -pc_asm_local_type [additive, multiplicative] - Sets ASM type, default is additive
+.  -pc_asm_local_type [additive, multiplicative] - Sets ASM type, default is additive
+-  -pc_asm_reuse_subdomain_pattern - Reuse the subdomain submatrices and symbolic factorizations for new operators with the same nonzero pattern
 
      IMPORTANT: If you run with, for example, 3 blocks on 1 processor or 3 blocks on 3 processors you
       will get a different convergence rate due to the default option of -pc_asm_type restrict. Use
@@ -1339,7 +1432,8 @@ PetscErrorCode  PCASMGetSubKSP(PC pc,PetscInt *n_local,PetscInt *first_local,KSP
 
 .seealso:  PCCreate(), PCSetType(), PCType (for list of available types), PC,
            PCBJACOBI, PCASMGetSubKSP(), PCASMSetLocalSubdomains(), PCASMType, PCASMGetType(), PCASMSetLocalType(), PCASMGetLocalType()
-           PCASMSetTotalSubdomains(), PCSetModifySubMatrices(), PCASMSetOverlap(), PCASMSetType(), PCCompositeType
+           PCASMSetTotalSubdomains(), PCSetModifySubMatrices(), PCASMSetOverlap(), PCASMSetType(), PCCompositeType,
+           PCASMSetReuseSubdomainPattern()
 
 M*/
 
@@ -1368,6 +1462,7 @@ PETSC_EXTERN PetscErrorCode PCCreate_ASM(PC pc)
   osm->type              = PC_ASM_RESTRICT;
   osm->loctype           = PC_COMPOSITE_ADDITIVE;
   osm->sort_indices      = PETSC_TRUE;
+  osm->reuse_pattern     = PETSC_FALSE;
   osm->dm_subdomains     = PETSC_FALSE;
   osm->sub_mat_type      = NULL;
 
@@ -1391,6 +1486,8 @@ PETSC_EXTERN PetscErrorCode PCCreate_ASM(PC pc)
   ierr = PetscObjectComposeFunction((PetscObject)pc,"PCASMSetLocalType_C",PCASMSetLocalType_ASM);CHKERRQ(ierr);
   ierr = PetscObjectComposeFunction((PetscObject)pc,"PCASMGetLocalType_C",PCASMGetLocalType_ASM);CHKERRQ(ierr);
   ierr = PetscObjectComposeFunction((PetscObject)pc,"PCASMSetSortIndices_C",PCASMSetSortIndices_ASM);CHKERRQ(ierr);
+  ierr = PetscObjectComposeFunction((PetscObject)pc,"PCASMSetReuseSubdomainPattern_C",PCASMSetReuseSubdomainPattern_ASM);CHKERRQ(ierr);
+  ierr = PetscObjectComposeFunction((PetscObject)pc,"PCASMGetReuseSubdomainPattern_C",PCASMGetReuseSubdomainPattern_ASM);CHKERRQ(ierr);
   ierr = PetscObjectComposeFunction((PetscObject)pc,"PCASMGetSubKSP_C",PCASMGetSubKSP_ASM);CHKERRQ(ierr);
   ierr = PetscObjectComposeFunction((PetscObject)pc,"PCASMGetSubMatType_C",PCASMGetSubMatType_ASM);CHKERRQ(ierr);
   ierr = PetscObjectComposeFunction((PetscObject)pc,"PCASMSetSubMatType_C",PCASMSetSubMatType_ASM);CHKERRQ(ierr);
@@ -8,6 +8,7 @@
 static PetscErrorCode PCSetUp_BJacobi_Singleblock(PC,Mat,Mat);
 static PetscErrorCode PCSetUp_BJacobi_Multiblock(PC,Mat,Mat);
 static PetscErrorCode PCSetUp_BJacobi_Multiproc(PC);
+static PetscErrorCode PCSetUp_BJacobi_Batched(PC);
 
 static PetscErrorCode PCSetUp_BJacobi(PC pc)
 {
@@ -128,7 +129,25 @@ end_1:
   if (jac->n_local == 1) {
     ierr = PCSetUp_BJacobi_Singleblock(pc,mat,pmat);CHKERRQ(ierr);
   } else {
-    ierr = PCSetUp_BJacobi_Multiblock(pc,mat,pmat);CHKERRQ(ierr);
+    if (jac->batched && !jac->ksp && !pc->setupcalled) {
+      ierr = MatHasOperation(pc->pmat,MATOP_INVERT_VBLOCK_DIAGONAL,&hasop);CHKERRQ(ierr);
+      if (!hasop || pc->modifysubmatrices) {
+        ierr = PetscInfo(pc,"Cannot use batched block solves with this matrix type or with PCSetModifySubMatrices(), using a KSP for each block\n");CHKERRQ(ierr);
+        jac->batched = PETSC_FALSE;
+        if (jac->data) { /* the batched data kept by PCReset() */
+          PC_BJacobi_Batched *bjac = (PC_BJacobi_Batched*)jac->data;
+
+          ierr = PetscFree2(bjac->starts,bjac->dstarts);CHKERRQ(ierr);
+          ierr = PetscFree(bjac->diag);CHKERRQ(ierr);
+          ierr = PetscFree(jac->data);CHKERRQ(ierr);
+        }
+      }
+    }
+    if (jac->batched && !jac->ksp) {
+      ierr = PCSetUp_BJacobi_Batched(pc);CHKERRQ(ierr);
+    } else {
+      ierr = PCSetUp_BJacobi_Multiblock(pc,mat,pmat);CHKERRQ(ierr);
+    }
   }
   PetscFunctionReturn(0);
 }
@@ -151,7 +170,7 @@ static PetscErrorCode PCSetFromOptions_BJacobi(PetscOptionItems *PetscOptionsObj
   PC_BJacobi     *jac = (PC_BJacobi*)pc->data;
   PetscErrorCode ierr;
   PetscInt       blocks,i;
-  PetscBool      flg;
+  PetscBool      flg,batched;
 
   PetscFunctionBegin;
   ierr = PetscOptionsHead(PetscOptionsObject,"Block Jacobi options");CHKERRQ(ierr);
@@ -159,6 +178,8 @@ static PetscErrorCode PCSetFromOptions_BJacobi(PetscOptionItems *PetscOptionsObj
   if (flg) {ierr = PCBJacobiSetTotalBlocks(pc,blocks,NULL);CHKERRQ(ierr);}
   ierr = PetscOptionsInt("-pc_bjacobi_local_blocks","Local number of blocks","PCBJacobiSetLocalBlocks",jac->n_local,&blocks,&flg);CHKERRQ(ierr);
   if (flg) {ierr = PCBJacobiSetLocalBlocks(pc,blocks,NULL);CHKERRQ(ierr);}
+  ierr = PetscOptionsBool("-pc_bjacobi_batched","Solve all the local blocks together with their inverses instead of a KSP for each block","PCBJacobiSetBatched",jac->batched,&batched,&flg);CHKERRQ(ierr);
+  if (flg) {ierr = PCBJacobiSetBatched(pc,batched);CHKERRQ(ierr);}
   if (jac->ksp) {
     /* The sub-KSP has already been set up (e.g., PCSetUp_BJacobi_Singleblock), but KSPSetFromOptions was not called
      * unless we had already been called. */
@@ -194,7 +215,17 @@ static PetscErrorCode PCView_BJacobi(PC pc,PetscViewer viewer)
     ierr = PetscViewerASCIIPrintf(viewer,"  number of blocks = %D\n",jac->n);CHKERRQ(ierr);
     ierr = MPI_Comm_rank(PetscObjectComm((PetscObject)pc),&rank);CHKERRMPI(ierr);
     ierr = PetscViewerGetFormat(viewer,&format);CHKERRQ(ierr);
-    if (format != PETSC_VIEWER_ASCII_INFO_DETAIL) {
+    if (jac->batched && pc->setupcalled && !jac->ksp) {
+      PC_BJacobi_Batched *bjac = (PC_BJacobi_Batched*)jac->data;
+      PetscInt           bsmax = 0;
+
+      for (i=0; i<jac->n_local; i++) bsmax = PetscMax(bsmax,jac->l_lens[i]);
+      ierr = PetscViewerASCIIPrintf(viewer,"  batched solves with the explicit inverses of the blocks, no sub KSP\n");CHKERRQ(ierr);
+      ierr = PetscViewerASCIIPushSynchronized(viewer);CHKERRQ(ierr);
+      ierr = PetscViewerASCIISynchronizedPrintf(viewer,"  [%d] number of local blocks = %D, largest block size = %D, stored entries = %D\n",rank,jac->n_local,bsmax,bjac->dstarts[jac->n_local]);CHKERRQ(ierr);
+      ierr = PetscViewerFlush(viewer);CHKERRQ(ierr);
+      ierr = PetscViewerASCIIPopSynchronized(viewer);CHKERRQ(ierr);
+    } else if (format != PETSC_VIEWER_ASCII_INFO_DETAIL) {
       ierr = PetscViewerASCIIPrintf(viewer,"  Local solver information for first block is in the following KSP and PC objects on rank 0:\n");CHKERRQ(ierr);
       ierr = PCGetOptionsPrefix(pc,&prefix);CHKERRQ(ierr);
       ierr = PetscViewerASCIIPrintf(viewer,"  Use -%sksp_view ::ascii_info_detail to display information for all blocks\n",prefix?prefix:"");CHKERRQ(ierr);
@@ -275,6 +306,7 @@ static PetscErrorCode  PCBJacobiGetSubKSP_BJacobi(PC pc,PetscInt *n_local,PetscI
 
   PetscFunctionBegin;
   if (!pc->setupcalled) SETERRQ(PetscObjectComm((PetscObject)pc),PETSC_ERR_ARG_WRONGSTATE,"Must call KSPSetUp() or PCSetUp() first");
+  if (!jac->ksp) SETERRQ(PetscObjectComm((PetscObject)pc),PETSC_ERR_ARG_WRONGSTATE,"No sub KSP with batched block solves, see PCBJacobiSetBatched()");
 
   if (n_local) *n_local = jac->n_local;
   if (first_local) *first_local = jac->first_local;
@@ -337,6 +369,25 @@ static PetscErrorCode  PCBJacobiGetLocalBlocks_BJacobi(PC pc, PetscInt *blocks,
   PetscFunctionReturn(0);
 }
 
+static PetscErrorCode  PCBJacobiSetBatched_BJacobi(PC pc,PetscBool flg)
+{
+  PC_BJacobi *jac = (PC_BJacobi*)pc->data;
+
+  PetscFunctionBegin;
+  if (pc->setupcalled > 0 && jac->batched != flg) SETERRQ(PetscObjectComm((PetscObject)pc),PETSC_ERR_ORDER,"Cannot change the batched block solves after PCSetUp()/KSPSetUp() has been called");
+  jac->batched = flg;
+  PetscFunctionReturn(0);
+}
+
+static PetscErrorCode  PCBJacobiGetBatched_BJacobi(PC pc,PetscBool *flg)
+{
+  PC_BJacobi *jac = (PC_BJacobi*)pc->data;
+
+  PetscFunctionBegin;
+  *flg = jac->batched;
+  PetscFunctionReturn(0);
+}
+
 /* -------------------------------------------------------------------------------------*/
 
 /*@C
@@ -501,6 +552,72 @@ PetscErrorCode  PCBJacobiGetLocalBlocks(PC pc, PetscInt *blocks, const PetscInt
   PetscFunctionReturn(0);
 }
 
+/*@
+   PCBJacobiSetBatched - Solves all the local blocks of the block Jacobi preconditioner together, with the
+   explicitly computed inverses of the blocks stored contiguously, instead of creating a KSP for each block.
+
+   Logically Collective on PC
+
+   Input Parameters:
++  pc - the preconditioner context
+-  flg - PETSC_TRUE to use the batched block solves
+
+   Options Database Key:
+.  -pc_bjacobi_batched <true,false> - use the batched block solves
+
+   Notes:
+   This is intended for many small blocks per process, where the setup and application of a KSP, PC and
+   factored matrix for each block dominate the cost. The inverse of each block is computed with partial pivoting
+   by MatInvertVariableBlockDiagonal() and the blocks are applied in a single loop over the blocks, which is
+   threaded when PETSc is configured with OpenMP (see -omp_num_threads). The storage grows with the square of the block
+   sizes, so the blocks should be small.
+
+   The batched solves are only used with more than one block per process and a matrix type that provides
+   MatInvertVariableBlockDiagonal() (currently MATAIJ), otherwise and with PCSetModifySubMatrices() a KSP is used for each block.
+   There are no sub KSP objects to access with PCBJacobiGetSubKSP() and the -sub_ options are ignored.
+
+   Level: intermediate
+
+.seealso: PCBJacobiGetBatched(), PCBJacobiSetLocalBlocks(), PCBJacobiSetTotalBlocks(), PCVPBJACOBI
+@*/
+PetscErrorCode  PCBJacobiSetBatched(PC pc,PetscBool flg)
+{
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  PetscValidHeaderSpecific(pc,PC_CLASSID,1);
+  PetscValidLogicalCollectiveBool(pc,flg,2);
+  ierr = PetscTryMethod(pc,"PCBJacobiSetBatched_C",(PC,PetscBool),(pc,flg));CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+/*@
+   PCBJacobiGetBatched - Determines if the local blocks of the block Jacobi preconditioner are solved together
+   with their explicitly computed inverses.
+
+   Not Collective
+
+   Input Parameter:
+.  pc - the preconditioner context
+
+   Output Parameter:
+.  flg - PETSC_TRUE if the batched block solves are requested
+
+   Level: intermediate
+
+.seealso: PCBJacobiSetBatched()
+@*/
+PetscErrorCode  PCBJacobiGetBatched(PC pc,PetscBool *flg)
+{
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  PetscValidHeaderSpecific(pc,PC_CLASSID,1);
+  PetscValidBoolPointer(flg,2);
+  ierr = PetscUseMethod(pc,"PCBJacobiGetBatched_C",(PC,PetscBool*),(pc,flg));CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
 /* -----------------------------------------------------------------------------------*/
 
 /*MC
@@ -509,7 +626,8 @@ PetscErrorCode  PCBJacobiGetLocalBlocks(PC pc, PetscInt *blocks, const PetscInt
 
    Options Database Keys:
 +  -pc_use_amat - use Amat to apply block of operator in inner Krylov method
--  -pc_bjacobi_blocks <n> - use n total blocks
+.  -pc_bjacobi_blocks <n> - use n total blocks
+-  -pc_bjacobi_batched - solve many small local blocks together with their inverses, see PCBJacobiSetBatched()
 
    Notes:
     Each processor can have one or more blocks, or a single block can be shared by several processes. Defaults to one block per processor.
@@ -533,7 +651,7 @@ PetscErrorCode  PCBJacobiGetLocalBlocks(PC pc, PetscInt *blocks, const PetscInt
 
 .seealso:  PCCreate(), PCSetType(), PCType (for list of available types), PC,
            PCASM, PCSetUseAmat(), PCGetUseAmat(), PCBJacobiGetSubKSP(), PCBJacobiSetTotalBlocks(),
-           PCBJacobiSetLocalBlocks(), PCSetModifySubMatrices()
+           PCBJacobiSetLocalBlocks(), PCSetModifySubMatrices(), PCBJacobiSetBatched()
 M*/
 
 PETSC_EXTERN PetscErrorCode PCCreate_BJacobi(PC pc)
@@ -569,6 +687,8 @@ PETSC_EXTERN PetscErrorCode PCCreate_BJacobi(PC pc)
   ierr = PetscObjectComposeFunction((PetscObject)pc,"PCBJacobiGetTotalBlocks_C",PCBJacobiGetTotalBlocks_BJacobi);CHKERRQ(ierr);
   ierr = PetscObjectComposeFunction((PetscObject)pc,"PCBJacobiSetLocalBlocks_C",PCBJacobiSetLocalBlocks_BJacobi);CHKERRQ(ierr);
   ierr = PetscObjectComposeFunction((PetscObject)pc,"PCBJacobiGetLocalBlocks_C",PCBJacobiGetLocalBlocks_BJacobi);CHKERRQ(ierr);
+  ierr = PetscObjectComposeFunction((PetscObject)pc,"PCBJacobiSetBatched_C",PCBJacobiSetBatched_BJacobi);CHKERRQ(ierr);
+  ierr = PetscObjectComposeFunction((PetscObject)pc,"PCBJacobiGetBatched_C",PCBJacobiGetBatched_BJacobi);CHKERRQ(ierr);
   PetscFunctionReturn(0);
 }
 
@@ -1105,6 +1225,163 @@ static PetscErrorCode PCSetUp_BJacobi_Multiblock(PC pc,Mat mat,Mat pmat)
   PetscFunctionReturn(0);
 }
 
+/* ---------------------------------------------------------------------------------------------*/
+/*
+      These are for multiple blocks per process solved together with the inverses of the blocks; works for AIJ, Seq and MPI
+*/
+static PetscErrorCode PCReset_BJacobi_Batched(PC pc)
+{
+  PC_BJacobi         *jac  = (PC_BJacobi*)pc->data;
+  PC_BJacobi_Batched *bjac = (PC_BJacobi_Batched*)jac->data;
+  PetscErrorCode     ierr;
+
+  PetscFunctionBegin;
+  if (bjac) {
+    ierr = PetscFree2(bjac->starts,bjac->dstarts);CHKERRQ(ierr);
+    ierr = PetscFree(bjac->diag);CHKERRQ(ierr);
+  }
+  ierr = PetscFree(jac->l_lens);CHKERRQ(ierr);
+  ierr = PetscFree(jac->g_lens);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+static PetscErrorCode PCDestroy_BJacobi_Batched(PC pc)
+{
+  PC_BJacobi     *jac = (PC_BJacobi*)pc->data;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  ierr = PCReset_BJacobi_Batched(pc);CHKERRQ(ierr);
+  ierr = PetscFree(jac->data);CHKERRQ(ierr);
+  ierr = PetscFree(pc->data);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+/*
+   The inverse of each block is stored in column major order, the inner loops run over contiguous entries
+   of the inverse so they can be vectorized by the compiler
+*/
+PETSC_STATIC_INLINE void PCBJacobiBatchedMult_Private(PetscInt m,const PetscScalar *d,const PetscScalar *x,PetscScalar *y)
+{
+  PetscInt    i,j;
+  PetscScalar xj;
+
+  for (i=0; i<m; i++) y[i] = d[i]*x[0];
+  for (j=1; j<m; j++) {
+    d += m;
+    xj = x[j];
+    for (i=0; i<m; i++) y[i] += d[i]*xj;
+  }
+}
+
+PETSC_STATIC_INLINE void PCBJacobiBatchedMultTranspose_Private(PetscInt m,const PetscScalar *d,const PetscScalar *x,PetscScalar *y)
+{
+  PetscInt    i,j;
+  PetscScalar sum;
+
+  for (i=0; i<m; i++) {
+    sum = 0.0;
+    for (j=0; j<m; j++) sum += d[j]*x[j];
+    y[i] = sum;
+    d   += m;
+  }
+}
+
+static PetscErrorCode PCApply_BJacobi_Batched(PC pc,Vec x,Vec y)
+{
+  PC_BJacobi         *jac  = (PC_BJacobi*)pc->data;
+  PC_BJacobi_Batched *bjac = (PC_BJacobi_Batched*)jac->data;
+  PetscErrorCode     ierr;
+  PetscInt           i,n_local = jac->n_local;
+  const PetscInt     *lens = jac->l_lens,*starts = bjac->starts,*dstarts = bjac->dstarts;
+  const PetscScalar  *diag = bjac->diag,*xin;
+  PetscScalar        *yin;
+
+  PetscFunctionBegin;
+  ierr = VecGetArrayRead(x,&xin);CHKERRQ(ierr);
+  ierr = VecGetArrayWrite(y,&yin);CHKERRQ(ierr);
+  ierr = PetscLogEventBegin(PC_ApplyOnBlocks,pc,x,y,0);CHKERRQ(ierr);
+#if defined(PETSC_HAVE_OPENMP)
+#pragma omp parallel for schedule(static) num_threads((int)PetscMax(PetscNumOMPThreads,1))
+#endif
+  for (i=0; i<n_local; i++) PCBJacobiBatchedMult_Private(lens[i],diag+dstarts[i],xin+starts[i],yin+starts[i]);
+  ierr = PetscLogEventEnd(PC_ApplyOnBlocks,pc,x,y,0);CHKERRQ(ierr);
+  ierr = PetscLogFlops(2.0*dstarts[n_local]-starts[n_local]);CHKERRQ(ierr);
+  ierr = VecRestoreArrayRead(x,&xin);CHKERRQ(ierr);
+  ierr = VecRestoreArrayWrite(y,&yin);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+static PetscErrorCode PCApplyTranspose_BJacobi_Batched(PC pc,Vec x,Vec y)
+{
+  PC_BJacobi         *jac  = (PC_BJacobi*)pc->data;
+  PC_BJacobi_Batched *bjac = (PC_BJacobi_Batched*)jac->data;
+  PetscErrorCode     ierr;
+  PetscInt           i,n_local = jac->n_local;
+  const PetscInt     *lens = jac->l_lens,*starts = bjac->starts,*dstarts = bjac->dstarts;
+  const PetscScalar  *diag = bjac->diag,*xin;
+  PetscScalar        *yin;
+
+  PetscFunctionBegin;
+  ierr = VecGetArrayRead(x,&xin);CHKERRQ(ierr);
+  ierr = VecGetArrayWrite(y,&yin);CHKERRQ(ierr);
+  ierr = PetscLogEventBegin(PC_ApplyTransposeOnBlocks,pc,x,y,0);CHKERRQ(ierr);
+#if defined(PETSC_HAVE_OPENMP)
+#pragma omp parallel for schedule(static) num_threads((int)PetscMax(PetscNumOMPThreads,1))
+#endif
+  for (i=0; i<n_local; i++) PCBJacobiBatchedMultTranspose_Private(lens[i],diag+dstarts[i],xin+starts[i],yin+starts[i]);
+  ierr = PetscLogEventEnd(PC_ApplyTransposeOnBlocks,pc,x,y,0);CHKERRQ(ierr);
+  ierr = PetscLogFlops(2.0*dstarts[n_local]-starts[n_local]);CHKERRQ(ierr);
+  ierr = VecRestoreArrayRead(x,&xin);CHKERRQ(ierr);
+  ierr = VecRestoreArrayWrite(y,&yin);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+/*
+   the inverses of all the blocks of the local diagonal block of the preconditioner matrix are stored in one array
+   so no objects are created for the blocks
+*/
+static PetscErrorCode PCSetUp_BJacobi_Batched(PC pc)
+{
+  PC_BJacobi         *jac  = (PC_BJacobi*)pc->data;
+  PC_BJacobi_Batched *bjac = (PC_BJacobi_Batched*)jac->data;
+  PetscErrorCode     ierr;
+  PetscInt           i,n_local = jac->n_local,bsmax = 0;
+  MatFactorError     err;
+
+  PetscFunctionBegin;
+  if (!pc->setupcalled) {
+    if (!bjac) {
+      pc->ops->reset          = PCReset_BJacobi_Batched;
+      pc->ops->destroy        = PCDestroy_BJacobi_Batched;
+      pc->ops->apply          = PCApply_BJacobi_Batched;
+      pc->ops->matapply       = NULL;
+      pc->ops->applytranspose = PCApplyTranspose_BJacobi_Batched;
+      pc->ops->setuponblocks  = NULL;
+
+      ierr      = PetscNewLog(pc,&bjac);CHKERRQ(ierr);
+      jac->data = (void*)bjac;
+    }
+    ierr = PetscMalloc2(n_local+1,&bjac->starts,n_local+1,&bjac->dstarts);CHKERRQ(ierr);
+    bjac->starts[0] = bjac->dstarts[0] = 0;
+    for (i=0; i<n_local; i++) {
+      bjac->starts[i+1]  = bjac->starts[i] + jac->l_lens[i];
+      bjac->dstarts[i+1] = bjac->dstarts[i] + jac->l_lens[i]*jac->l_lens[i];
+      bsmax              = PetscMax(bsmax,jac->l_lens[i]);
+    }
+    ierr = PetscMalloc1(bjac->dstarts[n_local],&bjac->diag);CHKERRQ(ierr);
+    ierr = PetscLogObjectMemory((PetscObject)pc,2*(n_local+1)*sizeof(PetscInt)+bjac->dstarts[n_local]*sizeof(PetscScalar));CHKERRQ(ierr);
+    ierr = PetscInfo3(pc,"Batched solves with %D local blocks of largest size %D, %D stored entries\n",n_local,bsmax,bjac->dstarts[n_local]);CHKERRQ(ierr);
+  }
+  /* as with PCVPBJACOBI a singular block is recorded on the preconditioner matrix, a failure of a previous setup is cleared */
+  pc->failedreason = PC_NOERROR;
+  ierr = MatFactorClearError(pc->pmat);CHKERRQ(ierr);
+  ierr = MatInvertVariableBlockDiagonal(pc->pmat,n_local,jac->l_lens,bjac->diag);CHKERRQ(ierr);
+  ierr = MatFactorGetError(pc->pmat,&err);CHKERRQ(ierr);
+  if (err) pc->failedreason = (PCFailedReason)err;
+  PetscFunctionReturn(0);
+}
+
 /* ---------------------------------------------------------------------------------------------*/
 /*
       These are for a single block with multiple processes
@@ -18,6 +18,7 @@ typedef struct {
   PetscInt     *l_lens;           /* lens of each block */
   PetscInt     *g_lens;
   PetscSubcomm psubcomm;          /* for multiple processors per block */
+  PetscBool    batched;           /* invert all the local blocks into one array instead of creating a KSP for each block */
 } PC_BJacobi;
 
 /*
@@ -32,6 +33,13 @@ typedef struct {
   IS       *is;                       /* for gathering the submatrices */
 } PC_BJacobi_Multiblock;
 
+/*  This is for multiple blocks per processor solved together without sub KSPs */
+typedef struct {
+  PetscInt    *starts;                /* starting point of each block */
+  PetscInt    *dstarts;               /* starting point of the inverse of each block in diag */
+  PetscScalar *diag;                  /* the inverses of all the blocks, each stored in column major order */
+} PC_BJacobi_Batched;
+
 /*  This is for a single block per processor */
 typedef struct {
   Vec x,y;
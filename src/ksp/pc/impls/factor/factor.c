@@ -217,6 +217,41 @@ PetscErrorCode  PCFactorSetDropTolerance(PC pc,PetscReal dt,PetscReal dtcol,Pets
   PetscFunctionReturn(0);
 }
 
+/*@
+   PCFactorSetIterativeSweeps - The ILU factor is computed by fixed-point sweeps and applied with Jacobi sweeps, which
+   both run in parallel with the OpenMP threads, instead of the exact factorization and triangular solves
+
+   Logically Collective on PC
+
+   Input Parameters:
++  pc - the preconditioner context
+.  fsweeps - the number of fixed-point sweeps of the numeric factorization, 0 for the exact factorization
+-  ssweeps - the number of Jacobi sweeps approximating each triangular solve, 0 for exact triangular solves
+
+   Options Database Keys:
++  -pc_factor_iterative_sweeps <fsweeps> - Sets the number of sweeps of the factorization
+-  -pc_factor_iterative_solve_sweeps <ssweeps> - Sets the number of sweeps of the triangular solves
+
+   Level: intermediate
+
+   Notes:
+   Only for PCILU with MATSOLVERPETSC and MATSEQAIJ matrices, for example the blocks of PCBJACOBI or PCASM with
+   MATMPIAIJ matrices; it is ignored otherwise. See MatFactorSetIterativeSweeps().
+
+.seealso: PCILU, PCFactorSetLevels(), MatFactorSetIterativeSweeps()
+@*/
+PetscErrorCode PCFactorSetIterativeSweeps(PC pc,PetscInt fsweeps,PetscInt ssweeps)
+{
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  PetscValidHeaderSpecific(pc,PC_CLASSID,1);
+  PetscValidLogicalCollectiveInt(pc,fsweeps,2);
+  PetscValidLogicalCollectiveInt(pc,ssweeps,3);
+  ierr = PetscTryMethod(pc,"PCFactorSetIterativeSweeps_C",(PC,PetscInt,PetscInt),(pc,fsweeps,ssweeps));CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
 /*@
    PCFactorGetZeroPivot - Gets the tolerance used to define a zero privot
 
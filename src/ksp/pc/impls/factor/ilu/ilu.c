@@ -42,6 +42,18 @@ PetscErrorCode  PCFactorSetDropTolerance_ILU(PC pc,PetscReal dt,PetscReal dtcol,
   PetscFunctionReturn(0);
 }
 
+static PetscErrorCode PCFactorSetIterativeSweeps_ILU(PC pc,PetscInt fsweeps,PetscInt ssweeps)
+{
+  PC_ILU *ilu = (PC_ILU*)pc->data;
+
+  PetscFunctionBegin;
+  if (fsweeps < 0 || ssweeps < 0) SETERRQ2(PetscObjectComm((PetscObject)pc),PETSC_ERR_ARG_OUTOFRANGE,"Number of sweeps %D and %D cannot be negative",fsweeps,ssweeps);
+  if (pc->setupcalled && (ilu->fsweeps != fsweeps || ilu->ssweeps != ssweeps)) SETERRQ(PetscObjectComm((PetscObject)pc),PETSC_ERR_SUP,"Cannot change the number of sweeps after using PC");
+  ilu->fsweeps = fsweeps;
+  ilu->ssweeps = ssweeps;
+  PetscFunctionReturn(0);
+}
+
 static PetscErrorCode PCSetFromOptions_ILU(PetscOptionItems *PetscOptionsObject,PC pc)
 {
   PetscErrorCode ierr;
@@ -59,6 +71,9 @@ static PetscErrorCode PCSetFromOptions_ILU(PetscOptionItems *PetscOptionsObject,
 
   ierr = PetscOptionsBool("-pc_factor_diagonal_fill","Allow fill into empty diagonal entry","PCFactorSetAllowDiagonalFill",((PC_Factor*)ilu)->info.diagonal_fill ? PETSC_TRUE : PETSC_FALSE,&flg,&set);CHKERRQ(ierr);
   if (set) ((PC_Factor*)ilu)->info.diagonal_fill = (PetscReal) flg;
+  ierr = PetscOptionsInt("-pc_factor_iterative_sweeps","Fixed-point sweeps computing the factor, 0 for the exact factorization","PCFactorSetIterativeSweeps",ilu->fsweeps,&ilu->fsweeps,NULL);CHKERRQ(ierr);
+  ierr = PetscOptionsInt("-pc_factor_iterative_solve_sweeps","Jacobi sweeps approximating the triangular solves, 0 for exact solves","PCFactorSetIterativeSweeps",ilu->ssweeps,&ilu->ssweeps,NULL);CHKERRQ(ierr);
+  if (ilu->fsweeps < 0 || ilu->ssweeps < 0) SETERRQ2(PetscObjectComm((PetscObject)pc),PETSC_ERR_ARG_OUTOFRANGE,"Number of sweeps %D and %D cannot be negative",ilu->fsweeps,ilu->ssweeps);
   ierr = PetscOptionsName("-pc_factor_nonzeros_along_diagonal","Reorder to remove zeros from diagonal","PCFactorReorderForNonzeroDiagonal",&flg);CHKERRQ(ierr);
   if (flg) {
     tol  = PETSC_DECIDE;
@@ -141,6 +156,7 @@ static PetscErrorCode PCSetUp_ILU(PC pc)
           ierr = MatReorderForNonzeroDiagonal(pc->pmat,ilu->nonzerosalongdiagonaltol,ilu->row,ilu->col);CHKERRQ(ierr);
         }
       }
+      ierr = MatFactorSetIterativeSweeps(((PC_Factor*)ilu)->fact,ilu->fsweeps,ilu->ssweeps);CHKERRQ(ierr);
       ierr = MatILUFactorSymbolic(((PC_Factor*)ilu)->fact,pc->pmat,ilu->row,ilu->col,&((PC_Factor*)ilu)->info);CHKERRQ(ierr);
       ierr = MatGetInfo(((PC_Factor*)ilu)->fact,MAT_LOCAL,&info);CHKERRQ(ierr);
       ilu->hdr.actualfill = info.fill_ratio_needed;
@@ -165,6 +181,7 @@ static PetscErrorCode PCSetUp_ILU(PC pc)
           }
         }
       }
+      ierr = MatFactorSetIterativeSweeps(((PC_Factor*)ilu)->fact,ilu->fsweeps,ilu->ssweeps);CHKERRQ(ierr);
       ierr = MatILUFactorSymbolic(((PC_Factor*)ilu)->fact,pc->pmat,ilu->row,ilu->col,&((PC_Factor*)ilu)->info);CHKERRQ(ierr);
       ierr = MatGetInfo(((PC_Factor*)ilu)->fact,MAT_LOCAL,&info);CHKERRQ(ierr);
       ilu->hdr.actualfill = info.fill_ratio_needed;
@@ -267,9 +284,11 @@ static PetscErrorCode PCApplySymmetricRight_ILU(PC pc,Vec x,Vec y)
 .  -pc_factor_nonzeros_along_diagonal - reorder the matrix before factorization to remove zeros from the diagonal,
                                    this decreases the chance of getting a zero pivot
 .  -pc_factor_mat_ordering_type <natural,nd,1wd,rcm,qmd> - set the row/column ordering of the factored matrix
--  -pc_factor_pivot_in_blocks - for block ILU(k) factorization, i.e. with BAIJ matrices with block size larger
+.  -pc_factor_pivot_in_blocks - for block ILU(k) factorization, i.e. with BAIJ matrices with block size larger
                              than 1 the diagonal blocks are factored with partial pivoting (this increases the
                              stability of the ILU factorization
+.  -pc_factor_iterative_sweeps <n> - compute the factor with n fixed-point sweeps instead of the exact factorization
+-  -pc_factor_iterative_solve_sweeps <n> - approximate the triangular solves with n Jacobi sweeps
 
    Level: beginner
 
@@ -284,6 +303,10 @@ static PetscErrorCode PCApplySymmetricRight_ILU(PC pc,Vec x,Vec y)
           If you are using MATSEQAIJCUSPARSE matrices (or MATMPIAIJCUSPARSE matrices with block Jacobi), factorization
           is never done on the GPU).
 
+          With MATSEQAIJ matrices, the factor can be computed by fixed-point sweeps over its entries and the triangular
+          solves approximated with Jacobi sweeps (see PCFactorSetIterativeSweeps()); both run with the OpenMP threads
+          (see -omp_num_threads) and trade accuracy of the preconditioner for parallelism.
+
    References:
 +  1. - T. Dupont, R. Kendall, and H. Rachford. An approximate factorization procedure for solving
    self adjoint elliptic difference equations. SIAM J. Numer. Anal., 5, 1968.
@@ -297,7 +320,7 @@ static PetscErrorCode PCApplySymmetricRight_ILU(PC pc,Vec x,Vec y)
            PCFactorSetZeroPivot(), PCFactorSetShiftSetType(), PCFactorSetAmount(),
            PCFactorSetDropTolerance(),PCFactorSetFill(), PCFactorSetMatOrderingType(), PCFactorSetReuseOrdering(),
            PCFactorSetLevels(), PCFactorSetUseInPlace(), PCFactorSetAllowDiagonalFill(), PCFactorSetPivotInBlocks(),
-           PCFactorGetAllowDiagonalFill(), PCFactorGetUseInPlace()
+           PCFactorGetAllowDiagonalFill(), PCFactorGetUseInPlace(), PCFactorSetIterativeSweeps()
 
 M*/
 
@@ -332,5 +355,6 @@ PETSC_EXTERN PetscErrorCode PCCreate_ILU(PC pc)
   pc->ops->applyrichardson     = NULL;
   ierr = PetscObjectComposeFunction((PetscObject)pc,"PCFactorSetDropTolerance_C",PCFactorSetDropTolerance_ILU);CHKERRQ(ierr);
   ierr = PetscObjectComposeFunction((PetscObject)pc,"PCFactorReorderForNonzeroDiagonal_C",PCFactorReorderForNonzeroDiagonal_ILU);CHKERRQ(ierr);
+  ierr = PetscObjectComposeFunction((PetscObject)pc,"PCFactorSetIterativeSweeps_C",PCFactorSetIterativeSweeps_ILU);CHKERRQ(ierr);
   PetscFunctionReturn(0);
 }
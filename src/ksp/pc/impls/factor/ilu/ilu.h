@@ -12,6 +12,7 @@ typedef struct {
   void      *implctx;                 /* private implementation context */
   PetscBool nonzerosalongdiagonal;
   PetscReal nonzerosalongdiagonaltol;
+  PetscInt  fsweeps,ssweeps;          /* fixed-point sweeps of the factorization and Jacobi sweeps of the solves, 0 for exact ones */
 } PC_ILU;
 
 #endif
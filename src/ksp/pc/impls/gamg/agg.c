@@ -10,6 +10,7 @@ typedef struct {
   PetscInt  nsmooths;
   PetscBool sym_graph;
   PetscInt  square_graph;
+  PetscBool matfree_prol;
 } PC_GAMG_AGG;
 
 /*@
@@ -102,9 +103,11 @@ static PetscErrorCode PCGAMGSetSymGraph_AGG(PC pc, PetscBool n)
    Notes:
    Squaring the graph increases the rate of coarsening (aggressive coarsening) and thereby reduces the complexity of the coarse grids, and generally results in slower solver converge rates. Reducing coarse grid complexity reduced the complexity of Galerkin coarse grid construction considerably.
 
+   With -mat_coarsen_type mis2 the graph is not squared, the aggregates of these levels come from a distance-2 maximal independent set of the graph itself, see MATCOARSENMIS2.
+
    Level: intermediate
 
-.seealso: PCGAMGSetSymGraph(), PCGAMGSetThreshold()
+.seealso: PCGAMGSetSymGraph(), PCGAMGSetThreshold(), MATCOARSENMIS2
 @*/
 PetscErrorCode PCGAMGSetSquareGraph(PC pc, PetscInt n)
 {
@@ -128,6 +131,55 @@ static PetscErrorCode PCGAMGSetSquareGraph_AGG(PC pc, PetscInt n)
   PetscFunctionReturn(0);
 }
 
+/*@
+   PCGAMGSetMatFreeProlongator - Apply the last smoothing step of the prolongator on the fly instead of forming it
+
+   Logically Collective on PC
+
+   Input Parameters:
++  pc - the preconditioner context
+-  n - PETSC_TRUE or PETSC_FALSE
+
+   Options Database Key:
+.  -pc_gamg_matfree_prolongator <true,default=false> - keep the prolongators as a tentative prolongator and a Jacobi smoothing step
+
+   Notes:
+   The prolongator P = (I - omega D^{-1} A) P0 is kept as a MATSHELL that stores only the tentative prolongator P0, which has
+   far fewer nonzeros, and the scaled inverse of the diagonal; interpolation and restriction apply the smoothing step with A.
+   The coarse grid operators are computed with a triple product specific to this shell (MatPtAP() with the shell as P) that forms
+   the smoothed prolongator only while the product is computed.
+
+   Unless PCGAMGSetReuseInterpolation() is used the data of these products is freed once the coarse grid operators are built,
+   so the hierarchy does not store the smoothed prolongators. With PCGAMGSetReuseInterpolation() they are kept for the numeric
+   refresh of the coarse grid operators, which then smooths P0 with the new fine grid operators and the eigenvalue estimates of
+   the setup.
+
+   Level: advanced
+
+.seealso: PCGAMGSetNSmooths(), PCGAMGSetReuseInterpolation()
+@*/
+PetscErrorCode PCGAMGSetMatFreeProlongator(PC pc, PetscBool n)
+{
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  PetscValidHeaderSpecific(pc,PC_CLASSID,1);
+  PetscValidLogicalCollectiveBool(pc,n,2);
+  ierr = PetscTryMethod(pc,"PCGAMGSetMatFreeProlongator_C",(PC,PetscBool),(pc,n));CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+static PetscErrorCode PCGAMGSetMatFreeProlongator_AGG(PC pc, PetscBool n)
+{
+  PC_MG       *mg          = (PC_MG*)pc->data;
+  PC_GAMG     *pc_gamg     = (PC_GAMG*)mg->innerctx;
+  PC_GAMG_AGG *pc_gamg_agg = (PC_GAMG_AGG*)pc_gamg->subctx;
+
+  PetscFunctionBegin;
+  pc_gamg_agg->matfree_prol = n;
+  PetscFunctionReturn(0);
+}
+
 static PetscErrorCode PCSetFromOptions_GAMG_AGG(PetscOptionItems *PetscOptionsObject,PC pc)
 {
   PetscErrorCode ierr;
@@ -141,6 +193,7 @@ static PetscErrorCode PCSetFromOptions_GAMG_AGG(PetscOptionItems *PetscOptionsOb
     ierr = PetscOptionsInt("-pc_gamg_agg_nsmooths","smoothing steps for smoothed aggregation, usually 1","PCGAMGSetNSmooths",pc_gamg_agg->nsmooths,&pc_gamg_agg->nsmooths,NULL);CHKERRQ(ierr);
     ierr = PetscOptionsBool("-pc_gamg_sym_graph","Set for asymmetric matrices","PCGAMGSetSymGraph",pc_gamg_agg->sym_graph,&pc_gamg_agg->sym_graph,NULL);CHKERRQ(ierr);
     ierr = PetscOptionsInt("-pc_gamg_square_graph","Number of levels to square graph for faster coarsening and lower coarse grid complexity","PCGAMGSetSquareGraph",pc_gamg_agg->square_graph,&pc_gamg_agg->square_graph,NULL);CHKERRQ(ierr);
+    ierr = PetscOptionsBool("-pc_gamg_matfree_prolongator","Apply the last smoothing step of the prolongators on the fly","PCGAMGSetMatFreeProlongator",pc_gamg_agg->matfree_prol,&pc_gamg_agg->matfree_prol,NULL);CHKERRQ(ierr);
   }
   ierr = PetscOptionsTail();CHKERRQ(ierr);
   PetscFunctionReturn(0);
@@ -788,6 +841,7 @@ static PetscErrorCode PCView_GAMG_AGG(PC pc,PetscViewer viewer)
   ierr = PetscViewerASCIIPrintf(viewer,"        Symmetric graph %s\n",pc_gamg_agg->sym_graph ? "true" : "false");CHKERRQ(ierr);
   ierr = PetscViewerASCIIPrintf(viewer,"        Number of levels to square graph %D\n",pc_gamg_agg->square_graph);CHKERRQ(ierr);
   ierr = PetscViewerASCIIPrintf(viewer,"        Number smoothing steps %D\n",pc_gamg_agg->nsmooths);CHKERRQ(ierr);
+  if (pc_gamg_agg->matfree_prol) {ierr = PetscViewerASCIIPrintf(viewer,"        Last smoothing step applied matrix-free\n");CHKERRQ(ierr);}
   PetscFunctionReturn(0);
 }
 
@@ -853,6 +907,7 @@ static PetscErrorCode PCGAMGCoarsen_AGG(PC a_pc,Mat *a_Gmat1,PetscCoarsenData **
   PetscReal      hashfact;
   PetscInt       iSwapIndex;
   PetscRandom    random;
+  PetscBool      ismis2;
 
   PetscFunctionBegin;
   ierr = PetscLogEventBegin(PC_GAMGCoarsen_AGG,0,0,0,0);CHKERRQ(ierr);
@@ -862,9 +917,19 @@ static PetscErrorCode PCGAMGCoarsen_AGG(PC a_pc,Mat *a_Gmat1,PetscCoarsenData **
   if (bs != 1) SETERRQ1(PETSC_COMM_SELF,PETSC_ERR_PLIB,"bs %D must be 1",bs);
   nloc = n/bs;
 
+  ierr = MatCoarsenCreate(comm, &crs);CHKERRQ(ierr);
+  ierr = MatCoarsenSetFromOptions(crs);CHKERRQ(ierr);
+  ierr = PetscObjectTypeCompare((PetscObject)crs,MATCOARSENMIS2,&ismis2);CHKERRQ(ierr);
   if (pc_gamg->current_level < pc_gamg_agg->square_graph) {
-    ierr = PCGAMGSquareGraph_GAMG(a_pc,Gmat1,&Gmat2);CHKERRQ(ierr);
-  } else Gmat2 = Gmat1;
+    /* MIS-2 on the graph gives the aggregates of MIS on its square */
+    if (ismis2) Gmat2 = Gmat1;
+    else {
+      ierr = PCGAMGSquareGraph_GAMG(a_pc,Gmat1,&Gmat2);CHKERRQ(ierr);
+    }
+  } else {
+    Gmat2 = Gmat1;
+    if (ismis2) {ierr = MatCoarsenSetType(crs,MATCOARSENMIS);CHKERRQ(ierr);}
+  }
 
   /* get MIS aggs - randomize */
   ierr = PetscMalloc1(nloc, &permute);CHKERRQ(ierr);
@@ -886,8 +951,6 @@ static PetscErrorCode PCGAMGCoarsen_AGG(PC a_pc,Mat *a_Gmat1,PetscCoarsenData **
   ierr = PetscRandomDestroy(&random);CHKERRQ(ierr);
   ierr = ISCreateGeneral(PETSC_COMM_SELF, nloc, permute, PETSC_USE_POINTER, &perm);CHKERRQ(ierr);
   ierr = PetscLogEventBegin(petsc_gamg_setup_events[SET4],0,0,0,0);CHKERRQ(ierr);
-  ierr = MatCoarsenCreate(comm, &crs);CHKERRQ(ierr);
-  ierr = MatCoarsenSetFromOptions(crs);CHKERRQ(ierr);
   ierr = MatCoarsenSetGreedyOrdering(crs, perm);CHKERRQ(ierr);
   ierr = MatCoarsenSetAdjacency(crs, Gmat2);CHKERRQ(ierr);
   ierr = MatCoarsenSetStrictAggs(crs, PETSC_TRUE);CHKERRQ(ierr);
@@ -1056,6 +1119,269 @@ static PetscErrorCode PCGAMGProlongator_AGG(PC pc,Mat Amat,Mat Gmat,PetscCoarsen
   PetscFunctionReturn(0);
 }
 
+/* -------------------------------------------------------------------------- */
+/*
+   Matrix-free smoothed prolongator P = P0 + D P0' with P0' = A P0 and D = -omega diag(A)^{-1}
+*/
+typedef struct {
+  Mat              A;        /* operator P0 is smoothed with */
+  Mat              P0;       /* tentative prolongator */
+  PetscReal        omega;
+  Vec              dinv;     /* -omega diag(A)^{-1} */
+  PetscObjectState state;    /* of A when dinv was computed */
+  Vec              wf0,wf1;  /* fine grid work vectors */
+} PC_GAMG_MatFreeProl;
+
+/* data of the triple product with a matrix-free prolongator */
+typedef struct {
+  Mat P;        /* the smoothed prolongator, formed in the product A P0 */
+  Mat PtAP;     /* product with the explicit P whose symbolic and numeric phases are run on C */
+} PC_GAMG_MatFreeProlPtAP;
+
+static PetscErrorCode PCGAMGCreateMatFreeProlongator(Mat,Mat,PetscReal,Mat*);
+
+/* the smoothing step follows changes of the values of A, with the eigenvalue estimate of the setup */
+static PetscErrorCode PCGAMGMatFreeProlUpdate(PC_GAMG_MatFreeProl *ctx)
+{
+  PetscErrorCode   ierr;
+  PetscObjectState state;
+
+  PetscFunctionBegin;
+  ierr = PetscObjectStateGet((PetscObject)ctx->A,&state);CHKERRQ(ierr);
+  if (ctx->dinv && state == ctx->state) PetscFunctionReturn(0);
+  if (!ctx->dinv) {ierr = MatCreateVecs(ctx->A,&ctx->dinv,NULL);CHKERRQ(ierr);}
+  ierr = MatGetDiagonal(ctx->A,ctx->dinv);CHKERRQ(ierr);
+  ierr = VecReciprocal(ctx->dinv);CHKERRQ(ierr);
+  ierr = VecScale(ctx->dinv,-ctx->omega);CHKERRQ(ierr);
+  ctx->state = state;
+  PetscFunctionReturn(0);
+}
+
+static PetscErrorCode MatMult_GAMGMatFreeProl(Mat P,Vec x,Vec y)
+{
+  PetscErrorCode      ierr;
+  PC_GAMG_MatFreeProl *ctx;
+
+  PetscFunctionBegin;
+  ierr = MatShellGetContext(P,&ctx);CHKERRQ(ierr);
+  ierr = PCGAMGMatFreeProlUpdate(ctx);CHKERRQ(ierr);
+  ierr = MatMult(ctx->P0,x,y);CHKERRQ(ierr);
+  ierr = MatMult(ctx->A,y,ctx->wf0);CHKERRQ(ierr);
+  ierr = VecPointwiseMult(ctx->wf0,ctx->dinv,ctx->wf0);CHKERRQ(ierr);
+  ierr = VecAXPY(y,1.0,ctx->wf0);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+static PetscErrorCode MatMultTranspose_GAMGMatFreeProl(Mat P,Vec x,Vec y)
+{
+  PetscErrorCode      ierr;
+  PC_GAMG_MatFreeProl *ctx;
+
+  PetscFunctionBegin;
+  ierr = MatShellGetContext(P,&ctx);CHKERRQ(ierr);
+  ierr = PCGAMGMatFreeProlUpdate(ctx);CHKERRQ(ierr);
+  ierr = VecPointwiseMult(ctx->wf0,ctx->dinv,x);CHKERRQ(ierr);
+  ierr = MatMultTranspose(ctx->A,ctx->wf0,ctx->wf1);CHKERRQ(ierr);
+  ierr = VecAXPY(ctx->wf1,1.0,x);CHKERRQ(ierr);
+  ierr = MatMultTranspose(ctx->P0,ctx->wf1,y);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+/* only selects columns, used when the coarse grid is repartitioned */
+static PetscErrorCode MatCreateSubMatrix_GAMGMatFreeProl(Mat P,IS isrow,IS iscol,MatReuse reuse,Mat *newP)
+{
+  PetscErrorCode      ierr;
+  PC_GAMG_MatFreeProl *ctx,*newctx;
+  PetscInt            m;
+  Mat                 P0;
+
+  PetscFunctionBegin;
+  ierr = MatShellGetContext(P,&ctx);CHKERRQ(ierr);
+  ierr = ISGetLocalSize(isrow,&m);CHKERRQ(ierr);
+  if (m != P->rmap->n) SETERRQ2(PETSC_COMM_SELF,PETSC_ERR_SUP,"Matrix-free prolongator only supports selecting all %D local rows, not %D",P->rmap->n,m);
+  if (reuse == MAT_REUSE_MATRIX) {
+    ierr = MatShellGetContext(*newP,&newctx);CHKERRQ(ierr);
+    ierr = MatCreateSubMatrix(ctx->P0,isrow,iscol,MAT_REUSE_MATRIX,&newctx->P0);CHKERRQ(ierr);
+  } else {
+    ierr = MatCreateSubMatrix(ctx->P0,isrow,iscol,MAT_INITIAL_MATRIX,&P0);CHKERRQ(ierr);
+    ierr = PCGAMGCreateMatFreeProlongator(ctx->A,P0,ctx->omega,newP);CHKERRQ(ierr);
+    ierr = MatDestroy(&P0);CHKERRQ(ierr);
+  }
+  PetscFunctionReturn(0);
+}
+
+static PetscErrorCode MatDestroy_GAMGMatFreeProl(Mat P)
+{
+  PetscErrorCode      ierr;
+  PC_GAMG_MatFreeProl *ctx;
+
+  PetscFunctionBegin;
+  ierr = MatShellGetContext(P,&ctx);CHKERRQ(ierr);
+  ierr = MatDestroy(&ctx->A);CHKERRQ(ierr);
+  ierr = MatDestroy(&ctx->P0);CHKERRQ(ierr);
+  ierr = VecDestroy(&ctx->dinv);CHKERRQ(ierr);
+  ierr = VecDestroy(&ctx->wf0);CHKERRQ(ierr);
+  ierr = VecDestroy(&ctx->wf1);CHKERRQ(ierr);
+  ierr = PetscFree(ctx);CHKERRQ(ierr);
+  ierr = PetscObjectComposeFunction((PetscObject)P,"MatProductSetFromOptions_anytype_C",NULL);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+static PetscErrorCode MatDestroy_GAMGMatFreeProlPtAP(void *data)
+{
+  PetscErrorCode          ierr;
+  PC_GAMG_MatFreeProlPtAP *ptap = (PC_GAMG_MatFreeProlPtAP*)data;
+
+  PetscFunctionBegin;
+  ierr = MatDestroy(&ptap->P);CHKERRQ(ierr);
+  ierr = MatDestroy(&ptap->PtAP);CHKERRQ(ierr);
+  ierr = PetscFree(ptap);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+/* P := A P0 numerically, then P := P0 + D P */
+static PetscErrorCode PCGAMGMatFreeProlFormP(PC_GAMG_MatFreeProl *ctx,Mat P)
+{
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  ierr = PCGAMGMatFreeProlUpdate(ctx);CHKERRQ(ierr);
+  ierr = MatProductNumeric(P);CHKERRQ(ierr);
+  ierr = MatDiagonalScale(P,ctx->dinv,NULL);CHKERRQ(ierr);
+  ierr = MatAXPY(P,1.0,ctx->P0,SUBSET_NONZERO_PATTERN);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+static PetscErrorCode MatProductNumeric_PtAP_GAMGMatFreeProl(Mat C)
+{
+  PetscErrorCode          ierr;
+  Mat_Product             *product = C->product;
+  PC_GAMG_MatFreeProl     *ctx;
+  PC_GAMG_MatFreeProlPtAP *ptap;
+
+  PetscFunctionBegin;
+  MatCheckProduct(C,1);
+  if (!product->data) SETERRQ(PetscObjectComm((PetscObject)C),PETSC_ERR_PLIB,"Product data empty");
+  ptap = (PC_GAMG_MatFreeProlPtAP*)product->data;
+  ierr = MatShellGetContext(product->B,&ctx);CHKERRQ(ierr);
+  /* MatPtAP() with MAT_REUSE_MATRIX may give a new operator with the same nonzero pattern, the prolongator is then smoothed with it */
+  if (product->A != ctx->A) {
+    ierr = PetscObjectReference((PetscObject)product->A);CHKERRQ(ierr);
+    ierr = MatDestroy(&ctx->A);CHKERRQ(ierr);
+    ctx->A     = product->A;
+    ctx->state = -1;
+  }
+  if (ptap->P->product->A != product->A) {ierr = MatProductReplaceMats(product->A,NULL,NULL,ptap->P);CHKERRQ(ierr);}
+  if (ptap->PtAP->product->A != product->A) {ierr = MatProductReplaceMats(product->A,NULL,NULL,ptap->PtAP);CHKERRQ(ierr);}
+  ierr = PCGAMGMatFreeProlFormP(ctx,ptap->P);CHKERRQ(ierr);
+  /* run the numeric phase of the product with the explicit P on C */
+  C->product = ptap->PtAP->product;
+  C->ops->productnumeric = ptap->PtAP->ops->productnumeric;
+  if (!C->ops->productnumeric) SETERRQ(PetscObjectComm((PetscObject)C),PETSC_ERR_PLIB,"Missing numeric stage");
+  ierr = (*C->ops->productnumeric)(C);CHKERRQ(ierr);
+  C->ops->productnumeric = MatProductNumeric_PtAP_GAMGMatFreeProl;
+  C->product = product;
+  PetscFunctionReturn(0);
+}
+
+/*
+   The smoothed prolongator is formed from the much sparser A P0 and dropped with the product data, the triple product with it
+   is computed by the implementation for the type of A
+*/
+static PetscErrorCode MatProductSymbolic_PtAP_GAMGMatFreeProl(Mat C)
+{
+  PetscErrorCode          ierr;
+  Mat_Product             *product = C->product;
+  PC_GAMG_MatFreeProl     *ctx;
+  PC_GAMG_MatFreeProlPtAP *ptap;
+  const char              *prefix;
+
+  PetscFunctionBegin;
+  MatCheckProduct(C,1);
+  if (product->data) SETERRQ(PetscObjectComm((PetscObject)C),PETSC_ERR_PLIB,"Product data not empty");
+  ierr = MatShellGetContext(product->B,&ctx);CHKERRQ(ierr);
+  ierr = MatGetOptionsPrefix(C,&prefix);CHKERRQ(ierr);
+  ierr = PetscNew(&ptap);CHKERRQ(ierr);
+  product->data    = ptap;
+  product->destroy = MatDestroy_GAMGMatFreeProlPtAP;
+
+  ierr = MatProductCreate(ctx->A,ctx->P0,NULL,&ptap->P);CHKERRQ(ierr);
+  ierr = MatSetOptionsPrefix(ptap->P,prefix);CHKERRQ(ierr);
+  ierr = MatAppendOptionsPrefix(ptap->P,"P1_");CHKERRQ(ierr);
+  ierr = MatProductSetType(ptap->P,MATPRODUCT_AB);CHKERRQ(ierr);
+  ierr = MatProductSetAlgorithm(ptap->P,MATPRODUCTALGORITHM_DEFAULT);CHKERRQ(ierr);
+  ierr = MatProductSetFill(ptap->P,PETSC_DEFAULT);CHKERRQ(ierr);
+  ptap->P->product->api_user = product->api_user;
+  ierr = MatProductSetFromOptions(ptap->P);CHKERRQ(ierr);
+  ierr = MatProductSymbolic(ptap->P);CHKERRQ(ierr);
+  /* the values are needed to fix the nonzero pattern of P before the symbolic triple product */
+  ierr = PCGAMGMatFreeProlFormP(ctx,ptap->P);CHKERRQ(ierr);
+
+  ierr = MatProductCreate(product->A,ptap->P,NULL,&ptap->PtAP);CHKERRQ(ierr);
+  ierr = MatSetOptionsPrefix(ptap->PtAP,prefix);CHKERRQ(ierr);
+  ierr = MatAppendOptionsPrefix(ptap->PtAP,"P2_");CHKERRQ(ierr);
+  ierr = MatProductSetType(ptap->PtAP,MATPRODUCT_PtAP);CHKERRQ(ierr);
+  ierr = MatProductSetAlgorithm(ptap->PtAP,MATPRODUCTALGORITHM_DEFAULT);CHKERRQ(ierr);
+  ierr = MatProductSetFill(ptap->PtAP,product->fill);CHKERRQ(ierr);
+  ptap->PtAP->product->api_user = product->api_user;
+  ierr = MatProductSetFromOptions(ptap->PtAP);CHKERRQ(ierr);
+  if (!ptap->PtAP->ops->productsymbolic) SETERRQ2(PetscObjectComm((PetscObject)C),PETSC_ERR_SUP,"Symbolic ProductType PtAP not supported with %s and %s",((PetscObject)product->A)->type_name,((PetscObject)ptap->P)->type_name);
+  /* run the symbolic phase of the product with the explicit P on C */
+  C->product = ptap->PtAP->product;
+  C->ops->productsymbolic = ptap->PtAP->ops->productsymbolic;
+  ierr = (*C->ops->productsymbolic)(C);CHKERRQ(ierr);
+  ptap->PtAP->ops->productnumeric = C->ops->productnumeric;
+  C->ops->productsymbolic = MatProductSymbolic_PtAP_GAMGMatFreeProl;
+  C->ops->productnumeric  = MatProductNumeric_PtAP_GAMGMatFreeProl;
+  C->product              = product;
+  PetscFunctionReturn(0);
+}
+
+static PetscErrorCode MatProductSetFromOptions_GAMGMatFreeProl(Mat C)
+{
+  PetscErrorCode ierr;
+  Mat_Product    *product = C->product;
+  PetscErrorCode (*f)(Mat) = NULL;
+
+  PetscFunctionBegin;
+  MatCheckProduct(C,1);
+  if (product->type != MATPRODUCT_PtAP) PetscFunctionReturn(0);
+  ierr = PetscObjectQueryFunction((PetscObject)product->B,"MatProductSetFromOptions_anytype_C",&f);CHKERRQ(ierr);
+  if (f == MatProductSetFromOptions_GAMGMatFreeProl) C->ops->productsymbolic = MatProductSymbolic_PtAP_GAMGMatFreeProl;
+  PetscFunctionReturn(0);
+}
+
+static PetscErrorCode PCGAMGCreateMatFreeProlongator(Mat A,Mat P0,PetscReal omega,Mat *a_P)
+{
+  PetscErrorCode      ierr;
+  PC_GAMG_MatFreeProl *ctx;
+  PetscInt            m,n,M,N,rbs,cbs;
+  VecType             vtype;
+
+  PetscFunctionBegin;
+  ierr = PetscNew(&ctx);CHKERRQ(ierr);
+  ierr = PetscObjectReference((PetscObject)A);CHKERRQ(ierr);
+  ierr = PetscObjectReference((PetscObject)P0);CHKERRQ(ierr);
+  ctx->A     = A;
+  ctx->P0    = P0;
+  ctx->omega = omega;
+  ierr = PCGAMGMatFreeProlUpdate(ctx);CHKERRQ(ierr);
+  ierr = MatCreateVecs(A,&ctx->wf0,&ctx->wf1);CHKERRQ(ierr);
+  ierr = MatGetLocalSize(P0,&m,&n);CHKERRQ(ierr);
+  ierr = MatGetSize(P0,&M,&N);CHKERRQ(ierr);
+  ierr = MatGetBlockSizes(P0,&rbs,&cbs);CHKERRQ(ierr);
+  ierr = MatCreateShell(PetscObjectComm((PetscObject)P0),m,n,M,N,ctx,a_P);CHKERRQ(ierr);
+  ierr = MatSetBlockSizes(*a_P,rbs,cbs);CHKERRQ(ierr);
+  ierr = VecGetType(ctx->wf0,&vtype);CHKERRQ(ierr);
+  ierr = MatShellSetVecType(*a_P,vtype);CHKERRQ(ierr);
+  ierr = MatShellSetOperation(*a_P,MATOP_MULT,(void (*)(void))MatMult_GAMGMatFreeProl);CHKERRQ(ierr);
+  ierr = MatShellSetOperation(*a_P,MATOP_MULT_TRANSPOSE,(void (*)(void))MatMultTranspose_GAMGMatFreeProl);CHKERRQ(ierr);
+  ierr = MatShellSetOperation(*a_P,MATOP_CREATE_SUBMATRIX,(void (*)(void))MatCreateSubMatrix_GAMGMatFreeProl);CHKERRQ(ierr);
+  ierr = MatShellSetOperation(*a_P,MATOP_DESTROY,(void (*)(void))MatDestroy_GAMGMatFreeProl);CHKERRQ(ierr);
+  ierr = PetscObjectComposeFunction((PetscObject)*a_P,"MatProductSetFromOptions_anytype_C",MatProductSetFromOptions_GAMGMatFreeProl);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
 /* -------------------------------------------------------------------------- */
 /*
    PCGAMGOptProlongator_AGG
@@ -1154,6 +1480,19 @@ static PetscErrorCode PCGAMGOptProlongator_AGG(PC pc,Mat Amat,Mat *a_P)
     Vec diag;
 
     ierr = PetscLogEventBegin(petsc_gamg_setup_events[SET9],0,0,0,0);CHKERRQ(ierr);
+    /* TODO: Set a PCFailedReason and exit the building of the AMG preconditioner */
+    if (emax == 0.0) SETERRQ(PetscObjectComm((PetscObject)pc),PETSC_ERR_PLIB,"Computed maximum singular value as zero");
+    /* TODO: Document the 1.4 and don't hardwire it in this routine */
+    alpha = -1.4/emax;
+
+    if (pc_gamg_agg->matfree_prol && jj == pc_gamg_agg->nsmooths-1) {
+      /* keep the last step as P0 + alpha D^{-1} A P0, applied on the fly */
+      ierr = PCGAMGCreateMatFreeProlongator(Amat, Prol, -alpha, &tMat);CHKERRQ(ierr);
+      ierr = MatDestroy(&Prol);CHKERRQ(ierr);
+      Prol = tMat;
+      ierr = PetscLogEventEnd(petsc_gamg_setup_events[SET9],0,0,0,0);CHKERRQ(ierr);
+      break;
+    }
 
     /* smooth P1 := (I - omega/lam D^{-1}A)P0 */
     ierr = PetscLogEventBegin(petsc_gamg_setup_matmat_events[pc_gamg->current_level][2],0,0,0,0);CHKERRQ(ierr);
@@ -1166,11 +1505,6 @@ static PetscErrorCode PCGAMGOptProlongator_AGG(PC pc,Mat Amat,Mat *a_P)
     ierr = MatDiagonalScale(tMat, diag, NULL);CHKERRQ(ierr);
     ierr = VecDestroy(&diag);CHKERRQ(ierr);
 
-    /* TODO: Set a PCFailedReason and exit the building of the AMG preconditioner */
-    if (emax == 0.0) SETERRQ(PetscObjectComm((PetscObject)pc),PETSC_ERR_PLIB,"Computed maximum singular value as zero");
-    /* TODO: Document the 1.4 and don't hardwire it in this routine */
-    alpha = -1.4/emax;
-
     ierr = MatAYPX(tMat, alpha, Prol, SUBSET_NONZERO_PATTERN);CHKERRQ(ierr);
     ierr = MatDestroy(&Prol);CHKERRQ(ierr);
     Prol = tMat;
@@ -1215,10 +1549,12 @@ PetscErrorCode  PCCreateGAMG_AGG(PC pc)
   pc_gamg_agg->square_graph = 1;
   pc_gamg_agg->sym_graph    = PETSC_FALSE;
   pc_gamg_agg->nsmooths     = 1;
+  pc_gamg_agg->matfree_prol = PETSC_FALSE;
 
   ierr = PetscObjectComposeFunction((PetscObject)pc,"PCGAMGSetNSmooths_C",PCGAMGSetNSmooths_AGG);CHKERRQ(ierr);
   ierr = PetscObjectComposeFunction((PetscObject)pc,"PCGAMGSetSymGraph_C",PCGAMGSetSymGraph_AGG);CHKERRQ(ierr);
   ierr = PetscObjectComposeFunction((PetscObject)pc,"PCGAMGSetSquareGraph_C",PCGAMGSetSquareGraph_AGG);CHKERRQ(ierr);
+  ierr = PetscObjectComposeFunction((PetscObject)pc,"PCGAMGSetMatFreeProlongator_C",PCGAMGSetMatFreeProlongator_AGG);CHKERRQ(ierr);
   ierr = PetscObjectComposeFunction((PetscObject)pc,"PCSetCoordinates_C",PCSetCoordinates_AGG);CHKERRQ(ierr);
   PetscFunctionReturn(0);
 }
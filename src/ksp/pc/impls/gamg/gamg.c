@@ -48,6 +48,10 @@ PetscErrorCode PCReset_GAMG(PC pc)
   }
   pc_gamg->emin = 0;
   pc_gamg->emax = 0;
+  for (level = 0; level < PETSC_MG_MAXLEVELS ; level++) {
+    ierr = MatDestroy(&pc_gamg->ptap_mat[level]);CHKERRQ(ierr);
+    ierr = ISDestroy(&pc_gamg->ptap_perm[level]);CHKERRQ(ierr);
+  }
   PetscFunctionReturn(0);
 }
 
@@ -77,6 +81,7 @@ static PetscErrorCode PCGAMGCreateLevel_GAMG(PC pc,Mat Amat_fine,PetscInt cr_bs,
   MPI_Comm        comm;
   PetscMPIInt     rank,size,new_size,nactive=*a_nactive_proc;
   PetscInt        ncrs_eq,ncrs,f_bs;
+  PetscBool       matfree;
 
   PetscFunctionBegin;
   ierr = PetscObjectGetComm((PetscObject)Amat_fine,&comm);CHKERRQ(ierr);
@@ -86,6 +91,9 @@ static PetscErrorCode PCGAMGCreateLevel_GAMG(PC pc,Mat Amat_fine,PetscInt cr_bs,
   ierr = PetscLogEventBegin(petsc_gamg_setup_matmat_events[pc_gamg->current_level][1],0,0,0,0);CHKERRQ(ierr);
   ierr = MatPtAP(Amat_fine, Pold, MAT_INITIAL_MATRIX, 2.0, &Cmat);CHKERRQ(ierr);
   ierr = PetscLogEventEnd(petsc_gamg_setup_matmat_events[pc_gamg->current_level][1],0,0,0,0);CHKERRQ(ierr);
+  ierr = PetscObjectTypeCompare((PetscObject)Pold, MATSHELL, &matfree);CHKERRQ(ierr);
+  /* the product with a matrix-free prolongator holds the smoothed prolongator, only keep it for the numeric refresh */
+  if (matfree && !pc_gamg->reuse_prol) {ierr = MatProductClear(Cmat);CHKERRQ(ierr);}
 
   if (Pcolumnperm) *Pcolumnperm = NULL;
 
@@ -403,7 +411,13 @@ static PetscErrorCode PCGAMGCreateLevel_GAMG(PC pc,Mat Amat_fine,PetscInt cr_bs,
       ierr        = MatCreateSubMatrix(Cmat, new_eq_indices, new_eq_indices, MAT_INITIAL_MATRIX, &mat);CHKERRQ(ierr);
       *a_Amat_crs = mat;
     }
-    ierr = MatDestroy(&Cmat);CHKERRQ(ierr);
+    if (pc_gamg->reuse_prol) {
+      /* keep the product, and with it the unpermuted prolongator, for the numeric refresh in PCSetUp_GAMG() */
+      ierr = MatDestroy(&pc_gamg->ptap_mat[pc_gamg->current_level+1]);CHKERRQ(ierr);
+      pc_gamg->ptap_mat[pc_gamg->current_level+1] = Cmat;
+    } else {
+      ierr = MatDestroy(&Cmat);CHKERRQ(ierr);
+    }
 
     ierr = PetscLogEventEnd(petsc_gamg_setup_events[SET14],0,0,0,0);CHKERRQ(ierr);
     /* prolongator */
@@ -445,7 +459,7 @@ static PetscErrorCode PCGAMGCreateLevel_GAMG(PC pc,Mat Amat_fine,PetscInt cr_bs,
         if (size > 1) {
           Mat_MPIAIJ     *a = (Mat_MPIAIJ*)A->data, *p = (Mat_MPIAIJ*)P->data;
           ierr = VecBindToCPU(a->lvec,PETSC_TRUE);CHKERRQ(ierr);
-          ierr = VecBindToCPU(p->lvec,PETSC_TRUE);CHKERRQ(ierr);
+          if (!matfree) {ierr = VecBindToCPU(p->lvec,PETSC_TRUE);CHKERRQ(ierr);}
         }
       }
     }
@@ -518,10 +532,14 @@ PetscErrorCode PCSetUp_GAMG(PC pc)
     if (!pc_gamg->reuse_prol || pc->flag == DIFFERENT_NONZERO_PATTERN) {
       /* reset everything */
       ierr = PCReset_MG(pc);CHKERRQ(ierr);
+      for (level = 0; level < PETSC_MG_MAXLEVELS; level++) {
+        ierr = MatDestroy(&pc_gamg->ptap_mat[level]);CHKERRQ(ierr);
+        ierr = ISDestroy(&pc_gamg->ptap_perm[level]);CHKERRQ(ierr);
+      }
       pc->setupcalled = 0;
     } else {
       PC_MG_Levels **mglevels = mg->levels;
-      /* just do Galerkin grids */
+      /* just do Galerkin grids: the prolongators, the repartitioning and the symbolic products are kept */
       Mat          B,dA,dB;
 
       if (pc_gamg->Nlevels > 1) {
@@ -533,27 +551,57 @@ PetscErrorCode PCSetUp_GAMG(PC pc)
 
         for (level=pc_gamg->Nlevels-2,gl=0; level>=0; level--,gl++) {
           MatReuse reuse = MAT_INITIAL_MATRIX ;
+          Mat      Cmat = pc_gamg->ptap_mat[gl+1];
 
-          /* matrix structure can change from repartitioning or process reduction but don't know if we have process reduction here. Should fix */
           ierr = KSPGetOperators(mglevels[level]->smoothd,NULL,&B);CHKERRQ(ierr);
-          if (B->product) {
-            if (B->product->A == dB && B->product->B == mglevels[level+1]->interpolate) {
-              reuse = MAT_REUSE_MATRIX;
-            }
-          }
-          if (reuse == MAT_INITIAL_MATRIX) { ierr = MatDestroy(&mglevels[level]->A);CHKERRQ(ierr); }
-          if (reuse == MAT_REUSE_MATRIX) {
-            ierr = PetscInfo1(pc,"RAP after first solve, reuse matrix level %D\n",level);CHKERRQ(ierr);
+          ierr = PetscLogEventBegin(petsc_gamg_setup_matmat_events[gl][1],0,0,0,0);CHKERRQ(ierr);
+          if (Cmat) {
+            /* repartitioned or reduced level: redo the product with the unpermuted prolongator and move it to the cached layout */
+            ierr = PetscInfo1(pc,"RAP after first solve, reuse repartitioned matrix level %D\n",level);CHKERRQ(ierr);
+            ierr = MatPtAP(dB,Cmat->product->B,MAT_REUSE_MATRIX,PETSC_DEFAULT,&Cmat);CHKERRQ(ierr);
+            ierr = MatCreateSubMatrix(Cmat,pc_gamg->ptap_perm[gl+1],pc_gamg->ptap_perm[gl+1],MAT_REUSE_MATRIX,&B);CHKERRQ(ierr);
           } else {
-            ierr = PetscInfo1(pc,"RAP after first solve, new matrix level %D\n",level);CHKERRQ(ierr);
+            if (B->product) {
+              if (B->product->A == dB && B->product->B == mglevels[level+1]->interpolate) {
+                reuse = MAT_REUSE_MATRIX;
+              }
+            }
+            if (reuse == MAT_INITIAL_MATRIX) { ierr = MatDestroy(&mglevels[level]->A);CHKERRQ(ierr); }
+            if (reuse == MAT_REUSE_MATRIX) {
+              ierr = PetscInfo1(pc,"RAP after first solve, reuse matrix level %D\n",level);CHKERRQ(ierr);
+            } else {
+              ierr = PetscInfo1(pc,"RAP after first solve, new matrix level %D\n",level);CHKERRQ(ierr);
+            }
+            ierr = MatPtAP(dB,mglevels[level+1]->interpolate,reuse,PETSC_DEFAULT,&B);CHKERRQ(ierr);
+            if (reuse == MAT_INITIAL_MATRIX) mglevels[level]->A = B;
           }
-          ierr = PetscLogEventBegin(petsc_gamg_setup_matmat_events[gl][1],0,0,0,0);CHKERRQ(ierr);
-          ierr = MatPtAP(dB,mglevels[level+1]->interpolate,reuse,PETSC_DEFAULT,&B);CHKERRQ(ierr);
           ierr = PetscLogEventEnd(petsc_gamg_setup_matmat_events[gl][1],0,0,0,0);CHKERRQ(ierr);
-          if (reuse == MAT_INITIAL_MATRIX) mglevels[level]->A = B;
           ierr = KSPSetOperators(mglevels[level]->smoothd,B,B);CHKERRQ(ierr);
           dB   = B;
         }
+
+        /* the eigenvalues from smoothing the prolongators are stale, let Chebyshev estimate them on the new operators */
+        if (pc_gamg->use_sa_esteig==1) {
+          for (level = 0; level < pc_gamg->Nlevels-1; level++) {
+            KSP       smoother;
+            PetscBool ischeb;
+
+            if (mg->max_eigen_DinvA[level] == 0.) continue;
+            ierr = PCMGGetSmoother(pc, pc_gamg->Nlevels-1-level, &smoother);CHKERRQ(ierr);
+            ierr = PetscObjectTypeCompare((PetscObject)smoother,KSPCHEBYSHEV,&ischeb);CHKERRQ(ierr);
+            if (ischeb) {
+              KSP_Chebyshev *cheb = (KSP_Chebyshev*)smoother->data;
+
+              if (!cheb->kspest && cheb->emax_computed == mg->max_eigen_DinvA[level]) {
+                ierr = PetscInfo1(pc,"Re-estimate Chebyshev eigenvalues on level %D\n",level);CHKERRQ(ierr);
+                ierr = KSPChebyshevEstEigSet(smoother,PETSC_DECIDE,PETSC_DECIDE,PETSC_DECIDE,PETSC_DECIDE);CHKERRQ(ierr);
+                ierr = KSPSetFromOptions(cheb->kspest);CHKERRQ(ierr);
+              }
+            }
+            mg->min_eigen_DinvA[level] = 0;
+            mg->max_eigen_DinvA[level] = 0;
+          }
+        }
       }
 
       ierr = PCSetUp_MG(pc);CHKERRQ(ierr);
@@ -660,7 +708,7 @@ PetscErrorCode PCSetUp_GAMG(PC pc)
     if (is_last) SETERRQ(PETSC_COMM_SELF,PETSC_ERR_PLIB,"Is last ?");
     if (N <= pc_gamg->coarse_eq_limit) is_last = PETSC_TRUE;
     if (level1 == pc_gamg->Nlevels-1) is_last = PETSC_TRUE;
-    ierr = pc_gamg->ops->createlevel(pc, Aarr[level], bs, &Parr[level1], &Aarr[level1], &nactivepe, NULL, is_last);CHKERRQ(ierr);
+    ierr = pc_gamg->ops->createlevel(pc, Aarr[level], bs, &Parr[level1], &Aarr[level1], &nactivepe, pc_gamg->reuse_prol ? &pc_gamg->ptap_perm[level1] : NULL, is_last);CHKERRQ(ierr);
 
     ierr = PetscLogEventEnd(petsc_gamg_setup_events[SET2],0,0,0,0);CHKERRQ(ierr);
     ierr = MatGetSize(Aarr[level1], &M, &N);CHKERRQ(ierr); /* M is loop test variables */
@@ -1150,6 +1198,11 @@ static PetscErrorCode PCGAMGSetEigenvalues_GAMG(PC pc,PetscReal emax,PetscReal e
     this may negatively affect the convergence rate of the method on new matrices if the matrix entries change a great deal, but allows
           rebuilding the preconditioner quicker.
 
+    When the nonzero pattern of the matrix does not change the rebuild is purely numeric: the prolongators, the repartitioning of the
+          coarse grids and the symbolic parts of the Galerkin products are kept and only the numeric products are recomputed. The
+          Chebyshev smoothers then estimate their eigenvalues on the new coarse operators. The Galerkin products of the repartitioned
+          levels are kept in their original layout for this, which needs some extra memory on these levels.
+
 .seealso: ()
 @*/
 PetscErrorCode PCGAMGSetReuseInterpolation(PC pc, PetscBool n)
@@ -1727,7 +1780,8 @@ PetscErrorCode PCSetFromOptions_GAMG(PetscOptionItems *PetscOptionsObject,PC pc)
    Options Database Keys for default Aggregation:
 +  -pc_gamg_agg_nsmooths <nsmooth, default=1> - number of smoothing steps to use with smooth aggregation
 .  -pc_gamg_sym_graph <true,default=false> - symmetrize the graph before computing the aggregation
--  -pc_gamg_square_graph <n,default=1> - number of levels to square the graph before aggregating it
+.  -pc_gamg_square_graph <n,default=1> - number of levels to square the graph before aggregating it
+-  -pc_gamg_matfree_prolongator <true,default=false> - apply the last smoothing step of the prolongators on the fly, see PCGAMGSetMatFreeProlongator()
 
    Multigrid options:
 +  -pc_mg_cycles <v> - v or w, see PCMGSetCycleType()
@@ -1741,6 +1795,9 @@ PetscErrorCode PCSetFromOptions_GAMG(PetscOptionItems *PetscOptionsObject,PC pc)
        Call MatSetNearNullSpace() (or PCSetCoordinates() if solving the equations of elasticity) to indicate the near null space of the operator
        See the Users Manual Chapter 4 for more details
 
+    The default smoothers are KSPCHEBYSHEV with PCJACOBI, with AIJ matrices -mg_levels_ksp_chebyshev_fused does each of their
+    steps in a single pass over the matrix, see KSPChebyshevSetFused()
+
   Level: intermediate
 
 .seealso:  PCCreate(), PCSetType(), MatSetBlockSize(), PCMGType, PCSetCoordinates(), MatSetNearNullSpace(), PCGAMGSetType(), PCGAMGAGG, PCGAMGGEO, PCGAMGCLASSICAL, PCGAMGSetProcEqLim(),
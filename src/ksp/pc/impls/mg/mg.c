@@ -26,13 +26,11 @@ PetscErrorCode PCMGMCycle_Private(PC pc,PC_MG_Levels **mglevelsin,PetscBool tran
       ierr = KSPMatSolve(mglevels->smoothd,mglevels->B,mglevels->X);CHKERRQ(ierr);  /* pre-smooth */
       ierr = KSPCheckSolve(mglevels->smoothd,pc,NULL);CHKERRQ(ierr);
     } else {
-      ierr = KSPSolve(mglevels->smoothd,mglevels->b,mglevels->x);CHKERRQ(ierr);  /* pre-smooth */
-      ierr = KSPCheckSolve(mglevels->smoothd,pc,mglevels->x);CHKERRQ(ierr);
+      ierr = PCMGLevelSolve_Private(pc,mglevels,mglevels->smoothd,PETSC_FALSE,mglevels->b,mglevels->x);CHKERRQ(ierr);  /* pre-smooth */
     }
   } else {
     if (matapp) SETERRQ(PetscObjectComm((PetscObject)pc),PETSC_ERR_SUP,"Not supported");
-    ierr = KSPSolveTranspose(mglevels->smoothu,mglevels->b,mglevels->x);CHKERRQ(ierr); /* transpose of post-smooth */
-    ierr = KSPCheckSolve(mglevels->smoothu,pc,mglevels->x);CHKERRQ(ierr);
+    ierr = PCMGLevelSolve_Private(pc,mglevels,mglevels->smoothu,PETSC_TRUE,mglevels->b,mglevels->x);CHKERRQ(ierr); /* transpose of post-smooth */
   }
   if (mglevels->eventsmoothsolve) {ierr = PetscLogEventEnd(mglevels->eventsmoothsolve,0,0,0,0);CHKERRQ(ierr);}
   if (mglevels->level) {  /* not the coarsest grid */
@@ -101,13 +99,11 @@ PetscErrorCode PCMGMCycle_Private(PC pc,PC_MG_Levels **mglevelsin,PetscBool tran
         ierr = KSPMatSolve(mglevels->smoothu,mglevels->B,mglevels->X);CHKERRQ(ierr);    /* post smooth */
         ierr = KSPCheckSolve(mglevels->smoothu,pc,NULL);CHKERRQ(ierr);
       } else {
-        ierr = KSPSolve(mglevels->smoothu,mglevels->b,mglevels->x);CHKERRQ(ierr);    /* post smooth */
-        ierr = KSPCheckSolve(mglevels->smoothu,pc,mglevels->x);CHKERRQ(ierr);
+        ierr = PCMGLevelSolve_Private(pc,mglevels,mglevels->smoothu,PETSC_FALSE,mglevels->b,mglevels->x);CHKERRQ(ierr);    /* post smooth */
       }
     } else {
       if (matapp) SETERRQ(PetscObjectComm((PetscObject)pc),PETSC_ERR_SUP,"Not supported");
-      ierr = KSPSolveTranspose(mglevels->smoothd,mglevels->b,mglevels->x);CHKERRQ(ierr);    /* post smooth */
-      ierr = KSPCheckSolve(mglevels->smoothd,pc,mglevels->x);CHKERRQ(ierr);
+      ierr = PCMGLevelSolve_Private(pc,mglevels,mglevels->smoothd,PETSC_TRUE,mglevels->b,mglevels->x);CHKERRQ(ierr);    /* post smooth */
     }
     if (mglevels->cr) {
       if (matapp) SETERRQ(PetscObjectComm((PetscObject)pc),PETSC_ERR_SUP,"Not supported");
@@ -221,6 +217,9 @@ PetscErrorCode PCReset_MG(PC pc)
       ierr = MatDestroy(&mglevels[i+1]->interpolate);CHKERRQ(ierr);
       ierr = MatDestroy(&mglevels[i+1]->inject);CHKERRQ(ierr);
       ierr = VecDestroy(&mglevels[i+1]->rscale);CHKERRQ(ierr);
+      ierr = VecDestroy(&mglevels[i+1]->l1inv);CHKERRQ(ierr);
+      ierr = VecDestroy(&mglevels[i+1]->work);CHKERRQ(ierr);
+      ierr = MatDestroy(&mglevels[i+1]->W);CHKERRQ(ierr);
     }
     ierr = VecDestroy(&mglevels[n-1]->crx);CHKERRQ(ierr);
     ierr = VecDestroy(&mglevels[n-1]->crb);CHKERRQ(ierr);
@@ -238,6 +237,7 @@ PetscErrorCode PCReset_MG(PC pc)
         ierr = KSPReset(mglevels[i]->smoothd);CHKERRQ(ierr);
       }
       ierr = KSPReset(mglevels[i]->smoothu);CHKERRQ(ierr);
+      ierr = PCMGAgglomerateReset_Private(mglevels[i]);CHKERRQ(ierr);
       if (mglevels[i]->cr) {ierr = KSPReset(mglevels[i]->cr);CHKERRQ(ierr);}
     }
     mg->Nc = 0;
@@ -554,6 +554,7 @@ static PetscErrorCode PCApply_MG_Internal(PC pc,Vec b,Vec x,Mat B,Mat X,PetscBoo
       ierr = KSPGetOperators(mglevels[i]->smoothu,&mglevels[i]->A,NULL);CHKERRQ(ierr);
       ierr = PetscObjectReference((PetscObject)mglevels[i]->A);CHKERRQ(ierr);
     }
+    if (matapp && mglevels[i]->aggsf) SETERRQ1(PetscObjectComm((PetscObject)pc),PETSC_ERR_SUP,"Level %D is agglomerated, applying to multiple right hand sides is not supported",i);
   }
 
   ierr = KSPGetPC(mglevels[levels-1]->smoothd,&tpc);CHKERRQ(ierr);
@@ -611,8 +612,10 @@ static PetscErrorCode PCApply_MG_Internal(PC pc,Vec b,Vec x,Mat B,Mat X,PetscBoo
     ierr = PetscObjectTypeCompare((PetscObject)mglevels[levels-2]->X,((PetscObject)mglevels[levels-1]->X)->type_name,&flg);CHKERRQ(ierr);
     if (Xc != Bc || !flg) {
       ierr = MatDestroy(&mglevels[levels-1]->R);CHKERRQ(ierr);
+      ierr = MatDestroy(&mglevels[levels-1]->W);CHKERRQ(ierr);
       for (i=0;i<levels-1;i++) {
         ierr = MatDestroy(&mglevels[i]->R);CHKERRQ(ierr);
+        ierr = MatDestroy(&mglevels[i]->W);CHKERRQ(ierr);
         ierr = MatDestroy(&mglevels[i]->B);CHKERRQ(ierr);
         ierr = MatDestroy(&mglevels[i]->X);CHKERRQ(ierr);
       }
@@ -629,6 +632,8 @@ static PetscErrorCode PCApply_MG_Internal(PC pc,Vec b,Vec x,Mat B,Mat X,PetscBoo
     ierr = PCMGACycle_Private(pc,mglevels,transpose,matapp);CHKERRQ(ierr);
   } else if (mg->am == PC_MG_KASKADE) {
     ierr = PCMGKCycle_Private(pc,mglevels,transpose,matapp);CHKERRQ(ierr);
+  } else if (mg->am == PC_MG_MULTADDITIVE) {
+    ierr = PCMGMultAdditiveCycle_Private(pc,mglevels,transpose,matapp);CHKERRQ(ierr);
   } else {
     ierr = PCMGFCycle_Private(pc,mglevels,transpose,matapp);CHKERRQ(ierr);
   }
@@ -725,6 +730,7 @@ PetscErrorCode PCSetFromOptions_MG(PetscOptionItems *PetscOptionsObject,PC pc)
       ierr = PCMGMultiplicativeSetCycles(pc,cycles);CHKERRQ(ierr);
     }
   }
+  ierr = PetscOptionsInt("-pc_mg_process_eq_limit","Limit (goal) on number of equations per process on coarse grids","PCMGSetProcEqLim",mg->min_eq_proc,&mg->min_eq_proc,NULL);CHKERRQ(ierr);
   flg  = PETSC_FALSE;
   ierr = PetscOptionsBool("-pc_mg_log","Log times for each multigrid level","None",flg,&flg,NULL);CHKERRQ(ierr);
   if (flg) {
@@ -772,7 +778,7 @@ PetscErrorCode PCSetFromOptions_MG(PetscOptionItems *PetscOptionsObject,PC pc)
   PetscFunctionReturn(0);
 }
 
-const char *const PCMGTypes[] = {"MULTIPLICATIVE","ADDITIVE","FULL","KASKADE","PCMGType","PC_MG",NULL};
+const char *const PCMGTypes[] = {"MULTIPLICATIVE","ADDITIVE","FULL","KASKADE","MULTADDITIVE","PCMGType","PC_MG",NULL};
 const char *const PCMGCycleTypes[] = {"invalid","v","w","PCMGCycleType","PC_MG_CYCLE",NULL};
 const char *const PCMGGalerkinTypes[] = {"both","pmat","mat","none","external","PCMGGalerkinType","PC_MG_GALERKIN",NULL};
 const char *const PCMGCoarseSpaceTypes[] = {"polynomial","harmonic","eigenvector","generalized_eigenvector","PCMGCoarseSpaceType","PCMG_POLYNOMIAL",NULL};
@@ -807,6 +813,9 @@ PetscErrorCode PCView_MG(PC pc,PetscViewer viewer)
     } else {
       ierr = PetscViewerASCIIPrintf(viewer,"    Not using Galerkin computed coarse grid matrices\n");CHKERRQ(ierr);
     }
+    if (mg->min_eq_proc) {
+      ierr = PetscViewerASCIIPrintf(viewer,"    Agglomerating the coarser levels to about %D equations per process\n",mg->min_eq_proc);CHKERRQ(ierr);
+    }
     if (mg->view) {
       ierr = (*mg->view)(pc,viewer);CHKERRQ(ierr);
     }
@@ -817,14 +826,14 @@ PetscErrorCode PCView_MG(PC pc,PetscViewer viewer)
         ierr = PetscViewerASCIIPrintf(viewer,"Down solver (pre-smoother) on level %D -------------------------------\n",i);CHKERRQ(ierr);
       }
       ierr = PetscViewerASCIIPushTab(viewer);CHKERRQ(ierr);
-      ierr = KSPView(mglevels[i]->smoothd,viewer);CHKERRQ(ierr);
+      ierr = PCMGLevelView_Private(pc,mglevels[i],mglevels[i]->smoothd,viewer);CHKERRQ(ierr);
       ierr = PetscViewerASCIIPopTab(viewer);CHKERRQ(ierr);
       if (i && mglevels[i]->smoothd == mglevels[i]->smoothu) {
         ierr = PetscViewerASCIIPrintf(viewer,"Up solver (post-smoother) same as down solver (pre-smoother)\n");CHKERRQ(ierr);
       } else if (i) {
         ierr = PetscViewerASCIIPrintf(viewer,"Up solver (post-smoother) on level %D -------------------------------\n",i);CHKERRQ(ierr);
         ierr = PetscViewerASCIIPushTab(viewer);CHKERRQ(ierr);
-        ierr = KSPView(mglevels[i]->smoothu,viewer);CHKERRQ(ierr);
+        ierr = PCMGLevelView_Private(pc,mglevels[i],mglevels[i]->smoothu,viewer);CHKERRQ(ierr);
         ierr = PetscViewerASCIIPopTab(viewer);CHKERRQ(ierr);
       }
       if (i && mglevels[i]->cr) {
@@ -1190,6 +1199,8 @@ PetscErrorCode PCSetUp_MG(PC pc)
     }
   }
 
+  ierr = PCMGAgglomerateSetUp_Private(pc);CHKERRQ(ierr);
+
   for (i=1; i<n; i++) {
     if (mglevels[i]->smoothu == mglevels[i]->smoothd || mg->am == PC_MG_FULL || mg->am == PC_MG_KASKADE || mg->cyclesperpcapply > 1) {
       /* if doing only down then initial guess is zero */
@@ -1197,10 +1208,7 @@ PetscErrorCode PCSetUp_MG(PC pc)
     }
     if (mglevels[i]->cr) {ierr = KSPSetInitialGuessNonzero(mglevels[i]->cr,PETSC_TRUE);CHKERRQ(ierr);}
     if (mglevels[i]->eventsmoothsetup) {ierr = PetscLogEventBegin(mglevels[i]->eventsmoothsetup,0,0,0,0);CHKERRQ(ierr);}
-    ierr = KSPSetUp(mglevels[i]->smoothd);CHKERRQ(ierr);
-    if (mglevels[i]->smoothd->reason == KSP_DIVERGED_PC_FAILED) {
-      pc->failedreason = PC_SUBPC_ERROR;
-    }
+    ierr = PCMGLevelSetUp_Private(pc,mglevels[i],mglevels[i]->smoothd);CHKERRQ(ierr);
     if (mglevels[i]->eventsmoothsetup) {ierr = PetscLogEventEnd(mglevels[i]->eventsmoothsetup,0,0,0,0);CHKERRQ(ierr);}
     if (!mglevels[i]->residual) {
       Mat mat;
@@ -1226,10 +1234,7 @@ PetscErrorCode PCSetUp_MG(PC pc)
 
       ierr = KSPSetInitialGuessNonzero(mglevels[i]->smoothu,PETSC_TRUE);CHKERRQ(ierr);
       if (mglevels[i]->eventsmoothsetup) {ierr = PetscLogEventBegin(mglevels[i]->eventsmoothsetup,0,0,0,0);CHKERRQ(ierr);}
-      ierr = KSPSetUp(mglevels[i]->smoothu);CHKERRQ(ierr);
-      if (mglevels[i]->smoothu->reason == KSP_DIVERGED_PC_FAILED) {
-        pc->failedreason = PC_SUBPC_ERROR;
-      }
+      ierr = PCMGLevelSetUp_Private(pc,mglevels[i],mglevels[i]->smoothu);CHKERRQ(ierr);
       if (mglevels[i]->eventsmoothsetup) {ierr = PetscLogEventEnd(mglevels[i]->eventsmoothsetup,0,0,0,0);CHKERRQ(ierr);}
     }
     if (mglevels[i]->cr) {
@@ -1252,11 +1257,10 @@ PetscErrorCode PCSetUp_MG(PC pc)
     }
   }
 
+  if (mg->am == PC_MG_MULTADDITIVE) {ierr = PCMGMultAdditiveSetUp_Private(pc,mglevels);CHKERRQ(ierr);}
+
   if (mglevels[0]->eventsmoothsetup) {ierr = PetscLogEventBegin(mglevels[0]->eventsmoothsetup,0,0,0,0);CHKERRQ(ierr);}
-  ierr = KSPSetUp(mglevels[0]->smoothd);CHKERRQ(ierr);
-  if (mglevels[0]->smoothd->reason == KSP_DIVERGED_PC_FAILED) {
-    pc->failedreason = PC_SUBPC_ERROR;
-  }
+  ierr = PCMGLevelSetUp_Private(pc,mglevels[0],mglevels[0]->smoothd);CHKERRQ(ierr);
   if (mglevels[0]->eventsmoothsetup) {ierr = PetscLogEventEnd(mglevels[0]->eventsmoothsetup,0,0,0,0);CHKERRQ(ierr);}
 
   /*
@@ -1326,18 +1330,23 @@ PetscErrorCode PCMGGetLevels(PC pc,PetscInt *levels)
 
 /*@
    PCMGSetType - Determines the form of multigrid to use:
-   multiplicative, additive, full, or the Kaskade algorithm.
+   multiplicative, additive, full, the Kaskade algorithm, or mult-additive.
 
    Logically Collective on PC
 
    Input Parameters:
 +  pc - the preconditioner context
 -  form - multigrid form, one of PC_MG_MULTIPLICATIVE, PC_MG_ADDITIVE,
-   PC_MG_FULL, PC_MG_KASKADE
+   PC_MG_FULL, PC_MG_KASKADE, PC_MG_MULTADDITIVE
 
    Options Database Key:
 .  -pc_mg_type <form> - Sets <form>, one of multiplicative,
-   additive, full, kaskade
+   additive, full, kaskade, multadditive
+
+   Notes:
+   PC_MG_MULTADDITIVE requires that the operator on each level other than the coarsest provides MatGetRow(),
+   since the transfers are smoothed with the l1-Jacobi method built from the operator's rows. The level solves
+   are applied sequentially, as for PC_MG_ADDITIVE, so it costs about as much as a V-cycle per application.
 
    Level: advanced
 
@@ -1358,7 +1367,7 @@ PetscErrorCode  PCMGSetType(PC pc,PCMGType form)
 
 /*@
    PCMGGetType - Determines the form of multigrid to use:
-   multiplicative, additive, full, or the Kaskade algorithm.
+   multiplicative, additive, full, the Kaskade algorithm, or mult-additive.
 
    Logically Collective on PC
 
@@ -1366,7 +1375,7 @@ PetscErrorCode  PCMGSetType(PC pc,PCMGType form)
 .  pc - the preconditioner context
 
    Output Parameter:
-.  type - one of PC_MG_MULTIPLICATIVE, PC_MG_ADDITIVE,PC_MG_FULL, PC_MG_KASKADE
+.  type - one of PC_MG_MULTIPLICATIVE, PC_MG_ADDITIVE,PC_MG_FULL, PC_MG_KASKADE, PC_MG_MULTADDITIVE
 
    Level: advanced
 
@@ -1445,6 +1454,45 @@ PetscErrorCode  PCMGMultiplicativeSetCycles(PC pc,PetscInt n)
   PetscFunctionReturn(0);
 }
 
+/*@
+   PCMGSetProcEqLim - Sets the number of rows to aim for per process when solving on the coarser levels; a level with
+   fewer rows than this times the number of processes is solved on a subcommunicator of about rows/limit processes
+
+   Logically Collective on PC
+
+   Input Parameters:
++  pc - the multigrid context
+-  n - the number of rows per process, 0 (the default) solves every level on the communicator of the PC
+
+   Options Database Key:
+.  -pc_mg_process_eq_limit <limit>
+
+   Level: intermediate
+
+   Notes:
+   The finest level is never agglomerated. Every stride-th process of the PC takes the rows of the following stride-1 processes,
+   so the numbering of the level does not change; the level operator is copied onto the subcommunicator and the level vectors
+   are moved there and back with a PetscSF around each smoother application. The residuals and the transfers between levels
+   stay on the communicator of the PC. This does the work of wrapping the coarser levels in PCTELESCOPE without setting it up by hand.
+
+   The solvers on the subcommunicators take the KSP type, tolerances and norm type of the level smoothers and the type of their PC,
+   as well as any options with the same prefix, for example -mg_coarse_pc_type; other settings made with PCMGGetSmoother() are not
+   carried over. Level operators computed by a DM, see KSPSetComputeOperators(), are computed on the communicator of the PC
+   before being copied. The level operators must support MatCreateSubMatrices(), otherwise PCSetUp() raises an error.
+
+.seealso: PCMGSetLevels(), PCGAMGSetProcEqLim(), PCTELESCOPE
+@*/
+PetscErrorCode  PCMGSetProcEqLim(PC pc,PetscInt n)
+{
+  PC_MG        *mg        = (PC_MG*)pc->data;
+
+  PetscFunctionBegin;
+  PetscValidHeaderSpecific(pc,PC_CLASSID,1);
+  PetscValidLogicalCollectiveInt(pc,n,2);
+  mg->min_eq_proc = n;
+  PetscFunctionReturn(0);
+}
+
 PetscErrorCode PCMGSetGalerkin_MG(PC pc,PCMGGalerkinType use)
 {
   PC_MG *mg = (PC_MG*)pc->data;
@@ -1867,11 +1915,12 @@ PetscErrorCode PCMGGetCoarseSpaceConstructor(const char name[], PetscErrorCode (
    Options Database Keys:
 +  -pc_mg_levels <nlevels> - number of levels including finest
 .  -pc_mg_cycle_type <v,w> - provide the cycle desired
-.  -pc_mg_type <additive,multiplicative,full,kaskade> - multiplicative is the default
+.  -pc_mg_type <additive,multiplicative,full,kaskade,multadditive> - multiplicative is the default
 .  -pc_mg_log - log information about time spent on each level of the solver
 .  -pc_mg_distinct_smoothup - configure up (after interpolation) and down (before restriction) smoothers separately (with different options prefixes)
 .  -pc_mg_galerkin <both,pmat,mat,none> - use Galerkin process to compute coarser operators, i.e. Acoarse = R A R'
 .  -pc_mg_multiplicative_cycles - number of cycles to use as the preconditioner (defaults to 1)
+.  -pc_mg_process_eq_limit <limit> - solve the coarser levels on subcommunicators with about <limit> equations per process, see PCMGSetProcEqLim()
 .  -pc_mg_dump_matlab - dumps the matrices for each level and the restriction/interpolation matrices
                         to the Socket viewer for reading from MATLAB.
 -  -pc_mg_dump_binary - dumps the matrices for each level and the restriction/interpolation matrices
@@ -1887,6 +1936,12 @@ PetscErrorCode PCMGGetCoarseSpaceConstructor(const char name[], PetscErrorCode (
        (because the residual has just been computed for the multigrid algorithm and is hence available for free) while with monitoring the
        residual is computed at the end of each cycle.
 
+       With KSPCHEBYSHEV and PCJACOBI smoothers on AIJ matrices -mg_levels_ksp_chebyshev_fused computes the residual, the Jacobi scaling
+       and the update of each smoothing step in a single pass over the matrix, see KSPChebyshevSetFused()
+
+       With -pc_mg_type multadditive the solves on all levels use right hand sides obtained with l1-Jacobi smoothed restriction,
+       they are applied sequentially and the smoothed interpolation then combines them, see PCMGSetType()
+
    Level: intermediate
 
 .seealso:  PCCreate(), PCSetType(), PCType (for list of available types), PC, PCMGType, PCEXOTIC, PCGAMG, PCML, PCHYPRE
@@ -0,0 +1,357 @@
+/*
+     Agglomeration of the coarse level solvers of PCMG onto subcommunicators, see PCMGSetProcEqLim()
+*/
+#include <petsc/private/pcmgimpl.h>
+#include <petsc/private/kspimpl.h>
+#include <petscsf.h>
+
+PETSC_STATIC_INLINE PetscBool PCMGAgglomerate_isActiveRank(PC_MG_Levels *mgl)
+{
+  return (PetscBool)(mgl->aggsubcomm && mgl->aggsubcomm->color == 0);
+}
+
+/*
+   Creates the solver used on the subcommunicator of an agglomerated level, it starts from the configuration of the
+   level smoother on the communicator of the PC and then takes the options with the same prefix
+*/
+static PetscErrorCode PCMGAgglomerateCreateKSP_Private(PC pc,PC_MG_Levels *mgl,KSP ksp,KSP *aksp)
+{
+  PetscErrorCode ierr;
+  MPI_Comm       subcomm = PetscSubcommChild(mgl->aggsubcomm);
+  PetscMPIInt    size;
+  KSPType        ktype;
+  PCType         ptype;
+  KSPNormType    normtype;
+  PC             kpc,apc;
+  PetscReal      rtol,abstol,dtol;
+  PetscInt       maxits;
+  PetscBool      isredundant;
+  const char     *prefix;
+
+  PetscFunctionBegin;
+  ierr = KSPCreate(subcomm,aksp);CHKERRQ(ierr);
+  ierr = KSPSetErrorIfNotConverged(*aksp,pc->erroriffailure);CHKERRQ(ierr);
+  ierr = PetscObjectIncrementTabLevel((PetscObject)*aksp,(PetscObject)pc,mgl->levels-mgl->level);CHKERRQ(ierr);
+  ierr = PetscObjectComposedDataSetInt((PetscObject)*aksp,PetscMGLevelId,mgl->level);CHKERRQ(ierr);
+  ierr = KSPGetOptionsPrefix(ksp,&prefix);CHKERRQ(ierr);
+  ierr = KSPSetOptionsPrefix(*aksp,prefix);CHKERRQ(ierr);
+  ierr = KSPGetType(ksp,&ktype);CHKERRQ(ierr);
+  if (ktype) {ierr = KSPSetType(*aksp,ktype);CHKERRQ(ierr);}
+  ierr = KSPGetTolerances(ksp,&rtol,&abstol,&dtol,&maxits);CHKERRQ(ierr);
+  ierr = KSPSetTolerances(*aksp,rtol,abstol,dtol,maxits);CHKERRQ(ierr);
+  ierr = KSPGetNormType(ksp,&normtype);CHKERRQ(ierr);
+  ierr = KSPSetNormType(*aksp,normtype);CHKERRQ(ierr);
+  if (ksp->converged == KSPConvergedSkip) {ierr = KSPSetConvergenceTest(*aksp,KSPConvergedSkip,NULL,NULL);CHKERRQ(ierr);}
+  ierr = KSPGetPC(ksp,&kpc);CHKERRQ(ierr);
+  ierr = KSPGetPC(*aksp,&apc);CHKERRQ(ierr);
+  ierr = PCGetType(kpc,&ptype);CHKERRQ(ierr);
+  if (ptype) {
+    ierr = MPI_Comm_size(subcomm,&size);CHKERRMPI(ierr);
+    ierr = PetscStrcmp(ptype,PCREDUNDANT,&isredundant);CHKERRQ(ierr);
+    if (isredundant && size == 1) {
+      ierr = PCSetType(apc,PCLU);CHKERRQ(ierr);
+    } else {
+      ierr = PCSetType(apc,ptype);CHKERRQ(ierr);
+    }
+  }
+  if (!mgl->level) {ierr = PCFactorSetShiftType(apc,MAT_SHIFT_INBLOCKS);CHKERRQ(ierr);}
+  ierr = KSPSetFromOptions(*aksp);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+/*
+   Moves the rows [st,ed) of B onto the subcommunicator of the level, the same way PCTELESCOPE does by default
+*/
+static PetscErrorCode PCMGAgglomerateMat_Private(PC_MG_Levels *mgl,Mat B,IS isrow,MatReuse reuse,Mat *Bred)
+{
+  PetscErrorCode ierr;
+  PetscInt       nc,bs,mm;
+  IS             iscol;
+  Mat            Blocal,*_Blocal;
+
+  PetscFunctionBegin;
+  ierr = MatGetSize(B,NULL,&nc);CHKERRQ(ierr);
+  ierr = ISCreateStride(PETSC_COMM_SELF,nc,0,1,&iscol);CHKERRQ(ierr);
+  ierr = ISSetIdentity(iscol);CHKERRQ(ierr);
+  ierr = MatGetBlockSizes(B,NULL,&bs);CHKERRQ(ierr);
+  ierr = ISSetBlockSize(iscol,bs);CHKERRQ(ierr);
+  ierr = MatSetOption(B,MAT_SUBMAT_SINGLEIS,PETSC_TRUE);CHKERRQ(ierr);
+  ierr = MatCreateSubMatrices(B,1,&isrow,&iscol,MAT_INITIAL_MATRIX,&_Blocal);CHKERRQ(ierr);
+  Blocal = *_Blocal;
+  ierr = PetscFree(_Blocal);CHKERRQ(ierr);
+  if (PCMGAgglomerate_isActiveRank(mgl)) {
+    ierr = MatGetSize(Blocal,&mm,NULL);CHKERRQ(ierr);
+    ierr = MatCreateMPIMatConcatenateSeqMat(PetscSubcommChild(mgl->aggsubcomm),Blocal,mm,reuse,Bred);CHKERRQ(ierr);
+  }
+  ierr = ISDestroy(&iscol);CHKERRQ(ierr);
+  ierr = MatDestroy(&Blocal);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+/*
+   Computes the operators of a level smoother that gets them from its DM, as KSPSetUp() does, since the smoother itself is
+   not set up once its level is agglomerated
+*/
+static PetscErrorCode PCMGAgglomerateComputeOperators_Private(KSP ksp)
+{
+  PetscErrorCode ierr;
+  DMKSP          kdm;
+  Mat            A,B;
+  PetscBool      opsset;
+
+  PetscFunctionBegin;
+  if (!ksp->dmActive) PetscFunctionReturn(0);
+  ierr = KSPGetOperatorsSet(ksp,&opsset,NULL);CHKERRQ(ierr);
+  if (!opsset) {
+    ierr = DMCreateMatrix(ksp->dm,&A);CHKERRQ(ierr);
+    ierr = KSPSetOperators(ksp,A,A);CHKERRQ(ierr);
+    ierr = PetscObjectDereference((PetscObject)A);CHKERRQ(ierr);
+  }
+  ierr = DMGetDMKSP(ksp->dm,&kdm);CHKERRQ(ierr);
+  if (!kdm->ops->computeoperators) SETERRQ(PetscObjectComm((PetscObject)ksp),PETSC_ERR_ARG_WRONGSTATE,"You called KSPSetDM() but did not use DMKSPSetComputeOperators() or KSPSetDMActive(ksp,PETSC_FALSE);");
+  ierr = KSPGetOperators(ksp,&A,&B);CHKERRQ(ierr);
+  ierr = (*kdm->ops->computeoperators)(ksp,A,B,kdm->operatorsctx);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+/*
+   Decides which of the coarser levels are agglomerated and (re)builds the subcommunicator, the star forest that moves
+   the level vectors, the redistributed operators and the solvers of those levels.
+
+   A level with M rows is agglomerated onto about M/min_eq_proc processes, every stride-th process of the PC communicator
+   (an interlaced PetscSubcomm) takes the rows of itself and of the next stride-1 processes, so the global numbering of
+   the level is not changed and only neighboring processes exchange data. The level vectors, residuals and transfers
+   stay on the PC communicator, only the level solves run on the subcommunicator.
+*/
+PetscErrorCode PCMGAgglomerateSetUp_Private(PC pc)
+{
+  PC_MG          *mg        = (PC_MG*)pc->data;
+  PC_MG_Levels   **mglevels = mg->levels;
+  PetscErrorCode ierr;
+  MPI_Comm       comm;
+  PetscMPIInt    size,rank;
+  PetscInt       i,k,n = mglevels[0]->levels;
+
+  PetscFunctionBegin;
+  if (mg->min_eq_proc <= 0) PetscFunctionReturn(0);
+  ierr = PetscObjectGetComm((PetscObject)pc,&comm);CHKERRQ(ierr);
+  ierr = MPI_Comm_size(comm,&size);CHKERRMPI(ierr);
+  ierr = MPI_Comm_rank(comm,&rank);CHKERRMPI(ierr);
+  if (size == 1) PetscFunctionReturn(0);
+  for (i=0; i<n-1; i++) {
+    PC_MG_Levels   *mgl = mglevels[i];
+    KSP            ksp = mgl->smoothd;
+    Mat            A,B;
+    PetscLayout    rmap;
+    const PetscInt *range;
+    PetscInt       M,bs,nactive,stride,st,ed,*gidx;
+    PetscBool      flg;
+    MatReuse       reuse = MAT_INITIAL_MATRIX;
+    IS             isrow;
+    Vec            v;
+
+    if (!mgl->aggsubcomm) {
+      /* the operator of a level set up by its DM is not computed yet, only compute it if the level is agglomerated */
+      if (ksp->dmActive) {
+        ierr = DMGetGlobalVector(ksp->dm,&v);CHKERRQ(ierr);
+        ierr = VecGetSize(v,&M);CHKERRQ(ierr);
+        ierr = DMRestoreGlobalVector(ksp->dm,&v);CHKERRQ(ierr);
+      } else {
+        ierr = KSPGetOperators(ksp,NULL,&B);CHKERRQ(ierr);
+        ierr = MatGetSize(B,&M,NULL);CHKERRQ(ierr);
+      }
+      nactive = PetscMax(1,M/mg->min_eq_proc);
+      if (nactive >= size) continue;
+      stride = (size + nactive - 1)/nactive;
+      ierr   = PetscInfo4(pc,"Agglomerating level %D with %D rows onto %D of %d processes\n",i,M,(size + stride - 1)/stride,size);CHKERRQ(ierr);
+      ierr   = PetscSubcommCreate(comm,&mgl->aggsubcomm);CHKERRQ(ierr);
+      ierr   = PetscSubcommSetNumber(mgl->aggsubcomm,stride);CHKERRQ(ierr);
+      ierr   = PetscSubcommSetType(mgl->aggsubcomm,PETSC_SUBCOMM_INTERLACED);CHKERRQ(ierr);
+    } else if (pc->flag == SAME_NONZERO_PATTERN && mgl->aggB) {
+      reuse = MAT_REUSE_MATRIX;
+    } else {
+      ierr = MatDestroy(&mgl->aggA);CHKERRQ(ierr);
+      ierr = MatDestroy(&mgl->aggB);CHKERRQ(ierr);
+    }
+    stride = mgl->aggsubcomm->n;
+
+    ierr = PCMGAgglomerateComputeOperators_Private(ksp);CHKERRQ(ierr);
+    ierr = KSPGetOperators(ksp,&A,&B);CHKERRQ(ierr);
+    ierr = MatHasOperation(B,MATOP_CREATE_SUBMATRICES,&flg);CHKERRQ(ierr);
+    if (flg && A != B) {ierr = MatHasOperation(A,MATOP_CREATE_SUBMATRICES,&flg);CHKERRQ(ierr);}
+    if (!flg) SETERRQ3(comm,PETSC_ERR_SUP,"Cannot agglomerate level %D, its operators of type %s and %s do not provide MatCreateSubMatrices(); use a larger -pc_mg_process_eq_limit or none",i,((PetscObject)A)->type_name,((PetscObject)B)->type_name);
+    ierr = MatGetSize(B,&M,NULL);CHKERRQ(ierr);
+    ierr = MatGetBlockSize(B,&bs);CHKERRQ(ierr);
+    ierr = MatGetLayouts(B,&rmap,NULL);CHKERRQ(ierr);
+    ierr = PetscLayoutGetRanges(rmap,&range);CHKERRQ(ierr);
+
+    /* the rows of this process and of the following stride-1 processes if it is active */
+    st = ed = range[rank];
+    if (PCMGAgglomerate_isActiveRank(mgl)) ed = range[PetscMin(rank+stride,size)];
+    if (!mgl->aggsf) {
+      ierr = PetscMalloc1(ed-st,&gidx);CHKERRQ(ierr);
+      for (k=st; k<ed; k++) gidx[k-st] = k;
+      ierr = PetscSFCreate(comm,&mgl->aggsf);CHKERRQ(ierr);
+      ierr = PetscSFSetGraphLayout(mgl->aggsf,rmap,ed-st,NULL,PETSC_COPY_VALUES,gidx);CHKERRQ(ierr);
+      ierr = PetscSFSetUp(mgl->aggsf);CHKERRQ(ierr);
+      ierr = PetscFree(gidx);CHKERRQ(ierr);
+      if (PCMGAgglomerate_isActiveRank(mgl)) {
+        ierr = VecCreateMPI(PetscSubcommChild(mgl->aggsubcomm),ed-st,M,&mgl->aggb);CHKERRQ(ierr);
+        ierr = VecSetBlockSize(mgl->aggb,bs);CHKERRQ(ierr);
+        ierr = VecDuplicate(mgl->aggb,&mgl->aggx);CHKERRQ(ierr);
+      }
+    }
+
+    ierr = ISCreateStride(comm,ed-st,st,1,&isrow);CHKERRQ(ierr);
+    ierr = ISSetBlockSize(isrow,bs);CHKERRQ(ierr);
+    ierr = PCMGAgglomerateMat_Private(mgl,B,isrow,reuse,&mgl->aggB);CHKERRQ(ierr);
+    if (A != B) {
+      ierr = PCMGAgglomerateMat_Private(mgl,A,isrow,reuse,&mgl->aggA);CHKERRQ(ierr);
+    } else if (reuse == MAT_INITIAL_MATRIX && mgl->aggB) {
+      ierr = PetscObjectReference((PetscObject)mgl->aggB);CHKERRQ(ierr);
+      mgl->aggA = mgl->aggB;
+    }
+    ierr = ISDestroy(&isrow);CHKERRQ(ierr);
+
+    if (PCMGAgglomerate_isActiveRank(mgl)) {
+      if (!mgl->aggsmoothd) {
+        ierr = PCMGAgglomerateCreateKSP_Private(pc,mgl,ksp,&mgl->aggsmoothd);CHKERRQ(ierr);
+        if (mgl->smoothu == mgl->smoothd) mgl->aggsmoothu = mgl->aggsmoothd;
+        else {ierr = PCMGAgglomerateCreateKSP_Private(pc,mgl,mgl->smoothu,&mgl->aggsmoothu);CHKERRQ(ierr);}
+      }
+      ierr = KSPSetOperators(mgl->aggsmoothd,mgl->aggA,mgl->aggB);CHKERRQ(ierr);
+      if (mgl->aggsmoothu != mgl->aggsmoothd) {ierr = KSPSetOperators(mgl->aggsmoothu,mgl->aggA,mgl->aggB);CHKERRQ(ierr);}
+    }
+  }
+  PetscFunctionReturn(0);
+}
+
+PetscErrorCode PCMGAgglomerateReset_Private(PC_MG_Levels *mgl)
+{
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  if (mgl->aggsmoothu != mgl->aggsmoothd) {ierr = KSPDestroy(&mgl->aggsmoothu);CHKERRQ(ierr);}
+  mgl->aggsmoothu = NULL;
+  ierr = KSPDestroy(&mgl->aggsmoothd);CHKERRQ(ierr);
+  ierr = MatDestroy(&mgl->aggA);CHKERRQ(ierr);
+  ierr = MatDestroy(&mgl->aggB);CHKERRQ(ierr);
+  ierr = VecDestroy(&mgl->aggb);CHKERRQ(ierr);
+  ierr = VecDestroy(&mgl->aggx);CHKERRQ(ierr);
+  ierr = PetscSFDestroy(&mgl->aggsf);CHKERRQ(ierr);
+  ierr = PetscSubcommDestroy(&mgl->aggsubcomm);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+/*
+   Sets up the solver that replaces ksp, one of the smoothers of the level, if the level is agglomerated
+*/
+PetscErrorCode PCMGLevelSetUp_Private(PC pc,PC_MG_Levels *mgl,KSP ksp)
+{
+  PetscErrorCode ierr;
+  KSP            aksp = ksp == mgl->smoothd ? mgl->aggsmoothd : mgl->aggsmoothu;
+  PetscBool      failed = PETSC_FALSE;
+
+  PetscFunctionBegin;
+  if (!mgl->aggsf) {
+    ierr = KSPSetUp(ksp);CHKERRQ(ierr);
+    if (ksp->reason == KSP_DIVERGED_PC_FAILED) pc->failedreason = PC_SUBPC_ERROR;
+    PetscFunctionReturn(0);
+  }
+  if (aksp) {
+    ierr   = KSPSetUp(aksp);CHKERRQ(ierr);
+    failed = (PetscBool)(aksp->reason == KSP_DIVERGED_PC_FAILED);
+  }
+  /* the ranks left out of the subcommunicator must see the failure too */
+  ierr = MPIU_Allreduce(MPI_IN_PLACE,&failed,1,MPIU_BOOL,MPI_LOR,PetscObjectComm((PetscObject)pc));CHKERRMPI(ierr);
+  if (failed) pc->failedreason = PC_SUBPC_ERROR;
+  PetscFunctionReturn(0);
+}
+
+/*
+   Applies ksp, one of the smoothers of the level, to b; if the level is agglomerated b (and x for a nonzero initial guess)
+   are moved to the subcommunicator, solved there and x is moved back. The failure of the solve is reduced over the
+   communicator of pc so that all its ranks take the same path, as KSPCheckSolve() does for a level that is not agglomerated
+*/
+PetscErrorCode PCMGLevelSolve_Private(PC pc,PC_MG_Levels *mgl,KSP ksp,PetscBool transpose,Vec b,Vec x)
+{
+  PetscErrorCode    ierr;
+  KSP               aksp;
+  PetscBool         nonzero;
+  const PetscScalar *rarray;
+  PetscScalar       *larray = NULL;
+  PetscMPIInt       reason = 0;  /* the failing KSPConvergedReason of the subcommunicator, 0 if the solve succeeded */
+  PC                apc;
+  PCFailedReason    pcreason;
+
+  PetscFunctionBegin;
+  if (!mgl->aggsf) {
+    if (transpose) {ierr = KSPSolveTranspose(ksp,b,x);CHKERRQ(ierr);}
+    else {ierr = KSPSolve(ksp,b,x);CHKERRQ(ierr);}
+    ierr = KSPCheckSolve(ksp,pc,x);CHKERRQ(ierr);
+    PetscFunctionReturn(0);
+  }
+  aksp = ksp == mgl->smoothd ? mgl->aggsmoothd : mgl->aggsmoothu;
+  ierr = KSPGetInitialGuessNonzero(ksp,&nonzero);CHKERRQ(ierr);
+  ierr = VecGetArrayRead(b,&rarray);CHKERRQ(ierr);
+  if (aksp) {ierr = VecGetArray(mgl->aggb,&larray);CHKERRQ(ierr);}
+  ierr = PetscSFBcastBegin(mgl->aggsf,MPIU_SCALAR,rarray,larray,MPI_REPLACE);CHKERRQ(ierr);
+  ierr = PetscSFBcastEnd(mgl->aggsf,MPIU_SCALAR,rarray,larray,MPI_REPLACE);CHKERRQ(ierr);
+  if (aksp) {ierr = VecRestoreArray(mgl->aggb,&larray);CHKERRQ(ierr);}
+  ierr = VecRestoreArrayRead(b,&rarray);CHKERRQ(ierr);
+  if (nonzero) {
+    ierr = VecGetArrayRead(x,&rarray);CHKERRQ(ierr);
+    if (aksp) {ierr = VecGetArray(mgl->aggx,&larray);CHKERRQ(ierr);}
+    ierr = PetscSFBcastBegin(mgl->aggsf,MPIU_SCALAR,rarray,larray,MPI_REPLACE);CHKERRQ(ierr);
+    ierr = PetscSFBcastEnd(mgl->aggsf,MPIU_SCALAR,rarray,larray,MPI_REPLACE);CHKERRQ(ierr);
+    if (aksp) {ierr = VecRestoreArray(mgl->aggx,&larray);CHKERRQ(ierr);}
+    ierr = VecRestoreArrayRead(x,&rarray);CHKERRQ(ierr);
+  }
+  if (aksp) {
+    ierr = KSPSetInitialGuessNonzero(aksp,nonzero);CHKERRQ(ierr);
+    if (transpose) {ierr = KSPSolveTranspose(aksp,mgl->aggb,mgl->aggx);CHKERRQ(ierr);}
+    else {ierr = KSPSolve(aksp,mgl->aggb,mgl->aggx);CHKERRQ(ierr);}
+    ierr = KSPGetPC(aksp,&apc);CHKERRQ(ierr);
+    ierr = PCGetFailedReason(apc,&pcreason);CHKERRQ(ierr);
+    if (aksp->reason < 0 && aksp->reason != KSP_DIVERGED_ITS) reason = (PetscMPIInt)aksp->reason;
+    else if (pcreason) reason = (PetscMPIInt)KSP_DIVERGED_PC_FAILED;
+    ierr = VecGetArrayRead(mgl->aggx,&rarray);CHKERRQ(ierr);
+  } else rarray = NULL;
+  ierr = VecGetArray(x,&larray);CHKERRQ(ierr);
+  ierr = PetscSFReduceBegin(mgl->aggsf,MPIU_SCALAR,rarray,larray,MPI_REPLACE);CHKERRQ(ierr);
+  ierr = PetscSFReduceEnd(mgl->aggsf,MPIU_SCALAR,rarray,larray,MPI_REPLACE);CHKERRQ(ierr);
+  ierr = VecRestoreArray(x,&larray);CHKERRQ(ierr);
+  if (aksp) {ierr = VecRestoreArrayRead(mgl->aggx,&rarray);CHKERRQ(ierr);}
+  ierr = MPIU_Allreduce(MPI_IN_PLACE,&reason,1,MPI_INT,MPI_MIN,PetscObjectComm((PetscObject)pc));CHKERRMPI(ierr);
+  if (reason) {
+    if (pc->erroriffailure) SETERRQ1(PetscObjectComm((PetscObject)pc),PETSC_ERR_NOT_CONVERGED,"Detected not converged in KSP inner solve of an agglomerated level: KSP reason %s",KSPConvergedReasons[reason]);
+    ierr = PetscInfo1(pc,"Detected not converged in KSP inner solve of an agglomerated level: KSP reason %s\n",KSPConvergedReasons[reason]);CHKERRQ(ierr);
+    pc->failedreason = PC_SUBPC_ERROR;
+    ierr = VecSetInf(x);CHKERRQ(ierr);
+  }
+  PetscFunctionReturn(0);
+}
+
+/*
+   Views the solver of an agglomerated level on its subcommunicator
+*/
+PetscErrorCode PCMGLevelView_Private(PC pc,PC_MG_Levels *mgl,KSP ksp,PetscViewer viewer)
+{
+  PetscErrorCode ierr;
+  PetscMPIInt    size,subsize;
+  PetscViewer    subviewer;
+  KSP            aksp = ksp == mgl->smoothd ? mgl->aggsmoothd : mgl->aggsmoothu;
+
+  PetscFunctionBegin;
+  if (!mgl->aggsf) {
+    ierr = KSPView(ksp,viewer);CHKERRQ(ierr);
+    PetscFunctionReturn(0);
+  }
+  ierr = MPI_Comm_size(PetscObjectComm((PetscObject)pc),&size);CHKERRMPI(ierr);
+  ierr = MPI_Comm_size(PetscSubcommChild(mgl->aggsubcomm),&subsize);CHKERRMPI(ierr);
+  ierr = PetscViewerASCIIPrintf(viewer,"agglomerated onto %d of %d processes\n",(int)subsize,(int)size);CHKERRQ(ierr);
+  ierr = PetscViewerGetSubViewer(viewer,PetscSubcommChild(mgl->aggsubcomm),&subviewer);CHKERRQ(ierr);
+  if (aksp) {ierr = KSPView(aksp,subviewer);CHKERRQ(ierr);}
+  ierr = PetscViewerRestoreSubViewer(viewer,PetscSubcommChild(mgl->aggsubcomm),&subviewer);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
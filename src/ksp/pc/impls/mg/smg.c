@@ -1,6 +1,6 @@
 
 /*
-     Additive Multigrid V Cycle routine
+     Additive and mult-additive Multigrid V Cycle routines
 */
 #include <petsc/private/pcmgimpl.h>
 
@@ -39,13 +39,11 @@ PetscErrorCode PCMGACycle_Private(PC pc,PC_MG_Levels **mglevels,PetscBool transp
         ierr = KSPMatSolve(mglevels[i]->smoothd,mglevels[i]->B,mglevels[i]->X);CHKERRQ(ierr);
         ierr = KSPCheckSolve(mglevels[i]->smoothd,pc,NULL);CHKERRQ(ierr);
       } else {
-        ierr = KSPSolve(mglevels[i]->smoothd,mglevels[i]->b,mglevels[i]->x);CHKERRQ(ierr);
-        ierr = KSPCheckSolve(mglevels[i]->smoothd,pc,mglevels[i]->x);CHKERRQ(ierr);
+        ierr = PCMGLevelSolve_Private(pc,mglevels[i],mglevels[i]->smoothd,PETSC_FALSE,mglevels[i]->b,mglevels[i]->x);CHKERRQ(ierr);
       }
     } else {
       if (matapp) SETERRQ(PetscObjectComm((PetscObject)pc),PETSC_ERR_SUP,"Not supported");
-      ierr = KSPSolveTranspose(mglevels[i]->smoothu,mglevels[i]->b,mglevels[i]->x);CHKERRQ(ierr);
-      ierr = KSPCheckSolve(mglevels[i]->smoothu,pc,mglevels[i]->x);CHKERRQ(ierr);
+      ierr = PCMGLevelSolve_Private(pc,mglevels[i],mglevels[i]->smoothu,PETSC_TRUE,mglevels[i]->b,mglevels[i]->x);CHKERRQ(ierr);
     }
     if (mglevels[i]->eventsmoothsolve) {ierr = PetscLogEventEnd(mglevels[i]->eventsmoothsolve,0,0,0,0);CHKERRQ(ierr);}
   }
@@ -62,3 +60,130 @@ PetscErrorCode PCMGACycle_Private(PC pc,PC_MG_Levels **mglevels,PetscBool transp
   }
   PetscFunctionReturn(0);
 }
+
+/*
+   Computes the inverse l1 row sums of the operator on each level but the coarsest, used by the mult-additive cycle
+   to smooth the transfer operators
+*/
+PetscErrorCode PCMGMultAdditiveSetUp_Private(PC pc,PC_MG_Levels **mglevels)
+{
+  PetscErrorCode    ierr;
+  PetscInt          i,j,row,rstart,rend,ncols,l = mglevels[0]->levels;
+  const PetscScalar *vals;
+  PetscScalar       *d;
+  PetscBool         flg;
+  Mat               A;
+
+  PetscFunctionBegin;
+  for (i=1; i<l; i++) {
+    A    = mglevels[i]->A;
+    ierr = MatHasOperation(A,MATOP_GET_ROW,&flg);CHKERRQ(ierr);
+    if (!flg) SETERRQ2(PetscObjectComm((PetscObject)pc),PETSC_ERR_SUP,"Mult-additive multigrid requires MatGetRow() for the operator on level %D, matrix type %s",i,((PetscObject)A)->type_name);
+    if (!mglevels[i]->l1inv) {
+      ierr = VecDuplicate(mglevels[i]->r,&mglevels[i]->l1inv);CHKERRQ(ierr);
+      ierr = VecDuplicate(mglevels[i]->r,&mglevels[i]->work);CHKERRQ(ierr);
+    }
+    ierr = MatGetOwnershipRange(A,&rstart,&rend);CHKERRQ(ierr);
+    ierr = VecGetArray(mglevels[i]->l1inv,&d);CHKERRQ(ierr);
+    for (row=rstart; row<rend; row++) {
+      ierr = MatGetRow(A,row,&ncols,NULL,&vals);CHKERRQ(ierr);
+      d[row-rstart] = 0.0;
+      for (j=0; j<ncols; j++) d[row-rstart] += PetscAbsScalar(vals[j]);
+      ierr = MatRestoreRow(A,row,&ncols,NULL,&vals);CHKERRQ(ierr);
+    }
+    ierr = VecRestoreArray(mglevels[i]->l1inv,&d);CHKERRQ(ierr);
+    ierr = VecReciprocal(mglevels[i]->l1inv);CHKERRQ(ierr);
+  }
+  PetscFunctionReturn(0);
+}
+
+/*
+     Mult-additive multigrid cycle of Vassilevski and Yang: the restriction and interpolation are smoothed with
+   l1-Jacobi, Pbar = (I - D^{-1} A) P, so the solves on the different levels only depend on the restricted
+   right hand sides. This is a sequential implementation, the levels are solved one after the other.
+   The transpose restricts with P^T (I - A^T D^{-1}) and interpolates with (I - D^{-1} A^T) R^T
+*/
+PetscErrorCode PCMGMultAdditiveCycle_Private(PC pc,PC_MG_Levels **mglevels,PetscBool transpose,PetscBool matapp)
+{
+  PetscErrorCode ierr;
+  PetscInt       i,l = mglevels[0]->levels;
+
+  PetscFunctionBegin;
+  if (transpose && matapp) SETERRQ(PetscObjectComm((PetscObject)pc),PETSC_ERR_SUP,"Not supported");
+  /* compute RHS on each level with the smoothed restriction Pbar^T = P^T (I - A D^{-1}), X holds D^{-1} B meanwhile */
+  for (i=l-1; i>0; i--) {
+    if (mglevels[i]->eventinterprestrict) {ierr = PetscLogEventBegin(mglevels[i]->eventinterprestrict,0,0,0,0);CHKERRQ(ierr);}
+    if (matapp) {
+      if (!mglevels[i]->X) {
+        ierr = MatDuplicate(mglevels[i]->B,MAT_COPY_VALUES,&mglevels[i]->X);CHKERRQ(ierr);
+      } else {
+        ierr = MatCopy(mglevels[i]->B,mglevels[i]->X,SAME_NONZERO_PATTERN);CHKERRQ(ierr);
+      }
+      if (!mglevels[i]->R) {
+        ierr = MatDuplicate(mglevels[i]->B,MAT_DO_NOT_COPY_VALUES,&mglevels[i]->R);CHKERRQ(ierr);
+      }
+      ierr = MatDiagonalScale(mglevels[i]->X,mglevels[i]->l1inv,NULL);CHKERRQ(ierr);
+      ierr = (*mglevels[i]->matresidual)(mglevels[i]->A,mglevels[i]->B,mglevels[i]->X,mglevels[i]->R);CHKERRQ(ierr);
+      ierr = MatMatRestrict(mglevels[i]->restrct,mglevels[i]->R,&mglevels[i-1]->B);CHKERRQ(ierr);
+    } else if (!transpose) {
+      ierr = VecPointwiseMult(mglevels[i]->r,mglevels[i]->l1inv,mglevels[i]->b);CHKERRQ(ierr);
+      ierr = MatMult(mglevels[i]->A,mglevels[i]->r,mglevels[i]->work);CHKERRQ(ierr);
+      ierr = VecWAXPY(mglevels[i]->r,-1.0,mglevels[i]->work,mglevels[i]->b);CHKERRQ(ierr);
+      ierr = MatRestrict(mglevels[i]->restrct,mglevels[i]->r,mglevels[i-1]->b);CHKERRQ(ierr);
+    } else {
+      ierr = VecPointwiseMult(mglevels[i]->r,mglevels[i]->l1inv,mglevels[i]->b);CHKERRQ(ierr);
+      ierr = MatMultTranspose(mglevels[i]->A,mglevels[i]->r,mglevels[i]->work);CHKERRQ(ierr);
+      ierr = VecWAXPY(mglevels[i]->r,-1.0,mglevels[i]->work,mglevels[i]->b);CHKERRQ(ierr);
+      ierr = MatRestrict(mglevels[i]->interpolate,mglevels[i]->r,mglevels[i-1]->b);CHKERRQ(ierr);
+    }
+    if (mglevels[i]->eventinterprestrict) {ierr = PetscLogEventEnd(mglevels[i]->eventinterprestrict,0,0,0,0);CHKERRQ(ierr);}
+  }
+  /* solve separately on each level */
+  for (i=0; i<l; i++) {
+    if (matapp) {
+      if (!mglevels[i]->X) {
+        ierr = MatDuplicate(mglevels[i]->B,MAT_DO_NOT_COPY_VALUES,&mglevels[i]->X);CHKERRQ(ierr);
+      } else {
+        ierr = MatZeroEntries(mglevels[i]->X);CHKERRQ(ierr);
+      }
+    } else {
+      ierr = VecZeroEntries(mglevels[i]->x);CHKERRQ(ierr);
+    }
+    if (mglevels[i]->eventsmoothsolve) {ierr = PetscLogEventBegin(mglevels[i]->eventsmoothsolve,0,0,0,0);CHKERRQ(ierr);}
+    if (matapp) {
+      ierr = KSPMatSolve(mglevels[i]->smoothd,mglevels[i]->B,mglevels[i]->X);CHKERRQ(ierr);
+      ierr = KSPCheckSolve(mglevels[i]->smoothd,pc,NULL);CHKERRQ(ierr);
+    } else if (!transpose) {
+      ierr = PCMGLevelSolve_Private(pc,mglevels[i],mglevels[i]->smoothd,PETSC_FALSE,mglevels[i]->b,mglevels[i]->x);CHKERRQ(ierr);
+    } else {
+      ierr = PCMGLevelSolve_Private(pc,mglevels[i],mglevels[i]->smoothu,PETSC_TRUE,mglevels[i]->b,mglevels[i]->x);CHKERRQ(ierr);
+    }
+    if (mglevels[i]->eventsmoothsolve) {ierr = PetscLogEventEnd(mglevels[i]->eventsmoothsolve,0,0,0,0);CHKERRQ(ierr);}
+  }
+  /* add the corrections with the smoothed interpolation Pbar = (I - D^{-1} A) P */
+  for (i=1; i<l; i++) {
+    if (mglevels[i]->eventinterprestrict) {ierr = PetscLogEventBegin(mglevels[i]->eventinterprestrict,0,0,0,0);CHKERRQ(ierr);}
+    if (matapp) {
+      ierr = MatMatInterpolate(mglevels[i]->interpolate,mglevels[i-1]->X,&mglevels[i]->R);CHKERRQ(ierr);
+      if (!mglevels[i]->W) {
+        ierr = MatDuplicate(mglevels[i]->R,MAT_DO_NOT_COPY_VALUES,&mglevels[i]->W);CHKERRQ(ierr);
+      }
+      ierr = MatMatMult(mglevels[i]->A,mglevels[i]->R,MAT_REUSE_MATRIX,PETSC_DEFAULT,&mglevels[i]->W);CHKERRQ(ierr);
+      ierr = MatDiagonalScale(mglevels[i]->W,mglevels[i]->l1inv,NULL);CHKERRQ(ierr);
+      ierr = MatAXPY(mglevels[i]->X,1.0,mglevels[i]->R,SAME_NONZERO_PATTERN);CHKERRQ(ierr);
+      ierr = MatAXPY(mglevels[i]->X,-1.0,mglevels[i]->W,SAME_NONZERO_PATTERN);CHKERRQ(ierr);
+    } else if (!transpose) {
+      ierr = MatInterpolate(mglevels[i]->interpolate,mglevels[i-1]->x,mglevels[i]->r);CHKERRQ(ierr);
+      ierr = MatMult(mglevels[i]->A,mglevels[i]->r,mglevels[i]->work);CHKERRQ(ierr);
+      ierr = VecPointwiseMult(mglevels[i]->work,mglevels[i]->l1inv,mglevels[i]->work);CHKERRQ(ierr);
+      ierr = VecAXPBYPCZ(mglevels[i]->x,1.0,-1.0,1.0,mglevels[i]->r,mglevels[i]->work);CHKERRQ(ierr);
+    } else {
+      ierr = MatInterpolate(mglevels[i]->restrct,mglevels[i-1]->x,mglevels[i]->r);CHKERRQ(ierr);
+      ierr = MatMultTranspose(mglevels[i]->A,mglevels[i]->r,mglevels[i]->work);CHKERRQ(ierr);
+      ierr = VecPointwiseMult(mglevels[i]->work,mglevels[i]->l1inv,mglevels[i]->work);CHKERRQ(ierr);
+      ierr = VecAXPBYPCZ(mglevels[i]->x,1.0,-1.0,1.0,mglevels[i]->r,mglevels[i]->work);CHKERRQ(ierr);
+    }
+    if (mglevels[i]->eventinterprestrict) {ierr = PetscLogEventEnd(mglevels[i]->eventinterprestrict,0,0,0,0);CHKERRQ(ierr);}
+  }
+  PetscFunctionReturn(0);
+}
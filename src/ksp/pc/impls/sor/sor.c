@@ -9,6 +9,7 @@ typedef struct {
   MatSORType sym;         /* forward, reverse, symmetric etc. */
   PetscReal  omega;
   PetscReal  fshift;
+  PetscBool  multicolor;  /* sweep color by color with the rows of a color updated simultaneously */
 } PC_SOR;
 
 static PetscErrorCode PCDestroy_SOR(PC pc)
@@ -24,7 +25,7 @@ static PetscErrorCode PCApply_SOR(PC pc,Vec x,Vec y)
 {
   PC_SOR         *jac = (PC_SOR*)pc->data;
   PetscErrorCode ierr;
-  PetscInt       flag = jac->sym | SOR_ZERO_INITIAL_GUESS;
+  PetscInt       flag = jac->sym | SOR_ZERO_INITIAL_GUESS | (jac->multicolor ? SOR_MULTICOLOR : 0);
 
   PetscFunctionBegin;
   ierr = MatSOR(pc->pmat,x,jac->omega,(MatSORType)flag,jac->fshift,jac->its,jac->lits,y);CHKERRQ(ierr);
@@ -36,7 +37,7 @@ static PetscErrorCode PCApplyTranspose_SOR(PC pc,Vec x,Vec y)
 {
   PC_SOR         *jac = (PC_SOR*)pc->data;
   PetscErrorCode ierr;
-  PetscInt       flag = jac->sym | SOR_ZERO_INITIAL_GUESS;
+  PetscInt       flag = jac->sym | SOR_ZERO_INITIAL_GUESS | (jac->multicolor ? SOR_MULTICOLOR : 0);
   PetscBool      set,sym;
 
   PetscFunctionBegin;
@@ -56,6 +57,7 @@ static PetscErrorCode PCApplyRichardson_SOR(PC pc,Vec b,Vec y,Vec w,PetscReal rt
   PetscFunctionBegin;
   ierr = PetscInfo1(pc,"Warning, convergence critera ignored, using %D iterations\n",its);CHKERRQ(ierr);
   if (guesszero) stype = (MatSORType) (stype | SOR_ZERO_INITIAL_GUESS);
+  if (jac->multicolor) stype = (MatSORType) (stype | SOR_MULTICOLOR);
   ierr = MatSOR(pc->pmat,b,jac->omega,stype,jac->fshift,its*jac->its,jac->lits,y);CHKERRQ(ierr);
   ierr = MatFactorGetError(pc->pmat,(MatFactorError*)&pc->failedreason);CHKERRQ(ierr);
   *outits = its;
@@ -75,6 +77,7 @@ PetscErrorCode PCSetFromOptions_SOR(PetscOptionItems *PetscOptionsObject,PC pc)
   ierr = PetscOptionsReal("-pc_sor_diagonal_shift","Add to the diagonal entries","",jac->fshift,&jac->fshift,NULL);CHKERRQ(ierr);
   ierr = PetscOptionsInt("-pc_sor_its","number of inner SOR iterations","PCSORSetIterations",jac->its,&jac->its,NULL);CHKERRQ(ierr);
   ierr = PetscOptionsInt("-pc_sor_lits","number of local inner SOR iterations","PCSORSetIterations",jac->lits,&jac->lits,NULL);CHKERRQ(ierr);
+  ierr = PetscOptionsBool("-pc_sor_multicolor","sweep over the colors of a coloring of the matrix, updating the rows of a color with threads","PCSORSetMultiColor",jac->multicolor,&jac->multicolor,NULL);CHKERRQ(ierr);
   ierr = PetscOptionsBoolGroupBegin("-pc_sor_symmetric","SSOR, not SOR","PCSORSetSymmetric",&flg);CHKERRQ(ierr);
   if (flg) {ierr = PCSORSetSymmetric(pc,SOR_SYMMETRIC_SWEEP);CHKERRQ(ierr);}
   ierr = PetscOptionsBoolGroup("-pc_sor_backward","use backward sweep instead of forward","PCSORSetSymmetric",&flg);CHKERRQ(ierr);
@@ -114,6 +117,7 @@ PetscErrorCode PCView_SOR(PC pc,PetscViewer viewer)
     else if (sym & SOR_LOCAL_BACKWARD_SWEEP)                                 sortype = "local_backward";
     else                                                                     sortype = "unknown";
     ierr = PetscViewerASCIIPrintf(viewer,"  type = %s, iterations = %D, local iterations = %D, omega = %g\n",sortype,jac->its,jac->lits,(double)jac->omega);CHKERRQ(ierr);
+    if (jac->multicolor) {ierr = PetscViewerASCIIPrintf(viewer,"  multicolor sweeps\n");CHKERRQ(ierr);}
   }
   PetscFunctionReturn(0);
 }
@@ -148,6 +152,24 @@ static PetscErrorCode  PCSORSetIterations_SOR(PC pc,PetscInt its,PetscInt lits)
   PetscFunctionReturn(0);
 }
 
+static PetscErrorCode  PCSORSetMultiColor_SOR(PC pc,PetscBool flg)
+{
+  PC_SOR *jac = (PC_SOR*)pc->data;
+
+  PetscFunctionBegin;
+  jac->multicolor = flg;
+  PetscFunctionReturn(0);
+}
+
+static PetscErrorCode  PCSORGetMultiColor_SOR(PC pc,PetscBool *flg)
+{
+  PC_SOR *jac = (PC_SOR*)pc->data;
+
+  PetscFunctionBegin;
+  *flg = jac->multicolor;
+  PetscFunctionReturn(0);
+}
+
 static PetscErrorCode  PCSORGetSymmetric_SOR(PC pc,MatSORType *flag)
 {
   PC_SOR *jac = (PC_SOR*)pc->data;
@@ -396,6 +418,68 @@ PetscErrorCode  PCSORSetIterations(PC pc,PetscInt its,PetscInt lits)
   PetscFunctionReturn(0);
 }
 
+/*@
+   PCSORSetMultiColor - Sets the SOR preconditioner to sweep over the colors of a coloring of the (local) matrix,
+   updating the rows of each color simultaneously with the OpenMP threads; multicolor Gauss-Seidel.
+
+   Logically Collective on PC
+
+   Input Parameters:
++  pc - the preconditioner context
+-  flg - PETSC_TRUE to use multicolor sweeps
+
+   Options Database Key:
+.  -pc_sor_multicolor - Activates multicolor sweeps
+
+   Notes:
+   Only the AIJ and BAIJ formats support multicolor sweeps, see SOR_MULTICOLOR in MatSOR(). The coloring is
+   computed on the first application and kept until the nonzero structure of the matrix changes; it can be
+   customized with the MatColoring options under the prefix -sor_ of the matrix, for example -sor_mat_coloring_type jp.
+
+   The rows are visited in a different order than with the standard sweeps, so the convergence of the smoother
+   may differ, but the result does not depend on the number of threads.
+
+   Level: intermediate
+
+.seealso: PCSORGetMultiColor(), PCSORSetSymmetric(), MatSOR(), MatColoring
+@*/
+PetscErrorCode  PCSORSetMultiColor(PC pc,PetscBool flg)
+{
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  PetscValidHeaderSpecific(pc,PC_CLASSID,1);
+  PetscValidLogicalCollectiveBool(pc,flg,2);
+  ierr = PetscTryMethod(pc,"PCSORSetMultiColor_C",(PC,PetscBool),(pc,flg));CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+/*@
+   PCSORGetMultiColor - Gets whether the SOR preconditioner uses multicolor sweeps
+
+   Not Collective
+
+   Input Parameter:
+.  pc - the preconditioner context
+
+   Output Parameter:
+.  flg - PETSC_TRUE if multicolor sweeps are used
+
+   Level: intermediate
+
+.seealso: PCSORSetMultiColor()
+@*/
+PetscErrorCode  PCSORGetMultiColor(PC pc,PetscBool *flg)
+{
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  PetscValidHeaderSpecific(pc,PC_CLASSID,1);
+  PetscValidBoolPointer(flg,2);
+  ierr = PetscUseMethod(pc,"PCSORGetMultiColor_C",(PC,PetscBool*),(pc,flg));CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
 /*MC
      PCSOR - (S)SOR (successive over relaxation, Gauss-Seidel) preconditioning
 
@@ -409,7 +493,8 @@ PetscErrorCode  PCSORSetIterations(PC pc,PetscInt its,PetscInt lits)
 .  -pc_sor_omega <omega> - Sets omega
 .  -pc_sor_diagonal_shift <shift> - shift the diagonal entries; useful if the matrix has zeros on the diagonal
 .  -pc_sor_its <its> - Sets number of iterations   (default 1)
--  -pc_sor_lits <lits> - Sets number of local iterations  (default 1)
+.  -pc_sor_lits <lits> - Sets number of local iterations  (default 1)
+-  -pc_sor_multicolor - Sweeps color by color, updating the rows of a color simultaneously with threads
 
    Level: beginner
 
@@ -433,8 +518,12 @@ PetscErrorCode  PCSORSetIterations(PC pc,PetscInt its,PetscInt lits)
 
           If omega != 1, you will need to set the MAT_USE_INODES option to PETSC_FALSE on the matrix.
 
+          With -pc_sor_multicolor the AIJ and BAIJ formats sweep over the colors of a coloring of the local matrix and
+          update the rows of each color with the OpenMP threads (see -omp_num_threads); multicolor sweeps of AIJ matrices
+          are pointwise, even with inodes.
+
 .seealso:  PCCreate(), PCSetType(), PCType (for list of available types), PC,
-           PCSORSetIterations(), PCSORSetSymmetric(), PCSORSetOmega(), PCEISENSTAT, MatSetOption()
+           PCSORSetIterations(), PCSORSetSymmetric(), PCSORSetOmega(), PCSORSetMultiColor(), PCEISENSTAT, MatSetOption()
 M*/
 
 PETSC_EXTERN PetscErrorCode PCCreate_SOR(PC pc)
@@ -465,5 +554,7 @@ PETSC_EXTERN PetscErrorCode PCCreate_SOR(PC pc)
   ierr = PetscObjectComposeFunction((PetscObject)pc,"PCSORGetSymmetric_C",PCSORGetSymmetric_SOR);CHKERRQ(ierr);
   ierr = PetscObjectComposeFunction((PetscObject)pc,"PCSORGetOmega_C",PCSORGetOmega_SOR);CHKERRQ(ierr);
   ierr = PetscObjectComposeFunction((PetscObject)pc,"PCSORGetIterations_C",PCSORGetIterations_SOR);CHKERRQ(ierr);
+  ierr = PetscObjectComposeFunction((PetscObject)pc,"PCSORSetMultiColor_C",PCSORSetMultiColor_SOR);CHKERRQ(ierr);
+  ierr = PetscObjectComposeFunction((PetscObject)pc,"PCSORGetMultiColor_C",PCSORGetMultiColor_SOR);CHKERRQ(ierr);
   PetscFunctionReturn(0);
 }
@@ -6,11 +6,32 @@
 
 #include <petsc/private/pcimpl.h>   /*I "petscpc.h" I*/
 
+/*
+   Number of blocks of the same size applied together; the inverses of the blocks of a group are interleaved
+   so that each entry of the inverses is a contiguous vector of this length
+*/
+#define PC_VPBJACOBI_LANES 8
+
+#if defined(PETSC_USE_REAL_DOUBLE) && !defined(PETSC_USE_COMPLEX)
+#define PC_VPBJACOBI_MIXED_PRECISION
+#endif
+
 /*
    Private context (data structure) for the VPBJacobi preconditioner.
 */
 typedef struct {
   MatScalar *diag;
+  PetscInt  nblocks,*bsizes;          /* the local block sizes of the last setup, the storage is reused while they do not change */
+  PetscBool batched;                  /* apply the blocks grouped by size with the interleaved inverses */
+  PetscBool mixed;                    /* store the interleaved inverses in single precision */
+  PetscInt  nsizes;                   /* number of different block sizes */
+  PetscInt  *sizes,*counts;           /* each block size and the number of blocks of that size */
+  PetscInt  *rstarts,*dstarts;        /* start of the blocks of each size in rows and in bdiag or fdiag */
+  PetscInt  *rows;                    /* first row of each block, grouped by size and padded to a multiple of PC_VPBJACOBI_LANES */
+  MatScalar *bdiag;                   /* interleaved inverses */
+#if defined(PC_VPBJACOBI_MIXED_PRECISION)
+  float     *fdiag;                   /* interleaved inverses in single precision */
+#endif
 } PC_VPBJacobi;
 
 static PetscErrorCode PCApply_VPBJacobi(PC pc,Vec x,Vec y)
@@ -97,6 +118,213 @@ static PetscErrorCode PCApply_VPBJacobi(PC pc,Vec x,Vec y)
   PetscFunctionReturn(0);
 }
 
+/*
+   Applies the inverses of PC_VPBJACOBI_LANES blocks of size bs, the padding lanes repeat the row of a block
+   and have zero inverses; only the first nl lanes are stored. The entries of x of the blocks are first gathered
+   into the interleaved layout of the inverses, unless the blocks are larger than PC_VPBJACOBI_GATHER_BS.
+*/
+#define PC_VPBJACOBI_GATHER_BS 16
+
+PETSC_STATIC_INLINE void PCVPBJacobiApplyGroup_Private(PetscInt bs,PetscInt nl,const PetscInt *rows,const MatScalar *d,const PetscScalar *xx,PetscScalar *yy)
+{
+  PetscInt    r,c,l;
+  PetscScalar yl[PC_VPBJACOBI_LANES],xl[PC_VPBJACOBI_GATHER_BS*PC_VPBJACOBI_LANES];
+
+  if (bs <= PC_VPBJACOBI_GATHER_BS) {
+    for (c=0; c<bs; c++) {
+      for (l=0; l<PC_VPBJACOBI_LANES; l++) xl[c*PC_VPBJACOBI_LANES+l] = xx[rows[l]+c];
+    }
+  }
+  for (r=0; r<bs; r++) {
+    for (l=0; l<PC_VPBJACOBI_LANES; l++) yl[l] = 0.0;
+    if (bs <= PC_VPBJACOBI_GATHER_BS) {
+      for (c=0; c<bs; c++) {
+        const MatScalar   *dc = d + (r+c*bs)*PC_VPBJACOBI_LANES;
+        const PetscScalar *xc = xl + c*PC_VPBJACOBI_LANES;
+        PetscPragmaSIMD
+        for (l=0; l<PC_VPBJACOBI_LANES; l++) yl[l] += dc[l]*xc[l];
+      }
+    } else {
+      for (c=0; c<bs; c++) {
+        const MatScalar *dc = d + (r+c*bs)*PC_VPBJACOBI_LANES;
+        for (l=0; l<PC_VPBJACOBI_LANES; l++) yl[l] += dc[l]*xx[rows[l]+c];
+      }
+    }
+    for (l=0; l<nl; l++) yy[rows[l]+r] = yl[l];
+  }
+}
+
+#if defined(PC_VPBJACOBI_MIXED_PRECISION)
+PETSC_STATIC_INLINE void PCVPBJacobiApplyGroup_Single_Private(PetscInt bs,PetscInt nl,const PetscInt *rows,const float *d,const PetscScalar *xx,PetscScalar *yy)
+{
+  PetscInt    r,c,l;
+  PetscScalar yl[PC_VPBJACOBI_LANES],xl[PC_VPBJACOBI_GATHER_BS*PC_VPBJACOBI_LANES];
+
+  if (bs <= PC_VPBJACOBI_GATHER_BS) {
+    for (c=0; c<bs; c++) {
+      for (l=0; l<PC_VPBJACOBI_LANES; l++) xl[c*PC_VPBJACOBI_LANES+l] = xx[rows[l]+c];
+    }
+  }
+  for (r=0; r<bs; r++) {
+    for (l=0; l<PC_VPBJACOBI_LANES; l++) yl[l] = 0.0;
+    if (bs <= PC_VPBJACOBI_GATHER_BS) {
+      for (c=0; c<bs; c++) {
+        const float       *dc = d + (r+c*bs)*PC_VPBJACOBI_LANES;
+        const PetscScalar *xc = xl + c*PC_VPBJACOBI_LANES;
+        PetscPragmaSIMD
+        for (l=0; l<PC_VPBJACOBI_LANES; l++) yl[l] += (PetscScalar)dc[l]*xc[l];
+      }
+    } else {
+      for (c=0; c<bs; c++) {
+        const float *dc = d + (r+c*bs)*PC_VPBJACOBI_LANES;
+        for (l=0; l<PC_VPBJACOBI_LANES; l++) yl[l] += (PetscScalar)dc[l]*xx[rows[l]+c];
+      }
+    }
+    for (l=0; l<nl; l++) yy[rows[l]+r] = yl[l];
+  }
+}
+#endif
+
+static PetscErrorCode PCApply_VPBJacobi_Batched(PC pc,Vec x,Vec y)
+{
+  PC_VPBJacobi      *jac = (PC_VPBJacobi*)pc->data;
+  PetscErrorCode    ierr;
+  PetscInt          k,g,bs,nb,ng;
+  PetscLogDouble    nflops = 0;
+  const PetscInt    *rows;
+  const PetscScalar *xx;
+  PetscScalar       *yy;
+
+  PetscFunctionBegin;
+  ierr = VecGetArrayRead(x,&xx);CHKERRQ(ierr);
+  ierr = VecGetArrayWrite(y,&yy);CHKERRQ(ierr);
+  for (k=0; k<jac->nsizes; k++) {
+    bs   = jac->sizes[k];
+    nb   = jac->counts[k];
+    ng   = (nb+PC_VPBJACOBI_LANES-1)/PC_VPBJACOBI_LANES;
+    rows = jac->rows + jac->rstarts[k];
+#if defined(PC_VPBJACOBI_MIXED_PRECISION)
+    if (jac->mixed) {
+      const float *d = jac->fdiag + jac->dstarts[k];
+#if defined(PETSC_HAVE_OPENMP)
+#pragma omp parallel for schedule(static) num_threads((int)PetscMax(PetscNumOMPThreads,1))
+#endif
+      for (g=0; g<ng; g++) PCVPBJacobiApplyGroup_Single_Private(bs,PetscMin(PC_VPBJACOBI_LANES,nb-g*PC_VPBJACOBI_LANES),rows+g*PC_VPBJACOBI_LANES,d+g*bs*bs*PC_VPBJACOBI_LANES,xx,yy);
+    } else
+#endif
+    {
+      const MatScalar *d = jac->bdiag + jac->dstarts[k];
+#if defined(PETSC_HAVE_OPENMP)
+#pragma omp parallel for schedule(static) num_threads((int)PetscMax(PetscNumOMPThreads,1))
+#endif
+      for (g=0; g<ng; g++) PCVPBJacobiApplyGroup_Private(bs,PetscMin(PC_VPBJACOBI_LANES,nb-g*PC_VPBJACOBI_LANES),rows+g*PC_VPBJACOBI_LANES,d+g*bs*bs*PC_VPBJACOBI_LANES,xx,yy);
+    }
+    nflops += (2*bs-1)*bs*nb;
+  }
+  ierr = PetscLogFlops(nflops);CHKERRQ(ierr);
+  ierr = VecRestoreArrayRead(x,&xx);CHKERRQ(ierr);
+  ierr = VecRestoreArrayWrite(y,&yy);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+/*
+   Groups the blocks by size and copies their inverses from diag, where they are stored one after the other
+   in column major order, to the interleaved storage
+*/
+static PetscErrorCode PCVPBJacobiSetUpBatched_Private(PC pc,PetscInt nblocks,const PetscInt *bsizes)
+{
+  PC_VPBJacobi   *jac = (PC_VPBJacobi*)pc->data;
+  PetscErrorCode ierr;
+  PetscInt       i,j,k,bs,bsmax = 0,p,g,l,ncnt,*kind,*pos,nrows,ndiag;
+  const MatScalar *diag;
+
+  PetscFunctionBegin;
+  if (!jac->sizes) {
+    for (i=0; i<nblocks; i++) bsmax = PetscMax(bsmax,bsizes[i]);
+    ierr = PetscCalloc2(bsmax+1,&kind,bsmax+1,&pos);CHKERRQ(ierr);
+    for (i=0; i<nblocks; i++) pos[bsizes[i]]++;
+    jac->nsizes = 0;
+    for (bs=0; bs<=bsmax; bs++) if (pos[bs]) jac->nsizes++;
+    ierr = PetscMalloc4(jac->nsizes,&jac->sizes,jac->nsizes,&jac->counts,jac->nsizes+1,&jac->rstarts,jac->nsizes+1,&jac->dstarts);CHKERRQ(ierr);
+    jac->rstarts[0] = jac->dstarts[0] = 0;
+    for (bs=0,k=0; bs<=bsmax; bs++) {
+      if (!pos[bs]) continue;
+      g                 = (pos[bs]+PC_VPBJACOBI_LANES-1)/PC_VPBJACOBI_LANES;
+      jac->sizes[k]     = bs;
+      jac->counts[k]    = pos[bs];
+      jac->rstarts[k+1] = jac->rstarts[k] + g*PC_VPBJACOBI_LANES;
+      jac->dstarts[k+1] = jac->dstarts[k] + g*bs*bs*PC_VPBJACOBI_LANES;
+      kind[bs]          = k++;
+      pos[bs]           = 0;
+    }
+    nrows = jac->rstarts[jac->nsizes];
+    ndiag = jac->dstarts[jac->nsizes];
+    ierr  = PetscMalloc1(nrows,&jac->rows);CHKERRQ(ierr);
+#if defined(PC_VPBJACOBI_MIXED_PRECISION)
+    if (jac->mixed) {
+      ierr = PetscCalloc1(ndiag,&jac->fdiag);CHKERRQ(ierr);
+    } else
+#endif
+    {
+      ierr = PetscCalloc1(ndiag,&jac->bdiag);CHKERRQ(ierr);
+    }
+    ierr = PetscLogObjectMemory((PetscObject)pc,nrows*sizeof(PetscInt)+ndiag*(jac->mixed ? sizeof(float) : sizeof(MatScalar)));CHKERRQ(ierr);
+    /* the rows of the blocks, the padding lanes of the last group of each size repeat its last block */
+    for (i=0,ncnt=0; i<nblocks; i++) {
+      k = kind[bsizes[i]];
+      jac->rows[jac->rstarts[k]+pos[bsizes[i]]++] = ncnt;
+      ncnt += bsizes[i];
+    }
+    for (k=0; k<jac->nsizes; k++) {
+      for (p=jac->counts[k]; p<jac->rstarts[k+1]-jac->rstarts[k]; p++) jac->rows[jac->rstarts[k]+p] = jac->rows[jac->rstarts[k]+jac->counts[k]-1];
+    }
+    ierr = PetscInfo3(pc,"Batched application of %D blocks of %D different sizes, %D stored entries\n",nblocks,jac->nsizes,ndiag);CHKERRQ(ierr);
+    ierr = PetscFree2(kind,pos);CHKERRQ(ierr);
+  }
+
+  /* the blocks of each size are in the same order in rows as in diag */
+  ierr = PetscMalloc1(jac->nsizes,&pos);CHKERRQ(ierr);
+  ierr = PetscArrayzero(pos,jac->nsizes);CHKERRQ(ierr);
+  for (i=0,diag=jac->diag; i<nblocks; i++) {
+    bs = bsizes[i];
+    for (k=0; jac->sizes[k] != bs; k++) ;
+    p = pos[k]++;
+    g = p/PC_VPBJACOBI_LANES;
+    l = p%PC_VPBJACOBI_LANES;
+#if defined(PC_VPBJACOBI_MIXED_PRECISION)
+    if (jac->mixed) {
+      float *d = jac->fdiag + jac->dstarts[k] + g*bs*bs*PC_VPBJACOBI_LANES + l;
+      for (j=0; j<bs*bs; j++) d[j*PC_VPBJACOBI_LANES] = (float)diag[j];
+    } else
+#endif
+    {
+      MatScalar *d = jac->bdiag + jac->dstarts[k] + g*bs*bs*PC_VPBJACOBI_LANES + l;
+      for (j=0; j<bs*bs; j++) d[j*PC_VPBJACOBI_LANES] = diag[j];
+    }
+    diag += bs*bs;
+  }
+  ierr = PetscFree(pos);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+static PetscErrorCode PCReset_VPBJacobi(PC pc)
+{
+  PC_VPBJacobi   *jac = (PC_VPBJacobi*)pc->data;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  ierr = PetscFree(jac->diag);CHKERRQ(ierr);
+  ierr = PetscFree(jac->bsizes);CHKERRQ(ierr);
+  ierr = PetscFree4(jac->sizes,jac->counts,jac->rstarts,jac->dstarts);CHKERRQ(ierr);
+  ierr = PetscFree(jac->rows);CHKERRQ(ierr);
+  ierr = PetscFree(jac->bdiag);CHKERRQ(ierr);
+#if defined(PC_VPBJACOBI_MIXED_PRECISION)
+  ierr = PetscFree(jac->fdiag);CHKERRQ(ierr);
+#endif
+  jac->nblocks = 0;
+  PetscFunctionReturn(0);
+}
+
 /* -------------------------------------------------------------------------- */
 static PetscErrorCode PCSetUp_VPBJacobi(PC pc)
 {
@@ -107,32 +335,84 @@ static PetscErrorCode PCSetUp_VPBJacobi(PC pc)
   PetscInt       i,nsize = 0,nlocal;
   PetscInt       nblocks;
   const PetscInt *bsizes;
+  PetscBool      same = PETSC_FALSE;
 
   PetscFunctionBegin;
   ierr = MatGetVariableBlockSizes(pc->pmat,&nblocks,&bsizes);CHKERRQ(ierr);
   ierr = MatGetLocalSize(pc->pmat,&nlocal,NULL);CHKERRQ(ierr);
   if (nlocal && !nblocks) SETERRQ(PETSC_COMM_SELF,PETSC_ERR_ARG_WRONGSTATE,"Must call MatSetVariableBlockSizes() before using PCVPBJACOBI");
+  for (i=0; i<nblocks; i++) nsize += bsizes[i]*bsizes[i];
+  if (jac->bsizes && nblocks == jac->nblocks) {ierr = PetscArraycmp(bsizes,jac->bsizes,nblocks,&same);CHKERRQ(ierr);}
+  if (!same) {ierr = PCReset_VPBJacobi(pc);CHKERRQ(ierr);}
   if (!jac->diag) {
-    for (i=0; i<nblocks; i++) nsize += bsizes[i]*bsizes[i];
     ierr = PetscMalloc1(nsize,&jac->diag);CHKERRQ(ierr);
+    ierr = PetscMalloc1(nblocks,&jac->bsizes);CHKERRQ(ierr);
+    ierr = PetscArraycpy(jac->bsizes,bsizes,nblocks);CHKERRQ(ierr);
+    ierr = PetscLogObjectMemory((PetscObject)pc,nsize*sizeof(MatScalar)+nblocks*sizeof(PetscInt));CHKERRQ(ierr);
+    jac->nblocks = nblocks;
   }
   ierr = MatInvertVariableBlockDiagonal(A,nblocks,bsizes,jac->diag);CHKERRQ(ierr);
   ierr = MatFactorGetError(A,&err);CHKERRQ(ierr);
   if (err) pc->failedreason = (PCFailedReason)err;
-  pc->ops->apply = PCApply_VPBJacobi;
+  if (jac->batched) {
+    /* diag is kept so that later setups with the same blocks do not allocate it again */
+    ierr = PCVPBJacobiSetUpBatched_Private(pc,nblocks,bsizes);CHKERRQ(ierr);
+    pc->ops->apply = PCApply_VPBJacobi_Batched;
+  } else pc->ops->apply = PCApply_VPBJacobi;
+  PetscFunctionReturn(0);
+}
+
+static PetscErrorCode PCSetFromOptions_VPBJacobi(PetscOptionItems *PetscOptionsObject,PC pc)
+{
+  PC_VPBJacobi   *jac = (PC_VPBJacobi*)pc->data;
+  PetscErrorCode ierr;
+  PetscBool      batched = jac->batched,mixed = jac->mixed;
+
+  PetscFunctionBegin;
+  ierr = PetscOptionsHead(PetscOptionsObject,"Variable point block Jacobi options");CHKERRQ(ierr);
+  ierr = PetscOptionsBool("-pc_vpbjacobi_batched","Apply the blocks grouped by size with vectorized loops","None",batched,&batched,NULL);CHKERRQ(ierr);
+  ierr = PetscOptionsBool("-pc_vpbjacobi_mixed_precision","Store the inverses of the blocks in single precision, implies -pc_vpbjacobi_batched","None",mixed,&mixed,NULL);CHKERRQ(ierr);
+  ierr = PetscOptionsTail();CHKERRQ(ierr);
+#if !defined(PC_VPBJACOBI_MIXED_PRECISION)
+  if (mixed) SETERRQ(PetscObjectComm((PetscObject)pc),PETSC_ERR_SUP,"-pc_vpbjacobi_mixed_precision is only available for real double precision");
+#endif
+  if (pc->setupcalled && (batched != jac->batched || mixed != jac->mixed)) SETERRQ(PetscObjectComm((PetscObject)pc),PETSC_ERR_ORDER,"Cannot change the storage of the inverses after PCSetUp()");
+  jac->batched = (PetscBool)(batched || mixed);
+  jac->mixed   = mixed;
+  PetscFunctionReturn(0);
+}
+
+static PetscErrorCode PCView_VPBJacobi(PC pc,PetscViewer viewer)
+{
+  PC_VPBJacobi   *jac = (PC_VPBJacobi*)pc->data;
+  PetscErrorCode ierr;
+  PetscBool      iascii;
+  PetscMPIInt    rank;
+
+  PetscFunctionBegin;
+  ierr = PetscObjectTypeCompare((PetscObject)viewer,PETSCVIEWERASCII,&iascii);CHKERRQ(ierr);
+  if (iascii && jac->batched) {
+    ierr = PetscViewerASCIIPrintf(viewer,"  blocks applied grouped by size, %d blocks at a time, inverses stored in %s precision\n",PC_VPBJACOBI_LANES,jac->mixed ? "single" : "working");CHKERRQ(ierr);
+    if (jac->sizes) {
+      ierr = MPI_Comm_rank(PetscObjectComm((PetscObject)pc),&rank);CHKERRMPI(ierr);
+      ierr = PetscViewerASCIIPushSynchronized(viewer);CHKERRQ(ierr);
+      ierr = PetscViewerASCIISynchronizedPrintf(viewer,"  [%d] number of different block sizes %D, largest block size %D\n",rank,jac->nsizes,jac->nsizes ? jac->sizes[jac->nsizes-1] : 0);CHKERRQ(ierr);
+      ierr = PetscViewerFlush(viewer);CHKERRQ(ierr);
+      ierr = PetscViewerASCIIPopSynchronized(viewer);CHKERRQ(ierr);
+    }
+  }
   PetscFunctionReturn(0);
 }
 /* -------------------------------------------------------------------------- */
 static PetscErrorCode PCDestroy_VPBJacobi(PC pc)
 {
-  PC_VPBJacobi    *jac = (PC_VPBJacobi*)pc->data;
   PetscErrorCode ierr;
 
   PetscFunctionBegin;
   /*
       Free the private data structure that was hanging off the PC
   */
-  ierr = PetscFree(jac->diag);CHKERRQ(ierr);
+  ierr = PCReset_VPBJacobi(pc);CHKERRQ(ierr);
   ierr = PetscFree(pc->data);CHKERRQ(ierr);
   PetscFunctionReturn(0);
 }
@@ -150,6 +430,15 @@ static PetscErrorCode PCDestroy_VPBJacobi(PC pc)
    is detected a PETSc error is generated.
 
    One must call MatSetVariableBlockSizes() to use this preconditioner
+
+   Options Database Keys:
++  -pc_vpbjacobi_batched - apply the blocks grouped by size, several blocks of the same size at a time with vectorized loops
+-  -pc_vpbjacobi_mixed_precision - store the inverses of the blocks in single precision (only for real double precision), this halves the
+                                   memory traffic of the application and implies -pc_vpbjacobi_batched
+
+   With -pc_vpbjacobi_batched the blocks are still inverted one at a time, but the inverses of 8 blocks of the same size are interleaved
+   so that the application vectorizes across the blocks; it is threaded when PETSc is configured with OpenMP (see -omp_num_threads).
+
    Developer Notes:
     This should support the PCSetErrorIfFailure() flag set to PETSC_TRUE to allow
    the factorization to continue even after a zero pivot is found resulting in a Nan and hence
@@ -195,7 +484,9 @@ PETSC_EXTERN PetscErrorCode PCCreate_VPBJacobi(PC pc)
   pc->ops->applytranspose      = NULL;
   pc->ops->setup               = PCSetUp_VPBJacobi;
   pc->ops->destroy             = PCDestroy_VPBJacobi;
-  pc->ops->setfromoptions      = NULL;
+  pc->ops->reset               = PCReset_VPBJacobi;
+  pc->ops->setfromoptions      = PCSetFromOptions_VPBJacobi;
+  pc->ops->view                = PCView_VPBJacobi;
   pc->ops->applyrichardson     = NULL;
   pc->ops->applysymmetricleft  = NULL;
   pc->ops->applysymmetricright = NULL;
@@ -0,0 +1,166 @@
+static char help[] = "Tests PCGAMGSetReuseInterpolation() with a sequence of operators with the same nonzero pattern on a DMDA.\n\n";
+
+#include <petscdm.h>
+#include <petscdmda.h>
+#include <petscksp.h>
+
+/* the five-point Laplacian of the DMDA with a coefficient that changes slowly with the step, assembled in the matrix of the DMDA */
+static PetscErrorCode FillMatrix(DM da,PetscInt step,Mat A)
+{
+  PetscErrorCode ierr;
+  DMDALocalInfo  info;
+  PetscInt       i,j,ncols;
+  MatStencil     row,col[5];
+  PetscScalar    v[5],c;
+
+  PetscFunctionBegin;
+  ierr = DMDAGetLocalInfo(da,&info);CHKERRQ(ierr);
+  for (j=info.ys; j<info.ys+info.ym; j++) {
+    for (i=info.xs; i<info.xs+info.xm; i++) {
+      c     = 1.0 + 0.2*step*(PetscReal)j/info.my;
+      row.i = i; row.j = j;
+      ncols = 0;
+      if (j>0)         {col[ncols].i = i;   col[ncols].j = j-1; v[ncols++] = -c;}
+      if (i>0)         {col[ncols].i = i-1; col[ncols].j = j;   v[ncols++] = -c;}
+      col[ncols].i = i; col[ncols].j = j; v[ncols++] = 4.0*c;
+      if (i<info.mx-1) {col[ncols].i = i+1; col[ncols].j = j;   v[ncols++] = -c;}
+      if (j<info.my-1) {col[ncols].i = i;   col[ncols].j = j+1; v[ncols++] = -c;}
+      ierr = MatSetValuesStencil(A,1,&row,ncols,col,v,INSERT_VALUES);CHKERRQ(ierr);
+    }
+  }
+  ierr = MatAssemblyBegin(A,MAT_FINAL_ASSEMBLY);CHKERRQ(ierr);
+  ierr = MatAssemblyEnd(A,MAT_FINAL_ASSEMBLY);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+/* relative difference between Ac and P^T Af P computed with P assembled explicitly, P may be matrix-free */
+static PetscErrorCode GalerkinError(Mat Af,Mat P,Mat Ac,PetscReal *err)
+{
+  PetscErrorCode ierr;
+  Mat            Pe,C;
+  PetscReal      nrm,diff;
+
+  PetscFunctionBegin;
+  ierr = MatComputeOperator(P,MATAIJ,&Pe);CHKERRQ(ierr);
+  ierr = MatPtAP(Af,Pe,MAT_INITIAL_MATRIX,PETSC_DEFAULT,&C);CHKERRQ(ierr);
+  ierr = MatNorm(C,NORM_FROBENIUS,&nrm);CHKERRQ(ierr);
+  ierr = MatAXPY(C,-1.0,Ac,DIFFERENT_NONZERO_PATTERN);CHKERRQ(ierr);
+  ierr = MatNorm(C,NORM_FROBENIUS,&diff);CHKERRQ(ierr);
+  ierr = MatDestroy(&C);CHKERRQ(ierr);
+  ierr = MatDestroy(&Pe);CHKERRQ(ierr);
+  *err = diff/nrm;
+  PetscFunctionReturn(0);
+}
+
+/* largest relative difference between the coarse operators and the Galerkin products of the finer ones */
+static PetscErrorCode CheckGalerkin(PC pc,PetscReal *err)
+{
+  PetscErrorCode ierr;
+  PetscInt       nlevels,l;
+  KSP            smoother;
+  Mat            Af,Ac,P;
+  PetscReal      lerr;
+
+  PetscFunctionBegin;
+  *err = 0.0;
+  ierr = PCMGGetLevels(pc,&nlevels);CHKERRQ(ierr);
+  for (l=nlevels-1; l>0; l--) {
+    ierr = PCMGGetSmoother(pc,l,&smoother);CHKERRQ(ierr);
+    ierr = KSPGetOperators(smoother,NULL,&Af);CHKERRQ(ierr);
+    ierr = PCMGGetSmoother(pc,l-1,&smoother);CHKERRQ(ierr);
+    ierr = KSPGetOperators(smoother,NULL,&Ac);CHKERRQ(ierr);
+    ierr = PCMGGetInterpolation(pc,l,&P);CHKERRQ(ierr);
+    ierr = GalerkinError(Af,P,Ac,&lerr);CHKERRQ(ierr);
+    *err = PetscMax(*err,lerr);
+  }
+  PetscFunctionReturn(0);
+}
+
+int main(int argc,char **args)
+{
+  DM             da;
+  Vec            b,x;
+  Mat            A,A2,P,Ac;
+  KSP            ksp;
+  PC             pc;
+  PetscInt       m = 32,nsteps = 3,step,its,nlevels;
+  PetscInt64     pid,pid0 = -1;
+  PetscReal      err;
+  PetscBool      reuse = PETSC_TRUE,kept;
+  PetscRandom    rctx;
+  PetscErrorCode ierr;
+
+  ierr = PetscInitialize(&argc,&args,(char*)0,help);if (ierr) return ierr;
+  ierr = PetscOptionsGetInt(NULL,NULL,"-m",&m,NULL);CHKERRQ(ierr);
+  ierr = PetscOptionsGetInt(NULL,NULL,"-nsteps",&nsteps,NULL);CHKERRQ(ierr);
+  ierr = PetscOptionsGetBool(NULL,NULL,"-reuse",&reuse,NULL);CHKERRQ(ierr);
+  ierr = DMDACreate2d(PETSC_COMM_WORLD,DM_BOUNDARY_NONE,DM_BOUNDARY_NONE,DMDA_STENCIL_STAR,m,m,PETSC_DECIDE,PETSC_DECIDE,1,1,NULL,NULL,&da);CHKERRQ(ierr);
+  ierr = DMSetFromOptions(da);CHKERRQ(ierr);
+  ierr = DMSetUp(da);CHKERRQ(ierr);
+  ierr = DMCreateMatrix(da,&A);CHKERRQ(ierr);
+  ierr = MatSetOption(A,MAT_SYMMETRIC,PETSC_TRUE);CHKERRQ(ierr);
+  ierr = MatCreateVecs(A,&x,&b);CHKERRQ(ierr);
+  ierr = PetscRandomCreate(PETSC_COMM_WORLD,&rctx);CHKERRQ(ierr);
+  ierr = PetscRandomSetFromOptions(rctx);CHKERRQ(ierr);
+  ierr = VecSetRandom(b,rctx);CHKERRQ(ierr);
+
+  ierr = KSPCreate(PETSC_COMM_WORLD,&ksp);CHKERRQ(ierr);
+  ierr = KSPSetType(ksp,KSPCG);CHKERRQ(ierr);
+  ierr = KSPSetTolerances(ksp,1.e-10,PETSC_DEFAULT,PETSC_DEFAULT,PETSC_DEFAULT);CHKERRQ(ierr);
+  ierr = KSPGetPC(ksp,&pc);CHKERRQ(ierr);
+  ierr = PCSetType(pc,PCGAMG);CHKERRQ(ierr);
+  ierr = PCGAMGSetReuseInterpolation(pc,reuse);CHKERRQ(ierr);
+  ierr = KSPSetFromOptions(ksp);CHKERRQ(ierr);
+  for (step=0; step<nsteps; step++) {
+    ierr = FillMatrix(da,step,A);CHKERRQ(ierr);
+    ierr = KSPSetOperators(ksp,A,A);CHKERRQ(ierr);
+    ierr = KSPSolve(ksp,b,x);CHKERRQ(ierr);
+    ierr = KSPGetIterationNumber(ksp,&its);CHKERRQ(ierr);
+    ierr = PCMGGetLevels(pc,&nlevels);CHKERRQ(ierr);
+    ierr = PCMGGetInterpolation(pc,nlevels-1,&P);CHKERRQ(ierr);
+    ierr = PetscObjectGetId((PetscObject)P,&pid);CHKERRQ(ierr);
+    kept = (PetscBool)(step && pid == pid0);
+    ierr = CheckGalerkin(pc,&err);CHKERRQ(ierr);
+    ierr = PetscPrintf(PETSC_COMM_WORLD,"step %D: %D levels, %D iterations",step,nlevels,its);CHKERRQ(ierr);
+    if (step) {ierr = PetscPrintf(PETSC_COMM_WORLD,", prolongator %s",kept ? "kept" : "rebuilt");CHKERRQ(ierr);}
+    ierr = PetscPrintf(PETSC_COMM_WORLD,", Galerkin operators %s\n",err < 1.e-12 ? "consistent" : "inconsistent");CHKERRQ(ierr);
+    pid0 = pid;
+  }
+
+  /* the Galerkin product of the finest level reused with another operator with the same nonzero pattern */
+  ierr = MatPtAP(A,P,MAT_INITIAL_MATRIX,PETSC_DEFAULT,&Ac);CHKERRQ(ierr);
+  ierr = DMCreateMatrix(da,&A2);CHKERRQ(ierr);
+  ierr = FillMatrix(da,nsteps,A2);CHKERRQ(ierr);
+  ierr = MatPtAP(A2,P,MAT_REUSE_MATRIX,PETSC_DEFAULT,&Ac);CHKERRQ(ierr);
+  ierr = GalerkinError(A2,P,Ac,&err);CHKERRQ(ierr);
+  ierr = PetscPrintf(PETSC_COMM_WORLD,"new operator: Galerkin product %s\n",err < 1.e-12 ? "consistent" : "inconsistent");CHKERRQ(ierr);
+  ierr = MatDestroy(&Ac);CHKERRQ(ierr);
+  ierr = MatDestroy(&A2);CHKERRQ(ierr);
+
+  ierr = KSPDestroy(&ksp);CHKERRQ(ierr);
+  ierr = PetscRandomDestroy(&rctx);CHKERRQ(ierr);
+  ierr = MatDestroy(&A);CHKERRQ(ierr);
+  ierr = DMDestroy(&da);CHKERRQ(ierr);
+  ierr = VecDestroy(&b);CHKERRQ(ierr);
+  ierr = VecDestroy(&x);CHKERRQ(ierr);
+  ierr = PetscFinalize();
+  return ierr;
+}
+
+/*TEST
+
+   test:
+     suffix: 1
+     args: -pc_gamg_coarse_eq_limit 20 -pc_gamg_esteig_ksp_type cg -mg_levels_ksp_chebyshev_esteig 0,0.05,0,1.05
+
+   test:
+     suffix: 2
+     nsize: 4
+     args: -pc_gamg_coarse_eq_limit 20 -pc_gamg_process_eq_limit 80 -pc_gamg_use_sa_esteig -pc_gamg_esteig_ksp_type cg -mg_levels_pc_type jacobi
+
+   test:
+     suffix: matfree
+     nsize: 4
+     args: -pc_gamg_coarse_eq_limit 20 -pc_gamg_process_eq_limit 80 -pc_gamg_matfree_prolongator -pc_gamg_esteig_ksp_type cg -mg_levels_ksp_chebyshev_esteig 0,0.05,0,1.05
+
+TEST*/
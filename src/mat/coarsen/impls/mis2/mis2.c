@@ -0,0 +1,372 @@
+#include <petsc/private/matimpl.h>    /*I "petscmat.h" I*/
+#include <../src/mat/impls/aij/seq/aij.h>
+#include <../src/mat/impls/aij/mpi/mpiaij.h>
+#include <petscsf.h>
+
+/* states of a vertex, undecided vertices carry their (unique, nonnegative) priority */
+#define MIS2_DELETED  ((PetscInt64)-1)
+#define MIS2_SELECTED (((PetscInt64)1)<<62)
+
+/* -------------------------------------------------------------------------- */
+/*
+   maxIndSetAgg2 - parallel distance-2 maximal independent set (MIS-2) aggregation, computed on the graph itself
+   without forming its square. MatAIJ specific!!!
+
+   A vertex is selected when it has the largest priority of all undecided vertices within distance two, and deleted
+   when a selected vertex is within distance two. Each round takes two exchanges of ghost values over a PetscSF, one
+   for the maximum over the neighbors and one for the maximum over the neighbors of the neighbors, and a reduction.
+
+   The neighbors of the selected vertices join their aggregate, then the remaining vertices join the aggregate of their
+   most strongly connected neighbor.
+
+   Input Parameter:
+   . perm - serial permutation of rows of local to process in MIS, gives the priorities of the vertices
+   . Gmat - global matrix of graph, assumed structurally symmetric
+
+   Output Parameter:
+   . a_locals_llist - array of list of global ids of nodes rooted at selected nodes
+*/
+static PetscErrorCode maxIndSetAgg2(IS perm,Mat Gmat,PetscCoarsenData **a_locals_llist)
+{
+  PetscErrorCode   ierr;
+  Mat_SeqAIJ       *matA,*matB=NULL;
+  Mat_MPIAIJ       *mpimat=NULL;
+  MPI_Comm         comm;
+  PetscMPIInt      rank,size;
+  PetscInt         num_fine_ghosts=0,kk,j,n,lid,lidj,cpid,gid,my0,Iend,iter=0,nremoved=0,nselected=0,nundone,nleaves,nmulti,*garray=NULL;
+  PetscInt         *lid_agg,*lid_agg1,*cpcol_agg=NULL,*lid_gid,*ilocal,*iremote,*multi_gid,nextra;
+  const PetscInt   *perm_ix,*degree,*idx;
+  PetscInt64       *lid_key,*lid_max,*cpcol_key=NULL,*cpcol_max=NULL,mx;
+  PetscBool        *lid_removed,isMPI,isAIJ,needmat=PETSC_FALSE;
+  const PetscInt   nloc = Gmat->rmap->n;
+  PetscCoarsenData *agg_lists;
+  PetscLayout      layout;
+  PetscSF          sf=NULL,sfagg;
+
+  PetscFunctionBegin;
+  ierr = PetscObjectGetComm((PetscObject)Gmat,&comm);CHKERRQ(ierr);
+  ierr = MPI_Comm_rank(comm,&rank);CHKERRMPI(ierr);
+  ierr = MPI_Comm_size(comm,&size);CHKERRMPI(ierr);
+
+  /* get submatrices */
+  ierr = PetscObjectBaseTypeCompare((PetscObject)Gmat,MATMPIAIJ,&isMPI);CHKERRQ(ierr);
+  if (isMPI) {
+    mpimat = (Mat_MPIAIJ*)Gmat->data;
+    matA   = (Mat_SeqAIJ*)mpimat->A->data;
+    matB   = (Mat_SeqAIJ*)mpimat->B->data;
+    garray = mpimat->garray;
+  } else {
+    ierr = PetscObjectBaseTypeCompare((PetscObject)Gmat,MATSEQAIJ,&isAIJ);CHKERRQ(ierr);
+    if (!isAIJ) SETERRQ(PETSC_COMM_SELF,PETSC_ERR_USER,"Require AIJ matrix.");
+    matA = (Mat_SeqAIJ*)Gmat->data;
+  }
+  ierr = MatGetOwnershipRange(Gmat,&my0,&Iend);CHKERRQ(ierr);
+  ierr = MatGetLayouts(Gmat,&layout,NULL);CHKERRQ(ierr);
+  if (mpimat) {
+    ierr = VecGetLocalSize(mpimat->lvec,&num_fine_ghosts);CHKERRQ(ierr);
+    ierr = PetscMalloc3(num_fine_ghosts,&cpcol_key,num_fine_ghosts,&cpcol_max,num_fine_ghosts,&cpcol_agg);CHKERRQ(ierr);
+    ierr = PetscSFCreate(comm,&sf);CHKERRQ(ierr);
+    ierr = PetscSFSetGraphLayout(sf,layout,num_fine_ghosts,NULL,PETSC_COPY_VALUES,garray);CHKERRQ(ierr);
+  }
+  ierr = PetscMalloc6(nloc,&lid_key,nloc,&lid_max,nloc,&lid_agg,nloc,&lid_agg1,nloc,&lid_gid,nloc,&lid_removed);CHKERRQ(ierr);
+
+  /* priorities from the greedy ordering, made unique over the processes; vertices without neighbors are removed */
+  ierr = ISGetIndices(perm,&perm_ix);CHKERRQ(ierr);
+  for (kk=0; kk<nloc; kk++) {
+    lid          = perm_ix[kk];
+    lid_key[lid] = (PetscInt64)kk*size + rank;
+  }
+  ierr = ISRestoreIndices(perm,&perm_ix);CHKERRQ(ierr);
+  for (lid=0; lid<nloc; lid++) {
+    lid_gid[lid] = lid + my0;
+    n            = matA->i[lid+1] - matA->i[lid];
+    idx          = matA->j + matA->i[lid];
+    for (j=0; j<n && idx[j] == lid; j++) ;
+    lid_removed[lid] = (PetscBool)(j == n && (!matB || matB->i[lid+1] == matB->i[lid]));
+    if (lid_removed[lid]) {
+      lid_key[lid] = MIS2_DELETED;
+      nremoved++;
+    }
+  }
+
+  /* MIS-2 */
+  do {
+    iter++;
+    /* maximum over the neighbors */
+    if (sf) {
+      ierr = PetscSFBcastBegin(sf,MPIU_INT64,lid_key,cpcol_key,MPI_REPLACE);CHKERRQ(ierr);
+      ierr = PetscSFBcastEnd(sf,MPIU_INT64,lid_key,cpcol_key,MPI_REPLACE);CHKERRQ(ierr);
+    }
+    for (lid=0; lid<nloc; lid++) {
+      mx  = lid_key[lid];
+      n   = matA->i[lid+1] - matA->i[lid];
+      idx = matA->j + matA->i[lid];
+      for (j=0; j<n; j++) mx = PetscMax(mx,lid_key[idx[j]]);
+      if (matB) {
+        n   = matB->i[lid+1] - matB->i[lid];
+        idx = matB->j + matB->i[lid];
+        for (j=0; j<n; j++) mx = PetscMax(mx,cpcol_key[idx[j]]);
+      }
+      lid_max[lid] = mx;
+    }
+    /* maximum over the neighbors of the neighbors, decide */
+    if (sf) {
+      ierr = PetscSFBcastBegin(sf,MPIU_INT64,lid_max,cpcol_max,MPI_REPLACE);CHKERRQ(ierr);
+      ierr = PetscSFBcastEnd(sf,MPIU_INT64,lid_max,cpcol_max,MPI_REPLACE);CHKERRQ(ierr);
+    }
+    nundone = 0;
+    for (lid=0; lid<nloc; lid++) {
+      if (lid_key[lid] == MIS2_DELETED || lid_key[lid] == MIS2_SELECTED) continue;
+      mx  = lid_max[lid];
+      n   = matA->i[lid+1] - matA->i[lid];
+      idx = matA->j + matA->i[lid];
+      for (j=0; j<n; j++) mx = PetscMax(mx,lid_max[idx[j]]);
+      if (matB) {
+        n   = matB->i[lid+1] - matB->i[lid];
+        idx = matB->j + matB->i[lid];
+        for (j=0; j<n; j++) mx = PetscMax(mx,cpcol_max[idx[j]]);
+      }
+      if (mx == MIS2_SELECTED) lid_key[lid] = MIS2_DELETED;
+      else if (mx == lid_key[lid]) {
+        lid_key[lid] = MIS2_SELECTED;
+        nselected++;
+      } else nundone++;
+    }
+    ierr = MPIU_Allreduce(MPI_IN_PLACE,&nundone,1,MPIU_INT,MPI_SUM,comm);CHKERRMPI(ierr);
+  } while (nundone);
+
+  /* the neighbors of the selected vertices join their aggregate */
+  if (sf) {
+    ierr = PetscSFBcastBegin(sf,MPIU_INT64,lid_key,cpcol_key,MPI_REPLACE);CHKERRQ(ierr);
+    ierr = PetscSFBcastEnd(sf,MPIU_INT64,lid_key,cpcol_key,MPI_REPLACE);CHKERRQ(ierr);
+  }
+  for (lid=0; lid<nloc; lid++) {
+    lid_agg[lid] = -1;
+    if (lid_removed[lid]) continue;
+    if (lid_key[lid] == MIS2_SELECTED) {
+      lid_agg[lid] = lid + my0;
+      continue;
+    }
+    n   = matA->i[lid+1] - matA->i[lid];
+    idx = matA->j + matA->i[lid];
+    for (j=0; j<n; j++) {
+      if (lid_key[idx[j]] == MIS2_SELECTED) {
+        lid_agg[lid] = idx[j] + my0;
+        break;
+      }
+    }
+    if (lid_agg[lid] == -1 && matB) {
+      n   = matB->i[lid+1] - matB->i[lid];
+      idx = matB->j + matB->i[lid];
+      for (j=0; j<n; j++) {
+        if (cpcol_key[idx[j]] == MIS2_SELECTED) {
+          lid_agg[lid] = garray[idx[j]];
+          break;
+        }
+      }
+    }
+  }
+
+  /* the vertices at distance two join the aggregate of their most strongly connected neighbor */
+  if (sf) {
+    ierr = PetscSFBcastBegin(sf,MPIU_INT,lid_agg,cpcol_agg,MPI_REPLACE);CHKERRQ(ierr);
+    ierr = PetscSFBcastEnd(sf,MPIU_INT,lid_agg,cpcol_agg,MPI_REPLACE);CHKERRQ(ierr);
+  }
+  for (lid=0; lid<nloc; lid++) {
+    PetscReal wmax = -1.0,w;
+
+    lid_agg1[lid] = lid_agg[lid];
+    if (lid_removed[lid] || lid_agg[lid] != -1) continue;
+    n   = matA->i[lid+1] - matA->i[lid];
+    idx = matA->j + matA->i[lid];
+    for (j=0; j<n; j++) {
+      lidj = idx[j];
+      w    = PetscAbsScalar(matA->a[matA->i[lid]+j]);
+      if (lidj != lid && lid_agg[lidj] != -1 && w > wmax) {
+        wmax          = w;
+        lid_agg1[lid] = lid_agg[lidj];
+      }
+    }
+    if (matB) {
+      n   = matB->i[lid+1] - matB->i[lid];
+      idx = matB->j + matB->i[lid];
+      for (j=0; j<n; j++) {
+        cpid = idx[j];
+        w    = PetscAbsScalar(matB->a[matB->i[lid]+j]);
+        if (cpcol_agg[cpid] != -1 && w > wmax) {
+          wmax          = w;
+          lid_agg1[lid] = cpcol_agg[cpid];
+        }
+      }
+    }
+    if (lid_agg1[lid] == -1) { /* only for graphs that are not symmetric, make it a singleton */
+      lid_agg1[lid] = lid + my0;
+      nselected++;
+    }
+  }
+  ierr = PetscInfo5(Gmat,"\t removed %D of %D vertices.  %D selected, %D rounds of %s.\n",nremoved,nloc,nselected,iter,"MIS-2");CHKERRQ(ierr);
+
+  /* send the members to the processes owning their selected vertex */
+  ierr = PetscMalloc2(nloc,&ilocal,nloc,&iremote);CHKERRQ(ierr);
+  for (lid=0,nleaves=0; lid<nloc; lid++) {
+    if (lid_agg1[lid] == -1) continue;
+    ilocal[nleaves]  = lid;
+    iremote[nleaves] = lid_agg1[lid];
+    nleaves++;
+  }
+  ierr = PetscSFCreate(comm,&sfagg);CHKERRQ(ierr);
+  ierr = PetscSFSetGraphLayout(sfagg,layout,nleaves,ilocal,PETSC_COPY_VALUES,iremote);CHKERRQ(ierr);
+  ierr = PetscFree2(ilocal,iremote);CHKERRQ(ierr);
+  ierr = PetscSFComputeDegreeBegin(sfagg,&degree);CHKERRQ(ierr);
+  ierr = PetscSFComputeDegreeEnd(sfagg,&degree);CHKERRQ(ierr);
+  for (lid=0,nmulti=0; lid<nloc; lid++) nmulti += degree[lid];
+  ierr = PetscMalloc1(nmulti,&multi_gid);CHKERRQ(ierr);
+  ierr = PetscSFGatherBegin(sfagg,MPIU_INT,lid_gid,multi_gid);CHKERRQ(ierr);
+  ierr = PetscSFGatherEnd(sfagg,MPIU_INT,lid_gid,multi_gid);CHKERRQ(ierr);
+
+  ierr = PetscCDCreate(nloc,&agg_lists);CHKERRQ(ierr);
+  *a_locals_llist = agg_lists;
+  for (lid=0,kk=0; lid<nloc; lid++) {
+    if (!degree[lid]) continue;
+    ierr = PetscCDAppendID(agg_lists,lid,lid+my0);CHKERRQ(ierr);
+    for (j=0; j<degree[lid]; j++,kk++) {
+      gid = multi_gid[kk];
+      if (gid == lid+my0) continue;
+      ierr = PetscCDAppendID(agg_lists,lid,gid);CHKERRQ(ierr);
+      if (!needmat && (gid < my0 || gid >= Iend)) {
+        PetscInt loc = -1;
+        if (garray) {ierr = PetscFindInt(gid,num_fine_ghosts,garray,&loc);CHKERRQ(ierr);}
+        if (loc < 0) needmat = PETSC_TRUE;
+      }
+    }
+  }
+
+  /* members at distance two on other processes may not be ghosts of the graph, add them to a copy of it */
+  ierr = MPIU_Allreduce(MPI_IN_PLACE,&needmat,1,MPIU_BOOL,MPI_LOR,comm);CHKERRMPI(ierr);
+  if (needmat) {
+    Mat         mat;
+    PetscInt    *d_nnz,*o_nnz,NN,row,col;
+    PetscScalar one = 1.0;
+
+    ierr = PetscInfo(Gmat,"\t adding aggregate members that are not ghosts to the graph\n");CHKERRQ(ierr);
+    ierr = MatGetSize(Gmat,&NN,NULL);CHKERRQ(ierr);
+    ierr = PetscMalloc2(nloc,&d_nnz,nloc,&o_nnz);CHKERRQ(ierr);
+    for (lid=0,kk=0; lid<nloc; lid++) {
+      d_nnz[lid] = matA->i[lid+1] - matA->i[lid];
+      o_nnz[lid] = matB ? matB->i[lid+1] - matB->i[lid] : 0;
+      for (j=0,nextra=0; j<degree[lid]; j++,kk++) {
+        gid = multi_gid[kk];
+        if (gid < my0 || gid >= Iend) nextra++;
+      }
+      o_nnz[lid] = PetscMin(o_nnz[lid]+nextra,NN-nloc);
+    }
+    ierr = MatCreateAIJ(comm,nloc,nloc,PETSC_DETERMINE,PETSC_DETERMINE,0,d_nnz,0,o_nnz,&mat);CHKERRQ(ierr);
+    ierr = PetscFree2(d_nnz,o_nnz);CHKERRQ(ierr);
+    for (lid=0,kk=0; lid<nloc; lid++) {
+      row = lid + my0;
+      n   = matA->i[lid+1] - matA->i[lid];
+      idx = matA->j + matA->i[lid];
+      for (j=0; j<n; j++) {
+        col  = idx[j] + my0;
+        ierr = MatSetValues(mat,1,&row,1,&col,&one,INSERT_VALUES);CHKERRQ(ierr);
+      }
+      if (matB) {
+        n   = matB->i[lid+1] - matB->i[lid];
+        idx = matB->j + matB->i[lid];
+        for (j=0; j<n; j++) {
+          col  = garray[idx[j]];
+          ierr = MatSetValues(mat,1,&row,1,&col,&one,INSERT_VALUES);CHKERRQ(ierr);
+        }
+      }
+      for (j=0; j<degree[lid]; j++,kk++) {
+        col = multi_gid[kk];
+        if (col < my0 || col >= Iend) {
+          ierr = MatSetValues(mat,1,&row,1,&col,&one,INSERT_VALUES);CHKERRQ(ierr);
+        }
+      }
+    }
+    ierr = MatAssemblyBegin(mat,MAT_FINAL_ASSEMBLY);CHKERRQ(ierr);
+    ierr = MatAssemblyEnd(mat,MAT_FINAL_ASSEMBLY);CHKERRQ(ierr);
+    ierr = PetscCDSetMat(agg_lists,mat);CHKERRQ(ierr);
+  }
+
+  ierr = PetscFree(multi_gid);CHKERRQ(ierr);
+  ierr = PetscSFDestroy(&sfagg);CHKERRQ(ierr);
+  ierr = PetscSFDestroy(&sf);CHKERRQ(ierr);
+  ierr = PetscFree3(cpcol_key,cpcol_max,cpcol_agg);CHKERRQ(ierr);
+  ierr = PetscFree6(lid_key,lid_max,lid_agg,lid_agg1,lid_gid,lid_removed);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+/*
+   MIS-2 coarsen, simple greedy.
+*/
+static PetscErrorCode MatCoarsenApply_MIS2(MatCoarsen coarse)
+{
+  PetscErrorCode ierr;
+  Mat            mat = coarse->graph;
+
+  PetscFunctionBegin;
+  if (!coarse->strict_aggs) SETERRQ(PetscObjectComm((PetscObject)coarse),PETSC_ERR_SUP,"MIS-2 coarsening only supports strict aggregates");
+  if (!coarse->perm) {
+    IS       perm;
+    PetscInt n,m;
+    MPI_Comm comm;
+
+    ierr = PetscObjectGetComm((PetscObject)mat,&comm);CHKERRQ(ierr);
+    ierr = MatGetLocalSize(mat, &m, &n);CHKERRQ(ierr);
+    ierr = ISCreateStride(comm, m, 0, 1, &perm);CHKERRQ(ierr);
+    ierr = maxIndSetAgg2(perm, mat, &coarse->agg_lists);CHKERRQ(ierr);
+    ierr = ISDestroy(&perm);CHKERRQ(ierr);
+  } else {
+    ierr = maxIndSetAgg2(coarse->perm, mat, &coarse->agg_lists);CHKERRQ(ierr);
+  }
+  PetscFunctionReturn(0);
+}
+
+PetscErrorCode MatCoarsenView_MIS2(MatCoarsen coarse,PetscViewer viewer)
+{
+  PetscErrorCode ierr;
+  PetscMPIInt    rank;
+  PetscBool      iascii;
+
+  PetscFunctionBegin;
+  ierr = MPI_Comm_rank(PetscObjectComm((PetscObject)coarse),&rank);CHKERRMPI(ierr);
+  ierr = PetscObjectTypeCompare((PetscObject)viewer,PETSCVIEWERASCII,&iascii);CHKERRQ(ierr);
+  if (iascii) {
+    ierr = PetscViewerASCIIPushSynchronized(viewer);CHKERRQ(ierr);
+    ierr = PetscViewerASCIISynchronizedPrintf(viewer,"  [%d] MIS-2 aggregator\n",rank);CHKERRQ(ierr);
+    ierr = PetscViewerFlush(viewer);CHKERRQ(ierr);
+    ierr = PetscViewerASCIIPopSynchronized(viewer);CHKERRQ(ierr);
+  }
+  PetscFunctionReturn(0);
+}
+
+/*MC
+   MATCOARSENMIS2 - Creates a coarsen context that aggregates with a distance-2 maximal independent set.
+
+   Collective
+
+   Input Parameter:
+.  coarse - the coarsen context
+
+   Notes:
+    The aggregates are about as large as those of MATCOARSENMIS on the square of the graph, but the independent set is
+    computed on the graph itself so the square is never formed. Only strict aggregates are supported and the graph is
+    assumed to be structurally symmetric.
+
+    PCGAMG uses it in place of squaring the graph on the levels given by -pc_gamg_square_graph when -mat_coarsen_type mis2 is set.
+
+   Level: beginner
+
+.seealso: MatCoarsenSetType(), MatCoarsenType, MATCOARSENMIS, PCGAMGSetSquareGraph()
+
+M*/
+
+PETSC_EXTERN PetscErrorCode MatCoarsenCreate_MIS2(MatCoarsen coarse)
+{
+  PetscFunctionBegin;
+  coarse->ops->apply = MatCoarsenApply_MIS2;
+  coarse->ops->view  = MatCoarsenView_MIS2;
+  PetscFunctionReturn(0);
+}
@@ -0,0 +1,73 @@
+#include <petsc/private/matimpl.h>      /*I "petscmat.h"  I*/
+
+PetscErrorCode MatSORColoringReset_Private(MatSORColoring *sc)
+{
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  ierr = PetscFree2(sc->color,sc->rows);CHKERRQ(ierr);
+  sc->ncolors      = 0;
+  sc->nonzerostate = 0;
+  PetscFunctionReturn(0);
+}
+
+/*
+   Colors the graph of the m local (block) rows ai[], aj[] of A so that no two rows of the same color are coupled,
+   which lets the SOR_MULTICOLOR sweeps of MatSOR() update the rows of a color simultaneously.
+
+   The graph is symmetrized since the couplings of both triangular parts must be respected; the coloring is kept
+   until the nonzero structure of A changes and may be customized with the options of MatColoring under the prefix -sor_
+*/
+PetscErrorCode MatSORColoringSetUp_Private(Mat A,PetscInt m,const PetscInt ai[],const PetscInt aj[],MatSORColoring *sc)
+{
+  PetscErrorCode ierr;
+  Mat            G,Gt;
+  MatScalar      *v;
+  MatColoring    mc;
+  ISColoring     iscoloring;
+  IS             *is;
+  PetscInt       c,i,n,nc;
+  const PetscInt *idx;
+  const char     *prefix;
+
+  PetscFunctionBegin;
+  if (sc->color && sc->nonzerostate == A->nonzerostate) PetscFunctionReturn(0);
+  ierr = MatSORColoringReset_Private(sc);CHKERRQ(ierr);
+
+  ierr = PetscMalloc1(ai[m],&v);CHKERRQ(ierr);
+  for (i=0; i<ai[m]; i++) v[i] = 1.0;
+  ierr = MatCreateSeqAIJWithArrays(PETSC_COMM_SELF,m,m,(PetscInt*)ai,(PetscInt*)aj,v,&G);CHKERRQ(ierr);
+  ierr = MatTranspose(G,MAT_INITIAL_MATRIX,&Gt);CHKERRQ(ierr);
+  ierr = MatAXPY(Gt,1.0,G,DIFFERENT_NONZERO_PATTERN);CHKERRQ(ierr);
+  ierr = MatDestroy(&G);CHKERRQ(ierr);
+  ierr = PetscFree(v);CHKERRQ(ierr);
+
+  ierr = MatColoringCreate(Gt,&mc);CHKERRQ(ierr);
+  ierr = MatGetOptionsPrefix(A,&prefix);CHKERRQ(ierr);
+  ierr = PetscObjectSetOptionsPrefix((PetscObject)mc,prefix);CHKERRQ(ierr);
+  ierr = PetscObjectAppendOptionsPrefix((PetscObject)mc,"sor_");CHKERRQ(ierr);
+  ierr = MatColoringSetType(mc,MATCOLORINGGREEDY);CHKERRQ(ierr);
+  ierr = MatColoringSetDistance(mc,1);CHKERRQ(ierr);
+  ierr = MatColoringSetFromOptions(mc);CHKERRQ(ierr);
+  ierr = MatColoringApply(mc,&iscoloring);CHKERRQ(ierr);
+  ierr = MatColoringDestroy(&mc);CHKERRQ(ierr);
+  ierr = MatDestroy(&Gt);CHKERRQ(ierr);
+
+  ierr = ISColoringGetIS(iscoloring,PETSC_USE_POINTER,&nc,&is);CHKERRQ(ierr);
+  ierr = PetscMalloc2(nc+1,&sc->color,m,&sc->rows);CHKERRQ(ierr);
+  sc->color[0] = 0;
+  for (c=0; c<nc; c++) {
+    ierr = ISGetLocalSize(is[c],&n);CHKERRQ(ierr);
+    ierr = ISGetIndices(is[c],&idx);CHKERRQ(ierr);
+    ierr = PetscArraycpy(sc->rows+sc->color[c],idx,n);CHKERRQ(ierr);
+    ierr = ISRestoreIndices(is[c],&idx);CHKERRQ(ierr);
+    sc->color[c+1] = sc->color[c] + n;
+  }
+  ierr = ISColoringRestoreIS(iscoloring,PETSC_USE_POINTER,&is);CHKERRQ(ierr);
+  ierr = ISColoringDestroy(&iscoloring);CHKERRQ(ierr);
+  if (sc->color[nc] != m) SETERRQ2(PETSC_COMM_SELF,PETSC_ERR_PLIB,"Coloring covers %D of the %D rows",sc->color[nc],m);
+  sc->ncolors      = nc;
+  sc->nonzerostate = A->nonzerostate;
+  ierr = PetscInfo2(A,"%D colors for the multicolor SOR sweeps of %D rows\n",nc,m);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
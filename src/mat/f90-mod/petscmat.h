@@ -158,6 +158,7 @@
       PetscEnum, parameter :: SOR_EISENSTAT=32
       PetscEnum, parameter :: SOR_APPLY_UPPER=64
       PetscEnum, parameter :: SOR_APPLY_LOWER=128
+      PetscEnum, parameter :: SOR_MULTICOLOR=256
 !
 !  MatOperation
 !
@@ -288,7 +289,7 @@
       PetscEnum, parameter :: MATOP_FIND_NONZERO_ROWS=124
       PetscEnum, parameter :: MATOP_GET_COLUMN_NORMS=125
       PetscEnum, parameter :: MATOP_INVERT_BLOCK_DIAGONAL=126
-!     PetscEnum, parameter :: MATOP_PLACEHOLDER_127=127
+      PetscEnum, parameter :: MATOP_INVERT_VBLOCK_DIAGONAL=127
       PetscEnum, parameter :: MATOP_CREATE_SUB_MATRICES_MPI=128
       PetscEnum, parameter :: MATOP_SET_VALUES_BATCH=129
       PetscEnum, parameter :: MATOP_PLACEHOLDER_130=130
@@ -448,6 +449,7 @@
 !DEC$ ATTRIBUTES DLLEXPORT::SOR_EISENSTAT
 !DEC$ ATTRIBUTES DLLEXPORT::SOR_APPLY_UPPER
 !DEC$ ATTRIBUTES DLLEXPORT::SOR_APPLY_LOWER
+!DEC$ ATTRIBUTES DLLEXPORT::SOR_MULTICOLOR
 !DEC$ ATTRIBUTES DLLEXPORT::MATOP_SET_VALUES
 !DEC$ ATTRIBUTES DLLEXPORT::MATOP_GET_ROWMATOP_RESTORE_ROW
 !DEC$ ATTRIBUTES DLLEXPORT::MATOP_MULT
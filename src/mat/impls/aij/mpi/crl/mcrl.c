@@ -134,6 +134,10 @@ PETSC_INTERN PetscErrorCode MatConvert_MPIAIJ_MPIAIJCRL(Mat A,MatType type,MatRe
   B->ops->destroy     = MatDestroy_MPIAIJCRL;
   B->ops->mult        = MatMult_AIJCRL;
 
+  /* The CRL copy of the values is only refreshed at assembly, use the MatSetValues() based COO assembly */
+  ierr = PetscObjectComposeFunction((PetscObject)B,"MatSetPreallocationCOO_C",NULL);CHKERRQ(ierr);
+  ierr = PetscObjectComposeFunction((PetscObject)B,"MatSetValuesCOO_C",NULL);CHKERRQ(ierr);
+
   /* If A has already been assembled, compute the permutation. */
   if (A->assembled) {
     ierr = MatMPIAIJCRL_create_aijcrl(B);CHKERRQ(ierr);
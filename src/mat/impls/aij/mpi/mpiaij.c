@@ -1008,6 +1008,29 @@ PetscErrorCode MatMultAdd_MPIAIJ(Mat A,Vec xx,Vec yy,Vec zz)
   PetscFunctionReturn(0);
 }
 
+static PetscErrorCode MatResidualJacobiUpdate_MPIAIJ(Mat A,Vec b,Vec dinv,PetscScalar alpha,Vec x,PetscScalar beta,Vec w,PetscScalar gamma,Vec y,PetscReal *rnorm)
+{
+  Mat_MPIAIJ        *a = (Mat_MPIAIJ*)A->data;
+  const PetscScalar *lw;
+  PetscReal         nrm2;
+  PetscErrorCode    ierr;
+
+  PetscFunctionBegin;
+  if (!a->rwork) {ierr = VecDuplicate(b,&a->rwork);CHKERRQ(ierr);}
+  /* as in MatMult_MPIAIJ() the diagonal block is applied while the ghost values of w are communicated */
+  ierr = VecScatterBegin(a->Mvctx,w,a->lvec,INSERT_VALUES,SCATTER_FORWARD);CHKERRQ(ierr);
+  ierr = (*a->A->ops->mult)(a->A,w,a->rwork);CHKERRQ(ierr);
+  ierr = VecScatterEnd(a->Mvctx,w,a->lvec,INSERT_VALUES,SCATTER_FORWARD);CHKERRQ(ierr);
+  ierr = VecGetArrayRead(a->lvec,&lw);CHKERRQ(ierr);
+  ierr = MatResidualJacobiUpdate_SeqAIJ_Private(a->B,lw,b,a->rwork,dinv,alpha,x,beta,w,gamma,y,rnorm ? &nrm2 : NULL);CHKERRQ(ierr);
+  ierr = VecRestoreArrayRead(a->lvec,&lw);CHKERRQ(ierr);
+  if (rnorm) {
+    ierr   = MPIU_Allreduce(&nrm2,rnorm,1,MPIU_REAL,MPIU_SUM,PetscObjectComm((PetscObject)A));CHKERRMPI(ierr);
+    *rnorm = PetscSqrtReal(*rnorm);
+  }
+  PetscFunctionReturn(0);
+}
+
 PetscErrorCode MatMultTranspose_MPIAIJ(Mat A,Vec xx,Vec yy)
 {
   Mat_MPIAIJ     *a = (Mat_MPIAIJ*)A->data;
@@ -1129,6 +1152,7 @@ PetscErrorCode MatDestroy_MPIAIJ(Mat mat)
 #endif
   ierr = MatStashDestroy_Private(&mat->stash);CHKERRQ(ierr);
   ierr = VecDestroy(&aij->diag);CHKERRQ(ierr);
+  ierr = VecDestroy(&aij->rwork);CHKERRQ(ierr);
   ierr = MatDestroy(&aij->A);CHKERRQ(ierr);
   ierr = MatDestroy(&aij->B);CHKERRQ(ierr);
 #if defined(PETSC_USE_CTABLE)
@@ -1141,6 +1165,7 @@ PetscErrorCode MatDestroy_MPIAIJ(Mat mat)
   ierr = VecScatterDestroy(&aij->Mvctx);CHKERRQ(ierr);
   ierr = PetscFree2(aij->rowvalues,aij->rowindices);CHKERRQ(ierr);
   ierr = PetscFree(aij->ld);CHKERRQ(ierr);
+  ierr = MatResetPreallocationCOO_MPIAIJ(mat);CHKERRQ(ierr);
   ierr = PetscFree(mat->data);CHKERRQ(ierr);
 
   /* may be created by MatCreateMPIAIJSumSeqAIJSymbolic */
@@ -1152,6 +1177,7 @@ PetscErrorCode MatDestroy_MPIAIJ(Mat mat)
   ierr = PetscObjectComposeFunction((PetscObject)mat,"MatIsTranspose_C",NULL);CHKERRQ(ierr);
   ierr = PetscObjectComposeFunction((PetscObject)mat,"MatMPIAIJSetPreallocation_C",NULL);CHKERRQ(ierr);
   ierr = PetscObjectComposeFunction((PetscObject)mat,"MatResetPreallocation_C",NULL);CHKERRQ(ierr);
+  ierr = PetscObjectComposeFunction((PetscObject)mat,"MatResidualJacobiUpdate_C",NULL);CHKERRQ(ierr);
   ierr = PetscObjectComposeFunction((PetscObject)mat,"MatMPIAIJSetPreallocationCSR_C",NULL);CHKERRQ(ierr);
   ierr = PetscObjectComposeFunction((PetscObject)mat,"MatDiagonalScaleLocal_C",NULL);CHKERRQ(ierr);
   ierr = PetscObjectComposeFunction((PetscObject)mat,"MatConvert_mpiaij_mpibaij_C",NULL);CHKERRQ(ierr);
@@ -1185,6 +1211,8 @@ PetscErrorCode MatDestroy_MPIAIJ(Mat mat)
   ierr = PetscObjectComposeFunction((PetscObject)mat,"MatConvert_mpiaij_mpiaijcrl_C",NULL);CHKERRQ(ierr);
   ierr = PetscObjectComposeFunction((PetscObject)mat,"MatConvert_mpiaij_is_C",NULL);CHKERRQ(ierr);
   ierr = PetscObjectComposeFunction((PetscObject)mat,"MatConvert_mpiaij_mpisell_C",NULL);CHKERRQ(ierr);
+  ierr = PetscObjectComposeFunction((PetscObject)mat,"MatSetPreallocationCOO_C",NULL);CHKERRQ(ierr);
+  ierr = PetscObjectComposeFunction((PetscObject)mat,"MatSetValuesCOO_C",NULL);CHKERRQ(ierr);
   PetscFunctionReturn(0);
 }
 
@@ -1314,6 +1342,11 @@ PetscErrorCode MatView_MPIAIJ_ASCIIorDraworSocket(Mat mat,PetscViewer viewer)
       ierr = PetscViewerASCIISynchronizedPrintf(viewer,"[%d] on-diagonal part: nz %D \n",rank,(PetscInt)info.nz_used);CHKERRQ(ierr);
       ierr = MatGetInfo(aij->B,MAT_LOCAL,&info);CHKERRQ(ierr);
       ierr = PetscViewerASCIISynchronizedPrintf(viewer,"[%d] off-diagonal part: nz %D \n",rank,(PetscInt)info.nz_used);CHKERRQ(ierr);
+      if (((Mat_SeqAIJ*)aij->A->data)->autotune.use) {
+        Mat_SeqAIJ_Autotune *at = &((Mat_SeqAIJ*)aij->A->data)->autotune;
+
+        ierr = PetscViewerASCIISynchronizedPrintf(viewer,"[%d] on-diagonal part MatMult() kernel: %s\n",rank,at->tuned ? MatSeqAIJKernels[at->kernel] : "not autotuned yet");CHKERRQ(ierr);
+      }
       ierr = PetscViewerFlush(viewer);CHKERRQ(ierr);
       ierr = PetscViewerASCIIPopSynchronized(viewer);CHKERRQ(ierr);
       ierr = PetscViewerASCIIPrintf(viewer,"Information on VecScatter used in matrix-vector product: \n");CHKERRQ(ierr);
@@ -1327,6 +1360,11 @@ PetscErrorCode MatView_MPIAIJ_ASCIIorDraworSocket(Mat mat,PetscViewer viewer)
       } else {
         ierr = PetscViewerASCIIPrintf(viewer,"not using I-node (on process 0) routines\n");CHKERRQ(ierr);
       }
+      if (((Mat_SeqAIJ*)aij->A->data)->autotune.use) {
+        Mat_SeqAIJ_Autotune *at = &((Mat_SeqAIJ*)aij->A->data)->autotune;
+
+        ierr = PetscViewerASCIIPrintf(viewer,"on-diagonal part MatMult() kernel (on process 0): %s\n",at->tuned ? MatSeqAIJKernels[at->kernel] : "not autotuned yet");CHKERRQ(ierr);
+      }
       PetscFunctionReturn(0);
     } else if (format == PETSC_VIEWER_ASCII_FACTOR_INFO) {
       PetscFunctionReturn(0);
@@ -1442,7 +1480,7 @@ PetscErrorCode MatSOR_MPIAIJ(Mat matin,Vec bb,PetscReal omega,MatSORType flag,Pe
       ierr = (*mat->B->ops->multadd)(mat->B,mat->lvec,bb,bb1);CHKERRQ(ierr);
 
       /* local sweep */
-      ierr = (*mat->A->ops->sor)(mat->A,bb1,omega,SOR_SYMMETRIC_SWEEP,fshift,lits,1,xx);CHKERRQ(ierr);
+      ierr = (*mat->A->ops->sor)(mat->A,bb1,omega,(MatSORType)(SOR_SYMMETRIC_SWEEP | (flag & SOR_MULTICOLOR)),fshift,lits,1,xx);CHKERRQ(ierr);
     }
   } else if (flag & SOR_LOCAL_FORWARD_SWEEP) {
     if (flag & SOR_ZERO_INITIAL_GUESS) {
@@ -1458,7 +1496,7 @@ PetscErrorCode MatSOR_MPIAIJ(Mat matin,Vec bb,PetscReal omega,MatSORType flag,Pe
       ierr = (*mat->B->ops->multadd)(mat->B,mat->lvec,bb,bb1);CHKERRQ(ierr);
 
       /* local sweep */
-      ierr = (*mat->A->ops->sor)(mat->A,bb1,omega,SOR_FORWARD_SWEEP,fshift,lits,1,xx);CHKERRQ(ierr);
+      ierr = (*mat->A->ops->sor)(mat->A,bb1,omega,(MatSORType)(SOR_FORWARD_SWEEP | (flag & SOR_MULTICOLOR)),fshift,lits,1,xx);CHKERRQ(ierr);
     }
   } else if (flag & SOR_LOCAL_BACKWARD_SWEEP) {
     if (flag & SOR_ZERO_INITIAL_GUESS) {
@@ -1474,7 +1512,7 @@ PetscErrorCode MatSOR_MPIAIJ(Mat matin,Vec bb,PetscReal omega,MatSORType flag,Pe
       ierr = (*mat->B->ops->multadd)(mat->B,mat->lvec,bb,bb1);CHKERRQ(ierr);
 
       /* local sweep */
-      ierr = (*mat->A->ops->sor)(mat->A,bb1,omega,SOR_BACKWARD_SWEEP,fshift,lits,1,xx);CHKERRQ(ierr);
+      ierr = (*mat->A->ops->sor)(mat->A,bb1,omega,(MatSORType)(SOR_BACKWARD_SWEEP | (flag & SOR_MULTICOLOR)),fshift,lits,1,xx);CHKERRQ(ierr);
     }
   } else if (flag & SOR_EISENSTAT) {
     Vec xx1;
@@ -2673,7 +2711,9 @@ PetscErrorCode MatInvertVariableBlockDiagonal_MPIAIJ(Mat A,PetscInt nblocks,cons
   PetscErrorCode ierr;
 
   PetscFunctionBegin;
+  ierr = MatFactorClearError(a->A);CHKERRQ(ierr);
   ierr = MatInvertVariableBlockDiagonal(a->A,nblocks,bsizes,diag);CHKERRQ(ierr);
+  A->factorerrortype = a->A->factorerrortype;
   PetscFunctionReturn(0);
 }
 
@@ -6094,6 +6134,7 @@ PETSC_EXTERN PetscErrorCode MatCreate_MPIAIJ(Mat B)
   ierr = PetscObjectComposeFunction((PetscObject)B,"MatIsTranspose_C",MatIsTranspose_MPIAIJ);CHKERRQ(ierr);
   ierr = PetscObjectComposeFunction((PetscObject)B,"MatMPIAIJSetPreallocation_C",MatMPIAIJSetPreallocation_MPIAIJ);CHKERRQ(ierr);
   ierr = PetscObjectComposeFunction((PetscObject)B,"MatResetPreallocation_C",MatResetPreallocation_MPIAIJ);CHKERRQ(ierr);
+  ierr = PetscObjectComposeFunction((PetscObject)B,"MatResidualJacobiUpdate_C",MatResidualJacobiUpdate_MPIAIJ);CHKERRQ(ierr);
   ierr = PetscObjectComposeFunction((PetscObject)B,"MatMPIAIJSetPreallocationCSR_C",MatMPIAIJSetPreallocationCSR_MPIAIJ);CHKERRQ(ierr);
   ierr = PetscObjectComposeFunction((PetscObject)B,"MatDiagonalScaleLocal_C",MatDiagonalScaleLocal_MPIAIJ);CHKERRQ(ierr);
   ierr = PetscObjectComposeFunction((PetscObject)B,"MatConvert_mpiaij_mpiaijperm_C",MatConvert_MPIAIJ_MPIAIJPERM);CHKERRQ(ierr);
@@ -6125,6 +6166,8 @@ PETSC_EXTERN PetscErrorCode MatCreate_MPIAIJ(Mat B)
 #endif
   ierr = PetscObjectComposeFunction((PetscObject)B,"MatProductSetFromOptions_is_mpiaij_C",MatProductSetFromOptions_IS_XAIJ);CHKERRQ(ierr);
   ierr = PetscObjectComposeFunction((PetscObject)B,"MatProductSetFromOptions_mpiaij_mpiaij_C",MatProductSetFromOptions_MPIAIJ);CHKERRQ(ierr);
+  ierr = PetscObjectComposeFunction((PetscObject)B,"MatSetPreallocationCOO_C",MatSetPreallocationCOO_MPIAIJ);CHKERRQ(ierr);
+  ierr = PetscObjectComposeFunction((PetscObject)B,"MatSetValuesCOO_C",MatSetValuesCOO_MPIAIJ);CHKERRQ(ierr);
   ierr = PetscObjectChangeTypeName((PetscObject)B,MATMPIAIJ);CHKERRQ(ierr);
   PetscFunctionReturn(0);
 }
@@ -6205,6 +6248,240 @@ PetscErrorCode MatCreateMPIAIJWithSplitArrays(MPI_Comm comm,PetscInt m,PetscInt
   PetscFunctionReturn(0);
 }
 
+PetscErrorCode MatResetPreallocationCOO_MPIAIJ(Mat mat)
+{
+  Mat_MPIAIJ     *mpiaij = (Mat_MPIAIJ*)mat->data;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  ierr = PetscSFDestroy(&mpiaij->coo_sf);CHKERRQ(ierr);
+  ierr = PetscFree2(mpiaij->Ajmap1,mpiaij->Aperm1);CHKERRQ(ierr);
+  ierr = PetscFree2(mpiaij->Bjmap1,mpiaij->Bperm1);CHKERRQ(ierr);
+  ierr = PetscFree3(mpiaij->Aimap2,mpiaij->Ajmap2,mpiaij->Aperm2);CHKERRQ(ierr);
+  ierr = PetscFree3(mpiaij->Bimap2,mpiaij->Bjmap2,mpiaij->Bperm2);CHKERRQ(ierr);
+  ierr = PetscFree(mpiaij->Cperm1);CHKERRQ(ierr);
+  ierr = PetscFree2(mpiaij->sendbuf,mpiaij->recvbuf);CHKERRQ(ierr);
+  mpiaij->coo_n = mpiaij->Annz = mpiaij->Bnnz = mpiaij->Annz2 = mpiaij->Bnnz2 = 0;
+  PetscFunctionReturn(0);
+}
+
+/*
+   MatSetPreallocationCOO_MPIAIJ - builds the nonzero pattern of the matrix from COO entries and a plan to
+   assemble them with MatSetValuesCOO_MPIAIJ() without hashing, sorting or stashing.
+
+   Entries in rows owned by other processes are shipped once (here) to their owners, which then know which of
+   their nonzeros receive values from the outside. The plan consists of
+     - Cperm1[], the COO entries to pack into the send buffer, and a PetscSF moving it to the owners,
+     - Ajmap1[]/Aperm1[] (Bjmap1[]/Bperm1[]), the locally owned COO entries summed into each nonzero of A (B),
+     - Aimap2[]/Ajmap2[]/Aperm2[] (B...), the received entries summed into the nonzeros that have any.
+*/
+PetscErrorCode MatSetPreallocationCOO_MPIAIJ(Mat mat,PetscInt coo_n,const PetscInt coo_i[],const PetscInt coo_j[])
+{
+  Mat_MPIAIJ     *mpiaij = (Mat_MPIAIJ*)mat->data;
+  MPI_Comm       comm;
+  PetscMPIInt    nto = 0,nfrom,*toranks,*fromranks,owner,prev = -1;
+  PetscInt       *todata,*fromdata,rstart,rend,cstart,cend,m,k,q,l,s,e,k1,k2,row,nsend,nrecv,nloc,nonewA,nonewB = 0;
+  PetscInt       *i1,*j1,*perm1,*sendi,*sendj,*li,*lj,*lt,*Ci,*Cj,Ccnt = 0,Acnt,Bcnt,Annz,Bnnz,Annz2,Bnnz2,n1,n2,p1,p2,*jmap1,*perm1b;
+  PetscSFNode    *iremote;
+  PetscBool      indiag;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  ierr   = PetscObjectGetComm((PetscObject)mat,&comm);CHKERRQ(ierr);
+  ierr   = PetscLayoutSetUp(mat->rmap);CHKERRQ(ierr);
+  ierr   = PetscLayoutSetUp(mat->cmap);CHKERRQ(ierr);
+  ierr   = MatResetPreallocationCOO_MPIAIJ(mat);CHKERRQ(ierr);
+  rstart = mat->rmap->rstart;
+  rend   = mat->rmap->rend;
+  cstart = mat->cmap->rstart;
+  cend   = mat->cmap->rend;
+  m      = rend - rstart;
+
+  /* sort the input by row; rows below rstart come first and rows from rend on come last */
+  ierr = PetscMalloc3(coo_n,&i1,coo_n,&j1,coo_n,&perm1);CHKERRQ(ierr);
+  ierr = PetscArraycpy(i1,coo_i,coo_n);CHKERRQ(ierr);
+  ierr = PetscArraycpy(j1,coo_j,coo_n);CHKERRQ(ierr);
+  for (k=0; k<coo_n; k++) perm1[k] = k;
+  ierr = PetscSortIntWithArrayPair(coo_n,i1,j1,perm1);CHKERRQ(ierr);
+  for (k1=0; k1<coo_n && i1[k1] < rstart; k1++) ;
+  for (k2=k1; k2<coo_n && i1[k2] < rend; k2++) ;
+
+  /* entries to send, ordered by owner since the layout is contiguous */
+  nsend = coo_n - (k2 - k1);
+  ierr  = PetscMalloc2(nsend,&sendi,nsend,&sendj);CHKERRQ(ierr);
+  ierr  = PetscMalloc1(nsend,&mpiaij->Cperm1);CHKERRQ(ierr);
+  for (k=0,q=0; k<k1; k++,q++) {sendi[q] = i1[k]; sendj[q] = j1[k]; mpiaij->Cperm1[q] = perm1[k];}
+  for (k=k2; k<coo_n; k++,q++) {sendi[q] = i1[k]; sendj[q] = j1[k]; mpiaij->Cperm1[q] = perm1[k];}
+  ierr = PetscMalloc2(nsend,&toranks,2*nsend,&todata);CHKERRQ(ierr);
+  for (k=0; k<nsend; k++) {
+    if (k && sendi[k] == sendi[k-1]) owner = prev;
+    else {ierr = PetscLayoutFindOwner(mat->rmap,sendi[k],&owner);CHKERRQ(ierr);}
+    if (owner != prev) {
+      toranks[nto]      = owner;
+      todata[2*nto]     = 0; /* number of entries sent to owner */
+      todata[2*nto+1]   = k; /* their offset in the send buffer */
+      nto++;
+      prev = owner;
+    }
+    todata[2*(nto-1)]++;
+  }
+  ierr = PetscCommBuildTwoSided(comm,2,MPIU_INT,nto,toranks,todata,&nfrom,&fromranks,&fromdata);CHKERRQ(ierr);
+  ierr = PetscFree2(toranks,todata);CHKERRQ(ierr);
+
+  /* each received entry is a leaf attached to its slot in the send buffer of the sender */
+  for (l=0,nrecv=0; l<nfrom; l++) nrecv += fromdata[2*l];
+  ierr = PetscMalloc1(nrecv,&iremote);CHKERRQ(ierr);
+  for (l=0,k=0; l<nfrom; l++) {
+    for (q=0; q<fromdata[2*l]; q++,k++) {
+      iremote[k].rank  = fromranks[l];
+      iremote[k].index = fromdata[2*l+1] + q;
+    }
+  }
+  ierr = PetscFree(fromranks);CHKERRQ(ierr);
+  ierr = PetscFree(fromdata);CHKERRQ(ierr);
+  ierr = PetscSFCreate(comm,&mpiaij->coo_sf);CHKERRQ(ierr);
+  ierr = PetscSFSetGraph(mpiaij->coo_sf,nsend,nrecv,NULL,PETSC_OWN_POINTER,iremote,PETSC_OWN_POINTER);CHKERRQ(ierr);
+  ierr = PetscSFSetUp(mpiaij->coo_sf);CHKERRQ(ierr);
+
+  /* gather the local entries: own entries are tagged with their COO index, received ones with coo_n + their recvbuf index */
+  nloc = (k2 - k1) + nrecv;
+  ierr = PetscMalloc3(nloc,&li,nloc,&lj,nloc,&lt);CHKERRQ(ierr);
+  for (k=k1,q=0; k<k2; k++,q++) {li[q] = i1[k]; lj[q] = j1[k]; lt[q] = perm1[k];}
+  ierr = PetscSFBcastBegin(mpiaij->coo_sf,MPIU_INT,sendi,li+q,MPI_REPLACE);CHKERRQ(ierr);
+  ierr = PetscSFBcastEnd(mpiaij->coo_sf,MPIU_INT,sendi,li+q,MPI_REPLACE);CHKERRQ(ierr);
+  ierr = PetscSFBcastBegin(mpiaij->coo_sf,MPIU_INT,sendj,lj+q,MPI_REPLACE);CHKERRQ(ierr);
+  ierr = PetscSFBcastEnd(mpiaij->coo_sf,MPIU_INT,sendj,lj+q,MPI_REPLACE);CHKERRQ(ierr);
+  for (k=0; k<nrecv; k++) lt[q+k] = coo_n + k;
+  ierr = PetscFree3(i1,j1,perm1);CHKERRQ(ierr);
+  ierr = PetscFree2(sendi,sendj);CHKERRQ(ierr);
+
+  /* sort the local entries by (row,col) and build the CSR of the unique ones */
+  ierr = PetscSortIntWithArrayPair(nloc,li,lj,lt);CHKERRQ(ierr);
+  ierr = PetscCalloc1(m+1,&Ci);CHKERRQ(ierr);
+  ierr = PetscMalloc1(nloc,&Cj);CHKERRQ(ierr);
+  Annz = Bnnz = 0;
+  for (k=0; k<nloc;) {
+    row = li[k];
+    s   = k;
+    while (k < nloc && li[k] == row) k++;
+    ierr = PetscSortIntWithArray(k-s,lj+s,lt+s);CHKERRQ(ierr);
+    for (q=s; q<k; q++) {
+      if (q == s || lj[q] != lj[q-1]) {
+        Cj[Ccnt++] = lj[q];
+        Ci[row-rstart+1]++;
+        if (cstart <= lj[q] && lj[q] < cend) Annz++;
+        else Bnnz++;
+      }
+    }
+  }
+  for (k=0; k<m; k++) Ci[k+1] += Ci[k];
+
+  /* MatMPIAIJSetPreallocationCSR_MPIAIJ() forbids new nonzeros, restore the previous setting */
+  if (mpiaij->A) nonewA = ((Mat_SeqAIJ*)mpiaij->A->data)->nonew;
+  else nonewA = 0;
+  if (mpiaij->B) nonewB = ((Mat_SeqAIJ*)mpiaij->B->data)->nonew;
+  ierr = MatMPIAIJSetPreallocationCSR_MPIAIJ(mat,Ci,Cj,NULL);CHKERRQ(ierr);
+  ((Mat_SeqAIJ*)mpiaij->A->data)->nonew = nonewA;
+  ((Mat_SeqAIJ*)mpiaij->B->data)->nonew = nonewB;
+  ierr = PetscFree(Ci);CHKERRQ(ierr);
+  ierr = PetscFree(Cj);CHKERRQ(ierr);
+  if (((Mat_SeqAIJ*)mpiaij->A->data)->nz != Annz || ((Mat_SeqAIJ*)mpiaij->B->data)->nz != Bnnz) SETERRQ(PETSC_COMM_SELF,PETSC_ERR_PLIB,"Unexpected number of nonzeros after COO preallocation");
+
+  /* Rows of A and B are sorted by global column (garray is sorted) and stored row after row, so walking the
+     unique entries in (row,col) order visits the nonzeros of A and of B in their storage order */
+  n1   = k2 - k1;
+  n2   = nrecv;
+  ierr = PetscMalloc2(Annz+1,&mpiaij->Ajmap1,n1,&mpiaij->Aperm1);CHKERRQ(ierr);
+  ierr = PetscMalloc2(Bnnz+1,&mpiaij->Bjmap1,n1,&mpiaij->Bperm1);CHKERRQ(ierr);
+  ierr = PetscMalloc3(Annz,&mpiaij->Aimap2,Annz+1,&mpiaij->Ajmap2,n2,&mpiaij->Aperm2);CHKERRQ(ierr);
+  ierr = PetscMalloc3(Bnnz,&mpiaij->Bimap2,Bnnz+1,&mpiaij->Bjmap2,n2,&mpiaij->Bperm2);CHKERRQ(ierr);
+  mpiaij->Ajmap1[0] = mpiaij->Bjmap1[0] = mpiaij->Ajmap2[0] = mpiaij->Bjmap2[0] = 0;
+  Acnt = Bcnt = Annz2 = Bnnz2 = 0;
+  for (s=0; s<nloc; s=e) {
+    PetscInt *imap2,*jmap2,*perm2,*nnz2,cnt;
+
+    for (e=s+1; e<nloc && li[e] == li[s] && lj[e] == lj[s]; e++) ;
+    indiag = (PetscBool)(cstart <= lj[s] && lj[s] < cend);
+    if (indiag) {
+      jmap1 = mpiaij->Ajmap1; perm1b = mpiaij->Aperm1; cnt = Acnt++;
+      imap2 = mpiaij->Aimap2; jmap2  = mpiaij->Ajmap2; perm2 = mpiaij->Aperm2; nnz2 = &Annz2;
+    } else {
+      jmap1 = mpiaij->Bjmap1; perm1b = mpiaij->Bperm1; cnt = Bcnt++;
+      imap2 = mpiaij->Bimap2; jmap2  = mpiaij->Bjmap2; perm2 = mpiaij->Bperm2; nnz2 = &Bnnz2;
+    }
+    p1 = jmap1[cnt];
+    p2 = jmap2[*nnz2];
+    for (q=s; q<e; q++) {
+      if (lt[q] < coo_n) perm1b[p1++] = lt[q];
+      else perm2[p2++] = lt[q] - coo_n;
+    }
+    jmap1[cnt+1] = p1;
+    if (p2 > jmap2[*nnz2]) {
+      imap2[*nnz2]   = cnt;
+      jmap2[*nnz2+1] = p2;
+      (*nnz2)++;
+    }
+  }
+  ierr = PetscFree3(li,lj,lt);CHKERRQ(ierr);
+
+  mpiaij->coo_n            = coo_n;
+  mpiaij->Annz             = Annz;
+  mpiaij->Bnnz             = Bnnz;
+  mpiaij->Annz2            = Annz2;
+  mpiaij->Bnnz2            = Bnnz2;
+  mpiaij->coo_nonzerostate = mat->nonzerostate;
+  ierr = PetscMalloc2(nsend,&mpiaij->sendbuf,nrecv,&mpiaij->recvbuf);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+PetscErrorCode MatSetValuesCOO_MPIAIJ(Mat mat,const PetscScalar v[],InsertMode imode)
+{
+  Mat_MPIAIJ        *mpiaij = (Mat_MPIAIJ*)mat->data;
+  Mat               A = mpiaij->A,B = mpiaij->B;
+  PetscInt          i,k,nsend;
+  PetscScalar       *Aa,*Ba,*sendbuf = mpiaij->sendbuf,sum;
+  const PetscScalar *recvbuf = mpiaij->recvbuf;
+  const PetscInt    *Ajmap1 = mpiaij->Ajmap1,*Aperm1 = mpiaij->Aperm1,*Bjmap1 = mpiaij->Bjmap1,*Bperm1 = mpiaij->Bperm1;
+  const PetscInt    *Aimap2 = mpiaij->Aimap2,*Ajmap2 = mpiaij->Ajmap2,*Aperm2 = mpiaij->Aperm2;
+  const PetscInt    *Bimap2 = mpiaij->Bimap2,*Bjmap2 = mpiaij->Bjmap2,*Bperm2 = mpiaij->Bperm2;
+  const PetscInt    *Cperm1 = mpiaij->Cperm1;
+  PetscErrorCode    ierr;
+
+  PetscFunctionBegin;
+  if (!mpiaij->coo_sf) SETERRQ(PETSC_COMM_SELF,PETSC_ERR_ARG_WRONGSTATE,"Must call MatSetPreallocationCOO() first");
+  if (mat->nonzerostate != mpiaij->coo_nonzerostate) SETERRQ(PETSC_COMM_SELF,PETSC_ERR_ARG_WRONGSTATE,"Nonzero pattern changed since MatSetPreallocationCOO(), call it again");
+  ierr = PetscSFGetGraph(mpiaij->coo_sf,&nsend,NULL,NULL,NULL);CHKERRQ(ierr);
+  for (i=0; i<nsend; i++) sendbuf[i] = v ? v[Cperm1[i]] : 0.0;
+  ierr = PetscSFBcastBegin(mpiaij->coo_sf,MPIU_SCALAR,sendbuf,mpiaij->recvbuf,MPI_REPLACE);CHKERRQ(ierr);
+
+  /* sum the local entries while the remote ones are on their way */
+  ierr = MatSeqAIJGetArray(A,&Aa);CHKERRQ(ierr);
+  ierr = MatSeqAIJGetArray(B,&Ba);CHKERRQ(ierr);
+  for (i=0; i<mpiaij->Annz; i++) {
+    sum = 0.0;
+    if (v) for (k=Ajmap1[i]; k<Ajmap1[i+1]; k++) sum += v[Aperm1[k]];
+    Aa[i] = (imode == INSERT_VALUES ? 0.0 : Aa[i]) + sum;
+  }
+  for (i=0; i<mpiaij->Bnnz; i++) {
+    sum = 0.0;
+    if (v) for (k=Bjmap1[i]; k<Bjmap1[i+1]; k++) sum += v[Bperm1[k]];
+    Ba[i] = (imode == INSERT_VALUES ? 0.0 : Ba[i]) + sum;
+  }
+  ierr = PetscSFBcastEnd(mpiaij->coo_sf,MPIU_SCALAR,sendbuf,mpiaij->recvbuf,MPI_REPLACE);CHKERRQ(ierr);
+
+  for (i=0; i<mpiaij->Annz2; i++) {
+    for (k=Ajmap2[i]; k<Ajmap2[i+1]; k++) Aa[Aimap2[i]] += recvbuf[Aperm2[k]];
+  }
+  for (i=0; i<mpiaij->Bnnz2; i++) {
+    for (k=Bjmap2[i]; k<Bjmap2[i+1]; k++) Ba[Bimap2[i]] += recvbuf[Bperm2[k]];
+  }
+  ierr = MatSeqAIJRestoreArray(A,&Aa);CHKERRQ(ierr);
+  ierr = MatSeqAIJRestoreArray(B,&Ba);CHKERRQ(ierr);
+  ierr = MatSeqAIJInvalidateDiagonal(A);CHKERRQ(ierr);
+  ierr = MatSeqAIJInvalidateDiagonal(B);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
 /*
     Special version for direct calls from Fortran
 */
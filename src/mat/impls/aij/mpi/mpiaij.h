@@ -54,6 +54,7 @@ typedef struct {
   /* The following variables are used for matrix-vector products */
   Vec        lvec;                 /* local vector */
   Vec        diag;
+  Vec        rwork;                /* product of the diagonal block used by MatResidualJacobiUpdate() */
   VecScatter Mvctx;                /* scatter context for vector */
   PetscBool  roworiented;          /* if true, row-oriented input, default true */
 
@@ -67,6 +68,18 @@ typedef struct {
   /* Used by device classes */
   void * spptr;
 
+  /* MatSetPreallocationCOO()/MatSetValuesCOO() related fields */
+  PetscInt         coo_n;                      /* number of entries in the COO input */
+  PetscInt         Annz,Bnnz;                  /* number of nonzeros in A and B */
+  PetscInt         *Ajmap1,*Aperm1;            /* Aa[k] gets the sum of coo_v[Aperm1[Ajmap1[k]..Ajmap1[k+1])] */
+  PetscInt         *Bjmap1,*Bperm1;            /* same for Ba[] */
+  PetscInt         Annz2,Bnnz2;                /* number of nonzeros of A and B receiving entries from other processes */
+  PetscInt         *Aimap2,*Ajmap2,*Aperm2;    /* Aa[Aimap2[k]] += sum of recvbuf[Aperm2[Ajmap2[k]..Ajmap2[k+1])] */
+  PetscInt         *Bimap2,*Bjmap2,*Bperm2;    /* same for Ba[] */
+  PetscInt         *Cperm1;                    /* sendbuf[k] = coo_v[Cperm1[k]] */
+  PetscSF          coo_sf;                     /* moves sendbuf[] to recvbuf[] on the owners of the rows */
+  PetscScalar      *sendbuf,*recvbuf;
+  PetscObjectState coo_nonzerostate;           /* nonzero state of the matrix when the COO map was built */
 } Mat_MPIAIJ;
 
 PETSC_EXTERN PetscErrorCode MatCreate_MPIAIJ(Mat);
@@ -137,6 +150,9 @@ PETSC_INTERN PetscErrorCode MatDestroy_MPIAIJ_PtAP(void*);
 PETSC_INTERN PetscErrorCode MatDestroy_MPIAIJ_MatMatMult(void*);
 
 PETSC_INTERN PetscErrorCode MatGetBrowsOfAoCols_MPIAIJ(Mat,Mat,MatReuse,PetscInt**,PetscInt**,MatScalar**,Mat*);
+PETSC_INTERN PetscErrorCode MatSetPreallocationCOO_MPIAIJ(Mat,PetscInt,const PetscInt[],const PetscInt[]);
+PETSC_INTERN PetscErrorCode MatSetValuesCOO_MPIAIJ(Mat,const PetscScalar[],InsertMode);
+PETSC_INTERN PetscErrorCode MatResetPreallocationCOO_MPIAIJ(Mat);
 PETSC_INTERN PetscErrorCode MatSetValues_MPIAIJ(Mat,PetscInt,const PetscInt[],PetscInt,const PetscInt[],const PetscScalar [],InsertMode);
 PETSC_INTERN PetscErrorCode MatSetValues_MPIAIJ_CopyFromCSRFormat(Mat,const PetscInt[],const PetscInt[],const PetscScalar[]);
 PETSC_INTERN PetscErrorCode MatSetValues_MPIAIJ_CopyFromCSRFormat_Symbolic(Mat,const PetscInt[],const PetscInt[]);
@@ -113,6 +113,12 @@ static PetscErrorCode MatSetPreallocationCOO_MPIAIJCUSPARSE(Mat B, PetscInt n, c
   PetscFunctionBegin;
   ierr = PetscLayoutSetUp(B->rmap);CHKERRQ(ierr);
   ierr = PetscLayoutSetUp(B->cmap);CHKERRQ(ierr);
+  if (PetscDefined(USE_DEBUG)) {
+    PetscInt i;
+    for (i = 0; i < n; i++) {
+      if (coo_i[i] < B->rmap->rstart || coo_i[i] >= B->rmap->rend) SETERRQ3(PETSC_COMM_SELF,PETSC_ERR_SUP,"Invalid row index %D! Must be in [%D,%D)",coo_i[i],B->rmap->rstart,B->rmap->rend);
+    }
+  }
   if (b->A) { ierr = MatCUSPARSEClearHandle(b->A);CHKERRQ(ierr); }
   if (b->B) { ierr = MatCUSPARSEClearHandle(b->B);CHKERRQ(ierr); }
   ierr = PetscFree(b->garray);CHKERRQ(ierr);
@@ -7,6 +7,9 @@
 #include <petscblaslapack.h>
 #include <petscbt.h>
 #include <petsc/private/kernels/blocktranspose.h>
+#if defined(PETSC_HAVE_OPENMP)
+#include <omp.h>
+#endif
 
 PetscErrorCode MatSeqAIJSetTypeFromOptions(Mat A)
 {
@@ -1138,6 +1141,59 @@ PetscErrorCode MatView_SeqAIJ_Draw(Mat A,PetscViewer viewer)
   PetscFunctionReturn(0);
 }
 
+const char *const MatSeqAIJKernels[] = {"aij","inode","sell","baij"};
+
+static PetscErrorCode MatView_SeqAIJ_Autotune(Mat A,PetscViewer viewer)
+{
+  Mat_SeqAIJ          *a = (Mat_SeqAIJ*)A->data;
+  Mat_SeqAIJ_Autotune *at = &a->autotune;
+  PetscErrorCode      ierr;
+  PetscBool           iascii;
+  PetscViewerFormat   format;
+  PetscInt            k;
+
+  PetscFunctionBegin;
+  if (!at->use) PetscFunctionReturn(0);
+  ierr = PetscObjectTypeCompare((PetscObject)viewer,PETSCVIEWERASCII,&iascii);CHKERRQ(ierr);
+  if (!iascii) PetscFunctionReturn(0);
+  ierr = PetscViewerGetFormat(viewer,&format);CHKERRQ(ierr);
+  if (format != PETSC_VIEWER_ASCII_INFO_DETAIL && format != PETSC_VIEWER_ASCII_INFO) PetscFunctionReturn(0);
+  if (!at->tuned) {
+    ierr = PetscViewerASCIIPrintf(viewer,"MatMult() kernel not autotuned yet, applied %D of %D times\n",at->nmult,at->threshold);CHKERRQ(ierr);
+    PetscFunctionReturn(0);
+  }
+  ierr = PetscViewerASCIIPrintf(viewer,"MatMult() kernel chosen by autotuning: %s\n",MatSeqAIJKernels[at->kernel]);CHKERRQ(ierr);
+  if (format == PETSC_VIEWER_ASCII_INFO_DETAIL) {
+    ierr = PetscViewerASCIIPushTab(viewer);CHKERRQ(ierr);
+    for (k=0; k<MAT_SEQAIJ_KERNEL_N; k++) {
+      if (at->time[k] > 0.0) {ierr = PetscViewerASCIIPrintf(viewer,"%s: %g seconds per product\n",MatSeqAIJKernels[k],at->time[k]);CHKERRQ(ierr);}
+    }
+    ierr = PetscViewerASCIIPopTab(viewer);CHKERRQ(ierr);
+  }
+  PetscFunctionReturn(0);
+}
+
+static PetscErrorCode MatView_SeqAIJ_CompressedIndices(Mat A,PetscViewer viewer)
+{
+  Mat_SeqAIJ        *a = (Mat_SeqAIJ*)A->data;
+  PetscErrorCode    ierr;
+  PetscBool         iascii;
+  PetscViewerFormat format;
+
+  PetscFunctionBegin;
+  if (!a->cind.use) PetscFunctionReturn(0);
+  ierr = PetscObjectTypeCompare((PetscObject)viewer,PETSCVIEWERASCII,&iascii);CHKERRQ(ierr);
+  if (!iascii) PetscFunctionReturn(0);
+  ierr = PetscViewerGetFormat(viewer,&format);CHKERRQ(ierr);
+  if (format != PETSC_VIEWER_ASCII_INFO_DETAIL && format != PETSC_VIEWER_ASCII_INFO) PetscFunctionReturn(0);
+  if (a->cind.width && a->cind.nonzerostate == A->nonzerostate) {
+    ierr = PetscViewerASCIIPrintf(viewer,"column indices compressed to %D bit offsets\n",8*a->cind.width);CHKERRQ(ierr);
+  } else {
+    ierr = PetscViewerASCIIPrintf(viewer,"column indices not compressed\n");CHKERRQ(ierr);
+  }
+  PetscFunctionReturn(0);
+}
+
 PetscErrorCode MatView_SeqAIJ(Mat A,PetscViewer viewer)
 {
   PetscErrorCode ierr;
@@ -1155,6 +1211,162 @@ PetscErrorCode MatView_SeqAIJ(Mat A,PetscViewer viewer)
     ierr = MatView_SeqAIJ_Draw(A,viewer);CHKERRQ(ierr);
   }
   ierr = MatView_SeqAIJ_Inode(A,viewer);CHKERRQ(ierr);
+  ierr = MatView_SeqAIJ_Autotune(A,viewer);CHKERRQ(ierr);
+  ierr = MatView_SeqAIJ_CompressedIndices(A,viewer);CHKERRQ(ierr);
+  ierr = MatView_SeqAIJ_Levels(A,viewer);CHKERRQ(ierr);
+  ierr = MatView_SeqAIJ_Iterative(A,viewer);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+#if defined(PETSC_HAVE_OPENMP)
+/*
+   Splits the (compressed) rows of the matrix into PetscNumOMPThreads contiguous blocks with about the same number
+   of nonzeros. Block t is always processed by thread t of the team, both by the kernels and when the arrays are
+   first touched in MatSeqAIJOMPFirstTouch_Private(), so each thread streams memory local to its NUMA domain.
+*/
+static PetscErrorCode MatSeqAIJOMPSetUp_Private(Mat A)
+{
+  Mat_SeqAIJ     *a = (Mat_SeqAIJ*)A->data;
+  PetscErrorCode ierr;
+  PetscInt       nt = PetscMax(PetscNumOMPThreads,1),nrows,t,lo,hi,mid,target,*rows,maxnz = 0;
+  const PetscInt *ii;
+  PetscInt64     nz;
+  PetscBool      cprow = a->compressedrow.use;
+
+  PetscFunctionBegin;
+  if (a->omp.rows && a->omp.nthreads == nt && a->omp.cprow == cprow && a->omp.mat_nonzerostate == A->nonzerostate) PetscFunctionReturn(0);
+  ierr = PetscFree(a->omp.rows);CHKERRQ(ierr);
+  ierr = PetscFree(a->omp.work);CHKERRQ(ierr);
+  if (cprow) {
+    nrows = a->compressedrow.nrows;
+    ii    = a->compressedrow.i;
+  } else {
+    nrows = A->rmap->n;
+    ii    = a->i;
+  }
+  ierr    = PetscMalloc1(nt+1,&rows);CHKERRQ(ierr);
+  nz      = ii[nrows] - ii[0];
+  rows[0] = 0;
+  for (t=1; t<nt; t++) { /* first row starting at or after the t-th fraction of the nonzeros */
+    target = ii[0] + (PetscInt)((t*nz)/nt);
+    lo     = rows[t-1];
+    hi     = nrows;
+    while (lo < hi) {
+      mid = lo + (hi - lo)/2;
+      if (ii[mid] < target) lo = mid + 1;
+      else hi = mid;
+    }
+    rows[t] = lo;
+  }
+  rows[nt] = nrows;
+  for (t=0; t<nt; t++) maxnz = PetscMax(maxnz,ii[rows[t+1]] - ii[rows[t]]);
+
+  a->omp.nthreads         = nt;
+  a->omp.rows             = rows;
+  a->omp.cprow            = cprow;
+  a->omp.mat_nonzerostate = A->nonzerostate;
+  a->omp.touched          = PETSC_FALSE;
+  ierr = PetscInfo3(A,"Using %D OpenMP threads on %D rows, largest block has %D nonzeros\n",nt,nrows,maxnz);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+/*
+   Moves a, i and j into freshly allocated arrays whose pages are first written by the thread owning the
+   corresponding row block. Arrays provided by the user or shared with another matrix are left in place.
+   Nothing is copied again while the nonzero structure, the row partition and the arrays are unchanged, so
+   assemblies that only change the values are free.
+*/
+static PetscErrorCode MatSeqAIJOMPFirstTouch_Private(Mat A)
+{
+  Mat_SeqAIJ      *a = (Mat_SeqAIJ*)A->data;
+  PetscErrorCode  ierr;
+  PetscInt        m = A->rmap->n,nt = a->omp.nthreads,*ni,*nj;
+  const PetscInt  *ii = a->omp.cprow ? a->compressedrow.i : a->i,*rows = a->omp.rows,*aj = a->j;
+  MatScalar       *na;
+  const MatScalar *aa = a->a;
+
+  PetscFunctionBegin;
+  if (a->omp.touched && a->omp.touched_nonzerostate == A->nonzerostate && a->omp.touched_a == a->a) PetscFunctionReturn(0);
+  if (!a->singlemalloc && !(a->free_a && a->free_ij)) PetscFunctionReturn(0);
+  if (a->parent) PetscFunctionReturn(0);
+  ierr = PetscMalloc1(a->nz,&na);CHKERRQ(ierr);
+  ierr = PetscMalloc1(a->nz,&nj);CHKERRQ(ierr);
+  ierr = PetscMalloc1(m+1,&ni);CHKERRQ(ierr);
+  ierr = PetscArraycpy(ni,a->i,m+1);CHKERRQ(ierr);
+#pragma omp parallel num_threads((int)nt)
+  {
+    PetscInt p,k;
+
+    for (p=omp_get_thread_num(); p<nt; p+=omp_get_num_threads()) {
+      for (k=ii[rows[p]]; k<ii[rows[p+1]]; k++) {
+        na[k] = aa[k];
+        nj[k] = aj[k];
+      }
+    }
+  }
+  ierr = MatSeqXAIJFreeAIJ(A,&a->a,&a->j,&a->i);CHKERRQ(ierr);
+  a->a            = na;
+  a->j            = nj;
+  a->i            = ni;
+  a->singlemalloc = PETSC_FALSE;
+  a->free_a       = PETSC_TRUE;
+  a->free_ij      = PETSC_TRUE;
+  a->maxnz        = a->nz;
+
+  a->omp.touched              = PETSC_TRUE;
+  a->omp.touched_nonzerostate = A->nonzerostate;
+  a->omp.touched_a            = a->a;
+  PetscFunctionReturn(0);
+}
+#endif
+
+/*
+   Stores the column indices of each row as 8 or 16 bit offsets from the smallest column of the row, when all
+   the rows fit; the offsets are only computed again when the nonzero structure changes
+*/
+static PetscErrorCode MatSeqAIJCompressIndices_Private(Mat A)
+{
+  Mat_SeqAIJ     *a = (Mat_SeqAIJ*)A->data;
+  PetscErrorCode ierr;
+  PetscInt       m = A->rmap->n,i,k,lo,span = 0,width;
+  const PetscInt *ai = a->i,*aj = a->j;
+
+  PetscFunctionBegin;
+  if (a->cind.base && a->cind.nonzerostate == A->nonzerostate) PetscFunctionReturn(0);
+  ierr = PetscFree(a->cind.base);CHKERRQ(ierr);
+  ierr = PetscFree(a->cind.off);CHKERRQ(ierr);
+  a->cind.width = 0;
+  for (i=0; i<m; i++) {
+    if (ai[i+1] == ai[i]) continue;
+    lo = aj[ai[i]];
+    for (k=ai[i]+1; k<ai[i+1]; k++) lo = PetscMin(lo,aj[k]);
+    for (k=ai[i]; k<ai[i+1]; k++) span = PetscMax(span,aj[k]-lo);
+  }
+  if (span <= UCHAR_MAX) width = 1;
+  else if (span <= USHRT_MAX) width = 2;
+  else {
+    ierr = PetscInfo1(A,"Not compressing the column indices, a row spans %D columns\n",span+1);CHKERRQ(ierr);
+    PetscFunctionReturn(0);
+  }
+  ierr = PetscMalloc1(m,&a->cind.base);CHKERRQ(ierr);
+  ierr = PetscMalloc(a->nz*width,&a->cind.off);CHKERRQ(ierr);
+  ierr = PetscLogObjectMemory((PetscObject)A,m*sizeof(PetscInt)+a->nz*width);CHKERRQ(ierr);
+  for (i=0; i<m; i++) {
+    lo = 0;
+    if (ai[i+1] > ai[i]) lo = aj[ai[i]];
+    for (k=ai[i]+1; k<ai[i+1]; k++) lo = PetscMin(lo,aj[k]);
+    a->cind.base[i] = lo;
+    if (width == 1) {
+      unsigned char *off = (unsigned char*)a->cind.off;
+      for (k=ai[i]; k<ai[i+1]; k++) off[k] = (unsigned char)(aj[k]-lo);
+    } else {
+      unsigned short *off = (unsigned short*)a->cind.off;
+      for (k=ai[i]; k<ai[i+1]; k++) off[k] = (unsigned short)(aj[k]-lo);
+    }
+  }
+  a->cind.width        = width;
+  a->cind.nonzerostate = A->nonzerostate;
+  ierr = PetscInfo2(A,"Compressed the column indices to %D bit offsets, largest offset %D\n",8*width,span);CHKERRQ(ierr);
   PetscFunctionReturn(0);
 }
 
@@ -1224,6 +1436,15 @@ PetscErrorCode MatAssemblyEnd_SeqAIJ(Mat A,MatAssemblyType mode)
   if (!A->structure_only) {
     ierr = MatCheckCompressedRow(A,a->nonzerorowcnt,&a->compressedrow,a->i,m,ratio);CHKERRQ(ierr);
   }
+#if defined(PETSC_HAVE_OPENMP)
+  if (a->omp.use && !A->structure_only && !A->factortype) {
+    ierr = MatSeqAIJOMPSetUp_Private(A);CHKERRQ(ierr);
+    ierr = MatSeqAIJOMPFirstTouch_Private(A);CHKERRQ(ierr);
+  }
+#endif
+  if (a->cind.use && !A->structure_only && !A->factortype) {
+    ierr = MatSeqAIJCompressIndices_Private(A);CHKERRQ(ierr);
+  }
   ierr = MatAssemblyEnd_SeqAIJ_Inode(A,mode);CHKERRQ(ierr);
   PetscFunctionReturn(0);
 }
@@ -1300,6 +1521,19 @@ PetscErrorCode MatDestroy_SeqAIJ(Mat A)
   ierr = ISDestroy(&a->icol);CHKERRQ(ierr);
   ierr = PetscFree(a->saved_values);CHKERRQ(ierr);
   ierr = PetscFree2(a->compressedrow.i,a->compressedrow.rindex);CHKERRQ(ierr);
+  ierr = MatResetPreallocationCOO_SeqAIJ(A);CHKERRQ(ierr);
+  ierr = PetscFree(a->omp.rows);CHKERRQ(ierr);
+  ierr = PetscFree(a->omp.work);CHKERRQ(ierr);
+  ierr = MatDestroy(&a->autotune.shadow);CHKERRQ(ierr);
+  ierr = PetscFree(a->mixed.a);CHKERRQ(ierr);
+  ierr = PetscFree(a->cind.base);CHKERRQ(ierr);
+  ierr = PetscFree(a->cind.off);CHKERRQ(ierr);
+  ierr = PetscHMapIJDestroy(&a->hash.ht);CHKERRQ(ierr);
+  ierr = PetscFree(a->hash.v);CHKERRQ(ierr);
+  ierr = PetscFree(a->hash.rlen);CHKERRQ(ierr);
+  ierr = MatSeqAIJLevelsReset_Private(A);CHKERRQ(ierr);
+  ierr = MatSeqAIJIterativeReset_Private(A);CHKERRQ(ierr);
+  ierr = MatSORColoringReset_Private(&a->sorcolor);CHKERRQ(ierr);
 
   ierr = MatDestroy_SeqAIJ_Inode(A);CHKERRQ(ierr);
   ierr = PetscFree(A->data);CHKERRQ(ierr);
@@ -1343,12 +1577,15 @@ PetscErrorCode MatDestroy_SeqAIJ(Mat A)
   ierr = PetscObjectComposeFunction((PetscObject)A,"MatIsTranspose_C",NULL);CHKERRQ(ierr);
   ierr = PetscObjectComposeFunction((PetscObject)A,"MatSeqAIJSetPreallocation_C",NULL);CHKERRQ(ierr);
   ierr = PetscObjectComposeFunction((PetscObject)A,"MatResetPreallocation_C",NULL);CHKERRQ(ierr);
+  ierr = PetscObjectComposeFunction((PetscObject)A,"MatResidualJacobiUpdate_C",NULL);CHKERRQ(ierr);
   ierr = PetscObjectComposeFunction((PetscObject)A,"MatSeqAIJSetPreallocationCSR_C",NULL);CHKERRQ(ierr);
   ierr = PetscObjectComposeFunction((PetscObject)A,"MatReorderForNonzeroDiagonal_C",NULL);CHKERRQ(ierr);
   ierr = PetscObjectComposeFunction((PetscObject)A,"MatProductSetFromOptions_is_seqaij_C",NULL);CHKERRQ(ierr);
   ierr = PetscObjectComposeFunction((PetscObject)A,"MatProductSetFromOptions_seqdense_seqaij_C",NULL);CHKERRQ(ierr);
   ierr = PetscObjectComposeFunction((PetscObject)A,"MatProductSetFromOptions_seqaij_seqaij_C",NULL);CHKERRQ(ierr);
   ierr = PetscObjectComposeFunction((PetscObject)A,"MatSeqAIJKron_C",NULL);CHKERRQ(ierr);
+  ierr = PetscObjectComposeFunction((PetscObject)A,"MatSetPreallocationCOO_C",NULL);CHKERRQ(ierr);
+  ierr = PetscObjectComposeFunction((PetscObject)A,"MatSetValuesCOO_C",NULL);CHKERRQ(ierr);
   PetscFunctionReturn(0);
 }
 
@@ -1448,7 +1685,257 @@ PetscErrorCode MatGetDiagonal_SeqAIJ(Mat A,Vec v)
   PetscFunctionReturn(0);
 }
 
+#if defined(PETSC_HAVE_OPENMP)
+/*
+   z = y + A x (or z = A x when yy is NULL) with each thread handling its block of rows from MatSeqAIJOMPSetUp_Private()
+*/
+static PetscErrorCode MatMultAdd_SeqAIJ_OMP(Mat A,Vec xx,Vec yy,Vec zz)
+{
+  Mat_SeqAIJ        *a = (Mat_SeqAIJ*)A->data;
+  PetscErrorCode    ierr;
+  PetscScalar       *y = NULL,*z;
+  const PetscScalar *x;
+  PetscInt          m = A->rmap->n,nt;
+  const PetscInt    *ii,*ridx = NULL,*rows;
+  PetscBool         cprow;
+
+  PetscFunctionBegin;
+  ierr  = MatSeqAIJOMPSetUp_Private(A);CHKERRQ(ierr);
+  nt    = a->omp.nthreads;
+  rows  = a->omp.rows;
+  cprow = a->omp.cprow;
+  if (cprow) {
+    ii   = a->compressedrow.i;
+    ridx = a->compressedrow.rindex;
+  } else ii = a->i;
+  ierr = VecGetArrayRead(xx,&x);CHKERRQ(ierr);
+  if (yy) {
+    ierr = VecGetArrayPair(yy,zz,&y,&z);CHKERRQ(ierr);
+  } else {
+    ierr = VecGetArrayWrite(zz,&z);CHKERRQ(ierr);
+  }
+#pragma omp parallel num_threads((int)nt)
+  {
+    const PetscInt  tid = omp_get_thread_num(),nth = omp_get_num_threads();
+    const PetscInt  *aj;
+    const MatScalar *aa;
+    PetscInt        p,i,n;
+    PetscScalar     sum;
+
+    if (cprow) { /* rows without nonzeros are not part of any block */
+      PetscInt chunk = (m + nth - 1)/nth,lo = PetscMin(m,tid*chunk),hi = PetscMin(m,lo+chunk);
+
+      if (!y) for (i=lo; i<hi; i++) z[i] = 0.0;
+      else if (z != y) for (i=lo; i<hi; i++) z[i] = y[i];
+#pragma omp barrier
+    }
+    for (p=tid; p<nt; p+=nth) {
+      for (i=rows[p]; i<rows[p+1]; i++) {
+        n   = ii[i+1] - ii[i];
+        aj  = a->j + ii[i];
+        aa  = a->a + ii[i];
+        sum = cprow ? z[ridx[i]] : (y ? y[i] : 0.0);
+        PetscSparseDensePlusDot(sum,x,aa,aj,n);
+        if (cprow) z[ridx[i]] = sum;
+        else z[i] = sum;
+      }
+    }
+  }
+  ierr = PetscLogFlops(yy ? 2.0*a->nz : 2.0*a->nz - a->nonzerorowcnt);CHKERRQ(ierr);
+  ierr = VecRestoreArrayRead(xx,&x);CHKERRQ(ierr);
+  if (yy) {
+    ierr = VecRestoreArrayPair(yy,zz,&y,&z);CHKERRQ(ierr);
+  } else {
+    ierr = VecRestoreArrayWrite(zz,&z);CHKERRQ(ierr);
+  }
+  PetscFunctionReturn(0);
+}
+
+/*
+   y = z + A^T x (or y = A^T x when zz is NULL); each thread scatters its block of rows into a private
+   accumulator and the accumulators are then summed by chunks of columns
+*/
+static PetscErrorCode MatMultTransposeAdd_SeqAIJ_OMP(Mat A,Vec xx,Vec zz,Vec yy)
+{
+  Mat_SeqAIJ        *a = (Mat_SeqAIJ*)A->data;
+  PetscErrorCode    ierr;
+  PetscScalar       *y,*z = NULL,*work;
+  const PetscScalar *x;
+  PetscInt          n = A->cmap->n,nt;
+  const PetscInt    *ii,*ridx = NULL,*rows;
+  PetscBool         cprow;
+
+  PetscFunctionBegin;
+  ierr  = MatSeqAIJOMPSetUp_Private(A);CHKERRQ(ierr);
+  nt    = a->omp.nthreads;
+  rows  = a->omp.rows;
+  cprow = a->omp.cprow;
+  if (!a->omp.work) {ierr = PetscMalloc1(nt*n,&a->omp.work);CHKERRQ(ierr);}
+  work = a->omp.work;
+  if (cprow) {
+    ii   = a->compressedrow.i;
+    ridx = a->compressedrow.rindex;
+  } else ii = a->i;
+  ierr = VecGetArrayRead(xx,&x);CHKERRQ(ierr);
+  if (zz) {
+    ierr = VecGetArrayPair(zz,yy,&z,&y);CHKERRQ(ierr);
+  } else {
+    ierr = VecGetArrayWrite(yy,&y);CHKERRQ(ierr);
+  }
+#pragma omp parallel num_threads((int)nt)
+  {
+    const PetscInt  tid = omp_get_thread_num(),nth = omp_get_num_threads();
+    PetscInt        chunk = (n + nth - 1)/nth,lo = PetscMin(n,tid*chunk),hi = PetscMin(n,lo+chunk);
+    PetscInt        p,i,j,len,c;
+    const PetscInt  *idx;
+    const MatScalar *v;
+    PetscScalar     alpha,*w,sum;
+
+    for (p=tid; p<nt; p+=nth) {
+      w = work + p*n;
+      for (c=0; c<n; c++) w[c] = 0.0;
+      for (i=rows[p]; i<rows[p+1]; i++) {
+        idx   = a->j + ii[i];
+        v     = a->a + ii[i];
+        len   = ii[i+1] - ii[i];
+        alpha = cprow ? x[ridx[i]] : x[i];
+        for (j=0; j<len; j++) w[idx[j]] += alpha*v[j];
+      }
+    }
+#pragma omp barrier
+    for (c=lo; c<hi; c++) {
+      sum = z ? z[c] : 0.0;
+      for (p=0; p<nt; p++) sum += work[p*n+c];
+      y[c] = sum;
+    }
+  }
+  ierr = PetscLogFlops(2.0*a->nz);CHKERRQ(ierr);
+  ierr = VecRestoreArrayRead(xx,&x);CHKERRQ(ierr);
+  if (zz) {
+    ierr = VecRestoreArrayPair(zz,yy,&z,&y);CHKERRQ(ierr);
+  } else {
+    ierr = VecRestoreArrayWrite(yy,&y);CHKERRQ(ierr);
+  }
+  PetscFunctionReturn(0);
+}
+#endif
+
 #include <../src/mat/impls/aij/seq/ftn-kernels/fmult.h>
+/* computes zz = A*xx + yy, or zz = A*xx if yy is NULL, with the compressed column indices */
+static PetscErrorCode MatMultAdd_SeqAIJ_CompressedIndices(Mat A,Vec xx,Vec yy,Vec zz)
+{
+  Mat_SeqAIJ        *a = (Mat_SeqAIJ*)A->data;
+  PetscScalar       *y = NULL,*z,sum;
+  const PetscScalar *x,*xb,*w;
+  const MatScalar   *aa = a->a,*v;
+  const PetscInt    *ii = a->i,*ridx = NULL;
+  PetscInt          m = A->rmap->n,n,i,k,r;
+  PetscErrorCode    ierr;
+
+  PetscFunctionBegin;
+  ierr = VecGetArrayRead(xx,&x);CHKERRQ(ierr);
+  if (yy) {
+    ierr = VecGetArrayPair(yy,zz,&y,&z);CHKERRQ(ierr);
+  } else {
+    ierr = VecGetArrayWrite(zz,&z);CHKERRQ(ierr);
+  }
+  w = y;
+  if (a->compressedrow.use) { /* use compressed row format */
+    if (!y) {
+      ierr = PetscArrayzero(z,m);CHKERRQ(ierr);
+    } else if (z != y) {
+      ierr = PetscArraycpy(z,y,m);CHKERRQ(ierr);
+    }
+    w    = z; /* the rows without nonzeros are already set */
+    m    = a->compressedrow.nrows;
+    ii   = a->compressedrow.i;
+    ridx = a->compressedrow.rindex;
+  }
+  if (a->cind.width == 1) {
+    const unsigned char *off = (const unsigned char*)a->cind.off,*o;
+    for (i=0; i<m; i++) {
+      r   = ridx ? ridx[i] : i;
+      n   = ii[i+1] - ii[i];
+      v   = aa + ii[i];
+      o   = off + ii[i];
+      xb  = x + a->cind.base[r];
+      sum = w ? w[r] : 0.0;
+      for (k=0; k<n; k++) sum += v[k]*xb[o[k]];
+      z[r] = sum;
+    }
+  } else {
+    const unsigned short *off = (const unsigned short*)a->cind.off,*o;
+    for (i=0; i<m; i++) {
+      r   = ridx ? ridx[i] : i;
+      n   = ii[i+1] - ii[i];
+      v   = aa + ii[i];
+      o   = off + ii[i];
+      xb  = x + a->cind.base[r];
+      sum = w ? w[r] : 0.0;
+      for (k=0; k<n; k++) sum += v[k]*xb[o[k]];
+      z[r] = sum;
+    }
+  }
+  ierr = PetscLogFlops(yy ? 2.0*a->nz : 2.0*a->nz - a->nonzerorowcnt);CHKERRQ(ierr);
+  ierr = VecRestoreArrayRead(xx,&x);CHKERRQ(ierr);
+  if (yy) {
+    ierr = VecRestoreArrayPair(yy,zz,&y,&z);CHKERRQ(ierr);
+  } else {
+    ierr = VecRestoreArrayWrite(zz,&z);CHKERRQ(ierr);
+  }
+  PetscFunctionReturn(0);
+}
+
+/* computes yy += A^T*xx with the compressed column indices; the offsets within a row are distinct so the updates do not conflict */
+static PetscErrorCode MatMultTransposeAdd_SeqAIJ_CompressedIndices(Mat A,Vec xx,Vec yy)
+{
+  Mat_SeqAIJ        *a = (Mat_SeqAIJ*)A->data;
+  PetscScalar       *y,*yb,alpha;
+  const PetscScalar *x;
+  const MatScalar   *aa = a->a,*v;
+  const PetscInt    *ii = a->i,*ridx = NULL;
+  PetscInt          m = A->rmap->n,n,i,k,r;
+  PetscErrorCode    ierr;
+
+  PetscFunctionBegin;
+  ierr = VecGetArrayRead(xx,&x);CHKERRQ(ierr);
+  ierr = VecGetArray(yy,&y);CHKERRQ(ierr);
+  if (a->compressedrow.use) {
+    m    = a->compressedrow.nrows;
+    ii   = a->compressedrow.i;
+    ridx = a->compressedrow.rindex;
+  }
+  if (a->cind.width == 1) {
+    const unsigned char *off = (const unsigned char*)a->cind.off,*o;
+    for (i=0; i<m; i++) {
+      r     = ridx ? ridx[i] : i;
+      n     = ii[i+1] - ii[i];
+      v     = aa + ii[i];
+      o     = off + ii[i];
+      yb    = y + a->cind.base[r];
+      alpha = x[r];
+      PetscPragmaSIMD
+      for (k=0; k<n; k++) yb[o[k]] += alpha*v[k];
+    }
+  } else {
+    const unsigned short *off = (const unsigned short*)a->cind.off,*o;
+    for (i=0; i<m; i++) {
+      r     = ridx ? ridx[i] : i;
+      n     = ii[i+1] - ii[i];
+      v     = aa + ii[i];
+      o     = off + ii[i];
+      yb    = y + a->cind.base[r];
+      alpha = x[r];
+      PetscPragmaSIMD
+      for (k=0; k<n; k++) yb[o[k]] += alpha*v[k];
+    }
+  }
+  ierr = PetscLogFlops(2.0*a->nz);CHKERRQ(ierr);
+  ierr = VecRestoreArrayRead(xx,&x);CHKERRQ(ierr);
+  ierr = VecRestoreArray(yy,&y);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
 PetscErrorCode MatMultTransposeAdd_SeqAIJ(Mat A,Vec xx,Vec zz,Vec yy)
 {
   Mat_SeqAIJ        *a = (Mat_SeqAIJ*)A->data;
@@ -1466,7 +1953,17 @@ PetscErrorCode MatMultTransposeAdd_SeqAIJ(Mat A,Vec xx,Vec zz,Vec yy)
 #endif
 
   PetscFunctionBegin;
+#if defined(PETSC_HAVE_OPENMP)
+  if (a->omp.use) {
+    ierr = MatMultTransposeAdd_SeqAIJ_OMP(A,xx,zz,yy);CHKERRQ(ierr);
+    PetscFunctionReturn(0);
+  }
+#endif
   if (zz != yy) {ierr = VecCopy(zz,yy);CHKERRQ(ierr);}
+  if (a->cind.width && a->cind.nonzerostate == A->nonzerostate) {
+    ierr = MatMultTransposeAdd_SeqAIJ_CompressedIndices(A,xx,yy);CHKERRQ(ierr);
+    PetscFunctionReturn(0);
+  }
   ierr = VecGetArrayRead(xx,&x);CHKERRQ(ierr);
   ierr = VecGetArray(yy,&y);CHKERRQ(ierr);
 
@@ -1501,13 +1998,236 @@ PetscErrorCode MatMultTransposeAdd_SeqAIJ(Mat A,Vec xx,Vec zz,Vec yy)
 PetscErrorCode MatMultTranspose_SeqAIJ(Mat A,Vec xx,Vec yy)
 {
   PetscErrorCode ierr;
+#if defined(PETSC_HAVE_OPENMP)
+  Mat_SeqAIJ     *a = (Mat_SeqAIJ*)A->data;
+#endif
 
   PetscFunctionBegin;
+#if defined(PETSC_HAVE_OPENMP)
+  if (a->omp.use) {
+    ierr = MatMultTransposeAdd_SeqAIJ_OMP(A,xx,NULL,yy);CHKERRQ(ierr);
+    PetscFunctionReturn(0);
+  }
+#endif
   ierr = VecSet(yy,0.0);CHKERRQ(ierr);
   ierr = MatMultTransposeAdd_SeqAIJ(A,xx,yy,yy);CHKERRQ(ierr);
   PetscFunctionReturn(0);
 }
 
+#if defined(MATSEQAIJ_HAVE_MIXED_PRECISION)
+/* Returns the single precision copy of the values, refreshed if the matrix changed since it was made */
+PetscErrorCode MatSeqAIJMixedGetArray_Private(Mat A,const float **af)
+{
+  Mat_SeqAIJ       *a = (Mat_SeqAIJ*)A->data;
+  PetscObjectState state;
+  PetscInt         i;
+  PetscErrorCode   ierr;
+
+  PetscFunctionBegin;
+  ierr = PetscObjectStateGet((PetscObject)A,&state);CHKERRQ(ierr);
+  if (!a->mixed.a || a->mixed.state != state || a->mixed.nz != a->nz) {
+    if (a->mixed.nz != a->nz) {
+      ierr = PetscFree(a->mixed.a);CHKERRQ(ierr);
+      ierr = PetscMalloc1(a->nz,&a->mixed.a);CHKERRQ(ierr);
+      ierr = PetscLogObjectMemory((PetscObject)A,a->nz*sizeof(float));CHKERRQ(ierr);
+      a->mixed.nz = a->nz;
+    }
+    for (i=0; i<a->nz; i++) a->mixed.a[i] = (float)a->a[i];
+    a->mixed.state = state;
+    ierr = PetscInfo1(A,"Copied %D values to single precision\n",a->nz);CHKERRQ(ierr);
+  }
+  *af = a->mixed.a;
+  PetscFunctionReturn(0);
+}
+
+/* computes zz = A*xx + yy, or zz = A*xx if yy is NULL, from the single precision values */
+static PetscErrorCode MatMultAdd_SeqAIJ_Mixed(Mat A,Vec xx,Vec yy,Vec zz)
+{
+  Mat_SeqAIJ        *a = (Mat_SeqAIJ*)A->data;
+  PetscScalar       *y = NULL,*z,sum;
+  const PetscScalar *x;
+  const float       *af,*aa;
+  const PetscInt    *aj,*ii,*ridx = NULL;
+  PetscInt          m = A->rmap->n,n,i;
+  PetscBool         usecprow = a->compressedrow.use;
+  PetscErrorCode    ierr;
+
+  PetscFunctionBegin;
+  ierr = MatSeqAIJMixedGetArray_Private(A,&af);CHKERRQ(ierr);
+  ierr = VecGetArrayRead(xx,&x);CHKERRQ(ierr);
+  if (yy) {
+    ierr = VecGetArrayPair(yy,zz,&y,&z);CHKERRQ(ierr);
+  } else {
+    ierr = VecGetArrayWrite(zz,&z);CHKERRQ(ierr);
+  }
+  if (usecprow) { /* use compressed row format */
+    if (!y) {
+      ierr = PetscArrayzero(z,m);CHKERRQ(ierr);
+    } else if (z != y) {
+      ierr = PetscArraycpy(z,y,m);CHKERRQ(ierr);
+    }
+    m    = a->compressedrow.nrows;
+    ii   = a->compressedrow.i;
+    ridx = a->compressedrow.rindex;
+    for (i=0; i<m; i++) {
+      n   = ii[i+1] - ii[i];
+      aj  = a->j + ii[i];
+      aa  = af + ii[i];
+      sum = z[*ridx];
+      PetscSparseDensePlusDot(sum,x,aa,aj,n);
+      z[*ridx++] = sum;
+    }
+  } else {
+    ii = a->i;
+    for (i=0; i<m; i++) {
+      n   = ii[i+1] - ii[i];
+      aj  = a->j + ii[i];
+      aa  = af + ii[i];
+      sum = y ? y[i] : 0.0;
+      PetscSparseDensePlusDot(sum,x,aa,aj,n);
+      z[i] = sum;
+    }
+  }
+  ierr = PetscLogFlops(yy ? 2.0*a->nz : 2.0*a->nz - a->nonzerorowcnt);CHKERRQ(ierr);
+  ierr = VecRestoreArrayRead(xx,&x);CHKERRQ(ierr);
+  if (yy) {
+    ierr = VecRestoreArrayPair(yy,zz,&y,&z);CHKERRQ(ierr);
+  } else {
+    ierr = VecRestoreArrayWrite(zz,&z);CHKERRQ(ierr);
+  }
+  PetscFunctionReturn(0);
+}
+#endif
+
+/*
+   Checks that the rows of each block row of A share one nonzero pattern made of full aligned bs x bs blocks,
+   so that the conversion to MATSEQBAIJ stores no explicit zeros and respects the preallocation
+*/
+static PetscErrorCode MatSeqAIJHasBlockStructure_Private(Mat A,PetscInt bs,PetscBool *flg)
+{
+  Mat_SeqAIJ     *a = (Mat_SeqAIJ*)A->data;
+  const PetscInt *ai = a->i,*aj = a->j;
+  PetscInt       i,j,k,n;
+  PetscBool      same;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  *flg = PETSC_FALSE;
+  if (bs < 2 || A->rmap->n % bs || A->cmap->n % bs) PetscFunctionReturn(0);
+  for (i=0; i<A->rmap->n; i+=bs) {
+    n = ai[i+1] - ai[i];
+    if (n % bs) PetscFunctionReturn(0);
+    for (k=0; k<n; k+=bs) {
+      if (aj[ai[i]+k] % bs) PetscFunctionReturn(0);
+      for (j=1; j<bs; j++) if (aj[ai[i]+k+j] != aj[ai[i]+k]+j) PetscFunctionReturn(0);
+    }
+    for (j=1; j<bs; j++) {
+      if (ai[i+j+1] - ai[i+j] != n) PetscFunctionReturn(0);
+      ierr = PetscArraycmp(aj+ai[i],aj+ai[i+j],n,&same);CHKERRQ(ierr);
+      if (!same) PetscFunctionReturn(0);
+    }
+  }
+  *flg = PETSC_TRUE;
+  PetscFunctionReturn(0);
+}
+
+/* Builds the copy of A used by kernel k, B is NULL if the kernel cannot be used for A */
+static PetscErrorCode MatSeqAIJAutotuneConvert_Private(Mat A,MatSeqAIJKernel k,Mat *B)
+{
+  PetscErrorCode ierr;
+  PetscBool      flg;
+
+  PetscFunctionBegin;
+  *B = NULL;
+  if (k == MAT_SEQAIJ_KERNEL_SELL) {
+    ierr = MatConvert(A,MATSEQSELL,MAT_INITIAL_MATRIX,B);CHKERRQ(ierr);
+  } else if (k == MAT_SEQAIJ_KERNEL_BAIJ) {
+    ierr = MatSeqAIJHasBlockStructure_Private(A,A->rmap->bs,&flg);CHKERRQ(ierr);
+    if (flg && A->rmap->bs == A->cmap->bs) {ierr = MatConvert(A,MATSEQBAIJ,MAT_INITIAL_MATRIX,B);CHKERRQ(ierr);}
+  }
+  PetscFunctionReturn(0);
+}
+
+/*
+   Times each kernel able to multiply with A and keeps the fastest one. The products are done through MatMult_SeqAIJ()
+   with the candidate installed, so each measurement includes the dispatch cost of the kernel.
+*/
+static PetscErrorCode MatSeqAIJAutotune_Private(Mat A,Vec xx,Vec yy)
+{
+  Mat_SeqAIJ          *a = (Mat_SeqAIJ*)A->data;
+  Mat_SeqAIJ_Autotune *at = &a->autotune;
+  Mat                 cand[MAT_SEQAIJ_KERNEL_N];
+  Vec                 y;
+  PetscLogDouble      t0,t1;
+  PetscInt            k,i,best = MAT_SEQAIJ_KERNEL_AIJ;
+  PetscErrorCode      ierr;
+
+  PetscFunctionBegin;
+  ierr = MatDestroy(&at->shadow);CHKERRQ(ierr);
+  ierr = VecDuplicate(yy,&y);CHKERRQ(ierr);
+  at->tuned = PETSC_TRUE;
+  for (k=0; k<MAT_SEQAIJ_KERNEL_N; k++) {
+    cand[k]     = NULL;
+    at->time[k] = 0.0;
+    if (k == MAT_SEQAIJ_KERNEL_INODE && !(a->inode.use && a->inode.checked)) continue;
+    if (k == MAT_SEQAIJ_KERNEL_SELL || k == MAT_SEQAIJ_KERNEL_BAIJ) {
+      ierr = MatSeqAIJAutotuneConvert_Private(A,(MatSeqAIJKernel)k,&cand[k]);CHKERRQ(ierr);
+      if (!cand[k]) continue;
+    }
+    at->kernel = (MatSeqAIJKernel)k;
+    at->shadow = cand[k];
+    ierr = MatMult_SeqAIJ(A,xx,y);CHKERRQ(ierr); /* warm up */
+    ierr = PetscTime(&t0);CHKERRQ(ierr);
+    for (i=0; i<at->its; i++) {ierr = MatMult_SeqAIJ(A,xx,y);CHKERRQ(ierr);}
+    ierr = PetscTime(&t1);CHKERRQ(ierr);
+    at->time[k] = PetscMax((t1 - t0)/at->its,PETSC_SMALL);
+    if (at->time[k] < at->time[best]) best = k;
+  }
+  for (k=0; k<MAT_SEQAIJ_KERNEL_N; k++) {
+    if (k != best) {ierr = MatDestroy(&cand[k]);CHKERRQ(ierr);}
+  }
+  at->kernel           = (MatSeqAIJKernel)best;
+  at->shadow           = cand[best];
+  at->mat_nonzerostate = A->nonzerostate;
+  ierr = VecDestroy(&y);CHKERRQ(ierr);
+  ierr = PetscInfo5(A,"MatMult() kernel %s chosen, seconds per product: aij %g inode %g sell %g baij %g\n",MatSeqAIJKernels[best],at->time[0],at->time[1],at->time[2],at->time[3]);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+/*
+   Counts the products done with the current values of A. After autotune.threshold of them the kernels are benchmarked,
+   or, if the nonzero pattern is the one the kernel was chosen for, only the copy used by the chosen kernel is rebuilt.
+   Returns done = PETSC_TRUE if the product was computed with that copy.
+*/
+static PetscErrorCode MatSeqAIJAutotuneMult_Private(Mat A,Vec xx,Vec yy,PetscBool *done)
+{
+  Mat_SeqAIJ          *a = (Mat_SeqAIJ*)A->data;
+  Mat_SeqAIJ_Autotune *at = &a->autotune;
+  PetscObjectState    state;
+  PetscErrorCode      ierr;
+
+  PetscFunctionBegin;
+  *done = PETSC_FALSE;
+  ierr  = PetscObjectStateGet((PetscObject)A,&state);CHKERRQ(ierr);
+  if (state != at->state) {
+    at->state = state;
+    at->nmult = 0;
+    ierr      = MatDestroy(&at->shadow);CHKERRQ(ierr);
+  }
+  if (at->nmult < at->threshold && ++at->nmult == at->threshold) {
+    if (!at->tuned || at->mat_nonzerostate != A->nonzerostate) {
+      ierr = MatSeqAIJAutotune_Private(A,xx,yy);CHKERRQ(ierr);
+    } else {
+      ierr = MatSeqAIJAutotuneConvert_Private(A,at->kernel,&at->shadow);CHKERRQ(ierr);
+    }
+  }
+  if (at->shadow) {
+    ierr  = (*at->shadow->ops->mult)(at->shadow,xx,yy);CHKERRQ(ierr);
+    *done = PETSC_TRUE;
+  }
+  PetscFunctionReturn(0);
+}
+
 #include <../src/mat/impls/aij/seq/ftn-kernels/fmult.h>
 
 PetscErrorCode MatMult_SeqAIJ(Mat A,Vec xx,Vec yy)
@@ -1528,7 +2248,29 @@ PetscErrorCode MatMult_SeqAIJ(Mat A,Vec xx,Vec yy)
 #endif
 
   PetscFunctionBegin;
-  if (a->inode.use && a->inode.checked) {
+#if defined(PETSC_HAVE_OPENMP)
+  if (a->omp.use) {
+    ierr = MatMultAdd_SeqAIJ_OMP(A,xx,NULL,yy);CHKERRQ(ierr);
+    PetscFunctionReturn(0);
+  }
+#endif
+#if defined(MATSEQAIJ_HAVE_MIXED_PRECISION)
+  if (a->mixed.use) {
+    ierr = MatMultAdd_SeqAIJ_Mixed(A,xx,NULL,yy);CHKERRQ(ierr);
+    PetscFunctionReturn(0);
+  }
+#endif
+  if (a->cind.width && a->cind.nonzerostate == A->nonzerostate) {
+    ierr = MatMultAdd_SeqAIJ_CompressedIndices(A,xx,NULL,yy);CHKERRQ(ierr);
+    PetscFunctionReturn(0);
+  }
+  if (a->autotune.use) {
+    PetscBool done;
+
+    ierr = MatSeqAIJAutotuneMult_Private(A,xx,yy,&done);CHKERRQ(ierr);
+    if (done) PetscFunctionReturn(0);
+  }
+  if (a->inode.use && a->inode.checked && !(a->autotune.tuned && a->autotune.kernel == MAT_SEQAIJ_KERNEL_AIJ)) {
     ierr = MatMult_SeqAIJ_Inode(A,xx,yy);CHKERRQ(ierr);
     PetscFunctionReturn(0);
   }
@@ -1684,6 +2426,22 @@ PetscErrorCode MatMultAdd_SeqAIJ(Mat A,Vec xx,Vec yy,Vec zz)
   PetscBool         usecprow=a->compressedrow.use;
 
   PetscFunctionBegin;
+#if defined(PETSC_HAVE_OPENMP)
+  if (a->omp.use) {
+    ierr = MatMultAdd_SeqAIJ_OMP(A,xx,yy,zz);CHKERRQ(ierr);
+    PetscFunctionReturn(0);
+  }
+#endif
+#if defined(MATSEQAIJ_HAVE_MIXED_PRECISION)
+  if (a->mixed.use) {
+    ierr = MatMultAdd_SeqAIJ_Mixed(A,xx,yy,zz);CHKERRQ(ierr);
+    PetscFunctionReturn(0);
+  }
+#endif
+  if (a->cind.width && a->cind.nonzerostate == A->nonzerostate) {
+    ierr = MatMultAdd_SeqAIJ_CompressedIndices(A,xx,yy,zz);CHKERRQ(ierr);
+    PetscFunctionReturn(0);
+  }
   if (a->inode.use && a->inode.checked) {
     ierr = MatMultAdd_SeqAIJ_Inode(A,xx,yy,zz);CHKERRQ(ierr);
     PetscFunctionReturn(0);
@@ -1728,6 +2486,66 @@ PetscErrorCode MatMultAdd_SeqAIJ(Mat A,Vec xx,Vec yy,Vec zz)
   PetscFunctionReturn(0);
 }
 
+/*
+   y = alpha x + beta w + gamma D^{-1} (b - z - A wa) in one sweep over the rows, where wa is the array of w, or for the
+   off-diagonal block A of an MPIAIJ matrix the ghost values of w, and the optional z is the product of the diagonal block
+   with w; rnorm2 gets the square of the local residual norm
+*/
+PetscErrorCode MatResidualJacobiUpdate_SeqAIJ_Private(Mat A,const PetscScalar wa[],Vec b,Vec z,Vec dinv,PetscScalar alpha,Vec x,PetscScalar beta,Vec w,PetscScalar gamma,Vec y,PetscReal *rnorm2)
+{
+  Mat_SeqAIJ        *a = (Mat_SeqAIJ*)A->data;
+  const PetscScalar *bb,*zz = NULL,*dd,*xx,*ww;
+  PetscScalar       *yy;
+  const MatScalar   *aa;
+  const PetscInt    *ai = a->i,*aj = a->j;
+  PetscInt          m = A->rmap->n,i;
+  PetscReal         nrm2 = 0.0;
+  PetscErrorCode    ierr;
+
+  PetscFunctionBegin;
+  ierr = MatSeqAIJGetArrayRead(A,&aa);CHKERRQ(ierr);
+  ierr = VecGetArrayRead(b,&bb);CHKERRQ(ierr);
+  if (z) {ierr = VecGetArrayRead(z,&zz);CHKERRQ(ierr);}
+  ierr = VecGetArrayRead(dinv,&dd);CHKERRQ(ierr);
+  ierr = VecGetArrayRead(x,&xx);CHKERRQ(ierr);
+  ierr = VecGetArrayRead(w,&ww);CHKERRQ(ierr);
+  ierr = VecGetArrayWrite(y,&yy);CHKERRQ(ierr);
+  if (!wa) wa = ww;
+#if defined(PETSC_HAVE_OPENMP)
+#pragma omp parallel for schedule(static) reduction(+:nrm2) num_threads((int)PetscMax(PetscNumOMPThreads,1))
+#endif
+  for (i=0; i<m; i++) {
+    PetscInt        n = ai[i+1] - ai[i];
+    const PetscInt  *idx = aj + ai[i];
+    const MatScalar *v = aa + ai[i];
+    PetscScalar     r = zz ? bb[i] - zz[i] : bb[i];
+
+    PetscSparseDenseMinusDot(r,wa,v,idx,n);
+    if (rnorm2) nrm2 += PetscRealPart(r*PetscConj(r));
+    yy[i] = alpha*xx[i] + beta*ww[i] + gamma*dd[i]*r;
+  }
+  ierr = VecRestoreArrayWrite(y,&yy);CHKERRQ(ierr);
+  ierr = VecRestoreArrayRead(w,&ww);CHKERRQ(ierr);
+  ierr = VecRestoreArrayRead(x,&xx);CHKERRQ(ierr);
+  ierr = VecRestoreArrayRead(dinv,&dd);CHKERRQ(ierr);
+  if (z) {ierr = VecRestoreArrayRead(z,&zz);CHKERRQ(ierr);}
+  ierr = VecRestoreArrayRead(b,&bb);CHKERRQ(ierr);
+  ierr = MatSeqAIJRestoreArrayRead(A,&aa);CHKERRQ(ierr);
+  if (rnorm2) *rnorm2 = nrm2;
+  ierr = PetscLogFlops(2.0*a->nz + (rnorm2 ? 8.0 : 6.0)*m + (z ? m : 0));CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+static PetscErrorCode MatResidualJacobiUpdate_SeqAIJ(Mat A,Vec b,Vec dinv,PetscScalar alpha,Vec x,PetscScalar beta,Vec w,PetscScalar gamma,Vec y,PetscReal *rnorm)
+{
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  ierr = MatResidualJacobiUpdate_SeqAIJ_Private(A,NULL,b,NULL,dinv,alpha,x,beta,w,gamma,y,rnorm);CHKERRQ(ierr);
+  if (rnorm) *rnorm = PetscSqrtReal(*rnorm);
+  PetscFunctionReturn(0);
+}
+
 /*
      Adds diagonal pointers to sparse matrix structure.
 */
@@ -1980,6 +2798,191 @@ PetscErrorCode  MatInvertDiagonal_SeqAIJ(Mat A,PetscScalar omega,PetscScalar fsh
 }
 
 #include <../src/mat/impls/aij/seq/ftn-kernels/frelax.h>
+#if defined(MATSEQAIJ_HAVE_MIXED_PRECISION)
+/*
+   The sweeps of MatSOR_SeqAIJ() with the single precision values; the inverted diagonal stays in double precision.
+   SOR_APPLY_UPPER, SOR_APPLY_LOWER and SOR_EISENSTAT are left to MatSOR_SeqAIJ()
+*/
+static PetscErrorCode MatSOR_SeqAIJ_Mixed(Mat A,Vec bb,PetscReal omega,MatSORType flag,PetscReal fshift,PetscInt its,PetscInt lits,Vec xx)
+{
+  Mat_SeqAIJ        *a = (Mat_SeqAIJ*)A->data;
+  PetscScalar       *x,sum,*t;
+  const MatScalar   *idiag,*mdiag;
+  const float       *af,*v;
+  const PetscScalar *b,*xb;
+  PetscErrorCode    ierr;
+  PetscInt          n,m = A->rmap->n,i;
+  const PetscInt    *idx,*diag;
+
+  PetscFunctionBegin;
+  its = its*lits;
+  if (fshift != a->fshift || omega != a->omega) a->idiagvalid = PETSC_FALSE; /* must recompute idiag[] */
+  if (!a->idiagvalid) {ierr = MatInvertDiagonal_SeqAIJ(A,omega,fshift);CHKERRQ(ierr);}
+  a->fshift = fshift;
+  a->omega  = omega;
+
+  diag  = a->diag;
+  t     = a->ssor_work;
+  idiag = a->idiag;
+  mdiag = a->mdiag;
+
+  ierr = MatSeqAIJMixedGetArray_Private(A,&af);CHKERRQ(ierr);
+  ierr = VecGetArray(xx,&x);CHKERRQ(ierr);
+  ierr = VecGetArrayRead(bb,&b);CHKERRQ(ierr);
+  if (flag & SOR_ZERO_INITIAL_GUESS) {
+    if (flag & SOR_FORWARD_SWEEP || flag & SOR_LOCAL_FORWARD_SWEEP) {
+      for (i=0; i<m; i++) {
+        n   = diag[i] - a->i[i];
+        idx = a->j + a->i[i];
+        v   = af + a->i[i];
+        sum = b[i];
+        PetscSparseDenseMinusDot(sum,x,v,idx,n);
+        t[i] = sum;
+        x[i] = sum*idiag[i];
+      }
+      xb   = t;
+      ierr = PetscLogFlops(a->nz);CHKERRQ(ierr);
+    } else xb = b;
+    if (flag & SOR_BACKWARD_SWEEP || flag & SOR_LOCAL_BACKWARD_SWEEP) {
+      for (i=m-1; i>=0; i--) {
+        n   = a->i[i+1] - diag[i] - 1;
+        idx = a->j + diag[i] + 1;
+        v   = af + diag[i] + 1;
+        sum = xb[i];
+        PetscSparseDenseMinusDot(sum,x,v,idx,n);
+        if (xb == b) {
+          x[i] = sum*idiag[i];
+        } else {
+          x[i] = (1-omega)*x[i] + sum*idiag[i];  /* omega in idiag */
+        }
+      }
+      ierr = PetscLogFlops(a->nz);CHKERRQ(ierr); /* assumes 1/2 in upper */
+    }
+    its--;
+  }
+  while (its--) {
+    if (flag & SOR_FORWARD_SWEEP || flag & SOR_LOCAL_FORWARD_SWEEP) {
+      for (i=0; i<m; i++) {
+        /* lower */
+        n   = diag[i] - a->i[i];
+        idx = a->j + a->i[i];
+        v   = af + a->i[i];
+        sum = b[i];
+        PetscSparseDenseMinusDot(sum,x,v,idx,n);
+        t[i] = sum;             /* save application of the lower-triangular part */
+        /* upper */
+        n   = a->i[i+1] - diag[i] - 1;
+        idx = a->j + diag[i] + 1;
+        v   = af + diag[i] + 1;
+        PetscSparseDenseMinusDot(sum,x,v,idx,n);
+        x[i] = (1. - omega)*x[i] + sum*idiag[i]; /* omega in idiag */
+      }
+      xb   = t;
+      ierr = PetscLogFlops(2.0*a->nz);CHKERRQ(ierr);
+    } else xb = b;
+    if (flag & SOR_BACKWARD_SWEEP || flag & SOR_LOCAL_BACKWARD_SWEEP) {
+      for (i=m-1; i>=0; i--) {
+        sum = xb[i];
+        if (xb == b) {
+          /* whole matrix (no checkpointing available) */
+          n   = a->i[i+1] - a->i[i];
+          idx = a->j + a->i[i];
+          v   = af + a->i[i];
+          PetscSparseDenseMinusDot(sum,x,v,idx,n);
+          x[i] = (1. - omega)*x[i] + (sum + mdiag[i]*x[i])*idiag[i];
+        } else { /* lower-triangular part has been saved, so only apply upper-triangular */
+          n   = a->i[i+1] - diag[i] - 1;
+          idx = a->j + diag[i] + 1;
+          v   = af + diag[i] + 1;
+          PetscSparseDenseMinusDot(sum,x,v,idx,n);
+          x[i] = (1. - omega)*x[i] + sum*idiag[i];  /* omega in idiag */
+        }
+      }
+      if (xb == b) {
+        ierr = PetscLogFlops(2.0*a->nz);CHKERRQ(ierr);
+      } else {
+        ierr = PetscLogFlops(a->nz);CHKERRQ(ierr); /* assumes 1/2 in upper */
+      }
+    }
+  }
+  ierr = VecRestoreArray(xx,&x);CHKERRQ(ierr);
+  ierr = VecRestoreArrayRead(bb,&b);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+#endif
+
+/*
+   Multicolor SOR: the forward (backward) sweep visits the colors in increasing (decreasing) order; the rows of a color
+   are not coupled so they are updated simultaneously by the OpenMP threads.
+   SOR_APPLY_UPPER, SOR_APPLY_LOWER and SOR_EISENSTAT are left to MatSOR_SeqAIJ()
+*/
+static PetscErrorCode MatSOR_SeqAIJ_MultiColor(Mat A,Vec bb,PetscReal omega,MatSORType flag,PetscReal fshift,PetscInt its,PetscInt lits,Vec xx)
+{
+  Mat_SeqAIJ        *a = (Mat_SeqAIJ*)A->data;
+  PetscScalar       *x;
+  const MatScalar   *aa;
+  const PetscScalar *b,*idiag,*mdiag;
+  PetscErrorCode    ierr;
+  PetscInt          m = A->rmap->n,nc,sweep;
+  const PetscInt    *ai = a->i,*aj = a->j,*color,*rows;
+
+  PetscFunctionBegin;
+  its = its*lits;
+  if (its <= 0) SETERRQ2(PETSC_COMM_SELF,PETSC_ERR_ARG_WRONG,"Relaxation requires global its %D and local its %D both positive",its,lits);
+  if (!m) PetscFunctionReturn(0);
+  ierr = MatSORColoringSetUp_Private(A,m,ai,aj,&a->sorcolor);CHKERRQ(ierr);
+  if (fshift != a->fshift || omega != a->omega) a->idiagvalid = PETSC_FALSE; /* must recompute idiag[] */
+  if (!a->idiagvalid) {ierr = MatInvertDiagonal_SeqAIJ(A,omega,fshift);CHKERRQ(ierr);}
+  a->fshift = fshift;
+  a->omega  = omega;
+
+  nc    = a->sorcolor.ncolors;
+  color = a->sorcolor.color;
+  rows  = a->sorcolor.rows;
+  idiag = a->idiag;
+  mdiag = a->mdiag;
+  if (flag & SOR_ZERO_INITIAL_GUESS) {ierr = VecSet(xx,0.0);CHKERRQ(ierr);}
+  ierr = MatSeqAIJGetArrayRead(A,&aa);CHKERRQ(ierr);
+  ierr = VecGetArray(xx,&x);CHKERRQ(ierr);
+  ierr = VecGetArrayRead(bb,&b);CHKERRQ(ierr);
+  while (its--) {
+    for (sweep=0; sweep<2; sweep++) {
+      if (!sweep && !(flag & (SOR_FORWARD_SWEEP | SOR_LOCAL_FORWARD_SWEEP))) continue;
+      if (sweep && !(flag & (SOR_BACKWARD_SWEEP | SOR_LOCAL_BACKWARD_SWEEP))) continue;
+#if defined(PETSC_HAVE_OPENMP)
+#pragma omp parallel num_threads((int)PetscMax(PetscNumOMPThreads,1))
+#endif
+      {
+        PetscInt        k,c,p,i,n;
+        const PetscInt  *idx;
+        const MatScalar *v;
+        PetscScalar     sum;
+
+        for (k=0; k<nc; k++) {
+          c = sweep ? nc-1-k : k;
+#if defined(PETSC_HAVE_OPENMP)
+#pragma omp for schedule(static)
+#endif
+          for (p=color[c]; p<color[c+1]; p++) {
+            i   = rows[p];
+            n   = ai[i+1] - ai[i];
+            idx = aj + ai[i];
+            v   = aa + ai[i];
+            sum = b[i];
+            PetscSparseDenseMinusDot(sum,x,v,idx,n);
+            x[i] = (1. - omega)*x[i] + (sum + mdiag[i]*x[i])*idiag[i]; /* omega in idiag */
+          }
+        }
+      }
+      ierr = PetscLogFlops(2.0*a->nz);CHKERRQ(ierr);
+    }
+  }
+  ierr = VecRestoreArray(xx,&x);CHKERRQ(ierr);
+  ierr = VecRestoreArrayRead(bb,&b);CHKERRQ(ierr);
+  ierr = MatSeqAIJRestoreArrayRead(A,&aa);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
 PetscErrorCode MatSOR_SeqAIJ(Mat A,Vec bb,PetscReal omega,MatSORType flag,PetscReal fshift,PetscInt its,PetscInt lits,Vec xx)
 {
   Mat_SeqAIJ        *a = (Mat_SeqAIJ*)A->data;
@@ -1991,6 +2994,16 @@ PetscErrorCode MatSOR_SeqAIJ(Mat A,Vec bb,PetscReal omega,MatSORType flag,PetscR
   const PetscInt    *idx,*diag;
 
   PetscFunctionBegin;
+  if ((flag & SOR_MULTICOLOR) && !(flag & (SOR_EISENSTAT | SOR_APPLY_UPPER | SOR_APPLY_LOWER))) {
+    ierr = MatSOR_SeqAIJ_MultiColor(A,bb,omega,flag,fshift,its,lits,xx);CHKERRQ(ierr);
+    PetscFunctionReturn(0);
+  }
+#if defined(MATSEQAIJ_HAVE_MIXED_PRECISION)
+  if (a->mixed.use && !(flag & (SOR_EISENSTAT | SOR_APPLY_UPPER | SOR_APPLY_LOWER))) {
+    ierr = MatSOR_SeqAIJ_Mixed(A,bb,omega,flag,fshift,its,lits,xx);CHKERRQ(ierr);
+    PetscFunctionReturn(0);
+  }
+#endif
   if (a->inode.use && a->inode.checked && omega == 1.0 && fshift == 0.0) {
     ierr = MatSOR_SeqAIJ_Inode(A,bb,omega,flag,fshift,its,lits,xx);CHKERRQ(ierr);
     PetscFunctionReturn(0);
@@ -3105,11 +4118,148 @@ PetscErrorCode MatCopy_SeqAIJ(Mat A,Mat B,MatStructure str)
   PetscFunctionReturn(0);
 }
 
+/*
+   Assembly without preallocation: until the first final assembly the entries are kept in a hash table keyed by
+   (row,column); MatAssemblyEnd() then preallocates exactly, fills the rows in one pass and restores the usual
+   operations, so later assemblies reuse the pattern like an exactly preallocated matrix
+*/
+static PetscErrorCode MatSeqAIJHashReset_Private(Mat A)
+{
+  Mat_SeqAIJ     *a = (Mat_SeqAIJ*)A->data;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  if (!a->hash.ht) PetscFunctionReturn(0);
+  A->ops->setvalues   = a->hash.setvalues;
+  A->ops->zeroentries = a->hash.zeroentries;
+  A->ops->assemblyend = a->hash.assemblyend;
+  ierr = PetscHMapIJDestroy(&a->hash.ht);CHKERRQ(ierr);
+  ierr = PetscFree(a->hash.v);CHKERRQ(ierr);
+  ierr = PetscFree(a->hash.rlen);CHKERRQ(ierr);
+  a->hash.n    = 0;
+  a->hash.nmax = 0;
+  PetscFunctionReturn(0);
+}
+
+static PetscErrorCode MatSetValues_SeqAIJ_Hash(Mat A,PetscInt m,const PetscInt im[],PetscInt n,const PetscInt in[],const PetscScalar v[],InsertMode is)
+{
+  Mat_SeqAIJ     *a = (Mat_SeqAIJ*)A->data;
+  PetscErrorCode ierr;
+  PetscInt       k,l,pos;
+  PetscScalar    value = 0.0;
+  PetscHashIJKey key;
+  PetscHashIter  iter;
+  PetscBool      missing;
+
+  PetscFunctionBegin;
+  for (k=0; k<m; k++) {
+    key.i = im[k];
+    if (key.i < 0) continue;
+    if (PetscUnlikelyDebug(key.i >= A->rmap->n)) SETERRQ2(PETSC_COMM_SELF,PETSC_ERR_ARG_OUTOFRANGE,"Row too large: row %D max %D",key.i,A->rmap->n-1);
+    for (l=0; l<n; l++) {
+      key.j = in[l];
+      if (key.j < 0) continue;
+      if (PetscUnlikelyDebug(key.j >= A->cmap->n)) SETERRQ2(PETSC_COMM_SELF,PETSC_ERR_ARG_OUTOFRANGE,"Column too large: col %D max %D",key.j,A->cmap->n-1);
+      if (v) value = a->roworiented ? v[l + k*n] : v[k + l*m];
+      if (value == 0.0 && a->ignorezeroentries && is == ADD_VALUES && key.i != key.j) continue;
+      ierr = PetscHMapIJPut(a->hash.ht,key,&iter,&missing);CHKERRQ(ierr);
+      if (missing) {
+        if (a->hash.n == a->hash.nmax) {
+          a->hash.nmax = PetscMax(2*a->hash.nmax,1024);
+          ierr = PetscRealloc(a->hash.nmax*sizeof(PetscScalar),&a->hash.v);CHKERRQ(ierr);
+        }
+        ierr = PetscHMapIJIterSet(a->hash.ht,iter,a->hash.n);CHKERRQ(ierr);
+        a->hash.v[a->hash.n++] = value;
+        a->hash.rlen[key.i]++;
+      } else {
+        ierr = PetscHMapIJIterGet(a->hash.ht,iter,&pos);CHKERRQ(ierr);
+        if (is == ADD_VALUES) a->hash.v[pos] += value;
+        else a->hash.v[pos] = value;
+      }
+    }
+  }
+  PetscFunctionReturn(0);
+}
+
+static PetscErrorCode MatZeroEntries_SeqAIJ_Hash(Mat A)
+{
+  Mat_SeqAIJ     *a = (Mat_SeqAIJ*)A->data;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  ierr = PetscArrayzero(a->hash.v,a->hash.n);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+static PetscErrorCode MatAssemblyEnd_SeqAIJ_Hash(Mat A,MatAssemblyType mode)
+{
+  Mat_SeqAIJ     *a = (Mat_SeqAIJ*)A->data;
+  PetscErrorCode ierr;
+  PetscInt       m = A->rmap->n,nonew = a->nonew,n = a->hash.n,i,k,p,*rlen = a->hash.rlen,*pos;
+  PetscHashIJKey *keys;
+  PetscScalar    *hv = a->hash.v;
+
+  PetscFunctionBegin;
+  if (mode == MAT_FLUSH_ASSEMBLY) PetscFunctionReturn(0);
+  if (A->structure_only) SETERRQ(PETSC_COMM_SELF,PETSC_ERR_ARG_WRONGSTATE,"MAT_STRUCTURE_ONLY must be set before MatSetUp()");
+  ierr = PetscMalloc2(n,&keys,n,&pos);CHKERRQ(ierr);
+  k    = 0;
+  ierr = PetscHMapIJGetPairs(a->hash.ht,&k,keys,pos);CHKERRQ(ierr);
+  /* keep the staged arrays while the exact preallocation is made, then restore the operations */
+  a->hash.v    = NULL;
+  a->hash.rlen = NULL;
+  ierr = MatSeqAIJHashReset_Private(A);CHKERRQ(ierr);
+  ierr = MatSeqAIJSetPreallocation_SeqAIJ(A,0,rlen);CHKERRQ(ierr);
+  a->nonew = nonew; /* new nonzeros are still allowed after the first assembly, as without preallocation */
+  for (k=0; k<n; k++) {
+    i         = keys[k].i;
+    p         = a->i[i] + a->ilen[i]++;
+    a->j[p]   = keys[k].j;
+    a->a[p]   = hv[pos[k]];
+  }
+  for (i=0; i<m; i++) {
+    ierr = PetscSortIntWithScalarArray(a->ilen[i],a->j+a->i[i],a->a+a->i[i]);CHKERRQ(ierr);
+  }
+  ierr = PetscFree2(keys,pos);CHKERRQ(ierr);
+  ierr = PetscFree(hv);CHKERRQ(ierr);
+  ierr = PetscFree(rlen);CHKERRQ(ierr);
+  if (n) A->nonzerostate++;
+  ierr = PetscInfo1(A,"Converted %D entries staged in the hash table to compressed rows\n",n);CHKERRQ(ierr);
+  ierr = (*A->ops->assemblyend)(A,mode);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+static PetscErrorCode MatSetUp_SeqAIJ_Hash(Mat A)
+{
+  Mat_SeqAIJ     *a = (Mat_SeqAIJ*)A->data;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  ierr = PetscLayoutSetUp(A->rmap);CHKERRQ(ierr);
+  ierr = PetscLayoutSetUp(A->cmap);CHKERRQ(ierr);
+  ierr = PetscHMapIJCreate(&a->hash.ht);CHKERRQ(ierr);
+  ierr = PetscCalloc1(A->rmap->n,&a->hash.rlen);CHKERRQ(ierr);
+  a->hash.setvalues   = A->ops->setvalues;
+  a->hash.zeroentries = A->ops->zeroentries;
+  a->hash.assemblyend = A->ops->assemblyend;
+  A->ops->setvalues   = MatSetValues_SeqAIJ_Hash;
+  A->ops->zeroentries = MatZeroEntries_SeqAIJ_Hash;
+  A->ops->assemblyend = MatAssemblyEnd_SeqAIJ_Hash;
+  A->preallocated     = PETSC_TRUE;
+  PetscFunctionReturn(0);
+}
+
 PetscErrorCode MatSetUp_SeqAIJ(Mat A)
 {
+  Mat_SeqAIJ     *a = (Mat_SeqAIJ*)A->data;
   PetscErrorCode ierr;
 
   PetscFunctionBegin;
+  /* the hash table stages values, structure only matrices keep the usual preallocation */
+  if (a->hash.use && !A->structure_only) {
+    ierr = MatSetUp_SeqAIJ_Hash(A);CHKERRQ(ierr);
+    PetscFunctionReturn(0);
+  }
   ierr = MatSeqAIJSetPreallocation_SeqAIJ(A,PETSC_DEFAULT,NULL);CHKERRQ(ierr);
   PetscFunctionReturn(0);
 }
@@ -4090,6 +5240,8 @@ PetscErrorCode  MatSeqAIJSetPreallocation_SeqAIJ(Mat B,PetscInt nz,const PetscIn
   PetscInt       i;
 
   PetscFunctionBegin;
+  ierr = MatSeqAIJHashReset_Private(B);CHKERRQ(ierr);
+  ierr = MatSeqAIJLevelsReset_Private(B);CHKERRQ(ierr);
   if (nz >= 0 || nnz) realalloc = PETSC_TRUE;
   if (nz == MAT_SKIP_ALLOCATION) {
     skipallocation = PETSC_TRUE;
@@ -4456,7 +5608,16 @@ PetscErrorCode MatMatMultSymbolic_SeqDense_SeqAIJ(Mat A,Mat B,PetscReal fill,Mat
    based on compressed sparse row format.
 
    Options Database Keys:
-. -mat_type seqaij - sets the matrix type to "seqaij" during a call to MatSetFromOptions()
++ -mat_type seqaij - sets the matrix type to "seqaij" during a call to MatSetFromOptions()
+. -mat_aij_omp - use OpenMP threads in the matrix-vector products (requires PETSc configured --with-openmp)
+. -mat_aij_autotune - benchmark the MatMult() kernels once the matrix has been applied often enough and use the fastest
+. -mat_aij_autotune_threshold <10> - number of MatMult() with the same matrix values before the kernels are benchmarked
+. -mat_aij_autotune_its <10> - number of timed products per kernel
+. -mat_aij_hash_assembly - when MatSetUp() is called instead of a preallocation routine, keep the entries in a hash table until the first final assembly and preallocate exactly then
+. -mat_aij_compress_indices - store the column indices as 8 or 16 bit offsets from the first column of each row for MatMult() and MatMultTranspose()
+. -mat_aij_level_solve - use level scheduled, threaded MatSolve() and MatSolveTranspose() with the PETSc LU and ILU factors
+. -mat_aij_supernodal - compute the PETSc Cholesky factor by supernodes with dense matrix-matrix products
+- -mat_aij_mixed_precision - store a single precision copy of the values for MatMult(), MatMultAdd(), MatSOR() and MatSolve() with the PETSc LU and ILU factors (requires real double precision PETSc)
 
    Level: beginner
 
@@ -4465,6 +5626,55 @@ PetscErrorCode MatMatMultSymbolic_SeqDense_SeqAIJ(Mat A,Mat B,PetscReal fill,Mat
     in this case the values associated with the rows and columns one passes in are set to zero
     in the matrix
 
+    With -mat_aij_omp the rows are split into one block per OpenMP thread (see -omp_num_threads) holding
+    about the same number of nonzeros; the numerical values and column indices of each block are first touched
+    by the thread that multiplies with them, so that they are placed in its NUMA domain
+
+    With -mat_aij_autotune the plain AIJ kernel, the I-node kernel, MATSEQSELL and, if the block size is larger than one
+    and every block row is made of full blocks, MATSEQBAIJ are timed after -mat_aij_autotune_threshold products with
+    unchanged values; MatMult() then uses a copy of the matrix in the fastest format. The copy is rebuilt when the values
+    change, the benchmark is only repeated when the nonzero structure changes. The chosen kernel is reported by
+    MatView() with PETSC_VIEWER_ASCII_INFO, for example with -mat_view ::ascii_info. The copy costs the memory of a
+    second matrix
+
+    With -mat_aij_mixed_precision the products, the SOR sweeps and the triangular solves with the LU and ILU factors
+    read the matrix values from a single precision copy while the vectors and all the arithmetic stay in double precision;
+    this reduces the memory traffic of these bandwidth bound kernels by about a third. The double precision values are
+    kept, so the copy is a cache that adds half the memory of the values rather than a way to save memory. It is tied to
+    the state of the matrix and refreshed before its next use after any change of the values, including MatSetValues(),
+    MatSetValuesCOO(), MatSeqAIJRestoreArray() and numeric factorizations. The rounding of the values limits the accuracy of
+    MatMult() to about 1e-7 relative, so the option is intended for preconditioners and smoothers, or for Krylov
+    methods whose tolerance is well above that. With MATMPIAIJ it applies to the diagonal and off-diagonal blocks.
+    -mat_aij_omp takes precedence over it, and it takes precedence over -mat_aij_autotune
+
+    With -mat_aij_compress_indices the final MatAssemblyEnd() stores, next to the column indices, the first column of
+    each row and the offsets of the columns from it in 8 bits if no row spans more than 256 columns, otherwise in 16 bits
+    if no row spans more than 65536 columns; MatMult(), MatMultAdd(), MatMultTranspose() and MatMultTransposeAdd() then
+    read 1 or 2 bytes per nonzero instead of sizeof(PetscInt). This suits banded matrices, for example finite element
+    matrices with a bandwidth reducing ordering, and is skipped (see -info) when a row spans too many columns. The offsets
+    are recomputed only when the nonzero structure changes. -mat_aij_omp and -mat_aij_mixed_precision take precedence
+    over it, and it takes precedence over -mat_aij_autotune
+
+    With -mat_aij_hash_assembly a matrix set up with MatSetUp() instead of MatSeqAIJSetPreallocation() inserts the entries
+    given to MatSetValues() into a hash table keyed by row and column. The final MatAssemblyEnd() counts the entries of
+    each row, allocates exactly that space and fills the rows in a single pass, so no row is ever reallocated or moved
+    during the first assembly. Later assemblies work on the resulting compressed rows, as for an exactly preallocated
+    matrix, except that new nonzeros are still accepted. Calling a preallocation routine discards the staged entries
+
+    With -mat_aij_level_solve the numeric LU and ILU factorizations group the rows of L and U into levels whose rows
+    only depend on rows of lower levels. MatSolve() then computes the rows of each level with the OpenMP threads (see
+    -omp_num_threads) and synchronizes between levels; the first MatSolveTranspose() does the same for U^T and L^T after
+    storing the factor by columns. The numbers of levels are reported by MatView() of the factor with
+    PETSC_VIEWER_ASCII_INFO, for example with -ksp_view; few levels relative to the number of rows mean much parallelism.
+    It takes precedence over -mat_aij_mixed_precision for the solves
+
+    With -mat_aij_supernodal the numeric Cholesky factorization with MATSOLVERPETSC groups consecutive rows of the factor
+    with the same nonzero structure into supernodes of at most 128 rows. Each supernode is computed as a dense panel that
+    receives the updates of the previous supernodes through BLAS matrix-matrix products, which pays off for factors with
+    much fill such as those of coarse grid problems or of nested dissection orderings of 2d and 3d meshes. The factor
+    and its solves are the same as without the option; the supernodes are reported by MatView() of the factor with
+    PETSC_VIEWER_ASCII_INFO. The same is provided for MATSEQSBAIJ with block size 1 by -mat_sbaij_supernodal
+
     MatSetOptions(,MAT_STRUCTURE_ONLY,PETSC_TRUE) may be called for this matrix type. In this no
     space is allocated for the nonzero entries and any entries passed with MatSetValues() are ignored
 
@@ -4653,6 +5863,10 @@ PetscErrorCode  MatSeqAIJGetMaxRowNonzeros(Mat A,PetscInt *nz)
 +  mat - a MATSEQAIJ matrix
 -  array - pointer to the data
 
+   Notes:
+   The values are assumed to have been changed, so the state of the matrix is increased and copies of the values
+   kept by the matrix, such as the single precision copy of -mat_aij_mixed_precision, are refreshed before their next use
+
    Level: intermediate
 
 .seealso: MatSeqAIJGetArray(), MatSeqAIJRestoreArrayF90()
@@ -4663,6 +5877,7 @@ PetscErrorCode  MatSeqAIJRestoreArray(Mat A,PetscScalar **array)
 
   PetscFunctionBegin;
   ierr = PetscUseMethod(A,"MatSeqAIJRestoreArray_C",(Mat,PetscScalar**),(A,array));CHKERRQ(ierr);
+  ierr = PetscObjectStateIncrease((PetscObject)A);CHKERRQ(ierr);
   PetscFunctionReturn(0);
 }
 
@@ -4755,13 +5970,36 @@ PETSC_EXTERN PetscErrorCode MatCreate_SeqAIJ(Mat B)
   ierr = PetscObjectComposeFunction((PetscObject)B,"MatIsHermitianTranspose_C",MatIsTranspose_SeqAIJ);CHKERRQ(ierr);
   ierr = PetscObjectComposeFunction((PetscObject)B,"MatSeqAIJSetPreallocation_C",MatSeqAIJSetPreallocation_SeqAIJ);CHKERRQ(ierr);
   ierr = PetscObjectComposeFunction((PetscObject)B,"MatResetPreallocation_C",MatResetPreallocation_SeqAIJ);CHKERRQ(ierr);
+  ierr = PetscObjectComposeFunction((PetscObject)B,"MatResidualJacobiUpdate_C",MatResidualJacobiUpdate_SeqAIJ);CHKERRQ(ierr);
   ierr = PetscObjectComposeFunction((PetscObject)B,"MatSeqAIJSetPreallocationCSR_C",MatSeqAIJSetPreallocationCSR_SeqAIJ);CHKERRQ(ierr);
   ierr = PetscObjectComposeFunction((PetscObject)B,"MatReorderForNonzeroDiagonal_C",MatReorderForNonzeroDiagonal_SeqAIJ);CHKERRQ(ierr);
   ierr = PetscObjectComposeFunction((PetscObject)B,"MatProductSetFromOptions_is_seqaij_C",MatProductSetFromOptions_IS_XAIJ);CHKERRQ(ierr);
   ierr = PetscObjectComposeFunction((PetscObject)B,"MatProductSetFromOptions_seqdense_seqaij_C",MatProductSetFromOptions_SeqDense_SeqAIJ);CHKERRQ(ierr);
   ierr = PetscObjectComposeFunction((PetscObject)B,"MatProductSetFromOptions_seqaij_seqaij_C",MatProductSetFromOptions_SeqAIJ);CHKERRQ(ierr);
   ierr = PetscObjectComposeFunction((PetscObject)B,"MatSeqAIJKron_C",MatSeqAIJKron_SeqAIJ);CHKERRQ(ierr);
+  ierr = PetscObjectComposeFunction((PetscObject)B,"MatSetPreallocationCOO_C",MatSetPreallocationCOO_SeqAIJ);CHKERRQ(ierr);
+  ierr = PetscObjectComposeFunction((PetscObject)B,"MatSetValuesCOO_C",MatSetValuesCOO_SeqAIJ);CHKERRQ(ierr);
   ierr = MatCreate_SeqAIJ_Inode(B);CHKERRQ(ierr);
+  b->autotune.threshold = 10;
+  b->autotune.its       = 10;
+  b->autotune.state     = -1;
+  ierr = PetscOptionsBegin(PetscObjectComm((PetscObject)B),((PetscObject)B)->prefix,"Options for SEQAIJ matrix","Mat");CHKERRQ(ierr);
+#if defined(PETSC_HAVE_OPENMP)
+  ierr = PetscOptionsBool("-mat_aij_omp","Use OpenMP threads in MatMult(), MatMultAdd() and MatMultTranspose()",NULL,b->omp.use,&b->omp.use,NULL);CHKERRQ(ierr);
+#endif
+  ierr = PetscOptionsBool("-mat_aij_autotune","Benchmark the MatMult() kernels and use the fastest for matrices applied many times",NULL,b->autotune.use,&b->autotune.use,NULL);CHKERRQ(ierr);
+  ierr = PetscOptionsInt("-mat_aij_autotune_threshold","Number of MatMult() with unchanged values before choosing the kernel",NULL,b->autotune.threshold,&b->autotune.threshold,NULL);CHKERRQ(ierr);
+  ierr = PetscOptionsInt("-mat_aij_autotune_its","Number of timed products per candidate kernel",NULL,b->autotune.its,&b->autotune.its,NULL);CHKERRQ(ierr);
+  ierr = PetscOptionsBool("-mat_aij_hash_assembly","Stage the entries in a hash table until the first assembly when MatSetUp() is called without preallocation",NULL,b->hash.use,&b->hash.use,NULL);CHKERRQ(ierr);
+  ierr = PetscOptionsBool("-mat_aij_level_solve","Use level scheduled threaded triangular solves with the LU and ILU factors of the matrix",NULL,b->levels.use,&b->levels.use,NULL);CHKERRQ(ierr);
+  ierr = PetscOptionsBool("-mat_aij_supernodal","Use the supernodal numeric Cholesky factorization",NULL,b->supernodal,&b->supernodal,NULL);CHKERRQ(ierr);
+  ierr = PetscOptionsBool("-mat_aij_compress_indices","Store the column indices as 8 or 16 bit offsets within each row for MatMult() and MatMultTranspose()",NULL,b->cind.use,&b->cind.use,NULL);CHKERRQ(ierr);
+#if defined(MATSEQAIJ_HAVE_MIXED_PRECISION)
+  ierr = PetscOptionsBool("-mat_aij_mixed_precision","Use a single precision copy of the values in MatMult(), MatMultAdd(), MatSOR() and the solves with its ILU/LU factors",NULL,b->mixed.use,&b->mixed.use,NULL);CHKERRQ(ierr);
+#endif
+  ierr = PetscOptionsEnd();CHKERRQ(ierr);
+  if (b->autotune.threshold < 1) SETERRQ1(PETSC_COMM_SELF,PETSC_ERR_ARG_OUTOFRANGE,"-mat_aij_autotune_threshold %D must be positive",b->autotune.threshold);
+  if (b->autotune.its < 1) SETERRQ1(PETSC_COMM_SELF,PETSC_ERR_ARG_OUTOFRANGE,"-mat_aij_autotune_its %D must be positive",b->autotune.its);
   ierr = PetscObjectChangeTypeName((PetscObject)B,MATSEQAIJ);CHKERRQ(ierr);
   ierr = MatSeqAIJSetTypeFromOptions(B);CHKERRQ(ierr);  /* this allows changing the matrix subtype to say MATSEQAIJPERM */
   PetscFunctionReturn(0);
@@ -4821,6 +6059,16 @@ PetscErrorCode MatDuplicateNoCreate_SeqAIJ(Mat C,Mat A,MatDuplicateOption cpvalu
   c->ignorezeroentries = a->ignorezeroentries;
   c->roworiented       = a->roworiented;
   c->nonew             = a->nonew;
+  c->omp.use           = a->omp.use;
+  c->autotune.use       = a->autotune.use;
+  c->autotune.threshold = a->autotune.threshold;
+  c->autotune.its       = a->autotune.its;
+  c->autotune.state     = -1;
+  c->mixed.use          = a->mixed.use;
+  c->cind.use           = a->cind.use;
+  c->hash.use           = a->hash.use;
+  c->levels.use         = a->levels.use;
+  c->supernodal         = a->supernodal;
   if (a->diag) {
     ierr = PetscMalloc1(m+1,&c->diag);CHKERRQ(ierr);
     ierr = PetscMemcpy(c->diag,a->diag,m*sizeof(PetscInt));CHKERRQ(ierr);
@@ -5361,6 +6609,107 @@ PetscErrorCode  MatSeqAIJRegisterAll(void)
   PetscFunctionReturn(0);
 }
 
+PetscErrorCode MatResetPreallocationCOO_SeqAIJ(Mat mat)
+{
+  Mat_SeqAIJ     *seqaij = (Mat_SeqAIJ*)mat->data;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  seqaij->coo_n = 0;
+  ierr = PetscFree(seqaij->coo_jmap);CHKERRQ(ierr);
+  ierr = PetscFree(seqaij->coo_perm);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+/*
+   MatSetPreallocationCOO_SeqAIJ - sorts the COO entries by (row,col), builds the CSR structure of the matrix
+   from the unique entries and records, for each nonzero, which COO entries have to be summed into it.
+
+   The map is made of coo_perm[], the COO entries in (row,col) order, and coo_jmap[], a CSR-like offset array
+   over the nonzeros. MatSetValuesCOO_SeqAIJ() is then a plain gather-and-sum into a->a.
+*/
+PetscErrorCode MatSetPreallocationCOO_SeqAIJ(Mat mat,PetscInt coo_n,const PetscInt coo_i[],const PetscInt coo_j[])
+{
+  Mat_SeqAIJ     *seqaij = (Mat_SeqAIJ*)mat->data;
+  PetscInt       M = mat->rmap->n,nnz = 0,nonew,k,q,start,row;
+  PetscInt       *i,*j,*perm,*Ai,*Aj,*jmap;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  ierr = PetscLayoutSetUp(mat->rmap);CHKERRQ(ierr);
+  ierr = PetscLayoutSetUp(mat->cmap);CHKERRQ(ierr);
+  ierr = MatResetPreallocationCOO_SeqAIJ(mat);CHKERRQ(ierr);
+
+  ierr = PetscMalloc2(coo_n,&i,coo_n,&j);CHKERRQ(ierr);
+  ierr = PetscMalloc1(coo_n,&perm);CHKERRQ(ierr);
+  ierr = PetscArraycpy(i,coo_i,coo_n);CHKERRQ(ierr);
+  ierr = PetscArraycpy(j,coo_j,coo_n);CHKERRQ(ierr);
+  for (k=0; k<coo_n; k++) {
+    if (PetscUnlikelyDebug(i[k] < 0 || i[k] >= M)) SETERRQ2(PETSC_COMM_SELF,PETSC_ERR_ARG_OUTOFRANGE,"Invalid row index %D! Must be in [0,%D)",i[k],M);
+    perm[k] = k;
+  }
+  ierr = PetscSortIntWithArrayPair(coo_n,i,j,perm);CHKERRQ(ierr);
+
+  /* the unique (row,col) pairs form the CSR of the matrix, duplicates are accounted for in jmap[] */
+  ierr = PetscCalloc1(M+1,&Ai);CHKERRQ(ierr);
+  ierr = PetscMalloc1(coo_n,&Aj);CHKERRQ(ierr);
+  ierr = PetscMalloc1(coo_n+1,&jmap);CHKERRQ(ierr);
+  for (k=0; k<coo_n;) {
+    row   = i[k];
+    start = k;
+    while (k < coo_n && i[k] == row) k++;
+    ierr = PetscSortIntWithArray(k-start,j+start,perm+start);CHKERRQ(ierr);
+    for (q=start; q<k; q++) {
+      if (q == start || j[q] != j[q-1]) {
+        Aj[nnz]   = j[q];
+        jmap[nnz] = q;
+        nnz++;
+        Ai[row+1]++;
+      }
+    }
+  }
+  jmap[nnz] = coo_n;
+  for (k=0; k<M; k++) Ai[k+1] += Ai[k];
+  ierr = PetscFree2(i,j);CHKERRQ(ierr);
+
+  /* MatSeqAIJSetPreallocationCSR_SeqAIJ() forbids new nonzeros, restore the previous setting */
+  nonew = seqaij->nonew;
+  ierr  = MatSeqAIJSetPreallocationCSR_SeqAIJ(mat,Ai,Aj,NULL);CHKERRQ(ierr);
+  seqaij->nonew = nonew;
+  ierr = PetscFree(Ai);CHKERRQ(ierr);
+  ierr = PetscFree(Aj);CHKERRQ(ierr);
+  if (seqaij->nz != nnz) SETERRQ2(PETSC_COMM_SELF,PETSC_ERR_PLIB,"Unexpected number of nonzeros %D != %D",seqaij->nz,nnz);
+
+  seqaij->coo_n            = coo_n;
+  seqaij->coo_jmap         = jmap;
+  seqaij->coo_perm         = perm;
+  seqaij->coo_nonzerostate = mat->nonzerostate;
+  PetscFunctionReturn(0);
+}
+
+PetscErrorCode MatSetValuesCOO_SeqAIJ(Mat A,const PetscScalar v[],InsertMode imode)
+{
+  Mat_SeqAIJ     *aseq = (Mat_SeqAIJ*)A->data;
+  PetscInt       i,k,nz = aseq->nz;
+  const PetscInt *jmap = aseq->coo_jmap,*perm = aseq->coo_perm;
+  PetscScalar    *Aa,sum;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  if (!jmap) SETERRQ(PETSC_COMM_SELF,PETSC_ERR_ARG_WRONGSTATE,"Must call MatSetPreallocationCOO() first");
+  if (A->nonzerostate != aseq->coo_nonzerostate) SETERRQ(PETSC_COMM_SELF,PETSC_ERR_ARG_WRONGSTATE,"Nonzero pattern changed since MatSetPreallocationCOO(), call it again");
+  if (!v && imode == ADD_VALUES) PetscFunctionReturn(0);
+  ierr = MatSeqAIJGetArray(A,&Aa);CHKERRQ(ierr);
+  for (i=0; i<nz; i++) {
+    sum = 0.0;
+    if (v) for (k=jmap[i]; k<jmap[i+1]; k++) sum += v[perm[k]];
+    Aa[i] = (imode == INSERT_VALUES ? 0.0 : Aa[i]) + sum;
+  }
+  ierr = MatSeqAIJRestoreArray(A,&Aa);CHKERRQ(ierr);
+  ierr = MatSeqAIJInvalidateDiagonal(A);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
 /*
     Special version for direct calls from Fortran
 */
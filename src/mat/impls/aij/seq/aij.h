@@ -4,6 +4,7 @@
 
 #include <petsc/private/matimpl.h>
 #include <petscctable.h>
+#include <petsc/private/hashmapij.h>
 
 /*
     Struct header shared by SeqAIJ, SeqBAIJ and SeqSBAIJ matrix formats
@@ -77,6 +78,11 @@ typedef struct {
   Mat BC;               /* temp matrix for storing B*C */
 } Mat_MatMatMatMult;
 
+typedef struct { /* used by the "hash" algorithm of MatPtAP() */
+  Mat Pt;               /* transpose of P */
+  Mat AP;               /* temp matrix for storing A*P */
+} Mat_PtAPHash;
+
 /*
   MATSEQAIJ format - Compressed row storage (also called Yale sparse matrix
   format) or compressed sparse row (CSR).  The i[] and j[] arrays start at 0. For example,
@@ -99,6 +105,95 @@ typedef struct {
   PetscObjectState mat_nonzerostate;               /* non-zero state when inodes were checked for */
 } Mat_SeqAIJ_Inode;
 
+/* Info about the row partition used by the OpenMP threaded MatMult() kernels for SeqAIJ */
+typedef struct {
+  PetscBool        use;                            /* use the threaded kernels, see -mat_aij_omp */
+  PetscInt         nthreads;                       /* number of row blocks, one per thread */
+  PetscInt         *rows;                          /* [nthreads+1]: (compressed) rows of block t are rows[t] to rows[t+1]-1 */
+  PetscBool        cprow;                          /* if the partition is over the compressed rows */
+  PetscScalar      *work;                          /* [nthreads*cmap->n]: per-thread accumulators for MatMultTranspose() */
+  PetscObjectState mat_nonzerostate;               /* non-zero state when the partition was computed */
+  PetscBool        touched;                        /* the arrays were first touched with the current partition */
+  PetscObjectState touched_nonzerostate;           /* non-zero state when the arrays were first touched */
+  const MatScalar  *touched_a;                     /* value array that was first touched */
+} Mat_SeqAIJ_OMP;
+
+/* Kernels MatMult() of SeqAIJ can choose from when autotuning, see -mat_aij_autotune */
+typedef enum {MAT_SEQAIJ_KERNEL_AIJ,MAT_SEQAIJ_KERNEL_INODE,MAT_SEQAIJ_KERNEL_SELL,MAT_SEQAIJ_KERNEL_BAIJ,MAT_SEQAIJ_KERNEL_N} MatSeqAIJKernel;
+
+typedef struct {
+  PetscBool        use;                            /* benchmark the MatMult() kernels of matrices applied often, see -mat_aij_autotune */
+  PetscInt         threshold;                      /* number of MatMult() with unchanged values before switching kernel */
+  PetscInt         its;                            /* number of timed products per candidate kernel */
+  PetscInt         nmult;                          /* number of MatMult() since the values last changed */
+  PetscObjectState state;                          /* object state nmult refers to */
+  PetscBool        tuned;                          /* kernel has been chosen */
+  PetscObjectState mat_nonzerostate;               /* non-zero state when the kernel was chosen */
+  MatSeqAIJKernel  kernel;                         /* chosen kernel */
+  Mat              shadow;                         /* copy of the matrix in the format of the chosen kernel, NULL for AIJ and inode */
+  PetscLogDouble   time[MAT_SEQAIJ_KERNEL_N];      /* seconds per product measured for each candidate, 0 if not available */
+} Mat_SeqAIJ_Autotune;
+PETSC_INTERN const char *const MatSeqAIJKernels[];
+
+/* Single precision copy of the values streamed by MatMult(), MatSOR() and MatSolve(), see -mat_aij_mixed_precision;
+   it is a cache kept next to a->a and refreshed when the object state changes */
+#if defined(PETSC_USE_REAL_DOUBLE) && !defined(PETSC_USE_COMPLEX)
+#define MATSEQAIJ_HAVE_MIXED_PRECISION
+#endif
+
+typedef struct {
+  PetscBool        use;                            /* compute with single precision values and double precision vectors */
+  float            *a;                             /* [nz] single precision copy of the values */
+  PetscInt         nz;                             /* length of a */
+  PetscObjectState state;                          /* object state when a was filled */
+} Mat_SeqAIJ_Mixed;
+
+/* Column indices stored as an offset from the first column of each row, see -mat_aij_compress_indices */
+typedef struct {
+  PetscBool        use;                            /* compress the column indices at the final assembly */
+  PetscInt         width;                          /* bytes per offset, 1 or 2; 0 if some row spans too many columns */
+  PetscInt         *base;                          /* [m] first column of each row */
+  void             *off;                           /* [nz] column index minus the base of its row */
+  PetscObjectState nonzerostate;                   /* nonzero state of the matrix when the offsets were computed */
+} Mat_SeqAIJ_CompressedIndices;
+
+/* Entries staged before the first final assembly of a matrix set up without preallocation, see -mat_aij_hash_assembly */
+typedef struct {
+  PetscBool        use;                            /* stage the entries in MatSetUp() instead of preallocating */
+  PetscHMapIJ      ht;                             /* (row,column) -> position of the value in v */
+  PetscScalar      *v;                             /* [nmax] staged values */
+  PetscInt         n,nmax;                         /* number of staged entries and length of v */
+  PetscInt         *rlen;                          /* [m] number of staged entries in each row */
+  PetscErrorCode   (*setvalues)(Mat,PetscInt,const PetscInt[],PetscInt,const PetscInt[],const PetscScalar[],InsertMode);
+  PetscErrorCode   (*zeroentries)(Mat);
+  PetscErrorCode   (*assemblyend)(Mat,MatAssemblyType);
+} Mat_SeqAIJ_Hash;
+
+/* Rows of a triangular factor grouped by levels of rows that can be computed simultaneously */
+typedef struct {
+  PetscInt         nlevels;
+  PetscInt         *level;                         /* [nlevels+1]: rows of level l are rows[level[l]] to rows[level[l+1]-1] */
+  PetscInt         *rows;                          /* [m] rows sorted by level */
+} Mat_SeqAIJ_LevelSet;
+
+/* Level scheduled MatSolve() and MatSolveTranspose() of LU and ILU factors, see -mat_aij_level_solve */
+typedef struct {
+  PetscBool           use;                         /* use the level scheduled solves once the matrix is factored */
+  Mat_SeqAIJ_LevelSet L,U;                         /* levels of the solves with L and U, computed at the numeric factorization */
+  Mat_SeqAIJ_LevelSet Ut,Lt;                       /* levels of the solves with U^T and L^T, computed at the first MatSolveTranspose() */
+  PetscInt            *ti,*tsplit,*tj,*tpos;       /* factor stored by columns: column i has entries ti[i] to ti[i+1]-1 in rows tj[] at positions tpos[] of a,
+                                                      those before tsplit[i] are in U */
+} Mat_SeqAIJ_Levels;
+
+/* ILU factors computed by fixed-point sweeps and applied with Jacobi sweeps, see MatFactorSetIterativeSweeps() */
+typedef struct {
+  PetscInt         fsweeps;                        /* fixed-point sweeps of the numeric factorization, 0 for the exact factorization */
+  PetscInt         ssweeps;                        /* Jacobi sweeps of each triangular solve, 0 for exact triangular solves */
+  MatScalar        *a;                             /* entries of the permuted matrix at the positions of the factor */
+  PetscInt         *ui,*uj,*upos;                  /* U stored by columns: column j has rows uj[ui[j]] to uj[ui[j+1]-1] at positions upos[] of a */
+  PetscScalar      *work;                          /* [2*m] work vectors of the Jacobi sweeps */
+} Mat_SeqAIJ_Iterative;
+
 PETSC_INTERN PetscErrorCode MatView_SeqAIJ_Inode(Mat,PetscViewer);
 PETSC_INTERN PetscErrorCode MatAssemblyEnd_SeqAIJ_Inode(Mat,MatAssemblyType);
 PETSC_INTERN PetscErrorCode MatDestroy_SeqAIJ_Inode(Mat);
@@ -110,10 +205,20 @@ PETSC_INTERN PetscErrorCode MatLUFactorNumeric_SeqAIJ_Inode_inplace(Mat,Mat,cons
 PETSC_INTERN PetscErrorCode MatLUFactorNumeric_SeqAIJ_Inode(Mat,Mat,const MatFactorInfo*);
 PETSC_INTERN PetscErrorCode MatSeqAIJGetArray_SeqAIJ(Mat,PetscScalar**);
 PETSC_INTERN PetscErrorCode MatSeqAIJRestoreArray_SeqAIJ(Mat,PetscScalar**);
+PETSC_INTERN PetscErrorCode MatResidualJacobiUpdate_SeqAIJ_Private(Mat,const PetscScalar[],Vec,Vec,Vec,PetscScalar,Vec,PetscScalar,Vec,PetscScalar,Vec,PetscReal*);
 
 typedef struct {
   SEQAIJHEADER(MatScalar);
   Mat_SeqAIJ_Inode inode;
+  Mat_SeqAIJ_OMP   omp;
+  Mat_SeqAIJ_Autotune autotune;
+  Mat_SeqAIJ_Mixed mixed;
+  Mat_SeqAIJ_CompressedIndices cind;
+  Mat_SeqAIJ_Hash  hash;
+  Mat_SeqAIJ_Levels levels;
+  Mat_SeqAIJ_Iterative iter;
+  MatSORColoring   sorcolor;                  /* coloring of the rows for SOR_MULTICOLOR */
+  PetscBool        supernodal;                /* use the supernodal numeric Cholesky factorization, see -mat_aij_supernodal */
   MatScalar        *saved_values;             /* location for stashing nonzero values of matrix */
 
   PetscScalar *idiag,*mdiag,*ssor_work;       /* inverse of diagonal entries, diagonal values and workspace for Eisenstat trick */
@@ -122,6 +227,12 @@ typedef struct {
   PetscBool   ibdiagvalid;                    /* inverses of block diagonals are valid. */
   PetscBool   diagonaldense;                  /* all entries along the diagonal have been set; i.e. no missing diagonal terms */
   PetscScalar fshift,omega;                   /* last used omega and fshift */
+
+  /* MatSetPreallocationCOO()/MatSetValuesCOO() related fields */
+  PetscInt         coo_n;                     /* number of entries in the COO input */
+  PetscInt         *coo_jmap;                 /* [nz+1]: coo_v[coo_perm[coo_jmap[k]..coo_jmap[k+1])] are summed into a[k] */
+  PetscInt         *coo_perm;                 /* [coo_n]: COO entries sorted by (row,col) */
+  PetscObjectState coo_nonzerostate;          /* nonzero state of the matrix when the COO map was built */
 } Mat_SeqAIJ;
 
 /*
@@ -219,6 +330,7 @@ PETSC_INTERN PetscErrorCode MatCholeskyFactorSymbolic_SeqAIJ_inplace(Mat,Mat,IS,
 PETSC_INTERN PetscErrorCode MatCholeskyFactorSymbolic_SeqAIJ(Mat,Mat,IS,const MatFactorInfo*);
 PETSC_INTERN PetscErrorCode MatCholeskyFactorNumeric_SeqAIJ_inplace(Mat,Mat,const MatFactorInfo*);
 PETSC_INTERN PetscErrorCode MatCholeskyFactorNumeric_SeqAIJ(Mat,Mat,const MatFactorInfo*);
+PETSC_INTERN PetscErrorCode MatCholeskyFactorNumeric_SeqAIJ_Supernodal(Mat,Mat,const MatFactorInfo*);
 PETSC_INTERN PetscErrorCode MatDuplicate_SeqAIJ(Mat,MatDuplicateOption,Mat*);
 PETSC_INTERN PetscErrorCode MatCopy_SeqAIJ(Mat,Mat,MatStructure);
 PETSC_INTERN PetscErrorCode MatMissingDiagonal_SeqAIJ(Mat,PetscBool*,PetscInt*);
@@ -250,6 +362,19 @@ PETSC_INTERN PetscErrorCode MatLUFactorNumeric_SeqAIJ_InplaceWithPerm(Mat,Mat,co
 PETSC_INTERN PetscErrorCode MatLUFactor_SeqAIJ(Mat,IS,IS,const MatFactorInfo*);
 PETSC_INTERN PetscErrorCode MatSolve_SeqAIJ_inplace(Mat,Vec,Vec);
 PETSC_INTERN PetscErrorCode MatSolve_SeqAIJ(Mat,Vec,Vec);
+#if defined(MATSEQAIJ_HAVE_MIXED_PRECISION)
+PETSC_INTERN PetscErrorCode MatSeqAIJMixedGetArray_Private(Mat,const float**);
+PETSC_INTERN PetscErrorCode MatSolve_SeqAIJ_Mixed(Mat,Vec,Vec);
+#endif
+PETSC_INTERN PetscErrorCode MatSeqAIJLevelsSetUp_Private(Mat);
+PETSC_INTERN PetscErrorCode MatSeqAIJLevelsReset_Private(Mat);
+PETSC_INTERN PetscErrorCode MatSolve_SeqAIJ_Levels(Mat,Vec,Vec);
+PETSC_INTERN PetscErrorCode MatSolveTranspose_SeqAIJ_Levels(Mat,Vec,Vec);
+PETSC_INTERN PetscErrorCode MatView_SeqAIJ_Levels(Mat,PetscViewer);
+PETSC_INTERN PetscErrorCode MatSeqAIJIterativeReset_Private(Mat);
+PETSC_INTERN PetscErrorCode MatILUFactorNumeric_SeqAIJ_Iterative(Mat,Mat,const MatFactorInfo*);
+PETSC_INTERN PetscErrorCode MatSolve_SeqAIJ_Jacobi(Mat,Vec,Vec);
+PETSC_INTERN PetscErrorCode MatView_SeqAIJ_Iterative(Mat,PetscViewer);
 PETSC_INTERN PetscErrorCode MatSolve_SeqAIJ_Inode_inplace(Mat,Vec,Vec);
 PETSC_INTERN PetscErrorCode MatSolve_SeqAIJ_Inode(Mat,Vec,Vec);
 PETSC_INTERN PetscErrorCode MatSolve_SeqAIJ_NaturalOrdering_inplace(Mat,Vec,Vec);
@@ -290,6 +415,7 @@ PETSC_INTERN PetscErrorCode MatMatMultSymbolic_SeqAIJ_SeqAIJ_Heap(Mat,Mat,PetscR
 PETSC_INTERN PetscErrorCode MatMatMultSymbolic_SeqAIJ_SeqAIJ_BTHeap(Mat,Mat,PetscReal,Mat);
 PETSC_INTERN PetscErrorCode MatMatMultSymbolic_SeqAIJ_SeqAIJ_RowMerge(Mat,Mat,PetscReal,Mat);
 PETSC_INTERN PetscErrorCode MatMatMultSymbolic_SeqAIJ_SeqAIJ_LLCondensed(Mat,Mat,PetscReal,Mat);
+PETSC_INTERN PetscErrorCode MatMatMultSymbolic_SeqAIJ_SeqAIJ_Hash(Mat,Mat,PetscReal,Mat);
 #if defined(PETSC_HAVE_HYPRE)
 PETSC_INTERN PetscErrorCode MatMatMultSymbolic_AIJ_AIJ_wHYPRE(Mat,Mat,PetscReal,Mat);
 #endif
@@ -299,10 +425,13 @@ PETSC_INTERN PetscErrorCode MatMatMultNumeric_SeqAIJ_SeqAIJ_Sorted(Mat,Mat,Mat);
 
 PETSC_INTERN PetscErrorCode MatMatMultNumeric_SeqDense_SeqAIJ(Mat,Mat,Mat);
 PETSC_INTERN PetscErrorCode MatMatMultNumeric_SeqAIJ_SeqAIJ_Scalable(Mat,Mat,Mat);
+PETSC_INTERN PetscErrorCode MatMatMultNumeric_SeqAIJ_SeqAIJ_Hash(Mat,Mat,Mat);
 
 PETSC_INTERN PetscErrorCode MatPtAPSymbolic_SeqAIJ_SeqAIJ_SparseAxpy(Mat,Mat,PetscReal,Mat);
 PETSC_INTERN PetscErrorCode MatPtAPNumeric_SeqAIJ_SeqAIJ(Mat,Mat,Mat);
 PETSC_INTERN PetscErrorCode MatPtAPNumeric_SeqAIJ_SeqAIJ_SparseAxpy(Mat,Mat,Mat);
+PETSC_INTERN PetscErrorCode MatPtAPSymbolic_SeqAIJ_SeqAIJ_Hash(Mat,Mat,PetscReal,Mat);
+PETSC_INTERN PetscErrorCode MatPtAPNumeric_SeqAIJ_SeqAIJ_Hash(Mat,Mat,Mat);
 
 PETSC_INTERN PetscErrorCode MatRARtSymbolic_SeqAIJ_SeqAIJ(Mat,Mat,PetscReal,Mat);
 PETSC_INTERN PetscErrorCode MatRARtSymbolic_SeqAIJ_SeqAIJ_matmattransposemult(Mat,Mat,PetscReal,Mat);
@@ -384,6 +513,9 @@ PETSC_INTERN PetscErrorCode MatDestroySubMatrices_Dummy(PetscInt, Mat*[]);
 PETSC_INTERN PetscErrorCode MatCreateSubMatrix_SeqAIJ(Mat,IS,IS,PetscInt,MatReuse,Mat*);
 
 PETSC_INTERN PetscErrorCode MatSeqAIJCompactOutExtraColumns_SeqAIJ(Mat,ISLocalToGlobalMapping*);
+PETSC_INTERN PetscErrorCode MatSetPreallocationCOO_SeqAIJ(Mat,PetscInt,const PetscInt[],const PetscInt[]);
+PETSC_INTERN PetscErrorCode MatSetValuesCOO_SeqAIJ(Mat,const PetscScalar[],InsertMode);
+PETSC_INTERN PetscErrorCode MatResetPreallocationCOO_SeqAIJ(Mat);
 PETSC_INTERN PetscErrorCode MatSetSeqAIJWithArrays_private(MPI_Comm,PetscInt,PetscInt,PetscInt[],PetscInt[],PetscScalar[],MatType,Mat);
 
 /*
@@ -3,6 +3,9 @@
 #include <../src/mat/impls/sbaij/seq/sbaij.h>
 #include <petscbt.h>
 #include <../src/mat/utils/freespace.h>
+#if defined(PETSC_HAVE_OPENMP)
+#include <omp.h>
+#endif
 
 /*
       Computes an ordering to get most of the large numerical values in the lower triangular part of the matrix
@@ -89,6 +92,8 @@ PetscErrorCode MatGetOrdering_Flow_SeqAIJ(Mat mat,MatOrderingType type,IS *irow,
   PetscFunctionReturn(0);
 }
 
+static PetscErrorCode MatFactorSetIterativeSweeps_SeqAIJ(Mat,PetscInt,PetscInt);
+
 static PetscErrorCode MatFactorGetSolverType_petsc(Mat A,MatSolverType *type)
 {
   PetscFunctionBegin;
@@ -125,8 +130,16 @@ PETSC_INTERN PetscErrorCode MatGetFactor_seqaij_petsc(Mat A,MatFactorType ftype,
     (*B)->ops->choleskyfactorsymbolic = MatCholeskyFactorSymbolic_SeqAIJ;
     ierr = PetscStrallocpy(MATORDERINGND,(char**)&(*B)->preferredordering[MAT_FACTOR_CHOLESKY]);CHKERRQ(ierr);
     ierr = PetscStrallocpy(MATORDERINGNATURAL,(char**)&(*B)->preferredordering[MAT_FACTOR_ICC]);CHKERRQ(ierr);
+    if (ftype == MAT_FACTOR_CHOLESKY) ((Mat_SeqSBAIJ*)(*B)->data)->sn.use = ((Mat_SeqAIJ*)A->data)->supernodal;
   } else SETERRQ(PETSC_COMM_SELF,PETSC_ERR_SUP,"Factor type not supported");
   (*B)->factortype = ftype;
+#if defined(MATSEQAIJ_HAVE_MIXED_PRECISION)
+  if (ftype == MAT_FACTOR_LU || ftype == MAT_FACTOR_ILU) ((Mat_SeqAIJ*)(*B)->data)->mixed.use = ((Mat_SeqAIJ*)A->data)->mixed.use;
+#endif
+  if (ftype == MAT_FACTOR_LU || ftype == MAT_FACTOR_ILU) ((Mat_SeqAIJ*)(*B)->data)->levels.use = ((Mat_SeqAIJ*)A->data)->levels.use;
+  if (ftype == MAT_FACTOR_ILU) {
+    ierr = PetscObjectComposeFunction((PetscObject)*B,"MatFactorSetIterativeSweeps_C",MatFactorSetIterativeSweeps_SeqAIJ);CHKERRQ(ierr);
+  }
 
   ierr = PetscFree((*B)->solvertype);CHKERRQ(ierr);
   ierr = PetscStrallocpy(MATSOLVERPETSC,&(*B)->solvertype);CHKERRQ(ierr);
@@ -608,10 +621,19 @@ PetscErrorCode MatLUFactorNumeric_SeqAIJ(Mat B,Mat A,const MatFactorInfo *info)
   } else {
     C->ops->solve = MatSolve_SeqAIJ;
   }
+#if defined(MATSEQAIJ_HAVE_MIXED_PRECISION)
+  if (b->mixed.use) C->ops->solve = MatSolve_SeqAIJ_Mixed;
+#endif
   C->ops->solveadd          = MatSolveAdd_SeqAIJ;
   C->ops->solvetranspose    = MatSolveTranspose_SeqAIJ;
   C->ops->solvetransposeadd = MatSolveTransposeAdd_SeqAIJ;
   C->ops->matsolve          = MatMatSolve_SeqAIJ;
+  if (b->levels.use) {
+    ierr = MatSeqAIJLevelsSetUp_Private(C);CHKERRQ(ierr);
+    C->ops->solve          = MatSolve_SeqAIJ_Levels;
+    C->ops->solvetranspose = MatSolveTranspose_SeqAIJ_Levels;
+  }
+  if (b->iter.ssweeps) C->ops->solve = MatSolve_SeqAIJ_Jacobi;
   C->assembled              = PETSC_TRUE;
   C->preallocated           = PETSC_TRUE;
 
@@ -1607,6 +1629,7 @@ PetscErrorCode MatILUFactorSymbolic_SeqAIJ_ilu0(Mat fact,Mat A,IS isrow,IS iscol
 
   PetscFunctionBegin;
   ierr = ISInvertPermutation(iscol,PETSC_DECIDE,&isicol);CHKERRQ(ierr);
+  ierr = MatSeqAIJLevelsReset_Private(fact);CHKERRQ(ierr);
   ierr = MatDuplicateNoCreate_SeqAIJ(fact,A,MAT_DO_NOT_COPY_VALUES,PETSC_FALSE);CHKERRQ(ierr);
   b    = (Mat_SeqAIJ*)(fact)->data;
 
@@ -1695,6 +1718,7 @@ PetscErrorCode MatILUFactorSymbolic_SeqAIJ(Mat fact,Mat A,IS isrow,IS iscol,cons
   if (A->rmap->n != A->cmap->n) SETERRQ2(PETSC_COMM_SELF,PETSC_ERR_ARG_WRONG,"Must be square matrix, rows %D columns %D",A->rmap->n,A->cmap->n);
   ierr = MatMissingDiagonal(A,&missing,&i);CHKERRQ(ierr);
   if (missing) SETERRQ1(PETSC_COMM_SELF,PETSC_ERR_ARG_WRONGSTATE,"Matrix is missing diagonal entry %D",i);
+  ierr = MatSeqAIJIterativeReset_Private(fact);CHKERRQ(ierr);
 
   levels = (PetscInt)info->levels;
   ierr   = ISIdentity(isrow,&row_identity);CHKERRQ(ierr);
@@ -1705,6 +1729,7 @@ PetscErrorCode MatILUFactorSymbolic_SeqAIJ(Mat fact,Mat A,IS isrow,IS iscol,cons
     if (a->inode.size) {
       fact->ops->lufactornumeric = MatLUFactorNumeric_SeqAIJ_Inode;
     }
+    if (((Mat_SeqAIJ*)fact->data)->iter.fsweeps) fact->ops->lufactornumeric = MatILUFactorNumeric_SeqAIJ_Iterative;
     PetscFunctionReturn(0);
   }
 
@@ -1845,6 +1870,7 @@ PetscErrorCode MatILUFactorSymbolic_SeqAIJ(Mat fact,Mat A,IS isrow,IS iscol,cons
   if (a->inode.size) {
     (fact)->ops->lufactornumeric = MatLUFactorNumeric_SeqAIJ_Inode;
   }
+  if (b->iter.fsweeps) (fact)->ops->lufactornumeric = MatILUFactorNumeric_SeqAIJ_Iterative;
   ierr = MatSeqAIJCheckInode_FactorLU(fact);CHKERRQ(ierr);
   PetscFunctionReturn(0);
 }
@@ -2197,6 +2223,80 @@ PetscErrorCode MatCholeskyFactorNumeric_SeqAIJ(Mat B,Mat A,const MatFactorInfo *
   PetscFunctionReturn(0);
 }
 
+/*
+    Version of MatCholeskyFactorNumeric_SeqAIJ() with the supernodes of the factor, see -mat_aij_supernodal
+*/
+PetscErrorCode MatCholeskyFactorNumeric_SeqAIJ_Supernodal(Mat B,Mat A,const MatFactorInfo *info)
+{
+  Mat_SeqAIJ     *a = (Mat_SeqAIJ*)A->data;
+  Mat_SeqSBAIJ   *b = (Mat_SeqSBAIJ*)B->data;
+  PetscErrorCode ierr;
+  const PetscInt *rip,*riip;
+  PetscInt       i,j,mbs = A->rmap->n,*ai = a->i,nz;
+  MatScalar      *aa = a->a,d,*v;
+  PetscBool      perm_identity;
+  FactorShiftCtx sctx;
+  PetscReal      rs;
+
+  PetscFunctionBegin;
+  /* MatPivotSetUp(): initialize shift context sctx */
+  ierr = PetscMemzero(&sctx,sizeof(FactorShiftCtx));CHKERRQ(ierr);
+
+  if (info->shifttype == (PetscReal)MAT_SHIFT_POSITIVE_DEFINITE) { /* set sctx.shift_top=max{rs} */
+    sctx.shift_top = info->zeropivot;
+    for (i=0; i<mbs; i++) {
+      /* calculate sum(|aij|)-RealPart(aii), amt of shift needed for this row */
+      d  = aa[a->diag[i]];
+      rs = -PetscAbsScalar(d) - PetscRealPart(d);
+      v  = aa+ai[i];
+      nz = ai[i+1] - ai[i];
+      for (j=0; j<nz; j++) rs += PetscAbsScalar(v[j]);
+      if (rs>sctx.shift_top) sctx.shift_top = rs;
+    }
+    sctx.shift_top *= 1.1;
+    sctx.nshift_max = 5;
+    sctx.shift_lo   = 0.;
+    sctx.shift_hi   = 1.;
+  }
+
+  ierr = ISGetIndices(b->row,&rip);CHKERRQ(ierr);
+  ierr = ISGetIndices(b->icol,&riip);CHKERRQ(ierr);
+  do {
+    sctx.newshift = PETSC_FALSE;
+    ierr = MatCholeskyFactorNumeric_SeqSBAIJ_1_Supernodal_Private(B,A,ai,a->j,aa,rip,riip,info,&sctx);CHKERRQ(ierr);
+  } while (sctx.newshift);
+  ierr = ISRestoreIndices(b->row,&rip);CHKERRQ(ierr);
+  ierr = ISRestoreIndices(b->icol,&riip);CHKERRQ(ierr);
+
+  ierr = ISIdentity(b->row,&perm_identity);CHKERRQ(ierr);
+  if (perm_identity) {
+    B->ops->solve          = MatSolve_SeqSBAIJ_1_NaturalOrdering;
+    B->ops->solvetranspose = MatSolve_SeqSBAIJ_1_NaturalOrdering;
+    B->ops->forwardsolve   = MatForwardSolve_SeqSBAIJ_1_NaturalOrdering;
+    B->ops->backwardsolve  = MatBackwardSolve_SeqSBAIJ_1_NaturalOrdering;
+  } else {
+    B->ops->solve          = MatSolve_SeqSBAIJ_1;
+    B->ops->solvetranspose = MatSolve_SeqSBAIJ_1;
+    B->ops->forwardsolve   = MatForwardSolve_SeqSBAIJ_1;
+    B->ops->backwardsolve  = MatBackwardSolve_SeqSBAIJ_1;
+  }
+
+  B->assembled    = PETSC_TRUE;
+  B->preallocated = PETSC_TRUE;
+
+  /* MatPivotView() */
+  if (sctx.nshift) {
+    if (info->shifttype == (PetscReal)MAT_SHIFT_POSITIVE_DEFINITE) {
+      ierr = PetscInfo4(A,"number of shift_pd tries %D, shift_amount %g, diagonal shifted up by %e fraction top_value %e\n",sctx.nshift,(double)sctx.shift_amount,(double)sctx.shift_fraction,(double)sctx.shift_top);CHKERRQ(ierr);
+    } else if (info->shifttype == (PetscReal)MAT_SHIFT_NONZERO) {
+      ierr = PetscInfo2(A,"number of shift_nz tries %D, shift_amount %g\n",sctx.nshift,(double)sctx.shift_amount);CHKERRQ(ierr);
+    } else if (info->shifttype == (PetscReal)MAT_SHIFT_INBLOCKS) {
+      ierr = PetscInfo2(A,"number of shift_inblocks applied %D, each shift_amount %g\n",sctx.nshift,(double)info->shiftamount);CHKERRQ(ierr);
+    }
+  }
+  PetscFunctionReturn(0);
+}
+
 PetscErrorCode MatCholeskyFactorNumeric_SeqAIJ_inplace(Mat B,Mat A,const MatFactorInfo *info)
 {
   Mat            C = B;
@@ -2940,6 +3040,10 @@ PetscErrorCode MatCholeskyFactorSymbolic_SeqAIJ(Mat fact,Mat A,IS perm,const Mat
   }
 #endif
   fact->ops->choleskyfactornumeric = MatCholeskyFactorNumeric_SeqAIJ;
+  if (b->sn.use) {
+    ierr = MatSeqSBAIJSupernodesSetUp_Private(fact);CHKERRQ(ierr);
+    fact->ops->choleskyfactornumeric = MatCholeskyFactorNumeric_SeqAIJ_Supernodal;
+  }
   PetscFunctionReturn(0);
 }
 
@@ -3206,6 +3310,668 @@ PetscErrorCode MatSolve_SeqAIJ(Mat A,Vec bb,Vec xx)
   PetscFunctionReturn(0);
 }
 
+#if defined(MATSEQAIJ_HAVE_MIXED_PRECISION)
+/* MatSolve_SeqAIJ() with the single precision copy of the factor, the work vector stays in double precision */
+PetscErrorCode MatSolve_SeqAIJ_Mixed(Mat A,Vec bb,Vec xx)
+{
+  Mat_SeqAIJ        *a    = (Mat_SeqAIJ*)A->data;
+  IS                iscol = a->col,isrow = a->row;
+  PetscErrorCode    ierr;
+  PetscInt          i,n=A->rmap->n,*vi,*ai=a->i,*aj=a->j,*adiag = a->diag,nz;
+  const PetscInt    *rout,*cout,*r,*c;
+  PetscScalar       *x,*tmp,sum;
+  const PetscScalar *b;
+  const float       *aa,*v;
+
+  PetscFunctionBegin;
+  if (!n) PetscFunctionReturn(0);
+
+  ierr = MatSeqAIJMixedGetArray_Private(A,&aa);CHKERRQ(ierr);
+  ierr = VecGetArrayRead(bb,&b);CHKERRQ(ierr);
+  ierr = VecGetArrayWrite(xx,&x);CHKERRQ(ierr);
+  tmp  = a->solve_work;
+
+  ierr = ISGetIndices(isrow,&rout);CHKERRQ(ierr); r = rout;
+  ierr = ISGetIndices(iscol,&cout);CHKERRQ(ierr); c = cout;
+
+  /* forward solve the lower triangular */
+  tmp[0] = b[r[0]];
+  v      = aa;
+  vi     = aj;
+  for (i=1; i<n; i++) {
+    nz  = ai[i+1] - ai[i];
+    sum = b[r[i]];
+    PetscSparseDenseMinusDot(sum,tmp,v,vi,nz);
+    tmp[i] = sum;
+    v     += nz; vi += nz;
+  }
+
+  /* backward solve the upper triangular */
+  for (i=n-1; i>=0; i--) {
+    v   = aa + adiag[i+1]+1;
+    vi  = aj + adiag[i+1]+1;
+    nz  = adiag[i]-adiag[i+1]-1;
+    sum = tmp[i];
+    PetscSparseDenseMinusDot(sum,tmp,v,vi,nz);
+    x[c[i]] = tmp[i] = sum*v[nz]; /* v[nz] = aa[adiag[i]] */
+  }
+
+  ierr = ISRestoreIndices(isrow,&rout);CHKERRQ(ierr);
+  ierr = ISRestoreIndices(iscol,&cout);CHKERRQ(ierr);
+  ierr = VecRestoreArrayRead(bb,&b);CHKERRQ(ierr);
+  ierr = VecRestoreArrayWrite(xx,&x);CHKERRQ(ierr);
+  ierr = PetscLogFlops(2.0*a->nz - A->cmap->n);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+#endif
+
+/*
+   Level scheduling of the triangular solves, see -mat_aij_level_solve: row i is in level l if the rows it depends on
+   are in levels below l, so the rows of a level can be computed simultaneously. The threads of PetscNumOMPThreads
+   sweep the levels one after the other, with a barrier between consecutive levels.
+*/
+static PetscErrorCode MatSeqAIJLevelSetCreate_Private(PetscInt n,const PetscInt *lev,Mat_SeqAIJ_LevelSet *ls)
+{
+  PetscErrorCode ierr;
+  PetscInt       i,l,nlevels = 0;
+
+  PetscFunctionBegin;
+  for (i=0; i<n; i++) nlevels = PetscMax(nlevels,lev[i]+1);
+  ierr = PetscCalloc1(nlevels+1,&ls->level);CHKERRQ(ierr);
+  ierr = PetscMalloc1(n,&ls->rows);CHKERRQ(ierr);
+  for (i=0; i<n; i++) ls->level[lev[i]+1]++;
+  for (l=0; l<nlevels; l++) ls->level[l+1] += ls->level[l];
+  for (i=0; i<n; i++) ls->rows[ls->level[lev[i]]++] = i;
+  for (l=nlevels; l>0; l--) ls->level[l] = ls->level[l-1];
+  ls->level[0] = 0;
+  ls->nlevels  = nlevels;
+  PetscFunctionReturn(0);
+}
+
+static PetscErrorCode MatSeqAIJLevelSetDestroy_Private(Mat_SeqAIJ_LevelSet *ls)
+{
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  ierr = PetscFree(ls->level);CHKERRQ(ierr);
+  ierr = PetscFree(ls->rows);CHKERRQ(ierr);
+  ls->nlevels = 0;
+  PetscFunctionReturn(0);
+}
+
+PetscErrorCode MatSeqAIJLevelsReset_Private(Mat A)
+{
+  Mat_SeqAIJ     *a = (Mat_SeqAIJ*)A->data;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  ierr = MatSeqAIJLevelSetDestroy_Private(&a->levels.L);CHKERRQ(ierr);
+  ierr = MatSeqAIJLevelSetDestroy_Private(&a->levels.U);CHKERRQ(ierr);
+  ierr = MatSeqAIJLevelSetDestroy_Private(&a->levels.Ut);CHKERRQ(ierr);
+  ierr = MatSeqAIJLevelSetDestroy_Private(&a->levels.Lt);CHKERRQ(ierr);
+  ierr = PetscFree4(a->levels.ti,a->levels.tsplit,a->levels.tj,a->levels.tpos);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+/* Computes the levels of the forward solve with L and of the backward solve with U */
+PetscErrorCode MatSeqAIJLevelsSetUp_Private(Mat A)
+{
+  Mat_SeqAIJ     *a = (Mat_SeqAIJ*)A->data;
+  PetscErrorCode ierr;
+  const PetscInt n = A->rmap->n,*ai = a->i,*aj = a->j,*adiag = a->diag;
+  PetscInt       i,k,*lev;
+
+  PetscFunctionBegin;
+  if (a->levels.L.rows) PetscFunctionReturn(0);
+  ierr = PetscMalloc1(n,&lev);CHKERRQ(ierr);
+  for (i=0; i<n; i++) {
+    lev[i] = 0;
+    for (k=ai[i]; k<ai[i+1]; k++) lev[i] = PetscMax(lev[i],lev[aj[k]]+1);
+  }
+  ierr = MatSeqAIJLevelSetCreate_Private(n,lev,&a->levels.L);CHKERRQ(ierr);
+  for (i=n-1; i>=0; i--) {
+    lev[i] = 0;
+    for (k=adiag[i+1]+1; k<adiag[i]; k++) lev[i] = PetscMax(lev[i],lev[aj[k]]+1);
+  }
+  ierr = MatSeqAIJLevelSetCreate_Private(n,lev,&a->levels.U);CHKERRQ(ierr);
+  ierr = PetscFree(lev);CHKERRQ(ierr);
+  ierr = PetscInfo3(A,"Level scheduled solves: %D levels for L and %D levels for U with %D rows\n",a->levels.L.nlevels,a->levels.U.nlevels,n);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+/*
+   Computes the levels of the solves with U^T and L^T, and stores the factor by columns so each row of the
+   transposed factors is computed from the rows it depends on instead of being scattered into them
+*/
+static PetscErrorCode MatSeqAIJLevelsSetUpTranspose_Private(Mat A)
+{
+  Mat_SeqAIJ     *a = (Mat_SeqAIJ*)A->data;
+  PetscErrorCode ierr;
+  const PetscInt n = A->rmap->n,*ai = a->i,*aj = a->j,*adiag = a->diag;
+  PetscInt       i,k,*lev,*ti,*tsplit,*tj,*tpos,*cnt,nz;
+
+  PetscFunctionBegin;
+  if (a->levels.Ut.rows) PetscFunctionReturn(0);
+  nz   = ai[n] + adiag[0] - adiag[n] - n;
+  ierr = PetscMalloc4(n+1,&ti,n,&tsplit,nz,&tj,nz,&tpos);CHKERRQ(ierr);
+  ierr = PetscCalloc1(n,&cnt);CHKERRQ(ierr);
+  ierr = PetscCalloc1(n,&lev);CHKERRQ(ierr);
+  ierr = PetscArrayzero(tsplit,n);CHKERRQ(ierr);
+  /* U(i,k) with k > i is in row k of U^T, L(i,k) with k < i in row k of L^T */
+  for (i=0; i<n; i++) {
+    for (k=ai[i]; k<ai[i+1]; k++) cnt[aj[k]]++;
+    for (k=adiag[i+1]+1; k<adiag[i]; k++) tsplit[aj[k]]++;
+  }
+  ti[0] = 0;
+  for (i=0; i<n; i++) ti[i+1] = ti[i] + tsplit[i] + cnt[i];
+  /* the rows of the factor are visited in increasing order, so the entries of U come first in each column */
+  for (i=0; i<n; i++) {
+    cnt[i]    = ti[i];
+    tsplit[i] = ti[i] + tsplit[i];
+  }
+  for (i=0; i<n; i++) {
+    for (k=adiag[i+1]+1; k<adiag[i]; k++) {tj[cnt[aj[k]]] = i; tpos[cnt[aj[k]]++] = k;}
+  }
+  for (i=0; i<n; i++) cnt[i] = tsplit[i];
+  for (i=0; i<n; i++) {
+    for (k=ai[i]; k<ai[i+1]; k++) {tj[cnt[aj[k]]] = i; tpos[cnt[aj[k]]++] = k;}
+  }
+  ierr = PetscFree(cnt);CHKERRQ(ierr);
+
+  for (i=0; i<n; i++) {
+    for (k=ti[i]; k<tsplit[i]; k++) lev[i] = PetscMax(lev[i],lev[tj[k]]+1);
+  }
+  ierr = MatSeqAIJLevelSetCreate_Private(n,lev,&a->levels.Ut);CHKERRQ(ierr);
+  for (i=n-1; i>=0; i--) {
+    lev[i] = 0;
+    for (k=tsplit[i]; k<ti[i+1]; k++) lev[i] = PetscMax(lev[i],lev[tj[k]]+1);
+  }
+  ierr = MatSeqAIJLevelSetCreate_Private(n,lev,&a->levels.Lt);CHKERRQ(ierr);
+  ierr = PetscFree(lev);CHKERRQ(ierr);
+
+  a->levels.ti     = ti;
+  a->levels.tsplit = tsplit;
+  a->levels.tj     = tj;
+  a->levels.tpos   = tpos;
+  ierr = PetscInfo3(A,"Level scheduled transposed solves: %D levels for U^T and %D levels for L^T with %D rows\n",a->levels.Ut.nlevels,a->levels.Lt.nlevels,n);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+PetscErrorCode MatSolve_SeqAIJ_Levels(Mat A,Vec bb,Vec xx)
+{
+  Mat_SeqAIJ          *a = (Mat_SeqAIJ*)A->data;
+  PetscErrorCode      ierr;
+  const PetscInt      *ai = a->i,*aj = a->j,*adiag = a->diag,*r,*c;
+  PetscScalar         *x,*tmp = a->solve_work;
+  const PetscScalar   *b;
+  const MatScalar     *aa = a->a;
+  Mat_SeqAIJ_LevelSet *L = &a->levels.L,*U = &a->levels.U;
+
+  PetscFunctionBegin;
+  if (!A->rmap->n) PetscFunctionReturn(0);
+  ierr = MatSeqAIJLevelsSetUp_Private(A);CHKERRQ(ierr);
+  ierr = VecGetArrayRead(bb,&b);CHKERRQ(ierr);
+  ierr = VecGetArrayWrite(xx,&x);CHKERRQ(ierr);
+  ierr = ISGetIndices(a->row,&r);CHKERRQ(ierr);
+  ierr = ISGetIndices(a->col,&c);CHKERRQ(ierr);
+#if defined(PETSC_HAVE_OPENMP)
+#pragma omp parallel num_threads((int)PetscMax(PetscNumOMPThreads,1))
+#endif
+  {
+    PetscInt        l,p,i,nz;
+    const PetscInt  *vi;
+    const MatScalar *v;
+    PetscScalar     sum;
+
+    for (l=0; l<L->nlevels; l++) {
+#if defined(PETSC_HAVE_OPENMP)
+#pragma omp for schedule(static)
+#endif
+      for (p=L->level[l]; p<L->level[l+1]; p++) {
+        i   = L->rows[p];
+        nz  = ai[i+1] - ai[i];
+        v   = aa + ai[i];
+        vi  = aj + ai[i];
+        sum = b[r[i]];
+        PetscSparseDenseMinusDot(sum,tmp,v,vi,nz);
+        tmp[i] = sum;
+      }
+    }
+    for (l=0; l<U->nlevels; l++) {
+#if defined(PETSC_HAVE_OPENMP)
+#pragma omp for schedule(static)
+#endif
+      for (p=U->level[l]; p<U->level[l+1]; p++) {
+        i   = U->rows[p];
+        nz  = adiag[i] - adiag[i+1] - 1;
+        v   = aa + adiag[i+1] + 1;
+        vi  = aj + adiag[i+1] + 1;
+        sum = tmp[i];
+        PetscSparseDenseMinusDot(sum,tmp,v,vi,nz);
+        x[c[i]] = tmp[i] = sum*v[nz]; /* v[nz] = aa[adiag[i]] */
+      }
+    }
+  }
+  ierr = ISRestoreIndices(a->row,&r);CHKERRQ(ierr);
+  ierr = ISRestoreIndices(a->col,&c);CHKERRQ(ierr);
+  ierr = VecRestoreArrayRead(bb,&b);CHKERRQ(ierr);
+  ierr = VecRestoreArrayWrite(xx,&x);CHKERRQ(ierr);
+  ierr = PetscLogFlops(2.0*a->nz - A->cmap->n);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+PetscErrorCode MatSolveTranspose_SeqAIJ_Levels(Mat A,Vec bb,Vec xx)
+{
+  Mat_SeqAIJ          *a = (Mat_SeqAIJ*)A->data;
+  PetscErrorCode      ierr;
+  const PetscInt      *adiag = a->diag,*r,*c,*ti,*tsplit,*tj,*tpos;
+  PetscInt            n = A->rmap->n,i;
+  PetscScalar         *x,*tmp = a->solve_work;
+  const PetscScalar   *b;
+  const MatScalar     *aa = a->a;
+  Mat_SeqAIJ_LevelSet *Ut,*Lt;
+
+  PetscFunctionBegin;
+  if (!n) PetscFunctionReturn(0);
+  ierr   = MatSeqAIJLevelsSetUpTranspose_Private(A);CHKERRQ(ierr);
+  Ut     = &a->levels.Ut;
+  Lt     = &a->levels.Lt;
+  ti     = a->levels.ti;
+  tsplit = a->levels.tsplit;
+  tj     = a->levels.tj;
+  tpos   = a->levels.tpos;
+  ierr = VecGetArrayRead(bb,&b);CHKERRQ(ierr);
+  ierr = VecGetArrayWrite(xx,&x);CHKERRQ(ierr);
+  ierr = ISGetIndices(a->row,&r);CHKERRQ(ierr);
+  ierr = ISGetIndices(a->col,&c);CHKERRQ(ierr);
+  for (i=0; i<n; i++) tmp[i] = b[c[i]];
+#if defined(PETSC_HAVE_OPENMP)
+#pragma omp parallel num_threads((int)PetscMax(PetscNumOMPThreads,1))
+#endif
+  {
+    PetscInt    l,p,k;
+    PetscScalar sum;
+
+    for (l=0; l<Ut->nlevels; l++) {
+#if defined(PETSC_HAVE_OPENMP)
+#pragma omp for schedule(static)
+#endif
+      for (p=Ut->level[l]; p<Ut->level[l+1]; p++) {
+        PetscInt j = Ut->rows[p];
+
+        sum = tmp[j];
+        for (k=ti[j]; k<tsplit[j]; k++) sum -= aa[tpos[k]]*tmp[tj[k]];
+        tmp[j] = sum*aa[adiag[j]];
+      }
+    }
+    for (l=0; l<Lt->nlevels; l++) {
+#if defined(PETSC_HAVE_OPENMP)
+#pragma omp for schedule(static)
+#endif
+      for (p=Lt->level[l]; p<Lt->level[l+1]; p++) {
+        PetscInt j = Lt->rows[p];
+
+        sum = tmp[j];
+        for (k=tsplit[j]; k<ti[j+1]; k++) sum -= aa[tpos[k]]*tmp[tj[k]];
+        tmp[j] = sum;
+      }
+    }
+  }
+  for (i=0; i<n; i++) x[r[i]] = tmp[i];
+  ierr = ISRestoreIndices(a->row,&r);CHKERRQ(ierr);
+  ierr = ISRestoreIndices(a->col,&c);CHKERRQ(ierr);
+  ierr = VecRestoreArrayRead(bb,&b);CHKERRQ(ierr);
+  ierr = VecRestoreArrayWrite(xx,&x);CHKERRQ(ierr);
+  ierr = PetscLogFlops(2.0*a->nz - A->cmap->n);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+PetscErrorCode MatView_SeqAIJ_Levels(Mat A,PetscViewer viewer)
+{
+  Mat_SeqAIJ        *a = (Mat_SeqAIJ*)A->data;
+  PetscErrorCode    ierr;
+  PetscBool         iascii;
+  PetscViewerFormat format;
+
+  PetscFunctionBegin;
+  if (!a->levels.L.rows) PetscFunctionReturn(0);
+  ierr = PetscObjectTypeCompare((PetscObject)viewer,PETSCVIEWERASCII,&iascii);CHKERRQ(ierr);
+  if (!iascii) PetscFunctionReturn(0);
+  ierr = PetscViewerGetFormat(viewer,&format);CHKERRQ(ierr);
+  if (format != PETSC_VIEWER_ASCII_INFO_DETAIL && format != PETSC_VIEWER_ASCII_INFO) PetscFunctionReturn(0);
+  ierr = PetscViewerASCIIPrintf(viewer,"level scheduled solves: %D levels for L, %D levels for U\n",a->levels.L.nlevels,a->levels.U.nlevels);CHKERRQ(ierr);
+  if (a->levels.Ut.rows) {
+    ierr = PetscViewerASCIIPrintf(viewer,"level scheduled transposed solves: %D levels for U^T, %D levels for L^T\n",a->levels.Ut.nlevels,a->levels.Lt.nlevels);CHKERRQ(ierr);
+  }
+  PetscFunctionReturn(0);
+}
+
+/*
+   Iterative ILU (Chow and Patel), see MatFactorSetIterativeSweeps(): the entries of L and U in the nonzero pattern S of
+   the ILU factor are the fixed point of
+
+     l_ij = (a_ij - sum_{k<j} l_ik u_kj)/u_jj   (i,j) in S, i > j
+     u_ij =  a_ij - sum_{k<i} l_ik u_kj         (i,j) in S, i <= j
+
+   Each sweep updates all the entries in place, the threads of PetscNumOMPThreads updating their rows without
+   synchronizing with each other. A sweep with one thread visits the entries in the order of the exact factorization,
+   so it produces the exact ILU factor.
+*/
+static PetscErrorCode MatFactorSetIterativeSweeps_SeqAIJ(Mat F,PetscInt fsweeps,PetscInt ssweeps)
+{
+  Mat_SeqAIJ *b = (Mat_SeqAIJ*)F->data;
+
+  PetscFunctionBegin;
+  b->iter.fsweeps = fsweeps;
+  b->iter.ssweeps = ssweeps;
+  PetscFunctionReturn(0);
+}
+
+PetscErrorCode MatSeqAIJIterativeReset_Private(Mat A)
+{
+  Mat_SeqAIJ     *a = (Mat_SeqAIJ*)A->data;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  ierr = PetscFree(a->iter.a);CHKERRQ(ierr);
+  ierr = PetscFree3(a->iter.ui,a->iter.uj,a->iter.upos);CHKERRQ(ierr);
+  ierr = PetscFree(a->iter.work);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+/* Allocates the copy of the permuted matrix and stores the nonzero pattern of U by columns */
+static PetscErrorCode MatSeqAIJIterativeSetUp_Private(Mat B)
+{
+  Mat_SeqAIJ     *b = (Mat_SeqAIJ*)B->data;
+  PetscErrorCode ierr;
+  const PetscInt n = B->rmap->n,*bj = b->j,*bdiag = b->diag;
+  PetscInt       i,k,nz,*ui,*uj,*upos,*cnt;
+
+  PetscFunctionBegin;
+  if (b->iter.a) PetscFunctionReturn(0);
+  nz   = bdiag[0] - bdiag[n] - n;
+  ierr = PetscMalloc1(bdiag[0]+1,&b->iter.a);CHKERRQ(ierr);
+  ierr = PetscMalloc3(n+1,&ui,nz,&uj,nz,&upos);CHKERRQ(ierr);
+  ierr = PetscCalloc1(n,&cnt);CHKERRQ(ierr);
+  for (i=0; i<n; i++) {
+    for (k=bdiag[i+1]+1; k<bdiag[i]; k++) cnt[bj[k]]++;
+  }
+  ui[0] = 0;
+  for (i=0; i<n; i++) {
+    ui[i+1] = ui[i] + cnt[i];
+    cnt[i]  = ui[i];
+  }
+  /* the rows are visited in increasing order, so each column is sorted */
+  for (i=0; i<n; i++) {
+    for (k=bdiag[i+1]+1; k<bdiag[i]; k++) {uj[cnt[bj[k]]] = i; upos[cnt[bj[k]]++] = k;}
+  }
+  ierr = PetscFree(cnt);CHKERRQ(ierr);
+  b->iter.ui   = ui;
+  b->iter.uj   = uj;
+  b->iter.upos = upos;
+  PetscFunctionReturn(0);
+}
+
+PetscErrorCode MatILUFactorNumeric_SeqAIJ_Iterative(Mat B,Mat A,const MatFactorInfo *info)
+{
+  Mat_SeqAIJ      *a = (Mat_SeqAIJ*)A->data,*b = (Mat_SeqAIJ*)B->data;
+  PetscErrorCode  ierr;
+  const PetscInt  n = A->rmap->n,*ai = a->i,*aj = a->j,*bi = b->i,*bj = b->j,*bdiag = b->diag;
+  const PetscInt  *r,*ic,*ui,*uj,*upos,*ddiag;
+  PetscInt        i,j,k,nz,s,fsweeps = b->iter.fsweeps;
+  const MatScalar *aa = a->a,*v;
+  MatScalar       *ba = b->a,*fa,*rtmp,d;
+  FactorShiftCtx  sctx;
+  PetscReal       rs;
+  PetscLogDouble  flops = 0.0;
+  PetscBool       row_identity,col_identity;
+
+  PetscFunctionBegin;
+  /* MatPivotSetUp(): initialize shift context sctx */
+  ierr = PetscMemzero(&sctx,sizeof(FactorShiftCtx));CHKERRQ(ierr);
+  if (info->shifttype == (PetscReal) MAT_SHIFT_POSITIVE_DEFINITE) { /* set sctx.shift_top=max{rs} */
+    ddiag          = a->diag;
+    sctx.shift_top = info->zeropivot;
+    for (i=0; i<n; i++) {
+      d  = aa[ddiag[i]];
+      rs = -PetscAbsScalar(d) - PetscRealPart(d);
+      v  = aa+ai[i];
+      nz = ai[i+1] - ai[i];
+      for (j=0; j<nz; j++) rs += PetscAbsScalar(v[j]);
+      if (rs>sctx.shift_top) sctx.shift_top = rs;
+    }
+    sctx.shift_top *= 1.1;
+    sctx.nshift_max = 5;
+    sctx.shift_lo   = 0.;
+    sctx.shift_hi   = 1.;
+  }
+
+  ierr = MatSeqAIJIterativeSetUp_Private(B);CHKERRQ(ierr);
+  fa   = b->iter.a;
+  ui   = b->iter.ui;
+  uj   = b->iter.uj;
+  upos = b->iter.upos;
+  ierr = ISGetIndices(b->row,&r);CHKERRQ(ierr);
+  ierr = ISGetIndices(b->icol,&ic);CHKERRQ(ierr);
+  ierr = PetscMalloc1(n+1,&rtmp);CHKERRQ(ierr);
+  /* the entries of the permuted matrix in the nonzero pattern of the factor, U(i,:) with its diagonal last */
+  for (i=0; i<n; i++) {
+    for (k=bi[i]; k<bi[i+1]; k++) rtmp[bj[k]] = 0.0;
+    for (k=bdiag[i+1]+1; k<=bdiag[i]; k++) rtmp[bj[k]] = 0.0;
+    for (k=ai[r[i]]; k<ai[r[i]+1]; k++) rtmp[ic[aj[k]]] = aa[k];
+    for (k=bi[i]; k<bi[i+1]; k++) fa[k] = rtmp[bj[k]];
+    for (k=bdiag[i+1]+1; k<=bdiag[i]; k++) fa[k] = rtmp[bj[k]];
+  }
+  ierr = PetscFree(rtmp);CHKERRQ(ierr);
+  ierr = ISRestoreIndices(b->icol,&ic);CHKERRQ(ierr);
+  ierr = ISRestoreIndices(b->row,&r);CHKERRQ(ierr);
+
+  do {
+    sctx.newshift = PETSC_FALSE;
+    /* the initial guess is the strictly lower part scaled by the diagonal and the upper part of the shifted matrix */
+    for (i=0; i<n; i++) {
+      for (k=bi[i]; k<bi[i+1]; k++) {
+        d     = fa[bdiag[bj[k]]] + sctx.shift_amount;
+        ba[k] = (d != (MatScalar)0.0) ? fa[k]/d : 0.0;
+      }
+      for (k=bdiag[i+1]+1; k<bdiag[i]; k++) ba[k] = fa[k];
+      ba[bdiag[i]] = fa[bdiag[i]] + sctx.shift_amount;
+    }
+
+    for (s=0; s<fsweeps; s++) {
+#if defined(PETSC_HAVE_OPENMP)
+#pragma omp parallel for schedule(static) reduction(+:flops) num_threads((int)PetscMax(PetscNumOMPThreads,1))
+#endif
+      for (i=0; i<n; i++) {
+        PetscInt    p,l,q,qe,col;
+        PetscScalar sum;
+
+        /* L(i,j) merges L(i,0:j-1) with U(0:j-1,j) */
+        for (p=bi[i]; p<bi[i+1]; p++) {
+          col = bj[p];
+          sum = fa[p];
+          l   = bi[i];
+          q   = ui[col];
+          qe  = ui[col+1];
+          while (l < p && q < qe) {
+            if (bj[l] < uj[q]) l++;
+            else if (bj[l] > uj[q]) q++;
+            else {sum -= ba[l++]*ba[upos[q++]]; flops += 2.0;}
+          }
+          if (ba[bdiag[col]] != (MatScalar)0.0) ba[p] = sum/ba[bdiag[col]];
+        }
+        /* U(i,j) merges L(i,0:i-1) with U(0:i-1,j) */
+        for (p=bdiag[i+1]+1; p<=bdiag[i]; p++) {
+          col = bj[p];
+          sum = fa[p] + (p == bdiag[i] ? sctx.shift_amount : 0.0);
+          l   = bi[i];
+          q   = ui[col];
+          qe  = ui[col+1];
+          while (l < bi[i+1] && q < qe && uj[q] < i) {
+            if (bj[l] < uj[q]) l++;
+            else if (bj[l] > uj[q]) q++;
+            else {sum -= ba[l++]*ba[upos[q++]]; flops += 2.0;}
+          }
+          ba[p] = sum;
+        }
+      }
+    }
+
+    for (i=0; i<n; i++) {
+      rs = 0.0;
+      for (k=bi[i]; k<bi[i+1]; k++) rs += PetscAbsScalar(ba[k]);
+      for (k=bdiag[i+1]+1; k<bdiag[i]; k++) rs += PetscAbsScalar(ba[k]);
+      sctx.rs = rs;
+      sctx.pv = ba[bdiag[i]];
+      ierr    = MatPivotCheck(B,A,info,&sctx,i);CHKERRQ(ierr);
+      if (sctx.newshift) break;
+      /* invert diagonal for simpler triangular solves */
+      ba[bdiag[i]] = 1.0/sctx.pv;
+    }
+
+    /* MatPivotRefine() */
+    if (info->shifttype == (PetscReal)MAT_SHIFT_POSITIVE_DEFINITE && !sctx.newshift && sctx.shift_fraction>0 && sctx.nshift<sctx.nshift_max) {
+      sctx.shift_hi       = sctx.shift_fraction;
+      sctx.shift_fraction = (sctx.shift_hi+sctx.shift_lo)/2.;
+      sctx.shift_amount   = sctx.shift_fraction * sctx.shift_top;
+      sctx.newshift       = PETSC_TRUE;
+      sctx.nshift++;
+    }
+  } while (sctx.newshift);
+
+  ierr = ISIdentity(b->row,&row_identity);CHKERRQ(ierr);
+  ierr = ISIdentity(b->icol,&col_identity);CHKERRQ(ierr);
+  if (row_identity && col_identity) {
+    B->ops->solve = MatSolve_SeqAIJ_NaturalOrdering;
+  } else {
+    B->ops->solve = MatSolve_SeqAIJ;
+  }
+#if defined(MATSEQAIJ_HAVE_MIXED_PRECISION)
+  if (b->mixed.use) B->ops->solve = MatSolve_SeqAIJ_Mixed;
+#endif
+  B->ops->solveadd          = MatSolveAdd_SeqAIJ;
+  B->ops->solvetranspose    = MatSolveTranspose_SeqAIJ;
+  B->ops->solvetransposeadd = MatSolveTransposeAdd_SeqAIJ;
+  B->ops->matsolve          = MatMatSolve_SeqAIJ;
+  if (b->levels.use) {
+    ierr = MatSeqAIJLevelsSetUp_Private(B);CHKERRQ(ierr);
+    B->ops->solve          = MatSolve_SeqAIJ_Levels;
+    B->ops->solvetranspose = MatSolveTranspose_SeqAIJ_Levels;
+  }
+  if (b->iter.ssweeps) B->ops->solve = MatSolve_SeqAIJ_Jacobi;
+  B->assembled    = PETSC_TRUE;
+  B->preallocated = PETSC_TRUE;
+
+  ierr = PetscLogFlops(flops + B->cmap->n);CHKERRQ(ierr);
+  ierr = PetscInfo3(A,"Iterative ILU with %D sweeps, %D shift tries with shift_amount %g\n",fsweeps,sctx.nshift,(double)sctx.shift_amount);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+/*
+   Approximates the triangular solves with Jacobi sweeps, see MatFactorSetIterativeSweeps(): y <- b - (L - I) y starting
+   from y = b, then x <- D^{-1} (y - (U - D) x) starting from x = D^{-1} y. Each sweep only reads the previous iterate,
+   so the rows are independent and are shared among the threads of PetscNumOMPThreads.
+*/
+PetscErrorCode MatSolve_SeqAIJ_Jacobi(Mat A,Vec bb,Vec xx)
+{
+  Mat_SeqAIJ        *a = (Mat_SeqAIJ*)A->data;
+  PetscErrorCode    ierr;
+  const PetscInt    n = A->rmap->n,ssweeps = a->iter.ssweeps,*ai = a->i,*aj = a->j,*adiag = a->diag,*r,*c;
+  PetscScalar       *x,*t = a->solve_work,*w;
+  const PetscScalar *b;
+  const MatScalar   *aa = a->a;
+
+  PetscFunctionBegin;
+  if (!n) PetscFunctionReturn(0);
+  if (!a->iter.work) {ierr = PetscMalloc1(2*n,&a->iter.work);CHKERRQ(ierr);}
+  w    = a->iter.work;
+  ierr = VecGetArrayRead(bb,&b);CHKERRQ(ierr);
+  ierr = VecGetArrayWrite(xx,&x);CHKERRQ(ierr);
+  ierr = ISGetIndices(a->row,&r);CHKERRQ(ierr);
+  ierr = ISGetIndices(a->col,&c);CHKERRQ(ierr);
+#if defined(PETSC_HAVE_OPENMP)
+#pragma omp parallel num_threads((int)PetscMax(PetscNumOMPThreads,1))
+#endif
+  {
+    PetscInt        i,s,nz;
+    const PetscInt  *vi;
+    const MatScalar *v;
+    PetscScalar     sum,*yo = w,*yn = w+n,*zo,*zn,*tt;
+
+#if defined(PETSC_HAVE_OPENMP)
+#pragma omp for schedule(static)
+#endif
+    for (i=0; i<n; i++) yo[i] = t[i] = b[r[i]];
+    for (s=0; s<ssweeps; s++) {
+#if defined(PETSC_HAVE_OPENMP)
+#pragma omp for schedule(static)
+#endif
+      for (i=0; i<n; i++) {
+        nz  = ai[i+1] - ai[i];
+        v   = aa + ai[i];
+        vi  = aj + ai[i];
+        sum = t[i];
+        PetscSparseDenseMinusDot(sum,yo,v,vi,nz);
+        yn[i] = sum;
+      }
+      tt = yo; yo = yn; yn = tt;
+    }
+    /* the permuted right hand side is no longer needed, its space holds the iterates of x */
+    zo = t;
+    zn = yn;
+#if defined(PETSC_HAVE_OPENMP)
+#pragma omp for schedule(static)
+#endif
+    for (i=0; i<n; i++) zo[i] = yo[i]*aa[adiag[i]];
+    for (s=0; s<ssweeps; s++) {
+#if defined(PETSC_HAVE_OPENMP)
+#pragma omp for schedule(static)
+#endif
+      for (i=0; i<n; i++) {
+        nz  = adiag[i] - adiag[i+1] - 1;
+        v   = aa + adiag[i+1] + 1;
+        vi  = aj + adiag[i+1] + 1;
+        sum = yo[i];
+        PetscSparseDenseMinusDot(sum,zo,v,vi,nz);
+        zn[i] = sum*v[nz]; /* v[nz] = aa[adiag[i]] */
+      }
+      tt = zo; zo = zn; zn = tt;
+    }
+#if defined(PETSC_HAVE_OPENMP)
+#pragma omp for schedule(static)
+#endif
+    for (i=0; i<n; i++) x[c[i]] = zo[i];
+  }
+  ierr = ISRestoreIndices(a->row,&r);CHKERRQ(ierr);
+  ierr = ISRestoreIndices(a->col,&c);CHKERRQ(ierr);
+  ierr = VecRestoreArrayRead(bb,&b);CHKERRQ(ierr);
+  ierr = VecRestoreArrayWrite(xx,&x);CHKERRQ(ierr);
+  ierr = PetscLogFlops(ssweeps*(2.0*a->nz - n) + n);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+PetscErrorCode MatView_SeqAIJ_Iterative(Mat A,PetscViewer viewer)
+{
+  Mat_SeqAIJ        *a = (Mat_SeqAIJ*)A->data;
+  PetscErrorCode    ierr;
+  PetscBool         iascii;
+  PetscViewerFormat format;
+
+  PetscFunctionBegin;
+  if (!a->iter.fsweeps && !a->iter.ssweeps) PetscFunctionReturn(0);
+  ierr = PetscObjectTypeCompare((PetscObject)viewer,PETSCVIEWERASCII,&iascii);CHKERRQ(ierr);
+  if (!iascii) PetscFunctionReturn(0);
+  ierr = PetscViewerGetFormat(viewer,&format);CHKERRQ(ierr);
+  if (format != PETSC_VIEWER_ASCII_INFO_DETAIL && format != PETSC_VIEWER_ASCII_INFO) PetscFunctionReturn(0);
+  if (a->iter.fsweeps) {
+    ierr = PetscViewerASCIIPrintf(viewer,"iterative ILU factorization: %D fixed-point sweeps\n",a->iter.fsweeps);CHKERRQ(ierr);
+  }
+  if (a->iter.ssweeps) {
+    ierr = PetscViewerASCIIPrintf(viewer,"approximate triangular solves: %D Jacobi sweeps\n",a->iter.ssweeps);CHKERRQ(ierr);
+  }
+  PetscFunctionReturn(0);
+}
+
 /*
     This will get a new name and become a varient of MatILUFactor_SeqAIJ() there is no longer separate functions in the matrix function table for dt factors
 */
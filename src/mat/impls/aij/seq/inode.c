@@ -1839,10 +1839,19 @@ PetscErrorCode MatLUFactorNumeric_SeqAIJ_Inode(Mat B,Mat A,const MatFactorInfo *
   } else {
     C->ops->solve           = MatSolve_SeqAIJ;
   }
+#if defined(MATSEQAIJ_HAVE_MIXED_PRECISION)
+  if (b->mixed.use) C->ops->solve = MatSolve_SeqAIJ_Mixed;
+#endif
   C->ops->solveadd          = MatSolveAdd_SeqAIJ;
   C->ops->solvetranspose    = MatSolveTranspose_SeqAIJ;
   C->ops->solvetransposeadd = MatSolveTransposeAdd_SeqAIJ;
   C->ops->matsolve          = MatMatSolve_SeqAIJ;
+  if (b->levels.use) {
+    ierr = MatSeqAIJLevelsSetUp_Private(C);CHKERRQ(ierr);
+    C->ops->solve          = MatSolve_SeqAIJ_Levels;
+    C->ops->solvetranspose = MatSolveTranspose_SeqAIJ_Levels;
+  }
+  if (b->iter.ssweeps) C->ops->solve = MatSolve_SeqAIJ_Jacobi;
   C->assembled              = PETSC_TRUE;
   C->preallocated           = PETSC_TRUE;
 
@@ -9,6 +9,9 @@
 #include <petscbt.h>
 #include <petsc/private/isimpl.h>
 #include <../src/mat/impls/dense/seq/dense.h>
+#if defined(PETSC_HAVE_OPENMP)
+#include <omp.h>
+#endif
 
 PetscErrorCode MatMatMultNumeric_SeqAIJ_SeqAIJ(Mat A,Mat B,Mat C)
 {
@@ -123,6 +126,13 @@ PetscErrorCode MatMatMultSymbolic_SeqAIJ_SeqAIJ(Mat A,Mat B,PetscReal fill,Mat C
     PetscFunctionReturn(0);
   }
 
+  /* hash */
+  ierr = PetscStrcmp(alg,"hash",&flg);CHKERRQ(ierr);
+  if (flg) {
+    ierr = MatMatMultSymbolic_SeqAIJ_SeqAIJ_Hash(A,B,fill,C);CHKERRQ(ierr);
+    PetscFunctionReturn(0);
+  }
+
 #if defined(PETSC_HAVE_HYPRE)
   ierr = PetscStrcmp(alg,"hypre",&flg);CHKERRQ(ierr);
   if (flg) {
@@ -1187,6 +1197,327 @@ PetscErrorCode MatMatMultSymbolic_SeqAIJ_SeqAIJ_Sorted(Mat A,Mat B,PetscReal fil
   PetscFunctionReturn(0);
 }
 
+/*
+   Workspace of the "hash" algorithm, composed with C so the numeric phase reuses it: the rows of C are split
+   into blocks with about the same number of multiply-adds, and block t is computed by thread t with its own
+   open addressing hash table
+*/
+typedef struct {
+  PetscInt       nthreads;
+  PetscInt       *rows;     /* [nthreads+1]: rows of C in block t are rows[t] to rows[t+1]-1 */
+  PetscInt       size;      /* size of the hash table of each thread, a power of 2 */
+  PetscInt       *keys;     /* [nthreads*size]: column of C in each slot, -1 for an empty slot */
+  PetscInt       *vals;     /* [nthreads*size]: position of the column in its row of C */
+  PetscInt       *slots;    /* [nthreads*size]: slots used by the current row */
+  PetscLogDouble flops;     /* flops of the numeric phase */
+} MatProductHash_SeqAIJ;
+
+#define MatProductHashSlot(col,mask) ((PetscInt)(((PetscInt64)(col)*2654435761) & (mask)))
+
+static PetscErrorCode MatProductHashDestroy_SeqAIJ(void *ctx)
+{
+  MatProductHash_SeqAIJ *work = (MatProductHash_SeqAIJ*)ctx;
+  PetscErrorCode        ierr;
+
+  PetscFunctionBegin;
+  ierr = PetscFree(work->rows);CHKERRQ(ierr);
+  ierr = PetscFree3(work->keys,work->vals,work->slots);CHKERRQ(ierr);
+  ierr = PetscFree(work);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+/* Creates the workspace of the "hash" algorithm for C = A*B and composes it with C */
+static PetscErrorCode MatProductHashCreate_SeqAIJ(Mat A,Mat B,Mat C,MatProductHash_SeqAIJ **hwork)
+{
+  Mat_SeqAIJ            *a = (Mat_SeqAIJ*)A->data,*b = (Mat_SeqAIJ*)B->data;
+  const PetscInt        *ai = a->i,*aj = a->j,*bi = b->i;
+  PetscInt              am = A->rmap->n,bn = B->cmap->n,nt,i,j,t,lo,hi,mid,maxrow = 0,diag = C->force_diagonals ? 1 : 0;
+  PetscInt64            *ub,target;
+  MatProductHash_SeqAIJ *work;
+  PetscContainer        container;
+  PetscErrorCode        ierr;
+
+  PetscFunctionBegin;
+  ierr = PetscNew(&work);CHKERRQ(ierr);
+  /* upper bounds of the number of multiply-adds, which also bound the number of nonzeros of the rows of C */
+  ierr  = PetscMalloc1(am+1,&ub);CHKERRQ(ierr);
+  ub[0] = 0;
+  for (i=0; i<am; i++) {
+    PetscInt nz = 0;
+
+    for (j=ai[i]; j<ai[i+1]; j++) nz += bi[aj[j]+1] - bi[aj[j]];
+    maxrow  = PetscMax(maxrow,nz + diag);
+    ub[i+1] = ub[i] + nz;
+  }
+  maxrow     = PetscMin(maxrow,bn);
+  work->size = 1;
+  while (work->size < 2*maxrow) work->size *= 2;
+  nt          = PetscMax(PetscMin(PetscNumOMPThreads,am),1);
+  work->flops = 2.0*ub[am];
+
+  ierr          = PetscMalloc1(nt+1,&work->rows);CHKERRQ(ierr);
+  work->rows[0] = 0;
+  for (t=1; t<nt; t++) { /* first row starting at or after the t-th fraction of the multiply-adds */
+    target = (t*ub[am])/nt;
+    lo     = work->rows[t-1];
+    hi     = am;
+    while (lo < hi) {
+      mid = lo + (hi - lo)/2;
+      if (ub[mid] < target) lo = mid + 1;
+      else hi = mid;
+    }
+    work->rows[t] = lo;
+  }
+  work->rows[nt] = am;
+  work->nthreads = nt;
+  ierr = PetscFree(ub);CHKERRQ(ierr);
+
+  ierr = PetscMalloc3(nt*work->size,&work->keys,nt*work->size,&work->vals,nt*work->size,&work->slots);CHKERRQ(ierr);
+  for (i=0; i<nt*work->size; i++) work->keys[i] = -1;
+
+  ierr = PetscContainerCreate(PETSC_COMM_SELF,&container);CHKERRQ(ierr);
+  ierr = PetscContainerSetPointer(container,work);CHKERRQ(ierr);
+  ierr = PetscContainerSetUserDestroy(container,MatProductHashDestroy_SeqAIJ);CHKERRQ(ierr);
+  ierr = PetscObjectCompose((PetscObject)C,"__PETSc__ab_hash",(PetscObject)container);CHKERRQ(ierr);
+  ierr = PetscObjectDereference((PetscObject)container);CHKERRQ(ierr);
+  ierr = PetscInfo3(C,"Hash product with %D threads, hash tables of size %D for rows with at most %D nonzeros\n",nt,work->size,maxrow);CHKERRQ(ierr);
+  *hwork = work;
+  PetscFunctionReturn(0);
+}
+
+/* Sorts a row of C; PetscSortInt() cannot be called by several threads at once */
+static void MatProductHashSortRow_Private(PetscInt n,PetscInt *v)
+{
+  PetscInt i,j,last,pivot,tmp;
+
+  while (n > 16) {
+    pivot = v[n/2];
+    tmp = v[0]; v[0] = v[n/2]; v[n/2] = tmp;
+    for (last=0,i=1; i<n; i++) {
+      if (v[i] < pivot) {last++; tmp = v[i]; v[i] = v[last]; v[last] = tmp;}
+    }
+    tmp = v[0]; v[0] = v[last]; v[last] = tmp;
+    MatProductHashSortRow_Private(last,v);
+    v += last+1;
+    n -= last+1;
+  }
+  for (i=1; i<n; i++) {
+    tmp = v[i];
+    for (j=i; j>0 && v[j-1] > tmp; j--) v[j] = v[j-1];
+    v[j] = tmp;
+  }
+}
+
+/*
+   Gustavson's row-by-row product where the columns of each row of C are gathered in a hash table instead of
+   a dense array of length B->cmap->n; the rows are computed by PetscNumOMPThreads threads
+*/
+PetscErrorCode MatMatMultSymbolic_SeqAIJ_SeqAIJ_Hash(Mat A,Mat B,PetscReal fill,Mat C)
+{
+  PetscErrorCode        ierr;
+  Mat_SeqAIJ            *a  = (Mat_SeqAIJ*)A->data,*b=(Mat_SeqAIJ*)B->data,*c;
+  const PetscInt        *ai = a->i,*bi=b->i,*aj=a->j,*bj=b->j;
+  PetscInt              *ci,*cj,i,am=A->rmap->N,bn=B->cmap->N,bm=B->rmap->N,nt,size;
+  const PetscInt        *rows;
+  PetscBool             diag = C->force_diagonals;
+  PetscReal             afill;
+  MatProductHash_SeqAIJ *work;
+
+  PetscFunctionBegin;
+  ierr = PetscObjectCompose((PetscObject)C,"__PETSc__ab_hash",NULL);CHKERRQ(ierr);
+  ierr = MatProductHashCreate_SeqAIJ(A,B,C,&work);CHKERRQ(ierr);
+  nt   = work->nthreads;
+  size = work->size;
+  rows = work->rows;
+
+  ierr  = PetscMalloc1(am+1,&ci);CHKERRQ(ierr);
+  ci[0] = 0;
+  /* first pass counts the nonzeros of each row, the second one fills and sorts the rows */
+#if defined(PETSC_HAVE_OPENMP)
+#pragma omp parallel num_threads((int)nt)
+#endif
+  {
+#if defined(PETSC_HAVE_OPENMP)
+    const PetscInt tid = omp_get_thread_num(),nth = omp_get_num_threads();
+#else
+    const PetscInt tid = 0,nth = 1;
+#endif
+    PetscInt p,r,j,k,col,h,cnt,*keys,*slots;
+
+    for (p=tid; p<nt; p+=nth) {
+      keys  = work->keys + p*size;
+      slots = work->slots + p*size;
+      for (r=rows[p]; r<rows[p+1]; r++) {
+        cnt = 0;
+        for (j=ai[r]; j<ai[r+1]; j++) {
+          for (k=bi[aj[j]]; k<bi[aj[j]+1]; k++) {
+            col = bj[k];
+            h   = MatProductHashSlot(col,size-1);
+            while (keys[h] != -1 && keys[h] != col) h = (h+1) & (size-1);
+            if (keys[h] == -1) {keys[h] = col; slots[cnt++] = h;}
+          }
+        }
+        if (diag && r < bn) {
+          h = MatProductHashSlot(r,size-1);
+          while (keys[h] != -1 && keys[h] != r) h = (h+1) & (size-1);
+          if (keys[h] == -1) {keys[h] = r; slots[cnt++] = h;}
+        }
+        for (k=0; k<cnt; k++) keys[slots[k]] = -1;
+        ci[r+1] = cnt;
+      }
+    }
+  }
+  for (i=0; i<am; i++) ci[i+1] += ci[i];
+  ierr = PetscMalloc1(ci[am]+1,&cj);CHKERRQ(ierr);
+#if defined(PETSC_HAVE_OPENMP)
+#pragma omp parallel num_threads((int)nt)
+#endif
+  {
+#if defined(PETSC_HAVE_OPENMP)
+    const PetscInt tid = omp_get_thread_num(),nth = omp_get_num_threads();
+#else
+    const PetscInt tid = 0,nth = 1;
+#endif
+    PetscInt p,r,j,k,col,h,cnt,*keys,*slots,*crow;
+
+    for (p=tid; p<nt; p+=nth) {
+      keys  = work->keys + p*size;
+      slots = work->slots + p*size;
+      for (r=rows[p]; r<rows[p+1]; r++) {
+        cnt  = 0;
+        crow = cj + ci[r];
+        for (j=ai[r]; j<ai[r+1]; j++) {
+          for (k=bi[aj[j]]; k<bi[aj[j]+1]; k++) {
+            col = bj[k];
+            h   = MatProductHashSlot(col,size-1);
+            while (keys[h] != -1 && keys[h] != col) h = (h+1) & (size-1);
+            if (keys[h] == -1) {keys[h] = col; slots[cnt] = h; crow[cnt++] = col;}
+          }
+        }
+        if (diag && r < bn) {
+          h = MatProductHashSlot(r,size-1);
+          while (keys[h] != -1 && keys[h] != r) h = (h+1) & (size-1);
+          if (keys[h] == -1) {keys[h] = r; slots[cnt] = h; crow[cnt++] = r;}
+        }
+        for (k=0; k<cnt; k++) keys[slots[k]] = -1;
+        MatProductHashSortRow_Private(cnt,crow);
+      }
+    }
+  }
+
+  /* put together the new symbolic matrix */
+  ierr = MatSetSeqAIJWithArrays_private(PetscObjectComm((PetscObject)A),am,bn,ci,cj,NULL,((PetscObject)A)->type_name,C);CHKERRQ(ierr);
+  ierr = MatSetBlockSizesFromMats(C,A,B);CHKERRQ(ierr);
+
+  /* MatCreateSeqAIJWithArrays flags matrix so PETSc doesn't free the user's arrays. */
+  /* These are PETSc arrays, so change flags so arrays can be deleted by PETSc */
+  c          = (Mat_SeqAIJ*)(C->data);
+  c->free_a  = PETSC_TRUE;
+  c->free_ij = PETSC_TRUE;
+  c->nonew   = 0;
+
+  C->ops->matmultnumeric = MatMatMultNumeric_SeqAIJ_SeqAIJ_Hash;
+
+  /* set MatInfo */
+  afill = (PetscReal)ci[am]/PetscMax(ai[am]+bi[bm],1) + 1.e-5;
+  if (afill < 1.0) afill = 1.0;
+  c->maxnz                  = ci[am];
+  c->nz                     = ci[am];
+  C->info.mallocs           = 0;
+  C->info.fill_ratio_given  = fill;
+  C->info.fill_ratio_needed = afill;
+
+#if defined(PETSC_USE_INFO)
+  if (ci[am]) {
+    ierr = PetscInfo2(C,"Fill ratio: given %g needed %g.\n",(double)fill,(double)afill);CHKERRQ(ierr);
+  } else {
+    ierr = PetscInfo(C,"Empty matrix product\n");CHKERRQ(ierr);
+  }
+#endif
+  PetscFunctionReturn(0);
+}
+
+PetscErrorCode MatMatMultNumeric_SeqAIJ_SeqAIJ_Hash(Mat A,Mat B,Mat C)
+{
+  PetscErrorCode        ierr;
+  Mat_SeqAIJ            *a = (Mat_SeqAIJ*)A->data,*b = (Mat_SeqAIJ*)B->data,*c = (Mat_SeqAIJ*)C->data;
+  const PetscInt        *ai = a->i,*aj = a->j,*bi = b->i,*bj = b->j,*ci = c->i,*cj = c->j,*rows;
+  PetscInt              cm = C->rmap->n,nt,size;
+  PetscScalar           *ca;
+  const PetscScalar     *aa,*ba;
+  MatProductHash_SeqAIJ *work;
+  PetscContainer        container;
+
+  PetscFunctionBegin;
+  ierr = PetscObjectQuery((PetscObject)C,"__PETSc__ab_hash",(PetscObject*)&container);CHKERRQ(ierr);
+  if (container) {
+    ierr = PetscContainerGetPointer(container,(void**)&work);CHKERRQ(ierr);
+  } else { /* for instance C was obtained with MatDuplicate() */
+    ierr = MatProductHashCreate_SeqAIJ(A,B,C,&work);CHKERRQ(ierr);
+  }
+  nt   = work->nthreads;
+  size = work->size;
+  rows = work->rows;
+  if (!c->a) {
+    ierr      = PetscMalloc1(ci[cm]+1,&ca);CHKERRQ(ierr);
+    c->a      = ca;
+    c->free_a = PETSC_TRUE;
+  } else ca = c->a;
+  ierr = MatSeqAIJGetArrayRead(A,&aa);CHKERRQ(ierr);
+  ierr = MatSeqAIJGetArrayRead(B,&ba);CHKERRQ(ierr);
+#if defined(PETSC_HAVE_OPENMP)
+#pragma omp parallel num_threads((int)nt)
+#endif
+  {
+#if defined(PETSC_HAVE_OPENMP)
+    const PetscInt tid = omp_get_thread_num(),nth = omp_get_num_threads();
+#else
+    const PetscInt tid = 0,nth = 1;
+#endif
+    PetscInt       p,r,j,k,col,h,cnz,*keys,*vals,*slots;
+    const PetscInt *crow;
+    PetscScalar    *cval,aval;
+
+    for (p=tid; p<nt; p+=nth) {
+      keys  = work->keys + p*size;
+      vals  = work->vals + p*size;
+      slots = work->slots + p*size;
+      for (r=rows[p]; r<rows[p+1]; r++) {
+        cnz  = ci[r+1] - ci[r];
+        crow = cj + ci[r];
+        cval = ca + ci[r];
+        for (k=0; k<cnz; k++) {
+          h = MatProductHashSlot(crow[k],size-1);
+          while (keys[h] != -1) h = (h+1) & (size-1);
+          keys[h]  = crow[k];
+          vals[h]  = k;
+          slots[k] = h;
+          cval[k]  = 0.0;
+        }
+        for (j=ai[r]; j<ai[r+1]; j++) {
+          aval = aa[j];
+          for (k=bi[aj[j]]; k<bi[aj[j]+1]; k++) {
+            col = bj[k];
+            h   = MatProductHashSlot(col,size-1);
+            while (keys[h] != col) h = (h+1) & (size-1);
+            cval[vals[h]] += aval*ba[k];
+          }
+        }
+        for (k=0; k<cnz; k++) keys[slots[k]] = -1;
+      }
+    }
+  }
+#if defined(PETSC_HAVE_DEVICE)
+  if (C->offloadmask != PETSC_OFFLOAD_UNALLOCATED) C->offloadmask = PETSC_OFFLOAD_CPU;
+#endif
+  ierr = MatAssemblyBegin(C,MAT_FINAL_ASSEMBLY);CHKERRQ(ierr);
+  ierr = MatAssemblyEnd(C,MAT_FINAL_ASSEMBLY);CHKERRQ(ierr);
+  ierr = PetscLogFlops(work->flops);CHKERRQ(ierr);
+  ierr = MatSeqAIJRestoreArrayRead(A,&aa);CHKERRQ(ierr);
+  ierr = MatSeqAIJRestoreArrayRead(B,&ba);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
 PetscErrorCode MatDestroy_SeqAIJ_MatMatMultTrans(void *data)
 {
   PetscErrorCode      ierr;
@@ -1996,11 +2327,11 @@ static PetscErrorCode MatProductSetFromOptions_SeqAIJ_AB(Mat C)
   PetscInt       alg = 0; /* default algorithm */
   PetscBool      flg = PETSC_FALSE;
 #if !defined(PETSC_HAVE_HYPRE)
-  const char     *algTypes[7] = {"sorted","scalable","scalable_fast","heap","btheap","llcondensed","rowmerge"};
-  PetscInt       nalg = 7;
-#else
-  const char     *algTypes[8] = {"sorted","scalable","scalable_fast","heap","btheap","llcondensed","rowmerge","hypre"};
+  const char     *algTypes[8] = {"sorted","scalable","scalable_fast","heap","btheap","llcondensed","rowmerge","hash"};
   PetscInt       nalg = 8;
+#else
+  const char     *algTypes[9] = {"sorted","scalable","scalable_fast","heap","btheap","llcondensed","rowmerge","hash","hypre"};
+  PetscInt       nalg = 9;
 #endif
 
   PetscFunctionBegin;
@@ -2100,11 +2431,11 @@ static PetscErrorCode MatProductSetFromOptions_SeqAIJ_PtAP(Mat C)
   PetscBool      flg = PETSC_FALSE;
   PetscInt       alg = 0; /* default algorithm -- alg=1 should be default!!! */
 #if !defined(PETSC_HAVE_HYPRE)
-  const char     *algTypes[2] = {"scalable","rap"};
-  PetscInt       nalg = 2;
-#else
-  const char     *algTypes[3] = {"scalable","rap","hypre"};
+  const char     *algTypes[3] = {"scalable","rap","hash"};
   PetscInt       nalg = 3;
+#else
+  const char     *algTypes[4] = {"scalable","rap","hash","hypre"};
+  PetscInt       nalg = 4;
 #endif
 
   PetscFunctionBegin;
@@ -51,6 +51,14 @@ PetscErrorCode MatProductSymbolic_PtAP_SeqAIJ_SeqAIJ(Mat C)
     PetscFunctionReturn(0);
   }
 
+  /* "hash" */
+  ierr = PetscStrcmp(alg,"hash",&flg);CHKERRQ(ierr);
+  if (flg) {
+    ierr = MatPtAPSymbolic_SeqAIJ_SeqAIJ_Hash(A,P,fill,C);CHKERRQ(ierr);
+    C->ops->productnumeric = MatProductNumeric_PtAP;
+    PetscFunctionReturn(0);
+  }
+
   /* hypre */
 #if defined(PETSC_HAVE_HYPRE)
   ierr = PetscStrcmp(alg,"hypre",&flg);CHKERRQ(ierr);
@@ -63,6 +71,57 @@ PetscErrorCode MatProductSymbolic_PtAP_SeqAIJ_SeqAIJ(Mat C)
   SETERRQ(PETSC_COMM_SELF,PETSC_ERR_SUP,"MatProductType is not supported");
 }
 
+static PetscErrorCode MatDestroy_SeqAIJ_PtAPHash(void *data)
+{
+  Mat_PtAPHash   *ptap = (Mat_PtAPHash*)data;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  ierr = MatDestroy(&ptap->Pt);CHKERRQ(ierr);
+  ierr = MatDestroy(&ptap->AP);CHKERRQ(ierr);
+  ierr = PetscFree(ptap);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+/*
+   C = P^T*(A*P) with two threaded hash products; P^T, A*P and the hash tables are kept for the numeric phase
+*/
+PetscErrorCode MatPtAPSymbolic_SeqAIJ_SeqAIJ_Hash(Mat A,Mat P,PetscReal fill,Mat C)
+{
+  PetscErrorCode ierr;
+  Mat_PtAPHash   *ptap;
+
+  PetscFunctionBegin;
+  MatCheckProduct(C,4);
+  if (C->product->data) SETERRQ(PetscObjectComm((PetscObject)C),PETSC_ERR_PLIB,"Product data not empty");
+  ierr = PetscNew(&ptap);CHKERRQ(ierr);
+  ierr = MatTranspose_SeqAIJ(P,MAT_INITIAL_MATRIX,&ptap->Pt);CHKERRQ(ierr);
+  ierr = MatCreate(PETSC_COMM_SELF,&ptap->AP);CHKERRQ(ierr);
+  ierr = MatMatMultSymbolic_SeqAIJ_SeqAIJ_Hash(A,P,fill,ptap->AP);CHKERRQ(ierr);
+  ierr = MatMatMultSymbolic_SeqAIJ_SeqAIJ_Hash(ptap->Pt,ptap->AP,fill,C);CHKERRQ(ierr);
+  ierr = MatSetBlockSizes(C,PetscAbs(P->cmap->bs),PetscAbs(P->cmap->bs));CHKERRQ(ierr);
+
+  C->product->data    = ptap;
+  C->product->destroy = MatDestroy_SeqAIJ_PtAPHash;
+  C->ops->ptapnumeric = MatPtAPNumeric_SeqAIJ_SeqAIJ_Hash;
+  PetscFunctionReturn(0);
+}
+
+PetscErrorCode MatPtAPNumeric_SeqAIJ_SeqAIJ_Hash(Mat A,Mat P,Mat C)
+{
+  PetscErrorCode ierr;
+  Mat_PtAPHash   *ptap;
+
+  PetscFunctionBegin;
+  MatCheckProduct(C,3);
+  ptap = (Mat_PtAPHash*)C->product->data;
+  if (!ptap) SETERRQ(PetscObjectComm((PetscObject)C),PETSC_ERR_PLIB,"Missing data structure");
+  ierr = MatTranspose_SeqAIJ(P,MAT_REUSE_MATRIX,&ptap->Pt);CHKERRQ(ierr);
+  ierr = MatMatMultNumeric_SeqAIJ_SeqAIJ_Hash(A,P,ptap->AP);CHKERRQ(ierr);
+  ierr = MatMatMultNumeric_SeqAIJ_SeqAIJ_Hash(ptap->Pt,ptap->AP,C);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
 PetscErrorCode MatPtAPSymbolic_SeqAIJ_SeqAIJ_SparseAxpy(Mat A,Mat P,PetscReal fill,Mat C)
 {
   PetscErrorCode     ierr;
@@ -7,6 +7,9 @@
 #include <petscblaslapack.h>
 #include <petsc/private/kernels/blockinvert.h>
 #include <petsc/private/kernels/blockmatmult.h>
+#if defined(PETSC_HAVE_OPENMP)
+#include <omp.h>
+#endif
 
 #if defined(PETSC_HAVE_HYPRE)
 PETSC_INTERN PetscErrorCode MatConvert_AIJ_HYPRE(Mat,MatType,MatReuse,Mat*);
@@ -198,6 +201,80 @@ PetscErrorCode MatInvertBlockDiagonal_SeqBAIJ(Mat A,const PetscScalar **values)
   PetscFunctionReturn(0);
 }
 
+/*
+   Multicolor block Gauss-Seidel: the forward (backward) sweep visits the colors of the block rows in increasing (decreasing)
+   order; the block rows of a color are not coupled so they are updated simultaneously by the OpenMP threads
+*/
+static PetscErrorCode MatSOR_SeqBAIJ_MultiColor(Mat A,Vec bb,MatSORType flag,PetscInt its,Vec xx)
+{
+  Mat_SeqBAIJ       *a = (Mat_SeqBAIJ*)A->data;
+  PetscScalar       *x,*work;
+  const MatScalar   *aa = a->a,*idiag = a->idiag;
+  const PetscScalar *b;
+  PetscErrorCode    ierr;
+  PetscInt          bs = A->rmap->bs,bs2 = bs*bs,nt = PetscMax(PetscNumOMPThreads,1),nc,sweep;
+  const PetscInt    *ai = a->i,*aj = a->j,*color,*rows;
+
+  PetscFunctionBegin;
+  ierr = MatSORColoringSetUp_Private(A,a->mbs,ai,aj,&a->sorcolor);CHKERRQ(ierr);
+  nc    = a->sorcolor.ncolors;
+  color = a->sorcolor.color;
+  rows  = a->sorcolor.rows;
+  ierr  = PetscMalloc1(bs*nt,&work);CHKERRQ(ierr);
+  if (flag & SOR_ZERO_INITIAL_GUESS) {ierr = VecSet(xx,0.0);CHKERRQ(ierr);}
+  ierr = VecGetArray(xx,&x);CHKERRQ(ierr);
+  ierr = VecGetArrayRead(bb,&b);CHKERRQ(ierr);
+  while (its--) {
+    for (sweep=0; sweep<2; sweep++) {
+      if (!sweep && !(flag & (SOR_FORWARD_SWEEP | SOR_LOCAL_FORWARD_SWEEP))) continue;
+      if (sweep && !(flag & (SOR_BACKWARD_SWEEP | SOR_LOCAL_BACKWARD_SWEEP))) continue;
+#if defined(PETSC_HAVE_OPENMP)
+#pragma omp parallel num_threads((int)nt)
+#endif
+      {
+        PetscInt          k,c,p,i,j,q,r,col;
+        const MatScalar   *v;
+        const PetscScalar *xj;
+        PetscScalar       sum,*s = work;
+
+#if defined(PETSC_HAVE_OPENMP)
+        s = work + bs*omp_get_thread_num();
+#endif
+        for (k=0; k<nc; k++) {
+          c = sweep ? nc-1-k : k;
+#if defined(PETSC_HAVE_OPENMP)
+#pragma omp for schedule(static)
+#endif
+          for (p=color[c]; p<color[c+1]; p++) {
+            i = rows[p];
+            for (r=0; r<bs; r++) s[r] = b[bs*i+r];
+            for (q=ai[i]; q<ai[i+1]; q++) {
+              j = aj[q];
+              if (j == i) continue;
+              v  = aa + bs2*q;
+              xj = x + bs*j;
+              for (col=0; col<bs; col++) {
+                for (r=0; r<bs; r++) s[r] -= v[r+bs*col]*xj[col];
+              }
+            }
+            v = idiag + bs2*i;
+            for (r=0; r<bs; r++) {
+              sum = 0.0;
+              for (col=0; col<bs; col++) sum += v[r+bs*col]*s[col];
+              x[bs*i+r] = sum;
+            }
+          }
+        }
+      }
+      ierr = PetscLogFlops(2.0*bs2*a->nz);CHKERRQ(ierr);
+    }
+  }
+  ierr = VecRestoreArray(xx,&x);CHKERRQ(ierr);
+  ierr = VecRestoreArrayRead(bb,&b);CHKERRQ(ierr);
+  ierr = PetscFree(work);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
 PetscErrorCode MatSOR_SeqBAIJ(Mat A,Vec bb,PetscReal omega,MatSORType flag,PetscReal fshift,PetscInt its,PetscInt lits,Vec xx)
 {
   Mat_SeqBAIJ       *a = (Mat_SeqBAIJ*)A->data;
@@ -220,6 +297,10 @@ PetscErrorCode MatSOR_SeqBAIJ(Mat A,Vec bb,PetscReal omega,MatSORType flag,Petsc
   if (!a->idiagvalid) {ierr = MatInvertBlockDiagonal(A,NULL);CHKERRQ(ierr);}
 
   if (!m) PetscFunctionReturn(0);
+  if (flag & SOR_MULTICOLOR) {
+    ierr = MatSOR_SeqBAIJ_MultiColor(A,bb,flag,its,xx);CHKERRQ(ierr);
+    PetscFunctionReturn(0);
+  }
   diag  = a->diag;
   idiag = a->idiag;
   k    = PetscMax(A->rmap->n,A->cmap->n);
@@ -1268,6 +1349,7 @@ PetscErrorCode MatDestroy_SeqBAIJ(Mat A)
   ierr = ISDestroy(&a->icol);CHKERRQ(ierr);
   ierr = PetscFree(a->saved_values);CHKERRQ(ierr);
   ierr = PetscFree2(a->compressedrow.i,a->compressedrow.rindex);CHKERRQ(ierr);
+  ierr = MatSORColoringReset_Private(&a->sorcolor);CHKERRQ(ierr);
 
   ierr = MatDestroy(&a->sbaijMat);CHKERRQ(ierr);
   ierr = MatDestroy(&a->parent);CHKERRQ(ierr);
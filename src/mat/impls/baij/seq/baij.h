@@ -28,6 +28,7 @@
 typedef struct {
   SEQAIJHEADER(MatScalar);
   SEQBAIJHEADER;
+  MatSORColoring sorcolor;         /* coloring of the block rows for SOR_MULTICOLOR */
 } Mat_SeqBAIJ;
 
 PETSC_INTERN PetscErrorCode MatSeqBAIJSetPreallocation_SeqBAIJ(Mat B,PetscInt bs,PetscInt nz,PetscInt *nnz);
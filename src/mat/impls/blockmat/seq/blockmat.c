@@ -29,6 +29,7 @@ static PetscErrorCode MatSOR_BlockMat_Symmetric(Mat A,Vec bb,PetscReal omega,Mat
   Mat               *diag;
 
   PetscFunctionBegin;
+  if (flag & SOR_MULTICOLOR) SETERRQ(PETSC_COMM_SELF,PETSC_ERR_SUP,"No support for SOR_MULTICOLOR");
   its = its*lits;
   if (its <= 0) SETERRQ2(PETSC_COMM_SELF,PETSC_ERR_ARG_WRONG,"Relaxation requires global its %D and local its %D both positive",its,lits);
   if (flag & SOR_EISENSTAT) SETERRQ(PETSC_COMM_SELF,PETSC_ERR_SUP,"No support yet for Eisenstat");
@@ -135,6 +136,7 @@ static PetscErrorCode MatSOR_BlockMat(Mat A,Vec bb,PetscReal omega,MatSORType fl
   Mat               *diag;
 
   PetscFunctionBegin;
+  if (flag & SOR_MULTICOLOR) SETERRQ(PETSC_COMM_SELF,PETSC_ERR_SUP,"No support for SOR_MULTICOLOR");
   its = its*lits;
   if (its <= 0) SETERRQ2(PETSC_COMM_SELF,PETSC_ERR_ARG_WRONG,"Relaxation requires global its %D and local its %D both positive",its,lits);
   if (flag & SOR_EISENSTAT) SETERRQ(PETSC_COMM_SELF,PETSC_ERR_SUP,"No support yet for Eisenstat");
@@ -202,6 +202,7 @@ PetscErrorCode MatSOR_ConstantDiagonal(Mat matin,Vec x,PetscReal omega,MatSORTyp
   Mat_ConstantDiagonal *ctx  = (Mat_ConstantDiagonal*)matin->data;
 
   PetscFunctionBegin;
+  if (flag & SOR_MULTICOLOR) SETERRQ(PETSC_COMM_SELF,PETSC_ERR_SUP,"No support for SOR_MULTICOLOR");
   if (ctx->diag == 0.0) matin->factorerrortype = MAT_FACTOR_NUMERIC_ZEROPIVOT;
   else matin->factorerrortype = MAT_FACTOR_NOERROR;
   ierr = VecAXPBY(y,1.0/ctx->diag,0.0,x);CHKERRQ(ierr);
@@ -1099,6 +1099,7 @@ static PetscErrorCode MatSOR_SeqDense(Mat A,Vec bb,PetscReal omega,MatSORType fl
 #if defined(PETSC_HAVE_CUDA)
   if (A->offloadmask == PETSC_OFFLOAD_GPU) SETERRQ(PETSC_COMM_SELF,PETSC_ERR_SUP,"Not implemented");
 #endif
+  if (flag & SOR_MULTICOLOR) SETERRQ(PETSC_COMM_SELF,PETSC_ERR_SUP,"No support for SOR_MULTICOLOR");
   if (shift == -1) shift = 0.0; /* negative shift indicates do not error on zero diagonal; this code never zeros on zero diagonal */
   ierr = PetscBLASIntCast(m,&bm);CHKERRQ(ierr);
   if (flag & SOR_ZERO_INITIAL_GUESS) {
@@ -192,6 +192,7 @@ PetscErrorCode MatDestroy_SeqSBAIJ(Mat A)
   ierr = PetscFree(a->saved_values);CHKERRQ(ierr);
   if (a->free_jshort) {ierr = PetscFree(a->jshort);CHKERRQ(ierr);}
   ierr = PetscFree(a->inew);CHKERRQ(ierr);
+  ierr = PetscFree(a->sn.sn);CHKERRQ(ierr);
   ierr = MatDestroy(&a->parent);CHKERRQ(ierr);
   ierr = PetscFree(A->data);CHKERRQ(ierr);
 
@@ -358,6 +359,9 @@ PetscErrorCode MatView_SeqSBAIJ_ASCII(Mat A,PetscViewer viewer)
   ierr = PetscViewerGetFormat(viewer,&format);CHKERRQ(ierr);
   if (format == PETSC_VIEWER_ASCII_INFO || format == PETSC_VIEWER_ASCII_INFO_DETAIL) {
     ierr = PetscViewerASCIIPrintf(viewer,"  block size is %D\n",bs);CHKERRQ(ierr);
+    if (A->factortype && a->sn.sn) {
+      ierr = PetscViewerASCIIPrintf(viewer,"  supernodal factorization: %D supernodes, largest has %D rows and %D columns\n",a->sn.nsn,a->sn.maxs,a->sn.maxncol);CHKERRQ(ierr);
+    }
   } else if (format == PETSC_VIEWER_ASCII_MATLAB) {
     Mat        aij;
     const char *matname;
@@ -1873,6 +1877,7 @@ PETSC_INTERN PetscErrorCode MatGetFactor_seqsbaij_petsc(Mat A,MatFactorType ftyp
     (*B)->ops->iccfactorsymbolic      = MatICCFactorSymbolic_SeqSBAIJ;
     ierr = PetscStrallocpy(MATORDERINGNATURAL,(char**)&(*B)->preferredordering[MAT_FACTOR_CHOLESKY]);CHKERRQ(ierr);
     ierr = PetscStrallocpy(MATORDERINGNATURAL,(char**)&(*B)->preferredordering[MAT_FACTOR_ICC]);CHKERRQ(ierr);
+    if (ftype == MAT_FACTOR_CHOLESKY) ((Mat_SeqSBAIJ*)(*B)->data)->sn.use = ((Mat_SeqSBAIJ*)A->data)->sn.use;
   } else SETERRQ(PETSC_COMM_SELF,PETSC_ERR_SUP,"Factor type not supported");
 
   (*B)->factortype = ftype;
@@ -1937,7 +1942,8 @@ PetscErrorCode  MatSeqSBAIJRestoreArray(Mat A,PetscScalar **array)
   can call MatSetOption(Mat, MAT_HERMITIAN).
 
   Options Database Keys:
-  . -mat_type seqsbaij - sets the matrix type to "seqsbaij" during a call to MatSetFromOptions()
+  + -mat_type seqsbaij - sets the matrix type to "seqsbaij" during a call to MatSetFromOptions()
+  - -mat_sbaij_supernodal - compute the PETSc Cholesky factor of a matrix with block size 1 by supernodes, see MATSEQAIJ
 
   Notes:
     By default if you insert values into the lower triangular part of the matrix they are simply ignored (since they are not
@@ -2038,6 +2044,7 @@ PETSC_EXTERN PetscErrorCode MatCreate_SeqSBAIJ(Mat B)
     ierr = PetscInfo(B,"Not using Inode routines due to -mat_no_inode\n");CHKERRQ(ierr);
   }
   ierr = PetscOptionsInt("-mat_inode_limit","Do not use inodes larger then this value",NULL,b->inode.limit,&b->inode.limit,NULL);CHKERRQ(ierr);
+  ierr = PetscOptionsBool("-mat_sbaij_supernodal","Use the supernodal numeric Cholesky factorization with block size 1",NULL,b->sn.use,&b->sn.use,NULL);CHKERRQ(ierr);
   ierr = PetscOptionsEnd();CHKERRQ(ierr);
   b->inode.use = (PetscBool)(!(no_unroll || no_inode));
   if (b->inode.limit > b->inode.max_limit) b->inode.limit = b->inode.max_limit;
@@ -2211,6 +2218,7 @@ PetscErrorCode MatDuplicate_SeqSBAIJ(Mat A,MatDuplicateOption cpvalues,Mat *B)
   c->icol               = NULL;
   c->saved_values       = NULL;
   c->keepnonzeropattern = a->keepnonzeropattern;
+  c->sn.use             = a->sn.use;
   C->assembled          = PETSC_TRUE;
 
   ierr   = PetscLayoutReference(A->rmap,&C->rmap);CHKERRQ(ierr);
@@ -9,6 +9,14 @@
   arrays start at 0.
 */
 
+/* Supernodes of a Cholesky factor with bs = 1, see -mat_aij_supernodal and -mat_sbaij_supernodal */
+typedef struct {
+  PetscBool use;                /* for a matrix, factor it with the supernodal numeric Cholesky factorization */
+  PetscInt  nsn;                /* for a factor, number of supernodes */
+  PetscInt  *sn;                /* [nsn+1]: supernode i consists of the rows sn[i] to sn[i+1]-1 which share their nonzero structure */
+  PetscInt  maxs,maxncol;       /* largest number of rows and of columns of a supernode */
+} Mat_SeqSBAIJ_Supernodes;
+
 typedef struct {
   SEQAIJHEADER(MatScalar);
   SEQBAIJHEADER;
@@ -24,6 +32,7 @@ typedef struct {
   Mat_SeqAIJ_Inode inode;
   unsigned short   *jshort;
   PetscBool        free_jshort;
+  Mat_SeqSBAIJ_Supernodes sn;
 } Mat_SeqSBAIJ;
 
 PETSC_INTERN PetscErrorCode MatCholeskyFactorSymbolic_SeqSBAIJ(Mat,Mat,IS,const MatFactorInfo*);
@@ -50,6 +59,9 @@ PETSC_INTERN PetscErrorCode MatDestroy_SeqSBAIJ(Mat);
 PETSC_INTERN PetscErrorCode MatView_SeqSBAIJ(Mat,PetscViewer);
 
 PETSC_INTERN PetscErrorCode MatCholeskyFactorNumeric_SeqSBAIJ_1_NaturalOrdering(Mat,Mat,const MatFactorInfo*);
+PETSC_INTERN PetscErrorCode MatCholeskyFactorNumeric_SeqSBAIJ_1_NaturalOrdering_Supernodal(Mat,Mat,const MatFactorInfo*);
+PETSC_INTERN PetscErrorCode MatCholeskyFactorNumeric_SeqSBAIJ_1_Supernodal_Private(Mat,Mat,const PetscInt[],const PetscInt[],const MatScalar[],const PetscInt[],const PetscInt[],const MatFactorInfo*,FactorShiftCtx*);
+PETSC_INTERN PetscErrorCode MatSeqSBAIJSupernodesSetUp_Private(Mat);
 PETSC_INTERN PetscErrorCode MatCholeskyFactorNumeric_SeqSBAIJ_1_NaturalOrdering_inplace(Mat,Mat,const MatFactorInfo*);
 PETSC_INTERN PetscErrorCode MatSolve_SeqSBAIJ_1_NaturalOrdering_inplace(Mat,Vec,Vec);
 PETSC_INTERN PetscErrorCode MatSolve_SeqSBAIJ_1_NaturalOrdering(Mat,Vec,Vec);
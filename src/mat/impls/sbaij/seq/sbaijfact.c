@@ -368,6 +368,10 @@ PetscErrorCode MatCholeskyFactorSymbolic_SeqSBAIJ(Mat fact,Mat A,IS perm,const M
   }
 #endif
   fact->ops->choleskyfactornumeric = MatCholeskyFactorNumeric_SeqSBAIJ_1_NaturalOrdering;
+  if (b->sn.use) {
+    ierr = MatSeqSBAIJSupernodesSetUp_Private(fact);CHKERRQ(ierr);
+    fact->ops->choleskyfactornumeric = MatCholeskyFactorNumeric_SeqSBAIJ_1_NaturalOrdering_Supernodal;
+  }
   PetscFunctionReturn(0);
 }
 
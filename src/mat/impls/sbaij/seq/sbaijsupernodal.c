@@ -0,0 +1,249 @@
+
+/*
+    Supernodal numeric U^T*D*U factorization for bs = 1, see -mat_aij_supernodal and -mat_sbaij_supernodal.
+
+    The factor has the data structure of MatCholeskyFactorSymbolic_SeqSBAIJ() and MatCholeskyFactorSymbolic_SeqAIJ(),
+    so the usual triangular solves are used with it. Consecutive rows whose nonzero structure beyond the diagonal only
+    differs by the previous row form a supernode; its rows are computed together as a dense panel, the updates from the
+    previously computed supernodes are dense matrix-matrix products
+*/
+#include <../src/mat/impls/baij/seq/baij.h>
+#include <../src/mat/impls/sbaij/seq/sbaij.h>
+#include <petscblaslapack.h>
+
+/* largest number of rows of a supernode, bounds the size of the dense panels */
+#define MAT_SEQSBAIJ_SUPERNODE_MAX 128
+
+/*
+   Finds the supernodes of the symbolic factor B, splitting those with more than MAT_SEQSBAIJ_SUPERNODE_MAX rows
+*/
+PetscErrorCode MatSeqSBAIJSupernodesSetUp_Private(Mat B)
+{
+  Mat_SeqSBAIJ   *b = (Mat_SeqSBAIJ*)B->data;
+  PetscErrorCode ierr;
+  const PetscInt *bi = b->i,*bj = b->j;
+  PetscInt       i,j,n = B->rmap->n;
+
+  PetscFunctionBegin;
+  ierr = PetscFree(b->sn.sn);CHKERRQ(ierr);
+  ierr = PetscMalloc1(n+1,&b->sn.sn);CHKERRQ(ierr);
+  b->sn.nsn     = 0;
+  b->sn.maxs    = 0;
+  b->sn.maxncol = 0;
+  for (i=0; i<n; i=j) {
+    /* row j joins the supernode if the first entry of row j-1 after the diagonal is in column j and
+       row j has the other entries of row j-1; the diagonal is the last entry of each row */
+    for (j=i+1; j<n && j-i<MAT_SEQSBAIJ_SUPERNODE_MAX; j++) {
+      if (bi[j]-bi[j-1] != bi[j+1]-bi[j]+1 || bj[bi[j-1]] != j) break;
+    }
+    b->sn.sn[b->sn.nsn++] = i;
+    b->sn.maxs    = PetscMax(b->sn.maxs,j-i);
+    b->sn.maxncol = PetscMax(b->sn.maxncol,bi[i+1]-bi[i]);
+  }
+  b->sn.sn[b->sn.nsn] = n;
+  ierr = PetscInfo4(B,"%D supernodes for %D rows, largest has %D rows and %D columns\n",b->sn.nsn,n,b->sn.maxs,b->sn.maxncol);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+/*
+   Computes the numeric factor B of the matrix given by ai[], aj[], aa[]; only the entries in the upper triangular part
+   of the permuted matrix are used. rip[] and riip[] are the permutation and its inverse or NULL for the natural ordering.
+
+   Left-looking: the dense panel F of a supernode J (its rows, with the columns of the nonzero structure of its first row)
+   is loaded with the matrix, updated with the products U(K,J)^T D(K) U(K,:) of each previous supernode K with entries
+   in the columns of J, then the rows of J are eliminated in F. The off-diagonal part U(J,T) of each computed supernode
+   is kept in a dense column-major array for the later updates.
+
+   Returns with sctx->newshift set if a pivot requires a shift and the factorization must be restarted
+*/
+PetscErrorCode MatCholeskyFactorNumeric_SeqSBAIJ_1_Supernodal_Private(Mat B,Mat A,const PetscInt ai[],const PetscInt aj[],const MatScalar aa[],const PetscInt rip[],const PetscInt riip[],const MatFactorInfo *info,FactorShiftCtx *sctx)
+{
+  Mat_SeqSBAIJ   *b = (Mat_SeqSBAIJ*)B->data;
+  PetscErrorCode ierr;
+  const PetscInt *bi = b->i,*bj = b->j,*sn = b->sn.sn,*T,*TK;
+  PetscInt       n = B->rmap->n,nsn = b->sn.nsn,J,K,nextK,f,l,s,nt,ncol,t,t2,c,e,a,row,col,j,p1,p2,m1,m2,sK,ntK;
+  PetscInt       *map,*rsn,*head,*next,*pos,*uoff;
+  MatScalar      *ba = b->a;
+  PetscScalar    *F,*U,*UJ,*UK,*D,*W,*C,*Frow,dk,u,one = 1.0,zero = 0.0;
+  PetscReal      rs;
+  PetscLogDouble flops = 0.0;
+  PetscBLASInt   bm1,bm2,bsK;
+
+  PetscFunctionBegin;
+  ierr = PetscMalloc6(n,&map,n,&rsn,nsn,&head,nsn,&next,nsn,&pos,nsn+1,&uoff);CHKERRQ(ierr);
+  uoff[0] = 0;
+  for (J=0; J<nsn; J++) {
+    s         = sn[J+1] - sn[J];
+    uoff[J+1] = uoff[J] + s*(bi[sn[J]+1] - bi[sn[J]] - s);
+    for (t=sn[J]; t<sn[J+1]; t++) rsn[t] = J;
+    head[J]   = -1;
+  }
+  ierr = PetscMalloc5(uoff[nsn],&U,n,&D,b->sn.maxs*b->sn.maxncol,&F,b->sn.maxs*b->sn.maxs,&W,b->sn.maxs*b->sn.maxncol,&C);CHKERRQ(ierr);
+
+  for (J=0; J<nsn; J++) {
+    f    = sn[J];
+    l    = sn[J+1] - 1;
+    s    = l - f + 1;
+    ncol = bi[f+1] - bi[f];
+    nt   = ncol - s;
+    T    = bj + bi[f] + s - 1; /* columns of the supernode beyond its diagonal block */
+    for (c=0; c<s; c++) map[f+c] = c;
+    for (c=0; c<nt; c++) map[T[c]] = s + c;
+
+    /* load the upper triangular part of the rows of the matrix into F, stored by rows */
+    ierr = PetscArrayzero(F,s*ncol);CHKERRQ(ierr);
+    for (t=0; t<s; t++) {
+      row  = rip ? rip[f+t] : f+t;
+      Frow = F + t*ncol;
+      for (j=ai[row]; j<ai[row+1]; j++) {
+        col = riip ? riip[aj[j]] : aj[j];
+        if (col >= f+t) Frow[map[col]] = aa[j];
+      }
+      Frow[t] += sctx->shift_amount;
+    }
+
+    /* F -= U(K,J)^T D(K) U(K,J:) for the previous supernodes K with entries in the columns of J */
+    for (K=head[J]; K>=0; K=nextK) {
+      nextK = next[K];
+      sK    = sn[K+1] - sn[K];
+      ntK   = bi[sn[K]+1] - bi[sn[K]] - sK;
+      TK    = bj + bi[sn[K]] + sK - 1;
+      UK    = U + uoff[K];
+      p1    = pos[K];
+      for (p2=p1; p2<ntK && TK[p2]<=l; p2++) ;
+      m1    = p2 - p1;
+      m2    = ntK - p1;
+      for (a=0; a<m1; a++) {
+        for (t=0; t<sK; t++) W[a*sK+t] = D[sn[K]+t]*UK[(p1+a)*sK+t];
+      }
+      ierr = PetscBLASIntCast(m1,&bm1);CHKERRQ(ierr);
+      ierr = PetscBLASIntCast(m2,&bm2);CHKERRQ(ierr);
+      ierr = PetscBLASIntCast(sK,&bsK);CHKERRQ(ierr);
+      PetscStackCallBLAS("BLASgemm",BLASgemm_("T","N",&bm1,&bm2,&bsK,&one,W,&bsK,UK+p1*sK,&bsK,&zero,C,&bm1));
+      for (e=0; e<m2; e++) {
+        c = map[TK[p1+e]];
+        for (a=0; a<=PetscMin(e,m1-1); a++) F[(TK[p1+a]-f)*ncol+c] -= C[e*m1+a];
+      }
+      flops += 2.0*m1*m2*sK + m1*sK;
+
+      /* K updates the supernode of its next column */
+      pos[K] = p2;
+      if (p2 < ntK) {
+        j       = rsn[TK[p2]];
+        next[K] = head[j];
+        head[j] = K;
+      }
+    }
+
+    /* eliminate the rows of the supernode, F(t,:) becomes D(t) U(t,:) */
+    for (t=0; t<s; t++) {
+      Frow = F + t*ncol;
+      dk   = Frow[t];
+      rs   = 0.0;
+      for (c=t+1; c<ncol; c++) rs += PetscAbsScalar(Frow[c]);
+      sctx->rs = rs;
+      sctx->pv = dk;
+      ierr     = MatPivotCheck(B,A,info,sctx,f+t);CHKERRQ(ierr);
+      if (sctx->newshift) break;
+      dk       = sctx->pv;
+      D[f+t]   = dk;
+      for (t2=t+1; t2<s; t2++) {
+        u = Frow[t2]/dk;
+        if (u == (PetscScalar)0.0) continue;
+        for (c=t2; c<ncol; c++) F[t2*ncol+c] -= u*Frow[c];
+        flops += 2.0*(ncol-t2) + 1;
+      }
+    }
+    if (sctx->newshift) break;
+
+    /* store the rows of the supernode in the factor and U(J,T) for the later updates */
+    UJ = U + uoff[J];
+    for (t=0; t<s; t++) {
+      Frow = F + t*ncol;
+      dk   = D[f+t];
+      ba[bi[f+t+1]-1] = 1.0/dk;
+      for (c=t+1; c<ncol; c++) ba[bi[f+t]+c-t-1] = -Frow[c]/dk;
+      for (c=0; c<nt; c++) UJ[c*s+t] = Frow[s+c]/dk;
+    }
+    flops += bi[l+1] - bi[f];
+    if (nt) {
+      pos[J]  = 0;
+      j       = rsn[T[0]];
+      next[J] = head[j];
+      head[j] = J;
+    }
+  }
+
+  ierr = PetscFree5(U,D,F,W,C);CHKERRQ(ierr);
+  ierr = PetscFree6(map,rsn,head,next,pos,uoff);CHKERRQ(ierr);
+  ierr = PetscLogFlops(flops);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+/*
+    Version of MatCholeskyFactorNumeric_SeqSBAIJ_1_NaturalOrdering() with the supernodes of the factor
+*/
+PetscErrorCode MatCholeskyFactorNumeric_SeqSBAIJ_1_NaturalOrdering_Supernodal(Mat B,Mat A,const MatFactorInfo *info)
+{
+  Mat_SeqSBAIJ   *a = (Mat_SeqSBAIJ*)A->data;
+  PetscErrorCode ierr;
+  PetscInt       i,j,mbs = A->rmap->n,*ai = a->i,*aj = a->j,*ajtmp,nz;
+  MatScalar      *aa = a->a,d,*v;
+  PetscReal      *rtmp;
+  FactorShiftCtx sctx;
+
+  PetscFunctionBegin;
+  /* MatPivotSetUp(): initialize shift context sctx */
+  ierr = PetscMemzero(&sctx,sizeof(FactorShiftCtx));CHKERRQ(ierr);
+
+  if (info->shifttype == (PetscReal)MAT_SHIFT_POSITIVE_DEFINITE) { /* set sctx.shift_top=max{rs} */
+    sctx.shift_top = info->zeropivot;
+
+    ierr = PetscCalloc1(mbs,&rtmp);CHKERRQ(ierr);
+    for (i=0; i<mbs; i++) {
+      /* calculate sum(|aij|)-RealPart(aii), amt of shift needed for this row */
+      d        = aa[a->diag[i]];
+      rtmp[i] += -PetscRealPart(d);  /* diagonal entry */
+      ajtmp    = aj + ai[i] + 1;     /* exclude diagonal */
+      v        = aa + ai[i] + 1;
+      nz       = ai[i+1] - ai[i] - 1;
+      for (j=0; j<nz; j++) {
+        rtmp[i]        += PetscAbsScalar(v[j]);
+        rtmp[ajtmp[j]] += PetscAbsScalar(v[j]);
+      }
+      if (rtmp[i] > sctx.shift_top) sctx.shift_top = rtmp[i];
+    }
+    ierr = PetscFree(rtmp);CHKERRQ(ierr);
+    sctx.shift_top *= 1.1;
+    sctx.nshift_max = 5;
+    sctx.shift_lo   = 0.;
+    sctx.shift_hi   = 1.;
+  }
+
+  do {
+    sctx.newshift = PETSC_FALSE;
+    ierr = MatCholeskyFactorNumeric_SeqSBAIJ_1_Supernodal_Private(B,A,ai,aj,aa,NULL,NULL,info,&sctx);CHKERRQ(ierr);
+  } while (sctx.newshift);
+
+  B->ops->solve          = MatSolve_SeqSBAIJ_1_NaturalOrdering;
+  B->ops->solves         = MatSolves_SeqSBAIJ_1;
+  B->ops->solvetranspose = MatSolve_SeqSBAIJ_1_NaturalOrdering;
+  B->ops->matsolve       = MatMatSolve_SeqSBAIJ_1_NaturalOrdering;
+  B->ops->forwardsolve   = MatForwardSolve_SeqSBAIJ_1_NaturalOrdering;
+  B->ops->backwardsolve  = MatBackwardSolve_SeqSBAIJ_1_NaturalOrdering;
+
+  B->assembled    = PETSC_TRUE;
+  B->preallocated = PETSC_TRUE;
+
+  /* MatPivotView() */
+  if (sctx.nshift) {
+    if (info->shifttype == (PetscReal)MAT_SHIFT_POSITIVE_DEFINITE) {
+      ierr = PetscInfo4(A,"number of shift_pd tries %D, shift_amount %g, diagonal shifted up by %e fraction top_value %e\n",sctx.nshift,(double)sctx.shift_amount,(double)sctx.shift_fraction,(double)sctx.shift_top);CHKERRQ(ierr);
+    } else if (info->shifttype == (PetscReal)MAT_SHIFT_NONZERO) {
+      ierr = PetscInfo2(A,"number of shift_nz tries %D, shift_amount %g\n",sctx.nshift,(double)sctx.shift_amount);CHKERRQ(ierr);
+    } else if (info->shifttype == (PetscReal)MAT_SHIFT_INBLOCKS) {
+      ierr = PetscInfo2(A,"number of shift_inblocks applied %D, each shift_amount %g\n",sctx.nshift,(double)info->shiftamount);CHKERRQ(ierr);
+    }
+  }
+  PetscFunctionReturn(0);
+}
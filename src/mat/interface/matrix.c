@@ -37,7 +37,7 @@ PetscLogEvent MAT_PreallCOO, MAT_SetVCOO;
 PetscLogEvent MAT_SetValuesBatch;
 PetscLogEvent MAT_ViennaCLCopyToGPU;
 PetscLogEvent MAT_DenseCopyToGPU, MAT_DenseCopyFromGPU;
-PetscLogEvent MAT_Merge,MAT_Residual,MAT_SetRandom;
+PetscLogEvent MAT_Merge,MAT_Residual,MAT_ResidualJacobiUpdate,MAT_SetRandom;
 PetscLogEvent MAT_FactorFactS,MAT_FactorInvS;
 PetscLogEvent MATCOLORING_Apply,MATCOLORING_Comm,MATCOLORING_Local,MATCOLORING_ISCreate,MATCOLORING_SetUp,MATCOLORING_Weights;
 PetscLogEvent MAT_H2Opus_Build,MAT_H2Opus_Compress,MAT_H2Opus_Orthog;
@@ -4132,13 +4132,18 @@ PetscErrorCode MatSolveTransposeAdd(Mat mat,Vec b,Vec y,Vec x)
 .     SOR_APPLY_UPPER, SOR_APPLY_LOWER - applies
          upper/lower triangular part of matrix to
          vector (with omega)
--     SOR_ZERO_INITIAL_GUESS - zero initial guess
+.     SOR_ZERO_INITIAL_GUESS - zero initial guess
+-     SOR_MULTICOLOR - sweeps over the rows color by color, updating the rows of a color simultaneously (with OpenMP threads)
 
    Notes:
    SOR_LOCAL_FORWARD_SWEEP, SOR_LOCAL_BACKWARD_SWEEP, and
    SOR_LOCAL_SYMMETRIC_SWEEP perform separate independent smoothings
    on each processor.
 
+   SOR_MULTICOLOR is supported by the AIJ and BAIJ formats, the other formats generate an error; the coloring of the (symmetrized) nonzero structure of the
+   local rows is computed with MatColoring, options prefix -sor_, and kept until the nonzero structure changes.
+   The result depends on the coloring but not on the number of threads.
+
    Application programmers will not generally use MatSOR() directly,
    but instead will employ the KSP/PC interface.
 
@@ -7661,6 +7666,58 @@ PetscErrorCode MatResidual(Mat mat,Vec b,Vec x,Vec r)
   PetscFunctionReturn(0);
 }
 
+/*@
+   MatResidualJacobiUpdate - Computes the residual of an approximate solution, scales it with an inverse diagonal and
+   adds it to a linear combination of two vectors, y = alpha x + beta w + gamma D^{-1} (b - A w), in a single pass over the matrix.
+
+   Collective on Mat
+
+   Input Parameters:
++  mat - the matrix
+.  b - the right-hand-side
+.  dinv - the inverse diagonal D^{-1}, for example the diagonal of PCJACOBI
+.  alpha - the coefficient of x
+.  x - a vector, may be the same as w
+.  beta - the coefficient of w
+.  w - the approximate solution
+-  gamma - the coefficient of the scaled residual
+
+   Output Parameters:
++  y - the result, must be different from w but may be the same as x
+-  rnorm - the 2-norm of the residual b - A w, or NULL if not needed
+
+   Notes:
+   This is the step of Jacobi preconditioned stationary and polynomial iterations such as KSPCHEBYSHEV, which
+   otherwise needs a MatMult() and several vector operations, each a separate pass over memory. It is
+   supported by the AIJ format and uses the OpenMP threads. Its time is logged in the MatResJacobiUpd event.
+
+   Level: developer
+
+.seealso: MatResidual(), KSPChebyshevSetFused(), PCJACOBI
+@*/
+PetscErrorCode MatResidualJacobiUpdate(Mat mat,Vec b,Vec dinv,PetscScalar alpha,Vec x,PetscScalar beta,Vec w,PetscScalar gamma,Vec y,PetscReal *rnorm)
+{
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  PetscValidHeaderSpecific(mat,MAT_CLASSID,1);
+  PetscValidHeaderSpecific(b,VEC_CLASSID,2);
+  PetscValidHeaderSpecific(dinv,VEC_CLASSID,3);
+  PetscValidLogicalCollectiveScalar(mat,alpha,4);
+  PetscValidHeaderSpecific(x,VEC_CLASSID,5);
+  PetscValidLogicalCollectiveScalar(mat,beta,6);
+  PetscValidHeaderSpecific(w,VEC_CLASSID,7);
+  PetscValidLogicalCollectiveScalar(mat,gamma,8);
+  PetscValidHeaderSpecific(y,VEC_CLASSID,9);
+  PetscValidType(mat,1);
+  MatCheckPreallocated(mat,1);
+  if (y == w) SETERRQ(PetscObjectComm((PetscObject)mat),PETSC_ERR_ARG_IDN,"y and w must be different vectors");
+  ierr = PetscLogEventBegin(MAT_ResidualJacobiUpdate,mat,0,0,0);CHKERRQ(ierr);
+  ierr = PetscUseMethod(mat,"MatResidualJacobiUpdate_C",(Mat,Vec,Vec,PetscScalar,Vec,PetscScalar,Vec,PetscScalar,Vec,PetscReal*),(mat,b,dinv,alpha,x,beta,w,gamma,y,rnorm));CHKERRQ(ierr);
+  ierr = PetscLogEventEnd(MAT_ResidualJacobiUpdate,mat,0,0,0);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
 /*@C
     MatGetRowIJ - Returns the compressed row storage i and j indices for sequential matrices.
 
@@ -9264,6 +9321,49 @@ PetscErrorCode MatFactorInfoInitialize(MatFactorInfo *info)
   PetscFunctionReturn(0);
 }
 
+/*@
+   MatFactorSetIterativeSweeps - Sets the ILU factor to be computed by fixed-point sweeps and applied with Jacobi sweeps
+   instead of the exact factorization and the exact triangular solves
+
+   Logically Collective on Mat
+
+   Input Parameters:
++  mat - the factored matrix obtained with MatGetFactor() and MAT_FACTOR_ILU
+.  fsweeps - the number of fixed-point sweeps of the numeric factorization, 0 for the exact factorization
+-  ssweeps - the number of Jacobi sweeps approximating each triangular solve of MatSolve(), 0 for exact triangular solves
+
+   Notes:
+   This must be called before MatILUFactorSymbolic(). It is ignored by the solver types that do not support it;
+   MATSOLVERPETSC supports it for MATSEQAIJ matrices.
+
+   The sweeps of the factorization update the entries of L and U in place, each thread (see -omp_num_threads) updating
+   its own rows, so the entries are computed in parallel but the result depends on the number of threads. The Jacobi
+   sweeps of the triangular solves are independent of the number of threads. Both converge to the exact ILU factor
+   and to the exact triangular solves after as many sweeps as the largest number of levels of the triangular factors.
+
+   Level: advanced
+
+   References:
+.  1. - E. Chow and A. Patel, Fine-grained parallel incomplete LU factorization, SIAM J. Sci. Comput., 37 (2015).
+
+.seealso: MatGetFactor(), MatILUFactorSymbolic(), PCFactorSetIterativeSweeps()
+@*/
+PetscErrorCode MatFactorSetIterativeSweeps(Mat mat,PetscInt fsweeps,PetscInt ssweeps)
+{
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  PetscValidHeaderSpecific(mat,MAT_CLASSID,1);
+  PetscValidType(mat,1);
+  PetscValidLogicalCollectiveInt(mat,fsweeps,2);
+  PetscValidLogicalCollectiveInt(mat,ssweeps,3);
+  if (!mat->factortype) SETERRQ(PetscObjectComm((PetscObject)mat),PETSC_ERR_ARG_WRONGSTATE,"Only for factored matrix");
+  if (fsweeps < 0) SETERRQ1(PetscObjectComm((PetscObject)mat),PETSC_ERR_ARG_OUTOFRANGE,"Number of factorization sweeps %D cannot be negative",fsweeps);
+  if (ssweeps < 0) SETERRQ1(PetscObjectComm((PetscObject)mat),PETSC_ERR_ARG_OUTOFRANGE,"Number of solve sweeps %D cannot be negative",ssweeps);
+  ierr = PetscTryMethod(mat,"MatFactorSetIterativeSweeps_C",(Mat,PetscInt,PetscInt),(mat,fsweeps,ssweeps));CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
 /*@
    MatFactorSetSchurIS - Set indices corresponding to the Schur complement you wish to have computed
 
@@ -0,0 +1,174 @@
+static char help[] = "Tests MatSetPreallocationCOO() and MatSetValuesCOO() with repeated entries and off-process rows,\n\
+against MatSetValues() with the stash, optionally with a persistent communication pattern.\n\n";
+
+#include <petscmat.h>
+
+/* assembles the tridiagonal matrix with diagonal d and off-diagonal -d/4, every entry given twice, and applies one symmetric SOR sweep to b */
+static PetscErrorCode TestSOR(Mat A,Mat B,PetscScalar d,Vec b,Vec x,Vec y)
+{
+  PetscInt       rstart,rend,n,row,k = 0,*coo_i,*coo_j;
+  PetscScalar    *coo_v;
+  PetscReal      norm;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  ierr = MatGetOwnershipRange(A,&rstart,&rend);CHKERRQ(ierr);
+  ierr = MatGetSize(A,&n,NULL);CHKERRQ(ierr);
+  ierr = PetscMalloc3(6*(rend-rstart),&coo_i,6*(rend-rstart),&coo_j,6*(rend-rstart),&coo_v);CHKERRQ(ierr);
+  for (row=rstart; row<rend; row++) {
+    PetscInt c;
+    for (c=PetscMax(row-1,0); c<=PetscMin(row+1,n-1); c++) {
+      coo_i[k] = coo_i[k+1] = row;
+      coo_j[k] = coo_j[k+1] = c;
+      coo_v[k] = coo_v[k+1] = 0.5*(c == row ? d : -0.25*d);
+      k   += 2;
+    }
+  }
+  ierr = MatSetValuesCOO(A,coo_v,INSERT_VALUES);CHKERRQ(ierr);
+  ierr = MatZeroEntries(B);CHKERRQ(ierr);
+  for (row=0; row<k; row++) {ierr = MatSetValue(B,coo_i[row],coo_j[row],coo_v[row],ADD_VALUES);CHKERRQ(ierr);}
+  ierr = MatAssemblyBegin(B,MAT_FINAL_ASSEMBLY);CHKERRQ(ierr);
+  ierr = MatAssemblyEnd(B,MAT_FINAL_ASSEMBLY);CHKERRQ(ierr);
+  ierr = MatSOR(A,b,1.0,(MatSORType)(SOR_LOCAL_SYMMETRIC_SWEEP | SOR_ZERO_INITIAL_GUESS),0.0,1,1,x);CHKERRQ(ierr);
+  ierr = MatSOR(B,b,1.0,(MatSORType)(SOR_LOCAL_SYMMETRIC_SWEEP | SOR_ZERO_INITIAL_GUESS),0.0,1,1,y);CHKERRQ(ierr);
+  ierr = VecAXPY(y,-1.0,x);CHKERRQ(ierr);
+  ierr = VecNorm(y,NORM_2,&norm);CHKERRQ(ierr);
+  if (norm > PETSC_SMALL) {ierr = PetscPrintf(PETSC_COMM_WORLD,"MatSOR() after MatSetValuesCOO() with diagonal %g differs, norm %g\n",(double)PetscRealPart(d),(double)norm);CHKERRQ(ierr);}
+  ierr = PetscFree3(coo_i,coo_j,coo_v);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+int main(int argc,char **args)
+{
+  Mat            A,B,D;
+  Vec            x,y,b;
+  PetscInt       M = 17,N = 13,ncoo = 60,k,*coo_i,*coo_j,it,rstart,rend;
+  PetscScalar    *coo_v;
+  PetscMPIInt    rank,size;
+  PetscReal      norm;
+  PetscErrorCode ierr;
+
+  ierr = PetscInitialize(&argc,&args,(char*)0,help);if (ierr) return ierr;
+  ierr = MPI_Comm_rank(PETSC_COMM_WORLD,&rank);CHKERRMPI(ierr);
+  ierr = MPI_Comm_size(PETSC_COMM_WORLD,&size);CHKERRMPI(ierr);
+  ierr = PetscOptionsGetInt(NULL,NULL,"-M",&M,NULL);CHKERRQ(ierr);
+  ierr = PetscOptionsGetInt(NULL,NULL,"-N",&N,NULL);CHKERRQ(ierr);
+  ierr = PetscOptionsGetInt(NULL,NULL,"-ncoo",&ncoo,NULL);CHKERRQ(ierr);
+
+  ierr = MatCreate(PETSC_COMM_WORLD,&A);CHKERRQ(ierr);
+  ierr = MatSetSizes(A,PETSC_DECIDE,PETSC_DECIDE,M,N);CHKERRQ(ierr);
+  ierr = MatSetFromOptions(A);CHKERRQ(ierr);
+  ierr = MatCreate(PETSC_COMM_WORLD,&B);CHKERRQ(ierr);
+  ierr = MatSetSizes(B,PETSC_DECIDE,PETSC_DECIDE,M,N);CHKERRQ(ierr);
+  ierr = MatSetFromOptions(B);CHKERRQ(ierr);
+  ierr = MatSetUp(B);CHKERRQ(ierr);
+  ierr = MatSetOption(B,MAT_NEW_NONZERO_ALLOCATION_ERR,PETSC_FALSE);CHKERRQ(ierr);
+
+  /* every process contributes to rows all over the matrix, with plenty of repeated (i,j) pairs */
+  ierr = PetscMalloc3(ncoo,&coo_i,ncoo,&coo_j,ncoo,&coo_v);CHKERRQ(ierr);
+  for (k=0; k<ncoo; k++) {
+    coo_i[k] = (7*k + 3*rank) % M;
+    coo_j[k] = (5*k + rank*rank) % N;
+  }
+  ierr = MatSetPreallocationCOO(A,ncoo,coo_i,coo_j);CHKERRQ(ierr);
+
+  /* B gets the same entries through MatSetValues() and the stash; in the third pass every process sets the entries of
+     the next one, so the off-process entries go to other processes than in the previous assemblies */
+  for (it=0; it<4; it++) {
+    InsertMode  imode = it == 1 ? ADD_VALUES : INSERT_VALUES;
+    PetscMPIInt src = it == 2 ? (rank + 1) % size : rank;
+
+    for (k=0; k<ncoo; k++) coo_v[k] = (PetscScalar)(1 + k + 10*it + 100*rank);
+    ierr = MatSetValuesCOO(A,coo_v,imode);CHKERRQ(ierr);
+    if (imode == INSERT_VALUES) {ierr = MatZeroEntries(B);CHKERRQ(ierr);}
+    for (k=0; k<ncoo; k++) {
+      ierr = MatSetValue(B,(7*k + 3*src) % M,(5*k + src*src) % N,(PetscScalar)(1 + k + 10*it + 100*src),ADD_VALUES);CHKERRQ(ierr);
+    }
+    ierr = MatAssemblyBegin(B,MAT_FINAL_ASSEMBLY);CHKERRQ(ierr);
+    ierr = MatAssemblyEnd(B,MAT_FINAL_ASSEMBLY);CHKERRQ(ierr);
+    ierr = MatDuplicate(B,MAT_COPY_VALUES,&D);CHKERRQ(ierr);
+    ierr = MatAXPY(D,-1.0,A,DIFFERENT_NONZERO_PATTERN);CHKERRQ(ierr);
+    ierr = MatNorm(D,NORM_FROBENIUS,&norm);CHKERRQ(ierr);
+    ierr = MatDestroy(&D);CHKERRQ(ierr);
+    if (norm > PETSC_SMALL) {ierr = PetscPrintf(PETSC_COMM_WORLD,"Iteration %D: MatSetValuesCOO() differs from MatSetValues(), norm %g\n",it,(double)norm);CHKERRQ(ierr);}
+  }
+
+  /* a NULL array of values zeros the matrix with INSERT_VALUES */
+  ierr = MatSetValuesCOO(A,NULL,INSERT_VALUES);CHKERRQ(ierr);
+  ierr = MatNorm(A,NORM_FROBENIUS,&norm);CHKERRQ(ierr);
+  if (norm > 0.0) {ierr = PetscPrintf(PETSC_COMM_WORLD,"MatSetValuesCOO() with NULL values did not zero the matrix\n");CHKERRQ(ierr);}
+
+  ierr = PetscFree3(coo_i,coo_j,coo_v);CHKERRQ(ierr);
+  ierr = MatDestroy(&A);CHKERRQ(ierr);
+  ierr = MatDestroy(&B);CHKERRQ(ierr);
+
+  /* new values through MatSetValuesCOO() must not reuse the inverted diagonal cached by MatSOR() of AIJ matrices */
+  rend = PETSC_DECIDE;
+  ierr = PetscSplitOwnership(PETSC_COMM_WORLD,&rend,&M);CHKERRQ(ierr);
+  ierr = MatCreate(PETSC_COMM_WORLD,&A);CHKERRQ(ierr);
+  ierr = MatSetSizes(A,rend,rend,M,M);CHKERRQ(ierr);
+  ierr = MatSetType(A,MATAIJ);CHKERRQ(ierr);
+  ierr = MPI_Scan(MPI_IN_PLACE,&rend,1,MPIU_INT,MPI_SUM,PETSC_COMM_WORLD);CHKERRMPI(ierr);
+  ierr = MatGetLocalSize(A,&rstart,NULL);CHKERRQ(ierr);
+  rstart = rend - rstart;
+  ierr = PetscMalloc2(6*(rend-rstart),&coo_i,6*(rend-rstart),&coo_j);CHKERRQ(ierr);
+  for (k=0,it=rstart; it<rend; it++) {
+    PetscInt c;
+    for (c=PetscMax(it-1,0); c<=PetscMin(it+1,M-1); c++, k+=2) {
+      coo_i[k] = coo_i[k+1] = it;
+      coo_j[k] = coo_j[k+1] = c;
+    }
+  }
+  ierr = MatSetPreallocationCOO(A,k,coo_i,coo_j);CHKERRQ(ierr);
+  ierr = PetscFree2(coo_i,coo_j);CHKERRQ(ierr);
+  ierr = MatDuplicate(A,MAT_DO_NOT_COPY_VALUES,&B);CHKERRQ(ierr);
+  ierr = MatCreateVecs(A,&x,&b);CHKERRQ(ierr);
+  ierr = VecDuplicate(x,&y);CHKERRQ(ierr);
+  ierr = VecSet(b,1.0);CHKERRQ(ierr);
+  ierr = TestSOR(A,B,4.0,b,x,y);CHKERRQ(ierr);
+  ierr = TestSOR(A,B,3.0,b,x,y);CHKERRQ(ierr);
+  ierr = VecDestroy(&x);CHKERRQ(ierr);
+  ierr = VecDestroy(&y);CHKERRQ(ierr);
+  ierr = VecDestroy(&b);CHKERRQ(ierr);
+  ierr = MatDestroy(&A);CHKERRQ(ierr);
+  ierr = MatDestroy(&B);CHKERRQ(ierr);
+  ierr = PetscFinalize();
+  return ierr;
+}
+
+/*TEST
+
+   test:
+     suffix: 1
+     args: -mat_type {{seqaij mpiaij}}
+     output_file: output/ex250_1.out
+
+   test:
+     suffix: 2
+     nsize: {{2 3 5}}
+     args: -mat_type mpiaij
+     output_file: output/ex250_1.out
+
+   testset:
+     nsize: 4
+     args: -matstash_persistent
+     output_file: output/ex250_1.out
+
+     test:
+       suffix: persistent
+       args: -mat_type {{aij baij}}
+
+     test:
+       suffix: persistent_info
+       args: -mat_type aij -info
+       filter: grep -c "do not fit the stash communication pattern"
+       output_file: output/ex250_persistent_info.out
+
+   test:
+     suffix: mixed
+     nsize: {{1 2}}
+     requires: double !complex
+     args: -mat_type aij -mat_aij_mixed_precision
+     output_file: output/ex250_1.out
+
+TEST*/
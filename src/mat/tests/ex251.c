@@ -0,0 +1,85 @@
+static char help[] = "Tests the OpenMP threaded MatMult(), MatMultAdd() and MatMultTranspose() of AIJ matrices.\n\n";
+
+#include <petscmat.h>
+
+int main(int argc,char **args)
+{
+  Mat            A,D,Ad;
+  PetscInt       M = 40,N = 31,rstart,rend,i,j,k,it;
+  PetscInt       emptyrows = 0; /* every emptyrows-th row has no entries, to exercise the compressed row format */
+  PetscBool      flg;
+  PetscErrorCode ierr;
+
+  ierr = PetscInitialize(&argc,&args,(char*)0,help);if (ierr) return ierr;
+  ierr = PetscOptionsGetInt(NULL,NULL,"-M",&M,NULL);CHKERRQ(ierr);
+  ierr = PetscOptionsGetInt(NULL,NULL,"-N",&N,NULL);CHKERRQ(ierr);
+  ierr = PetscOptionsGetInt(NULL,NULL,"-empty_rows",&emptyrows,NULL);CHKERRQ(ierr);
+
+  ierr = MatCreate(PETSC_COMM_WORLD,&A);CHKERRQ(ierr);
+  ierr = MatSetSizes(A,PETSC_DECIDE,PETSC_DECIDE,M,N);CHKERRQ(ierr);
+  ierr = MatSetFromOptions(A);CHKERRQ(ierr);
+  ierr = MatSetUp(A);CHKERRQ(ierr);
+  ierr = MatSetOption(A,MAT_NEW_NONZERO_ALLOCATION_ERR,PETSC_FALSE);CHKERRQ(ierr);
+  ierr = MatGetOwnershipRange(A,&rstart,&rend);CHKERRQ(ierr);
+
+  /* the second pass adds new nonzeros, so the row partition has to be rebuilt; the third only changes the values,
+     which must not move the arrays again */
+  for (it=0; it<3; it++) {
+    const PetscScalar *aa = NULL,*ab;
+
+    if (it == 2) {
+      ierr = MatGetDiagonalBlock(A,&Ad);CHKERRQ(ierr);
+      ierr = MatSeqAIJGetArrayRead(Ad,&ab);CHKERRQ(ierr);
+      aa   = ab;
+      ierr = MatSeqAIJRestoreArrayRead(Ad,&ab);CHKERRQ(ierr);
+    }
+    for (i=rstart; i<rend; i++) {
+      if (emptyrows && i % emptyrows) continue;
+      for (k=0; k<1+(i*(PetscMin(it,1)+3))%7; k++) {
+        j    = (i*(k+1) + 3*k + PetscMin(it,1)) % N;
+        ierr = MatSetValue(A,i,j,(PetscScalar)(1.0 + i + 0.5*k),ADD_VALUES);CHKERRQ(ierr);
+      }
+    }
+    ierr = MatAssemblyBegin(A,MAT_FINAL_ASSEMBLY);CHKERRQ(ierr);
+    ierr = MatAssemblyEnd(A,MAT_FINAL_ASSEMBLY);CHKERRQ(ierr);
+    if (aa) {
+      ierr = MatSeqAIJGetArrayRead(Ad,&ab);CHKERRQ(ierr);
+      flg  = (PetscBool)(ab == aa);
+      ierr = MatSeqAIJRestoreArrayRead(Ad,&ab);CHKERRQ(ierr);
+      if (!flg) {ierr = PetscPrintf(PETSC_COMM_SELF,"Pass %D: the values were copied again although the nonzero structure did not change\n",it);CHKERRQ(ierr);}
+    }
+
+    ierr = MatConvert(A,MATDENSE,MAT_INITIAL_MATRIX,&D);CHKERRQ(ierr);
+    ierr = MatMultEqual(A,D,5,&flg);CHKERRQ(ierr);
+    if (!flg) {ierr = PetscPrintf(PETSC_COMM_WORLD,"Pass %D: error in MatMult()\n",it);CHKERRQ(ierr);}
+    ierr = MatMultAddEqual(A,D,5,&flg);CHKERRQ(ierr);
+    if (!flg) {ierr = PetscPrintf(PETSC_COMM_WORLD,"Pass %D: error in MatMultAdd()\n",it);CHKERRQ(ierr);}
+    ierr = MatMultTransposeEqual(A,D,5,&flg);CHKERRQ(ierr);
+    if (!flg) {ierr = PetscPrintf(PETSC_COMM_WORLD,"Pass %D: error in MatMultTranspose()\n",it);CHKERRQ(ierr);}
+    ierr = MatMultTransposeAddEqual(A,D,5,&flg);CHKERRQ(ierr);
+    if (!flg) {ierr = PetscPrintf(PETSC_COMM_WORLD,"Pass %D: error in MatMultTransposeAdd()\n",it);CHKERRQ(ierr);}
+    ierr = MatDestroy(&D);CHKERRQ(ierr);
+  }
+
+  ierr = MatDestroy(&A);CHKERRQ(ierr);
+  ierr = PetscFinalize();
+  return ierr;
+}
+
+/*TEST
+
+   testset:
+     requires: openmp
+     args: -mat_aij_omp -omp_num_threads {{1 3}} -empty_rows {{0 3}}
+     output_file: output/ex251_1.out
+
+     test:
+       suffix: 1
+       args: -mat_type seqaij
+
+     test:
+       suffix: 2
+       nsize: 2
+       args: -mat_type mpiaij
+
+TEST*/
@@ -0,0 +1,66 @@
+static char help[] = "Tests the autotuned MatMult() kernels of AIJ matrices.\n\n";
+
+#include <petscmat.h>
+
+int main(int argc,char **args)
+{
+  Mat            A,D;
+  PetscInt       bs = 2,mb = 23,rstart,rend,i,j,k,ib,it;
+  PetscScalar    v[4];
+  PetscBool      flg;
+  PetscErrorCode ierr;
+
+  ierr = PetscInitialize(&argc,&args,(char*)0,help);if (ierr) return ierr;
+  ierr = PetscOptionsGetInt(NULL,NULL,"-mb",&mb,NULL);CHKERRQ(ierr);
+
+  ierr = MatCreate(PETSC_COMM_WORLD,&A);CHKERRQ(ierr);
+  ierr = MatSetSizes(A,PETSC_DECIDE,PETSC_DECIDE,bs*mb,bs*mb);CHKERRQ(ierr);
+  ierr = MatSetBlockSize(A,bs);CHKERRQ(ierr);
+  ierr = MatSetFromOptions(A);CHKERRQ(ierr);
+  ierr = MatSetUp(A);CHKERRQ(ierr);
+  ierr = MatSetOption(A,MAT_NEW_NONZERO_ALLOCATION_ERR,PETSC_FALSE);CHKERRQ(ierr);
+  ierr = MatGetOwnershipRange(A,&rstart,&rend);CHKERRQ(ierr);
+
+  /* full 2x2 blocks; the second pass only changes the values, the third one adds blocks */
+  for (it=0; it<3; it++) {
+    for (ib=rstart/bs; ib<rend/bs; ib++) {
+      for (k=0; k<(it == 2 ? 4 : 3); k++) {
+        j    = (ib + k*k*(k+1)) % mb;
+        for (i=0; i<4; i++) v[i] = 1.0 + ib + 0.5*i + 0.25*k + it;
+        ierr = MatSetValuesBlocked(A,1,&ib,1,&j,v,INSERT_VALUES);CHKERRQ(ierr);
+      }
+    }
+    ierr = MatAssemblyBegin(A,MAT_FINAL_ASSEMBLY);CHKERRQ(ierr);
+    ierr = MatAssemblyEnd(A,MAT_FINAL_ASSEMBLY);CHKERRQ(ierr);
+
+    ierr = MatConvert(A,MATDENSE,MAT_INITIAL_MATRIX,&D);CHKERRQ(ierr);
+    /* the kernel is chosen during the first test, the second one uses it */
+    ierr = MatMultEqual(A,D,5,&flg);CHKERRQ(ierr);
+    if (!flg) {ierr = PetscPrintf(PETSC_COMM_WORLD,"Pass %D: error in MatMult() while autotuning\n",it);CHKERRQ(ierr);}
+    ierr = MatMultEqual(A,D,5,&flg);CHKERRQ(ierr);
+    if (!flg) {ierr = PetscPrintf(PETSC_COMM_WORLD,"Pass %D: error in MatMult() after autotuning\n",it);CHKERRQ(ierr);}
+    ierr = MatDestroy(&D);CHKERRQ(ierr);
+    ierr = MatViewFromOptions(A,NULL,"-A_view");CHKERRQ(ierr);
+  }
+
+  ierr = MatDestroy(&A);CHKERRQ(ierr);
+  ierr = PetscFinalize();
+  return ierr;
+}
+
+/*TEST
+
+   testset:
+     args: -mat_aij_autotune -mat_aij_autotune_threshold 3 -mat_aij_autotune_its 2 -A_view ::ascii_info
+     filter: sed -e "s@autotuning: [a-z]*@autotuning@g" -e "s@(on process 0): [a-z]*@(on process 0)@g"
+
+     test:
+       suffix: 1
+       args: -mat_type seqaij
+
+     test:
+       suffix: 2
+       nsize: 2
+       args: -mat_type mpiaij
+
+TEST*/
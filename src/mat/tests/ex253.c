@@ -0,0 +1,118 @@
+static char help[] = "Tests the single precision values of AIJ matrices in MatMult(), MatMultAdd(), MatSOR() and MatSolve().\n\n";
+
+#include <petscksp.h>
+
+int main(int argc,char **args)
+{
+  Mat            A,D;
+  Vec            x,y,z,b;
+  KSP            ksp;
+  PetscInt       m = 11,n,i,j,row,col,rstart,rend;
+  PetscScalar    v;
+  PetscReal      nrm,err,tol = 1.e-6;
+  PetscRandom    rctx;
+  PetscErrorCode ierr;
+
+  ierr = PetscInitialize(&argc,&args,(char*)0,help);if (ierr) return ierr;
+  ierr = PetscOptionsGetInt(NULL,NULL,"-m",&m,NULL);CHKERRQ(ierr);
+  n    = m*m;
+
+  /* a 2d Laplacian with values that are not exactly representable in single precision */
+  ierr = MatCreate(PETSC_COMM_WORLD,&A);CHKERRQ(ierr);
+  ierr = MatSetSizes(A,PETSC_DECIDE,PETSC_DECIDE,n,n);CHKERRQ(ierr);
+  ierr = MatSetFromOptions(A);CHKERRQ(ierr);
+  ierr = MatSeqAIJSetPreallocation(A,5,NULL);CHKERRQ(ierr);
+  ierr = MatMPIAIJSetPreallocation(A,5,NULL,5,NULL);CHKERRQ(ierr);
+  ierr = MatGetOwnershipRange(A,&rstart,&rend);CHKERRQ(ierr);
+  for (row=rstart; row<rend; row++) {
+    i = row/m; j = row - i*m;
+    v = -1.0/3.0 - 0.01*i;
+    if (i>0)   {col = row - m; ierr = MatSetValues(A,1,&row,1,&col,&v,INSERT_VALUES);CHKERRQ(ierr);}
+    if (i<m-1) {col = row + m; ierr = MatSetValues(A,1,&row,1,&col,&v,INSERT_VALUES);CHKERRQ(ierr);}
+    v = -1.0/7.0 - 0.01*j;
+    if (j>0)   {col = row - 1; ierr = MatSetValues(A,1,&row,1,&col,&v,INSERT_VALUES);CHKERRQ(ierr);}
+    if (j<m-1) {col = row + 1; ierr = MatSetValues(A,1,&row,1,&col,&v,INSERT_VALUES);CHKERRQ(ierr);}
+    v = 2.0/3.0 + 2.0/7.0 + 0.05*(i+j) + 0.1;
+    ierr = MatSetValues(A,1,&row,1,&row,&v,INSERT_VALUES);CHKERRQ(ierr);
+  }
+  ierr = MatAssemblyBegin(A,MAT_FINAL_ASSEMBLY);CHKERRQ(ierr);
+  ierr = MatAssemblyEnd(A,MAT_FINAL_ASSEMBLY);CHKERRQ(ierr);
+  ierr = MatConvert(A,MATDENSE,MAT_INITIAL_MATRIX,&D);CHKERRQ(ierr);
+
+  ierr = MatCreateVecs(A,&x,&y);CHKERRQ(ierr);
+  ierr = VecDuplicate(y,&z);CHKERRQ(ierr);
+  ierr = VecDuplicate(y,&b);CHKERRQ(ierr);
+  ierr = PetscRandomCreate(PETSC_COMM_WORLD,&rctx);CHKERRQ(ierr);
+  ierr = PetscRandomSetFromOptions(rctx);CHKERRQ(ierr);
+  ierr = VecSetRandom(x,rctx);CHKERRQ(ierr);
+  ierr = VecSetRandom(b,rctx);CHKERRQ(ierr);
+
+  /* the products agree with the double precision ones to single precision accuracy */
+  ierr = MatMult(A,x,y);CHKERRQ(ierr);
+  ierr = MatMult(D,x,z);CHKERRQ(ierr);
+  ierr = VecNorm(z,NORM_2,&nrm);CHKERRQ(ierr);
+  ierr = VecAXPY(z,-1.0,y);CHKERRQ(ierr);
+  ierr = VecNorm(z,NORM_2,&err);CHKERRQ(ierr);
+  if (err > tol*nrm) {ierr = PetscPrintf(PETSC_COMM_WORLD,"Error in MatMult(): %g\n",(double)(err/nrm));CHKERRQ(ierr);}
+  ierr = MatMultAdd(A,x,b,y);CHKERRQ(ierr);
+  ierr = MatMultAdd(D,x,b,z);CHKERRQ(ierr);
+  ierr = VecNorm(z,NORM_2,&nrm);CHKERRQ(ierr);
+  ierr = VecAXPY(z,-1.0,y);CHKERRQ(ierr);
+  ierr = VecNorm(z,NORM_2,&err);CHKERRQ(ierr);
+  if (err > tol*nrm) {ierr = PetscPrintf(PETSC_COMM_WORLD,"Error in MatMultAdd(): %g\n",(double)(err/nrm));CHKERRQ(ierr);}
+
+  /* changing the values refreshes the single precision copy */
+  ierr = MatScale(A,2.0);CHKERRQ(ierr);
+  ierr = MatScale(D,2.0);CHKERRQ(ierr);
+  ierr = MatMult(A,x,y);CHKERRQ(ierr);
+  ierr = MatMult(D,x,z);CHKERRQ(ierr);
+  ierr = VecNorm(z,NORM_2,&nrm);CHKERRQ(ierr);
+  ierr = VecAXPY(z,-1.0,y);CHKERRQ(ierr);
+  ierr = VecNorm(z,NORM_2,&err);CHKERRQ(ierr);
+  if (err > tol*nrm) {ierr = PetscPrintf(PETSC_COMM_WORLD,"Error in MatMult() after MatScale(): %g\n",(double)(err/nrm));CHKERRQ(ierr);}
+
+  /* the preconditioners use the single precision values, the Krylov method converges to the requested tolerance */
+  ierr = KSPCreate(PETSC_COMM_WORLD,&ksp);CHKERRQ(ierr);
+  ierr = KSPSetOperators(ksp,A,A);CHKERRQ(ierr);
+  ierr = KSPSetTolerances(ksp,1.e-5,PETSC_DEFAULT,PETSC_DEFAULT,PETSC_DEFAULT);CHKERRQ(ierr);
+  ierr = KSPSetFromOptions(ksp);CHKERRQ(ierr);
+  ierr = KSPSolve(ksp,b,x);CHKERRQ(ierr);
+  ierr = MatMult(D,x,z);CHKERRQ(ierr);
+  ierr = VecAXPY(z,-1.0,b);CHKERRQ(ierr);
+  ierr = VecNorm(z,NORM_2,&err);CHKERRQ(ierr);
+  ierr = VecNorm(b,NORM_2,&nrm);CHKERRQ(ierr);
+  if (err > 1.e-4*nrm) {ierr = PetscPrintf(PETSC_COMM_WORLD,"Residual of the solution too large: %g\n",(double)(err/nrm));CHKERRQ(ierr);}
+
+  ierr = KSPDestroy(&ksp);CHKERRQ(ierr);
+  ierr = PetscRandomDestroy(&rctx);CHKERRQ(ierr);
+  ierr = VecDestroy(&x);CHKERRQ(ierr);
+  ierr = VecDestroy(&y);CHKERRQ(ierr);
+  ierr = VecDestroy(&z);CHKERRQ(ierr);
+  ierr = VecDestroy(&b);CHKERRQ(ierr);
+  ierr = MatDestroy(&D);CHKERRQ(ierr);
+  ierr = MatDestroy(&A);CHKERRQ(ierr);
+  ierr = PetscFinalize();
+  return ierr;
+}
+
+/*TEST
+
+   testset:
+     requires: double !complex
+     args: -mat_aij_mixed_precision
+     output_file: output/ex253_1.out
+
+     test:
+       suffix: 1
+       args: -pc_type {{sor ilu}}
+
+     test:
+       suffix: lu
+       args: -ksp_type preonly -pc_type lu
+
+     test:
+       suffix: 2
+       nsize: 2
+       args: -pc_type bjacobi -sub_pc_type {{sor ilu}}
+
+TEST*/
@@ -0,0 +1,81 @@
+static char help[] = "Tests the compressed column indices of AIJ matrices in MatMult(), MatMultAdd(), MatMultTranspose() and MatMultTransposeAdd().\n\n";
+
+#include <petscmat.h>
+
+int main(int argc,char **args)
+{
+  Mat            A,B;
+  PetscInt       n = 100,i,col[3],rstart,rend;
+  PetscScalar    v[3];
+  PetscBool      far = PETSC_FALSE,flg;
+  PetscErrorCode ierr;
+
+  ierr = PetscInitialize(&argc,&args,(char*)0,help);if (ierr) return ierr;
+  ierr = PetscOptionsGetInt(NULL,NULL,"-n",&n,NULL);CHKERRQ(ierr);
+  ierr = PetscOptionsGetBool(NULL,NULL,"-far",&far,NULL);CHKERRQ(ierr);
+
+  /* a nonsymmetric tridiagonal matrix, with -far the first and last rows are coupled */
+  ierr = MatCreate(PETSC_COMM_WORLD,&A);CHKERRQ(ierr);
+  ierr = MatSetSizes(A,PETSC_DECIDE,PETSC_DECIDE,n,n);CHKERRQ(ierr);
+  ierr = MatSetFromOptions(A);CHKERRQ(ierr);
+  ierr = MatSeqAIJSetPreallocation(A,4,NULL);CHKERRQ(ierr);
+  ierr = MatMPIAIJSetPreallocation(A,4,NULL,2,NULL);CHKERRQ(ierr);
+  ierr = MatGetOwnershipRange(A,&rstart,&rend);CHKERRQ(ierr);
+  for (i=rstart; i<rend; i++) {
+    col[0] = i-1; col[1] = i; col[2] = i+1;
+    v[0]   = -1.0 - 0.1*i; v[1] = 4.0; v[2] = -2.0 + 0.01*i;
+    if (i == 0) {
+      ierr = MatSetValues(A,1,&i,2,col+1,v+1,INSERT_VALUES);CHKERRQ(ierr);
+    } else if (i == n-1) {
+      ierr = MatSetValues(A,1,&i,2,col,v,INSERT_VALUES);CHKERRQ(ierr);
+    } else {
+      ierr = MatSetValues(A,1,&i,3,col,v,INSERT_VALUES);CHKERRQ(ierr);
+    }
+    if (far && (i == 0 || i == n-1)) {
+      col[0] = n-1-i; v[0] = 0.5;
+      ierr = MatSetValues(A,1,&i,1,col,v,INSERT_VALUES);CHKERRQ(ierr);
+    }
+  }
+  ierr = MatAssemblyBegin(A,MAT_FINAL_ASSEMBLY);CHKERRQ(ierr);
+  ierr = MatAssemblyEnd(A,MAT_FINAL_ASSEMBLY);CHKERRQ(ierr);
+  ierr = MatViewFromOptions(A,NULL,"-A_view");CHKERRQ(ierr);
+
+  ierr = MatConvert(A,MATBAIJ,MAT_INITIAL_MATRIX,&B);CHKERRQ(ierr);
+  ierr = MatMultEqual(A,B,5,&flg);CHKERRQ(ierr);
+  if (!flg) {ierr = PetscPrintf(PETSC_COMM_WORLD,"Error in MatMult()\n");CHKERRQ(ierr);}
+  ierr = MatMultAddEqual(A,B,5,&flg);CHKERRQ(ierr);
+  if (!flg) {ierr = PetscPrintf(PETSC_COMM_WORLD,"Error in MatMultAdd()\n");CHKERRQ(ierr);}
+  ierr = MatMultTransposeEqual(A,B,5,&flg);CHKERRQ(ierr);
+  if (!flg) {ierr = PetscPrintf(PETSC_COMM_WORLD,"Error in MatMultTranspose()\n");CHKERRQ(ierr);}
+  ierr = MatMultTransposeAddEqual(A,B,5,&flg);CHKERRQ(ierr);
+  if (!flg) {ierr = PetscPrintf(PETSC_COMM_WORLD,"Error in MatMultTransposeAdd()\n");CHKERRQ(ierr);}
+
+  ierr = MatDestroy(&B);CHKERRQ(ierr);
+  ierr = MatDestroy(&A);CHKERRQ(ierr);
+  ierr = PetscFinalize();
+  return ierr;
+}
+
+/*TEST
+
+   testset:
+     args: -mat_type seqaij -mat_aij_compress_indices -A_view ::ascii_info
+
+     test:
+       suffix: 1
+
+     test:
+       suffix: 2
+       args: -n 1000 -far
+
+     test:
+       suffix: 3
+       args: -n 70000 -far
+
+   test:
+     suffix: mpi
+     nsize: 2
+     args: -mat_type mpiaij -mat_aij_compress_indices -n 1000 -far
+     output_file: output/ex254_mpi.out
+
+TEST*/
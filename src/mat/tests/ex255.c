@@ -0,0 +1,99 @@
+static char help[] = "Tests the assembly of AIJ matrices without preallocation through a hash table.\n\n";
+
+#include <petscmat.h>
+
+/* inserts the entries of an irregular pattern, each entry twice with half the value, into A and the dense B */
+static PetscErrorCode FillMatrices(Mat A,Mat B,PetscInt n,PetscInt pass)
+{
+  PetscErrorCode ierr;
+  PetscInt       i,k,row,cols[4];
+  PetscScalar    vals[4];
+
+  PetscFunctionBegin;
+  for (k=0; k<2; k++) {
+    for (i=n-1; i>=0; i--) {
+      row     = i;
+      cols[0] = i;
+      cols[1] = (7*i + 3) % n;
+      cols[2] = (i*i) % n;
+      cols[3] = (i % 5) ? -1 : (n - 1 - i/5); /* negative indices are ignored */
+      vals[0] = 0.5*(4.0 + pass);
+      vals[1] = 0.5*(-1.0 - 0.1*i);
+      vals[2] = 0.5*(0.25 + 0.01*i);
+      vals[3] = 0.5*(3.0 + pass);
+      ierr = MatSetValues(A,1,&row,4,cols,vals,ADD_VALUES);CHKERRQ(ierr);
+      ierr = MatSetValues(B,1,&row,4,cols,vals,ADD_VALUES);CHKERRQ(ierr);
+    }
+    ierr = MatAssemblyBegin(A,MAT_FLUSH_ASSEMBLY);CHKERRQ(ierr);
+    ierr = MatAssemblyEnd(A,MAT_FLUSH_ASSEMBLY);CHKERRQ(ierr);
+    ierr = MatAssemblyBegin(B,MAT_FLUSH_ASSEMBLY);CHKERRQ(ierr);
+    ierr = MatAssemblyEnd(B,MAT_FLUSH_ASSEMBLY);CHKERRQ(ierr);
+  }
+  /* overwrite a few entries */
+  for (i=0; i<n; i+=3) {
+    vals[0] = 10.0 + i + pass;
+    ierr = MatSetValues(A,1,&i,1,&i,vals,INSERT_VALUES);CHKERRQ(ierr);
+    ierr = MatSetValues(B,1,&i,1,&i,vals,INSERT_VALUES);CHKERRQ(ierr);
+  }
+  ierr = MatAssemblyBegin(A,MAT_FINAL_ASSEMBLY);CHKERRQ(ierr);
+  ierr = MatAssemblyEnd(A,MAT_FINAL_ASSEMBLY);CHKERRQ(ierr);
+  ierr = MatAssemblyBegin(B,MAT_FINAL_ASSEMBLY);CHKERRQ(ierr);
+  ierr = MatAssemblyEnd(B,MAT_FINAL_ASSEMBLY);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+int main(int argc,char **args)
+{
+  Mat            A,B,C;
+  PetscInt       n = 53,pass,row,col;
+  PetscScalar    v = 1.0;
+  PetscReal      nrm;
+  MatInfo        info;
+  PetscErrorCode ierr;
+
+  ierr = PetscInitialize(&argc,&args,(char*)0,help);if (ierr) return ierr;
+  ierr = PetscOptionsGetInt(NULL,NULL,"-n",&n,NULL);CHKERRQ(ierr);
+  ierr = MatCreate(PETSC_COMM_WORLD,&A);CHKERRQ(ierr);
+  ierr = MatSetSizes(A,PETSC_DECIDE,PETSC_DECIDE,n,n);CHKERRQ(ierr);
+  ierr = MatSetFromOptions(A);CHKERRQ(ierr);
+  ierr = MatSetUp(A);CHKERRQ(ierr);
+  ierr = MatCreateSeqDense(PETSC_COMM_WORLD,n,n,NULL,&B);CHKERRQ(ierr);
+
+  /* the second pass reuses the pattern of the first one, the third one adds a nonzero */
+  for (pass=0; pass<3; pass++) {
+    ierr = MatZeroEntries(A);CHKERRQ(ierr);
+    ierr = MatZeroEntries(B);CHKERRQ(ierr);
+    if (pass == 2) {
+      row  = n/2;
+      col  = n-2;
+      ierr = MatSetValues(A,1,&row,1,&col,&v,ADD_VALUES);CHKERRQ(ierr);
+      ierr = MatSetValues(B,1,&row,1,&col,&v,ADD_VALUES);CHKERRQ(ierr);
+    }
+    ierr = FillMatrices(A,B,n,pass);CHKERRQ(ierr);
+    ierr = MatGetInfo(A,MAT_LOCAL,&info);CHKERRQ(ierr);
+    ierr = PetscPrintf(PETSC_COMM_WORLD,"Pass %D: nonzeros %D, mallocs %D\n",pass,(PetscInt)info.nz_used,(PetscInt)info.mallocs);CHKERRQ(ierr);
+    ierr = MatConvert(A,MATDENSE,MAT_INITIAL_MATRIX,&C);CHKERRQ(ierr);
+    ierr = MatAXPY(C,-1.0,B,SAME_NONZERO_PATTERN);CHKERRQ(ierr);
+    ierr = MatNorm(C,NORM_FROBENIUS,&nrm);CHKERRQ(ierr);
+    if (nrm > 1.e-12) {ierr = PetscPrintf(PETSC_COMM_WORLD,"Pass %D: wrong entries, error %g\n",pass,(double)nrm);CHKERRQ(ierr);}
+    ierr = MatDestroy(&C);CHKERRQ(ierr);
+  }
+
+  ierr = MatDestroy(&B);CHKERRQ(ierr);
+  ierr = MatDestroy(&A);CHKERRQ(ierr);
+  ierr = PetscFinalize();
+  return ierr;
+}
+
+/*TEST
+
+   test:
+     suffix: 1
+     args: -mat_type seqaij -mat_aij_hash_assembly
+
+   test:
+     suffix: 2
+     args: -mat_type seqaij
+     output_file: output/ex255_1.out
+
+TEST*/
@@ -203,6 +203,17 @@ PetscErrorCode testPTAPRectangular(void)
       args: -matmatmult_via heap
       output_file: output/ex93_1.out
 
+   test:
+      suffix: hash
+      args: -matmatmult_via hash -matptap_via hash
+      output_file: output/ex93_1.out
+
+   test:
+      suffix: hash_omp
+      requires: openmp
+      args: -matmatmult_via hash -matptap_via hash -omp_num_threads 3
+      output_file: output/ex93_1.out
+
    #HYPRE PtAP is broken for complex numbers
    test:
       suffix: hypre
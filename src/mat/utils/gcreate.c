@@ -564,7 +564,9 @@ PetscErrorCode MatSetPreallocationCOO_Basic(Mat A,PetscInt ncoo,const PetscInt c
 
    Level: beginner
 
-   Notes: Entries can be repeated, see MatSetValuesCOO(). Currently optimized for cuSPARSE matrices only.
+   Notes: Entries can be repeated, see MatSetValuesCOO(). Rows owned by other processes are allowed for MATMPIAIJ;
+          the communication pattern needed to ship their values to the owners is computed here once and reused by MatSetValuesCOO().
+          Natively supported by MATSEQAIJ, MATMPIAIJ and the cuSPARSE matrix types; other types fall back to a slow MatSetValues() based implementation.
 
 .seealso: MatSetValuesCOO(), MatSeqAIJSetPreallocation(), MatMPIAIJSetPreallocation(), MatSeqBAIJSetPreallocation(), MatMPIBAIJSetPreallocation(), MatSeqSBAIJSetPreallocation(), MatMPISBAIJSetPreallocation()
 @*/
@@ -583,7 +585,7 @@ PetscErrorCode MatSetPreallocationCOO(Mat A,PetscInt ncoo,const PetscInt coo_i[]
   if (PetscDefined(USE_DEBUG)) {
     PetscInt i;
     for (i = 0; i < ncoo; i++) {
-      if (coo_i[i] < A->rmap->rstart || coo_i[i] >= A->rmap->rend) SETERRQ3(PETSC_COMM_SELF,PETSC_ERR_USER,"Invalid row index %D! Must be in [%D,%D)",coo_i[i],A->rmap->rstart,A->rmap->rend);
+      if (coo_i[i] < 0 || coo_i[i] >= A->rmap->N) SETERRQ2(PETSC_COMM_SELF,PETSC_ERR_USER,"Invalid row index %D! Must be in [0,%D)",coo_i[i],A->rmap->N);
       if (coo_j[i] < 0 || coo_j[i] >= A->cmap->N) SETERRQ2(PETSC_COMM_SELF,PETSC_ERR_USER,"Invalid col index %D! Must be in [0,%D)",coo_j[i],A->cmap->N);
     }
   }
@@ -613,7 +615,7 @@ PetscErrorCode MatSetPreallocationCOO(Mat A,PetscInt ncoo,const PetscInt coo_i[]
    Notes: The values must follow the order of the indices prescribed with MatSetPreallocationCOO().
           When repeated entries are specified in the COO indices the coo_v values are first properly summed.
           The imode flag indicates if coo_v must be added to the current values of the matrix (ADD_VALUES) or overwritten (INSERT_VALUES).
-          Currently optimized for cuSPARSE matrices only.
+          Natively supported by MATSEQAIJ, MATMPIAIJ and the cuSPARSE matrix types, for which this routine only gathers and sums coo_v[] into the matrix storage.
           Passing coo_v == NULL is equivalent to passing an array of zeros.
 
 .seealso: MatSetPreallocationCOO(), InsertMode, INSERT_VALUES, ADD_VALUES
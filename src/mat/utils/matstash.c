@@ -79,6 +79,8 @@ PetscErrorCode MatStashCreate_Private(MPI_Comm comm,PetscInt bs,MatStash *stash)
   stash->blocktype   = MPI_DATATYPE_NULL;
 
   ierr = PetscOptionsGetBool(NULL,NULL,"-matstash_reproduce",&stash->reproduce,NULL);CHKERRQ(ierr);
+  stash->persistent = PETSC_FALSE;
+  ierr = PetscOptionsGetBool(NULL,NULL,"-matstash_persistent",&stash->persistent,NULL);CHKERRQ(ierr);
 #if !defined(PETSC_HAVE_MPIUNI)
   flg  = PETSC_FALSE;
   ierr = PetscOptionsGetBool(NULL,NULL,"-matstash_legacy",&flg,NULL);CHKERRQ(ierr);
@@ -839,6 +841,49 @@ static PetscErrorCode MatStashBTSRecv_Private(MPI_Comm comm,const PetscMPIInt ta
   PetscFunctionReturn(0);
 }
 
+static PetscErrorCode MatStashBTSPlanDestroy_Private(MatStash *stash)
+{
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  stash->nsendranks = 0;
+  stash->nrecvranks = 0;
+  ierr = PetscFree4(stash->sendranks,stash->sendhdr,stash->sendframes,stash->sendcap);CHKERRQ(ierr);
+  ierr = PetscFree(stash->sendreqs);CHKERRQ(ierr);
+  ierr = PetscFree(stash->recvreqs);CHKERRQ(ierr);
+  ierr = PetscFree(stash->recvranks);CHKERRQ(ierr);
+  ierr = PetscFree(stash->recvhdr);CHKERRQ(ierr);
+  ierr = PetscFree2(stash->some_indices,stash->some_statuses);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+/*
+   With -matstash_persistent the communication pattern of the previous assembly is kept. It is reused, without
+   the rendezvous of PetscCommBuildTwoSidedFReq(), when on every rank the sorted blocks go to ranks of the
+   pattern and no more of them go to a rank than the pattern was built for; this costs one reduction
+*/
+static PetscErrorCode MatStashBTSPlanFits_Private(MatStash *stash,const PetscInt owners[],size_t nblocks,const char *sendblocks,PetscBool *fits)
+{
+  PetscErrorCode ierr;
+  PetscInt       i = 0,count;
+  size_t         b = 0;
+  PetscBool      lfits = PETSC_TRUE;
+
+  PetscFunctionBegin;
+  while (b<nblocks && lfits) {
+    const MatStashBlock *block = (const MatStashBlock*)&sendblocks[b*stash->blocktype_size];
+    while (i<stash->nsendranks && block->row >= owners[stash->sendranks[i]+1]) i++;
+    if (i == stash->nsendranks || block->row < owners[stash->sendranks[i]]) {lfits = PETSC_FALSE; break;}
+    for (count=0; b<nblocks; b++,count++) {
+      const MatStashBlock *block_b = (const MatStashBlock*)&sendblocks[b*stash->blocktype_size];
+      if (block_b->row >= owners[stash->sendranks[i]+1]) break;
+    }
+    if (count > stash->sendcap[i]) lfits = PETSC_FALSE;
+  }
+  ierr = MPIU_Allreduce(&lfits,fits,1,MPIU_BOOL,MPI_LAND,stash->comm);CHKERRMPI(ierr);
+  PetscFunctionReturn(0);
+}
+
 /*
  * owners[] contains the ownership ranges; may be indexed by either blocks or scalars
  */
@@ -859,6 +904,16 @@ static PetscErrorCode MatStashScatterBegin_BTS(Mat mat,MatStash *stash,PetscInt
   ierr = MatStashSortCompress_Private(stash,mat->insertmode);CHKERRQ(ierr);
   ierr = PetscSegBufferGetSize(stash->segsendblocks,&nblocks);CHKERRQ(ierr);
   ierr = PetscSegBufferExtractInPlace(stash->segsendblocks,&sendblocks);CHKERRQ(ierr);
+  if (stash->first_assembly_done && !mat->assembly_subset) { /* persistent pattern */
+    PetscBool fits;
+
+    ierr = MatStashBTSPlanFits_Private(stash,owners,nblocks,sendblocks,&fits);CHKERRQ(ierr);
+    if (!fits) {
+      ierr = PetscInfo(mat,"Off-process entries do not fit the stash communication pattern, building a new one\n");CHKERRQ(ierr);
+      ierr = MatStashBTSPlanDestroy_Private(stash);CHKERRQ(ierr);
+      stash->first_assembly_done = PETSC_FALSE;
+    }
+  }
   if (stash->first_assembly_done) { /* Set up sendhdrs and sendframes for each rank that we sent before */
     PetscInt i;
     size_t b;
@@ -891,7 +946,7 @@ static PetscErrorCode MatStashScatterBegin_BTS(Mat mat,MatStash *stash,PetscInt
       stash->nsendranks++;
       rowstart = i;
     }
-    ierr = PetscMalloc3(stash->nsendranks,&stash->sendranks,stash->nsendranks,&stash->sendhdr,stash->nsendranks,&stash->sendframes);CHKERRQ(ierr);
+    ierr = PetscMalloc4(stash->nsendranks,&stash->sendranks,stash->nsendranks,&stash->sendhdr,stash->nsendranks,&stash->sendframes,stash->nsendranks,&stash->sendcap);CHKERRQ(ierr);
 
     /* Set up sendhdrs and sendframes */
     sendno = 0;
@@ -908,6 +963,7 @@ static PetscErrorCode MatStashScatterBegin_BTS(Mat mat,MatStash *stash,PetscInt
       stash->sendframes[sendno].buffer = sendblock_rowstart;
       stash->sendframes[sendno].pending = 0;
       stash->sendhdr[sendno].count = i - rowstart;
+      stash->sendcap[sendno] = i - rowstart;
       sendno++;
       rowstart = i;
     }
@@ -948,7 +1004,7 @@ static PetscErrorCode MatStashScatterBegin_BTS(Mat mat,MatStash *stash,PetscInt
   stash->some_i               = 0;
   stash->some_count           = 0;
   stash->recvcount            = 0;
-  stash->first_assembly_done  = mat->assembly_subset; /* See the same logic in VecAssemblyBegin_MPI_BTS */
+  stash->first_assembly_done  = (PetscBool)(mat->assembly_subset || stash->persistent); /* See the same logic in VecAssemblyBegin_MPI_BTS */
   stash->insertmode           = &mat->insertmode;
   PetscFunctionReturn(0);
 }
@@ -957,6 +1013,7 @@ static PetscErrorCode MatStashScatterGetMesg_BTS(MatStash *stash,PetscMPIInt *n,
 {
   PetscErrorCode ierr;
   MatStashBlock *block;
+  PetscInt      i,nb,bs2 = stash->bs*stash->bs;
 
   PetscFunctionBegin;
   *flg = 0;
@@ -981,13 +1038,25 @@ static PetscErrorCode MatStashScatterGetMesg_BTS(MatStash *stash,PetscMPIInt *n,
     stash->recvcount++;
     stash->recvframe_i = 0;
   }
-  *n = 1;
-  block = (MatStashBlock*)&((char*)stash->recvframe_active->buffer)[stash->recvframe_i*stash->blocktype_size];
-  if (block->row < 0) block->row = -(block->row + 1);
-  *row = &block->row;
-  *col = &block->col;
-  *val = block->vals;
-  stash->recvframe_i++;
+  /* Unpack the rest of the frame, it is sorted by rows so that the caller inserts each row with a single call */
+  nb = stash->recvframe_count - stash->recvframe_i;
+  if (nb > stash->nrecvmax) {
+    ierr = PetscFree3(stash->recvrows,stash->recvcols,stash->recvvals);CHKERRQ(ierr);
+    stash->nrecvmax = PetscMax(nb,2*stash->nrecvmax);
+    ierr = PetscMalloc3(stash->nrecvmax,&stash->recvrows,stash->nrecvmax,&stash->recvcols,stash->nrecvmax*bs2,&stash->recvvals);CHKERRQ(ierr);
+  }
+  for (i=0; i<nb; i++) {
+    block = (MatStashBlock*)&((char*)stash->recvframe_active->buffer)[(stash->recvframe_i+i)*stash->blocktype_size];
+    stash->recvrows[i] = block->row < 0 ? -(block->row + 1) : block->row;
+    stash->recvcols[i] = block->col;
+    if (bs2 == 1) stash->recvvals[i] = block->vals[0];
+    else {ierr = PetscArraycpy(stash->recvvals+i*bs2,block->vals,bs2);CHKERRQ(ierr);}
+  }
+  ierr = PetscMPIIntCast(nb,n);CHKERRQ(ierr);
+  *row = stash->recvrows;
+  *col = stash->recvcols;
+  *val = stash->recvvals;
+  stash->recvframe_i += nb;
   *flg = 1;
   PetscFunctionReturn(0);
 }
@@ -1038,14 +1107,9 @@ PetscErrorCode MatStashScatterDestroy_BTS(MatStash *stash)
   if (stash->blocktype != MPI_DATATYPE_NULL) {
     ierr = MPI_Type_free(&stash->blocktype);CHKERRMPI(ierr);
   }
-  stash->nsendranks = 0;
-  stash->nrecvranks = 0;
-  ierr = PetscFree3(stash->sendranks,stash->sendhdr,stash->sendframes);CHKERRQ(ierr);
-  ierr = PetscFree(stash->sendreqs);CHKERRQ(ierr);
-  ierr = PetscFree(stash->recvreqs);CHKERRQ(ierr);
-  ierr = PetscFree(stash->recvranks);CHKERRQ(ierr);
-  ierr = PetscFree(stash->recvhdr);CHKERRQ(ierr);
-  ierr = PetscFree2(stash->some_indices,stash->some_statuses);CHKERRQ(ierr);
+  ierr = MatStashBTSPlanDestroy_Private(stash);CHKERRQ(ierr);
+  ierr = PetscFree3(stash->recvrows,stash->recvcols,stash->recvvals);CHKERRQ(ierr);
+  stash->nrecvmax = 0;
   PetscFunctionReturn(0);
 }
 #endif
@@ -32,10 +32,11 @@ int main(int argc,char **argv)
   Vec            x,r,F,U;                /* vectors */
   Mat            J;                      /* Jacobian matrix */
   PetscErrorCode ierr;
-  PetscInt       its,n = 5,i,maxit,maxf,lens[3] = {1,2,2};
+  PetscInt       its,n = 5,i,maxit,maxf,lens[3] = {1,2,2},lens2[3] = {2,2,1};
   PetscMPIInt    size;
   PetscScalar    h,xp,v,none = -1.0;
   PetscReal      abstol,rtol,stol,norm;
+  PetscBool      change = PETSC_FALSE;
   KSP            ksp;
   PC             pc;
 
@@ -43,6 +44,7 @@ int main(int argc,char **argv)
   ierr = MPI_Comm_size(PETSC_COMM_WORLD,&size);CHKERRMPI(ierr);
   if (size != 1) SETERRQ(PETSC_COMM_SELF,PETSC_ERR_SUP,"This is a uniprocessor example only!");
   ierr = PetscOptionsGetInt(NULL,NULL,"-n",&n,NULL);CHKERRQ(ierr);
+  ierr = PetscOptionsGetBool(NULL,NULL,"-change_blocks",&change,NULL);CHKERRQ(ierr);
   h    = 1.0/(n-1);
 
   /* - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
@@ -146,6 +148,17 @@ int main(int argc,char **argv)
   ierr = SNESGetIterationNumber(snes,&its);CHKERRQ(ierr);
   ierr = PetscPrintf(PETSC_COMM_WORLD,"number of SNES iterations = %D\n\n",its);CHKERRQ(ierr);
 
+  /*
+     Solve again with the same number of blocks and the same sizes in another order
+  */
+  if (change) {
+    ierr = MatSetVariableBlockSizes(J,3,lens2);CHKERRQ(ierr);
+    ierr = FormInitialGuess(x);CHKERRQ(ierr);
+    ierr = SNESSolve(snes,NULL,x);CHKERRQ(ierr);
+    ierr = SNESGetIterationNumber(snes,&its);CHKERRQ(ierr);
+    ierr = PetscPrintf(PETSC_COMM_WORLD,"number of SNES iterations = %D\n\n",its);CHKERRQ(ierr);
+  }
+
   /* - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -
      Check solution and clean up
    - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - */
@@ -320,4 +333,27 @@ PetscErrorCode FormJacobian(SNES snes,Vec x,Mat jac,Mat B,void *dummy)
       suffix: transpose_only
       args: -snes_monitor_short -snes_view -ksp_monitor -snes_type ksptransposeonly -pc_type ilu -snes_test_jacobian -snes_test_jacobian_view -ksp_view_rhs -ksp_view_solution -ksp_view_mat_explicit -ksp_view_preconditioned_operator_explicit
 
+   # each Newton step sets up PCVPBJACOBI again with the same blocks
+   testset:
+      args: -snes_monitor_short -ksp_monitor_short -pc_vpbjacobi_batched {{0 1}}
+      output_file: output/ex5_vpbjacobi.out
+
+      test:
+         suffix: vpbjacobi
+
+      test:
+         suffix: vpbjacobi_omp
+         requires: openmp
+         args: -omp_num_threads 3
+
+   # the second solve permutes the block sizes
+   test:
+      suffix: vpbjacobi_change
+      args: -snes_monitor_short -ksp_monitor_short -pc_vpbjacobi_batched {{0 1}shared output} -change_blocks
+
+   test:
+      suffix: vpbjacobi_mixed
+      requires: double !complex
+      args: -snes_monitor_short -ksp_monitor_short -pc_vpbjacobi_mixed_precision
+
 TEST*/
@@ -1152,4 +1152,46 @@ PetscErrorCode NonlinearGS(SNES snes, Vec X, Vec B, void *ctx)
       requires: hypre !single !complex !defined(PETSC_HAVE_HYPRE_MIXEDINT) !defined(PETSC_HAVE_HYPRE_DEVICE)
       args: -da_refine 2 -ksp_monitor -snes_monitor -snes_view -pc_type hypre -pc_hypre_type euclid -pc_hypre_euclid_droptolerance .1
 
+   testset:
+      args: -da_grid_x 10 -da_grid_y 10 -snes_converged_reason -ksp_converged_reason -pc_type sor -pc_sor_local_symmetric -pc_sor_multicolor -dm_mat_type aij
+      output_file: output/ex19_sor_multicolor_aij.out
+      test:
+         suffix: sor_multicolor_aij
+      test:
+         suffix: sor_multicolor_aij_omp
+         requires: openmp
+         args: -omp_num_threads 3
+
+   testset:
+      args: -da_grid_x 10 -da_grid_y 10 -snes_converged_reason -ksp_converged_reason -pc_type sor -pc_sor_local_symmetric -pc_sor_multicolor -dm_mat_type baij
+      output_file: output/ex19_sor_multicolor_baij.out
+      test:
+         suffix: sor_multicolor_baij
+      test:
+         suffix: sor_multicolor_baij_omp
+         requires: openmp
+         args: -omp_num_threads 3
+
+   testset:
+      nsize: 2
+      args: -da_grid_x 10 -da_grid_y 10 -snes_converged_reason -ksp_converged_reason -pc_type sor -pc_sor_local_symmetric -pc_sor_multicolor -dm_mat_type aij
+      output_file: output/ex19_sor_multicolor_aij_2.out
+      test:
+         suffix: sor_multicolor_aij_2
+      test:
+         suffix: sor_multicolor_aij_2_omp
+         requires: openmp
+         args: -omp_num_threads 3
+
+   testset:
+      nsize: 2
+      args: -da_grid_x 10 -da_grid_y 10 -snes_converged_reason -ksp_converged_reason -pc_type sor -pc_sor_local_symmetric -pc_sor_multicolor -dm_mat_type baij
+      output_file: output/ex19_sor_multicolor_baij_2.out
+      test:
+         suffix: sor_multicolor_baij_2
+      test:
+         suffix: sor_multicolor_baij_2_omp
+         requires: openmp
+         args: -omp_num_threads 3
+
 TEST*/
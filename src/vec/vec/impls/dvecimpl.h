@@ -50,6 +50,10 @@ PETSC_INTERN PetscErrorCode VecPointwiseMax_Seq(Vec,Vec,Vec);
 PETSC_INTERN PetscErrorCode VecPointwiseMaxAbs_Seq(Vec,Vec,Vec);
 PETSC_INTERN PetscErrorCode VecPointwiseMin_Seq(Vec,Vec,Vec);
 PETSC_INTERN PetscErrorCode VecPointwiseDivide_Seq(Vec,Vec,Vec);
+PETSC_INTERN PetscErrorCode VecAXPYNorm_Seq(Vec,PetscScalar,Vec,PetscReal*);
+PETSC_INTERN PetscErrorCode VecWAXPYNorm_Seq(Vec,PetscScalar,Vec,Vec,PetscReal*);
+PETSC_INTERN PetscErrorCode VecMAXPYNorm_Seq(Vec,PetscInt,const PetscScalar*,Vec*,PetscReal*);
+PETSC_INTERN PetscErrorCode VecMAXPYMDot_Seq(Vec,PetscInt,const PetscScalar*,Vec*,PetscScalar*);
 
 PETSC_EXTERN PetscErrorCode VecCreate_Seq(Vec);
 PETSC_INTERN PetscErrorCode VecCreate_Seq_Private(Vec,const PetscScalar[]);
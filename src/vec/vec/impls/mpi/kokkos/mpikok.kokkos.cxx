@@ -201,6 +201,10 @@ static PetscErrorCode VecSetOps_MPIKokkos(Vec v)
   v->ops->pointwisemult          = VecPointwiseMult_SeqKokkos;
   v->ops->setrandom              = VecSetRandom_SeqKokkos;
   v->ops->dotnorm2               = VecDotNorm2_MPIKokkos;
+  v->ops->axpynorm               = NULL;
+  v->ops->waxpynorm              = NULL;
+  v->ops->maxpynorm              = NULL;
+  v->ops->maxpymdot              = NULL;
   v->ops->waxpy                  = VecWAXPY_SeqKokkos;
   v->ops->norm                   = VecNorm_MPIKokkos;
   v->ops->min                    = VecMin_MPIKokkos;
@@ -419,6 +419,10 @@ PetscErrorCode VecBindToCPU_MPICUDA(Vec V,PetscBool pin)
     ierr = VecCUDACopyFromGPU(V);CHKERRQ(ierr);
     V->offloadmask = PETSC_OFFLOAD_CPU; /* since the CPU code will likely change values in the vector */
     V->ops->dotnorm2               = NULL;
+    V->ops->axpynorm               = VecAXPYNorm_MPI;
+    V->ops->waxpynorm              = VecWAXPYNorm_MPI;
+    V->ops->maxpynorm              = VecMAXPYNorm_MPI;
+    V->ops->maxpymdot              = VecMAXPYMDot_MPI;
     V->ops->waxpy                  = VecWAXPY_Seq;
     V->ops->dot                    = VecDot_MPI;
     V->ops->mdot                   = VecMDot_MPI;
@@ -458,6 +462,10 @@ PetscErrorCode VecBindToCPU_MPICUDA(Vec V,PetscBool pin)
     ierr = PetscStrallocpy(PETSCRANDER48,&V->defaultrandtype);CHKERRQ(ierr);
   } else {
     V->ops->dotnorm2               = VecDotNorm2_MPICUDA;
+    V->ops->axpynorm               = NULL;
+    V->ops->waxpynorm              = NULL;
+    V->ops->maxpynorm              = NULL;
+    V->ops->maxpymdot              = NULL;
     V->ops->waxpy                  = VecWAXPY_SeqCUDA;
     V->ops->duplicate              = VecDuplicate_MPICUDA;
     V->ops->dot                    = VecDot_MPICUDA;
@@ -419,6 +419,10 @@ PetscErrorCode VecBindToCPU_MPIHIP(Vec V,PetscBool pin)
     ierr = VecHIPCopyFromGPU(V);CHKERRQ(ierr);
     V->offloadmask = PETSC_OFFLOAD_CPU; /* since the CPU code will likely change values in the vector */
     V->ops->dotnorm2               = NULL;
+    V->ops->axpynorm               = VecAXPYNorm_MPI;
+    V->ops->waxpynorm              = VecWAXPYNorm_MPI;
+    V->ops->maxpynorm              = VecMAXPYNorm_MPI;
+    V->ops->maxpymdot              = VecMAXPYMDot_MPI;
     V->ops->waxpy                  = VecWAXPY_Seq;
     V->ops->dot                    = VecDot_MPI;
     V->ops->mdot                   = VecMDot_MPI;
@@ -455,6 +459,10 @@ PetscErrorCode VecBindToCPU_MPIHIP(Vec V,PetscBool pin)
     V->ops->shift                  = NULL;
   } else {
     V->ops->dotnorm2               = VecDotNorm2_MPIHIP;
+    V->ops->axpynorm               = NULL;
+    V->ops->waxpynorm              = NULL;
+    V->ops->maxpynorm              = NULL;
+    V->ops->maxpymdot              = NULL;
     V->ops->waxpy                  = VecWAXPY_SeqHIP;
     V->ops->duplicate              = VecDuplicate_MPIHIP;
     V->ops->dot                    = VecDot_MPIHIP;
@@ -182,6 +182,10 @@ PetscErrorCode VecBindToCPU_MPIViennaCL(Vec vv, PetscBool pin)
     ierr = VecViennaCLCopyFromGPU(vv);CHKERRQ(ierr);
     vv->offloadmask = PETSC_OFFLOAD_CPU; /* since the CPU code will likely change values in the vector */
     vv->ops->dotnorm2               = NULL;
+    vv->ops->axpynorm               = VecAXPYNorm_MPI;
+    vv->ops->waxpynorm              = VecWAXPYNorm_MPI;
+    vv->ops->maxpynorm              = VecMAXPYNorm_MPI;
+    vv->ops->maxpymdot              = VecMAXPYMDot_MPI;
     vv->ops->waxpy                  = VecWAXPY_Seq;
     vv->ops->dot                    = VecDot_MPI;
     vv->ops->mdot                   = VecMDot_MPI;
@@ -213,6 +217,10 @@ PetscErrorCode VecBindToCPU_MPIViennaCL(Vec vv, PetscBool pin)
     vv->ops->getarraywrite          = NULL;
   } else {
     vv->ops->dotnorm2        = VecDotNorm2_MPIViennaCL;
+    vv->ops->axpynorm        = NULL;
+    vv->ops->waxpynorm       = NULL;
+    vv->ops->maxpynorm       = NULL;
+    vv->ops->maxpymdot       = NULL;
     vv->ops->waxpy           = VecWAXPY_SeqViennaCL;
     vv->ops->duplicate       = VecDuplicate_MPIViennaCL;
     vv->ops->dot             = VecDot_MPIViennaCL;
@@ -4,6 +4,9 @@
  */
 #include <petscsys.h>
 #include <../src/vec/vec/impls/mpi/pvecimpl.h>   /*I  "petscvec.h"   I*/
+#if defined(PETSC_HAVE_OPENMP)
+#include <omp.h>
+#endif
 
 PetscErrorCode VecDot_MPI(Vec xin,Vec yin,PetscScalar *z)
 {
@@ -479,7 +482,23 @@ static struct _VecOps DvOps = { VecDuplicate_MPI, /* 1 */
                                 VecStrideSubSetScatter_Default,
                                 NULL,
                                 NULL,
-                                NULL
+                                NULL,
+                                NULL,
+                                NULL,
+                                NULL,
+                                NULL,
+                                NULL,
+                                NULL,
+                                NULL,
+                                NULL,
+                                NULL,
+                                NULL,
+                                NULL,
+                                NULL,
+                                VecAXPYNorm_MPI,
+                                VecWAXPYNorm_MPI,
+                                VecMAXPYNorm_MPI,
+                                VecMAXPYMDot_MPI
 };
 
 /*
@@ -509,7 +528,24 @@ PetscErrorCode VecCreate_MPI_Private(Vec v,PetscBool alloc,PetscInt nghost,const
   s->array_allocated = NULL;
   if (alloc && !array) {
     PetscInt n = v->map->n+nghost;
-    ierr               = PetscCalloc1(n,&s->array);CHKERRQ(ierr);
+#if defined(PETSC_HAVE_OPENMP)
+    if (VecOMPUseThreads(v->map->n)) { /* first touch with the static split of the threaded kernels */
+      PetscInt nlocal = v->map->n;
+
+      ierr = PetscMalloc1(n,&s->array);CHKERRQ(ierr);
+#pragma omp parallel num_threads((int)PetscNumOMPThreads)
+      {
+        PetscInt i,lo,hi;
+
+        VecOMPGetChunk(nlocal,omp_get_thread_num(),omp_get_num_threads(),lo,hi);
+        for (i=lo; i<hi; i++) s->array[i] = 0.0;
+      }
+      ierr = PetscArrayzero(s->array+nlocal,nghost);CHKERRQ(ierr);
+    } else
+#endif
+    {
+      ierr = PetscCalloc1(n,&s->array);CHKERRQ(ierr);
+    }
     ierr               = PetscLogObjectMemory((PetscObject)v,n*sizeof(PetscScalar));CHKERRQ(ierr);
     s->array_allocated = s->array;
   }
@@ -538,7 +574,9 @@ PetscErrorCode VecCreate_MPI_Private(Vec v,PetscBool alloc,PetscInt nghost,const
    VECMPI - VECMPI = "mpi" - The basic parallel vector
 
    Options Database Keys:
-. -vec_type mpi - sets the vector type to VECMPI during a call to VecSetFromOptions()
++ -vec_type mpi - sets the vector type to VECMPI during a call to VecSetFromOptions()
+. -vec_omp - use OpenMP threads (see -omp_num_threads) in VecSet(), VecAXPY(), VecMAXPY(), VecDot(), VecMDot(), VecNorm() and VecPointwiseMult()
+- -vec_omp_min_size <n> - only use the threads for vectors with at least n local entries (default 10000)
 
   Level: beginner
 
@@ -39,6 +39,63 @@ PetscErrorCode VecMTDot_MPI(Vec xin,PetscInt nv,const Vec y[],PetscScalar *z)
   PetscFunctionReturn(0);
 }
 
+/* the fused kernels do the local work with the sequential kernel and need a single reduction */
+PetscErrorCode VecAXPYNorm_MPI(Vec yin,PetscScalar alpha,Vec xin,PetscReal *z)
+{
+  PetscReal      work,sum;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  ierr = VecAXPYNorm_Seq(yin,alpha,xin,&work);CHKERRQ(ierr);
+  work = work*work;
+  ierr = MPIU_Allreduce(&work,&sum,1,MPIU_REAL,MPIU_SUM,PetscObjectComm((PetscObject)yin));CHKERRMPI(ierr);
+  *z   = PetscSqrtReal(sum);
+  PetscFunctionReturn(0);
+}
+
+PetscErrorCode VecWAXPYNorm_MPI(Vec win,PetscScalar alpha,Vec xin,Vec yin,PetscReal *z)
+{
+  PetscReal      work,sum;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  ierr = VecWAXPYNorm_Seq(win,alpha,xin,yin,&work);CHKERRQ(ierr);
+  work = work*work;
+  ierr = MPIU_Allreduce(&work,&sum,1,MPIU_REAL,MPIU_SUM,PetscObjectComm((PetscObject)win));CHKERRMPI(ierr);
+  *z   = PetscSqrtReal(sum);
+  PetscFunctionReturn(0);
+}
+
+PetscErrorCode VecMAXPYNorm_MPI(Vec yin,PetscInt nv,const PetscScalar *alpha,Vec *x,PetscReal *z)
+{
+  PetscReal      work,sum;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  ierr = VecMAXPYNorm_Seq(yin,nv,alpha,x,&work);CHKERRQ(ierr);
+  work = work*work;
+  ierr = MPIU_Allreduce(&work,&sum,1,MPIU_REAL,MPIU_SUM,PetscObjectComm((PetscObject)yin));CHKERRMPI(ierr);
+  *z   = PetscSqrtReal(sum);
+  PetscFunctionReturn(0);
+}
+
+PetscErrorCode VecMAXPYMDot_MPI(Vec yin,PetscInt nv,const PetscScalar *alpha,Vec *x,PetscScalar *z)
+{
+  PetscScalar    awork[128],*work = awork;
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  if (nv > 128) {
+    ierr = PetscMalloc1(nv,&work);CHKERRQ(ierr);
+  }
+  ierr = VecMAXPYMDot_Seq(yin,nv,alpha,x,work);CHKERRQ(ierr);
+  ierr = MPIU_Allreduce(work,z,nv,MPIU_SCALAR,MPIU_SUM,PetscObjectComm((PetscObject)yin));CHKERRMPI(ierr);
+  if (nv > 128) {
+    ierr = PetscFree(work);CHKERRQ(ierr);
+  }
+  PetscFunctionReturn(0);
+}
+
 #include <../src/vec/vec/impls/seq/ftn-kernels/fnorm.h>
 PetscErrorCode VecNorm_MPI(Vec xin,NormType type,PetscReal *z)
 {
@@ -51,12 +108,20 @@ PetscErrorCode VecNorm_MPI(Vec xin,NormType type,PetscReal *z)
   PetscFunctionBegin;
   ierr = PetscBLASIntCast(n,&bn);CHKERRQ(ierr);
   if (type == NORM_2 || type == NORM_FROBENIUS) {
-    ierr = VecGetArrayRead(xin,&xx);CHKERRQ(ierr);
-    work = PetscRealPart(BLASdot_(&bn,xx,&one,xx,&one));
-    ierr = VecRestoreArrayRead(xin,&xx);CHKERRQ(ierr);
+#if defined(PETSC_HAVE_OPENMP)
+    if (VecOMPUseThreads(n)) {
+      ierr = VecNorm_Seq(xin,NORM_2,&work);CHKERRQ(ierr);
+      work = work*work;
+    } else
+#endif
+    {
+      ierr = VecGetArrayRead(xin,&xx);CHKERRQ(ierr);
+      work = PetscRealPart(BLASdot_(&bn,xx,&one,xx,&one));
+      ierr = VecRestoreArrayRead(xin,&xx);CHKERRQ(ierr);
+      ierr = PetscLogFlops(2.0*xin->map->n);CHKERRQ(ierr);
+    }
     ierr = MPIU_Allreduce(&work,&sum,1,MPIU_REAL,MPIU_SUM,PetscObjectComm((PetscObject)xin));CHKERRMPI(ierr);
     *z   = PetscSqrtReal(sum);
-    ierr = PetscLogFlops(2.0*xin->map->n);CHKERRQ(ierr);
   } else if (type == NORM_1) {
     /* Find the local part */
     ierr = VecNorm_Seq(xin,NORM_1,&work);CHKERRQ(ierr);
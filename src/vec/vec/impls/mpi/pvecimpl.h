@@ -49,6 +49,10 @@ PETSC_INTERN PetscErrorCode VecMDot_MPI(Vec,PetscInt,const Vec[],PetscScalar*);
 PETSC_INTERN PetscErrorCode VecTDot_MPI(Vec,Vec,PetscScalar*);
 PETSC_INTERN PetscErrorCode VecMTDot_MPI(Vec,PetscInt,const Vec[],PetscScalar*);
 PETSC_INTERN PetscErrorCode VecNorm_MPI(Vec,NormType,PetscReal*);
+PETSC_INTERN PetscErrorCode VecAXPYNorm_MPI(Vec,PetscScalar,Vec,PetscReal*);
+PETSC_INTERN PetscErrorCode VecWAXPYNorm_MPI(Vec,PetscScalar,Vec,Vec,PetscReal*);
+PETSC_INTERN PetscErrorCode VecMAXPYNorm_MPI(Vec,PetscInt,const PetscScalar*,Vec*,PetscReal*);
+PETSC_INTERN PetscErrorCode VecMAXPYMDot_MPI(Vec,PetscInt,const PetscScalar*,Vec*,PetscScalar*);
 PETSC_INTERN PetscErrorCode VecMax_MPI(Vec,PetscInt*,PetscReal*);
 PETSC_INTERN PetscErrorCode VecMin_MPI(Vec,PetscInt*,PetscReal*);
 PETSC_INTERN PetscErrorCode VecDestroy_MPI(Vec);
@@ -6,6 +6,9 @@
 
 #include <../src/vec/vec/impls/dvecimpl.h>          /*I "petscvec.h" I*/
 #include <petscblaslapack.h>
+#if defined(PETSC_HAVE_OPENMP)
+#include <omp.h>
+#endif
 
 PetscErrorCode VecDot_Seq(Vec xin,Vec yin,PetscScalar *z)
 {
@@ -17,6 +20,26 @@ PetscErrorCode VecDot_Seq(Vec xin,Vec yin,PetscScalar *z)
   ierr = PetscBLASIntCast(xin->map->n,&bn);CHKERRQ(ierr);
   ierr = VecGetArrayRead(xin,&xa);CHKERRQ(ierr);
   ierr = VecGetArrayRead(yin,&ya);CHKERRQ(ierr);
+#if defined(PETSC_HAVE_OPENMP)
+  if (VecOMPUseThreads(xin->map->n)) {
+    PetscInt    n = xin->map->n,nt = PetscNumOMPThreads,t;
+    PetscScalar *part;
+
+    /* partial sums are added in thread order so the result does not depend on the scheduling */
+    ierr = PetscCalloc1(nt,&part);CHKERRQ(ierr);
+#pragma omp parallel num_threads((int)nt)
+    {
+      PetscInt    i,lo,hi;
+      PetscScalar sum = 0.0;
+
+      VecOMPGetChunk(n,omp_get_thread_num(),omp_get_num_threads(),lo,hi);
+      for (i=lo; i<hi; i++) sum += xa[i]*PetscConj(ya[i]);
+      part[omp_get_thread_num()] = sum;
+    }
+    for (*z=0.0,t=0; t<nt; t++) *z += part[t];
+    ierr = PetscFree(part);CHKERRQ(ierr);
+  } else
+#endif
   /* arguments ya, xa are reversed because BLAS complex conjugates the first argument, PETSc the second */
   PetscStackCallBLAS("BLASdot",*z   = BLASdot_(&bn,ya,&one,xa,&one));
   ierr = VecRestoreArrayRead(xin,&xa);CHKERRQ(ierr);
@@ -78,6 +101,19 @@ PetscErrorCode VecAXPY_Seq(Vec yin,PetscScalar alpha,Vec xin)
   if (alpha != (PetscScalar)0.0) {
     ierr = VecGetArrayRead(xin,&xarray);CHKERRQ(ierr);
     ierr = VecGetArray(yin,&yarray);CHKERRQ(ierr);
+#if defined(PETSC_HAVE_OPENMP)
+    if (VecOMPUseThreads(yin->map->n)) {
+      PetscInt n = yin->map->n;
+
+#pragma omp parallel num_threads((int)PetscNumOMPThreads)
+      {
+        PetscInt i,lo,hi;
+
+        VecOMPGetChunk(n,omp_get_thread_num(),omp_get_num_threads(),lo,hi);
+        for (i=lo; i<hi; i++) yarray[i] += alpha*xarray[i];
+      }
+    } else
+#endif
     PetscStackCallBLAS("BLASaxpy",BLASaxpy_(&bn,&alpha,xarray,&one,yarray,&one));
     ierr = VecRestoreArrayRead(xin,&xarray);CHKERRQ(ierr);
     ierr = VecRestoreArray(yin,&yarray);CHKERRQ(ierr);
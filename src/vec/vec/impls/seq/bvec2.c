@@ -8,6 +8,9 @@
 #include <petsc/private/glvisviewerimpl.h>
 #include <petsc/private/glvisvecimpl.h>
 #include <petscblaslapack.h>
+#if defined(PETSC_HAVE_OPENMP)
+#include <omp.h>
+#endif
 
 #if defined(PETSC_HAVE_HDF5)
 extern PetscErrorCode VecView_MPI_HDF5(Vec,PetscViewer);
@@ -85,6 +88,17 @@ PetscErrorCode VecPointwiseMult_Seq(Vec win,Vec xin,Vec yin)
   ierr = VecGetArrayRead(xin,(const PetscScalar**)&xx);CHKERRQ(ierr);
   ierr = VecGetArrayRead(yin,(const PetscScalar**)&yy);CHKERRQ(ierr);
   ierr = VecGetArray(win,&ww);CHKERRQ(ierr);
+#if defined(PETSC_HAVE_OPENMP)
+  if (VecOMPUseThreads(n)) {
+#pragma omp parallel num_threads((int)PetscNumOMPThreads)
+    {
+      PetscInt j,lo,hi;
+
+      VecOMPGetChunk(n,omp_get_thread_num(),omp_get_num_threads(),lo,hi);
+      for (j=lo; j<hi; j++) ww[j] = xx[j]*yy[j];
+    }
+  } else
+#endif
   if (ww == xx) {
     for (i=0; i<n; i++) ww[i] *= yy[i];
   } else if (ww == yy) {
@@ -209,6 +223,61 @@ PetscErrorCode VecSwap_Seq(Vec xin,Vec yin)
 
 #include <../src/vec/vec/impls/seq/ftn-kernels/fnorm.h>
 
+#if defined(PETSC_HAVE_OPENMP)
+/*
+   Each thread reduces its static chunk; the partial results are combined in thread order
+   so the norm does not depend on the scheduling
+*/
+static PetscErrorCode VecNorm_Seq_OMP(Vec xin,NormType type,PetscReal *z)
+{
+  const PetscScalar *xx;
+  PetscErrorCode    ierr;
+  PetscInt          n = xin->map->n,nt = PetscNumOMPThreads,t;
+  PetscReal         *part;
+
+  PetscFunctionBegin;
+  ierr = PetscCalloc1(nt,&part);CHKERRQ(ierr);
+  ierr = VecGetArrayRead(xin,&xx);CHKERRQ(ierr);
+#pragma omp parallel num_threads((int)nt)
+  {
+    PetscInt  i,lo,hi;
+    PetscReal sum = 0.0,tmp;
+
+    VecOMPGetChunk(n,omp_get_thread_num(),omp_get_num_threads(),lo,hi);
+    if (type == NORM_INFINITY) {
+      for (i=lo; i<hi; i++) {
+        if ((tmp = PetscAbsScalar(xx[i])) > sum) sum = tmp;
+        /* check special case of tmp == NaN */
+        if (tmp != tmp) {sum = tmp; break;}
+      }
+    } else if (type == NORM_1) {
+      for (i=lo; i<hi; i++) sum += PetscAbsScalar(xx[i]);
+    } else {
+      for (i=lo; i<hi; i++) sum += PetscRealPart(xx[i]*PetscConj(xx[i]));
+    }
+    part[omp_get_thread_num()] = sum;
+  }
+  ierr = VecRestoreArrayRead(xin,&xx);CHKERRQ(ierr);
+  *z = 0.0;
+  if (type == NORM_INFINITY) {
+    for (t=0; t<nt; t++) {
+      if (part[t] > *z) *z = part[t];
+      if (part[t] != part[t]) {*z = part[t]; break;}
+    }
+  } else {
+    for (t=0; t<nt; t++) *z += part[t];
+  }
+  if (type == NORM_2 || type == NORM_FROBENIUS) {
+    *z   = PetscSqrtReal(*z);
+    ierr = PetscLogFlops(PetscMax(2.0*n-1,0.0));CHKERRQ(ierr);
+  } else if (type == NORM_1) {
+    ierr = PetscLogFlops(PetscMax(n-1.0,0.0));CHKERRQ(ierr);
+  }
+  ierr = PetscFree(part);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+#endif
+
 PetscErrorCode VecNorm_Seq(Vec xin,NormType type,PetscReal *z)
 {
   const PetscScalar *xx;
@@ -217,6 +286,12 @@ PetscErrorCode VecNorm_Seq(Vec xin,NormType type,PetscReal *z)
   PetscBLASInt      one = 1, bn = 0;
 
   PetscFunctionBegin;
+#if defined(PETSC_HAVE_OPENMP)
+  if (type != NORM_1_AND_2 && VecOMPUseThreads(n)) {
+    ierr = VecNorm_Seq_OMP(xin,type,z);CHKERRQ(ierr);
+    PetscFunctionReturn(0);
+  }
+#endif
   ierr = PetscBLASIntCast(n,&bn);CHKERRQ(ierr);
   if (type == NORM_2 || type == NORM_FROBENIUS) {
     ierr = VecGetArrayRead(xin,&xx);CHKERRQ(ierr);
@@ -810,7 +885,23 @@ static struct _VecOps DvOps = {VecDuplicate_Seq, /* 1 */
                                VecStrideSubSetScatter_Default,
                                NULL,
                                NULL,
-                               NULL
+                               NULL,
+                               NULL,
+                               NULL,
+                               NULL,
+                               NULL,
+                               NULL,
+                               NULL,
+                               NULL,
+                               NULL,
+                               NULL,
+                               NULL,
+                               NULL,
+                               NULL,
+                               VecAXPYNorm_Seq,
+                               VecWAXPYNorm_Seq,
+                               VecMAXPYNorm_Seq,
+                               VecMAXPYMDot_Seq
 };
 
 /*
@@ -8,7 +8,9 @@
    VECSEQ - VECSEQ = "seq" - The basic sequential vector
 
    Options Database Keys:
-. -vec_type seq - sets the vector type to VECSEQ during a call to VecSetFromOptions()
++ -vec_type seq - sets the vector type to VECSEQ during a call to VecSetFromOptions()
+. -vec_omp - use OpenMP threads (see -omp_num_threads) in VecSet(), VecAXPY(), VecMAXPY(), VecDot(), VecMDot(), VecNorm() and VecPointwiseMult()
+- -vec_omp_min_size <n> - only use the threads for vectors with at least n local entries (default 10000)
 
   Level: beginner
 
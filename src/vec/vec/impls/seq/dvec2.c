@@ -5,6 +5,98 @@
 */
 #include <../src/vec/vec/impls/dvecimpl.h>
 #include <petsc/private/kernels/petscaxpy.h>
+#if defined(PETSC_HAVE_OPENMP)
+#include <omp.h>
+
+/*
+   Each thread computes the nv partial dot products over its static chunk; the partial results
+   are then added in thread order so z does not depend on the scheduling
+*/
+static PetscErrorCode VecMDot_Seq_OMP(Vec xin,PetscInt nv,const Vec yin[],PetscScalar *z)
+{
+  PetscErrorCode    ierr;
+  PetscInt          n = xin->map->n,nt = PetscNumOMPThreads,j,t;
+  const PetscScalar *x,**y;
+  PetscScalar       *part;
+
+  PetscFunctionBegin;
+  ierr = PetscMalloc2(nv,&y,nt*nv,&part);CHKERRQ(ierr);
+  ierr = PetscArrayzero(part,nt*nv);CHKERRQ(ierr);
+  ierr = VecGetArrayRead(xin,&x);CHKERRQ(ierr);
+  for (j=0; j<nv; j++) {ierr = VecGetArrayRead(yin[j],&y[j]);CHKERRQ(ierr);}
+#pragma omp parallel num_threads((int)nt)
+  {
+    PetscInt          i,k,lo,hi;
+    PetscScalar       *zt = part + omp_get_thread_num()*nv,sum0,sum1,sum2,sum3,xi;
+    const PetscScalar *yy0,*yy1,*yy2,*yy3;
+
+    VecOMPGetChunk(n,omp_get_thread_num(),omp_get_num_threads(),lo,hi);
+    for (k=0; k+3<nv; k+=4) {
+      yy0  = y[k]; yy1 = y[k+1]; yy2 = y[k+2]; yy3 = y[k+3];
+      sum0 = sum1 = sum2 = sum3 = 0.0;
+      for (i=lo; i<hi; i++) {
+        xi    = x[i];
+        sum0 += xi*PetscConj(yy0[i]);
+        sum1 += xi*PetscConj(yy1[i]);
+        sum2 += xi*PetscConj(yy2[i]);
+        sum3 += xi*PetscConj(yy3[i]);
+      }
+      zt[k] = sum0; zt[k+1] = sum1; zt[k+2] = sum2; zt[k+3] = sum3;
+    }
+    for (; k<nv; k++) {
+      yy0  = y[k];
+      sum0 = 0.0;
+      for (i=lo; i<hi; i++) sum0 += x[i]*PetscConj(yy0[i]);
+      zt[k] = sum0;
+    }
+  }
+  for (j=0; j<nv; j++) {ierr = VecRestoreArrayRead(yin[j],&y[j]);CHKERRQ(ierr);}
+  ierr = VecRestoreArrayRead(xin,&x);CHKERRQ(ierr);
+  for (j=0; j<nv; j++) {
+    z[j] = 0.0;
+    for (t=0; t<nt; t++) z[j] += part[t*nv+j];
+  }
+  ierr = PetscFree2(y,part);CHKERRQ(ierr);
+  ierr = PetscLogFlops(PetscMax(nv*(2.0*n-1),0.0));CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+static PetscErrorCode VecMAXPY_Seq_OMP(Vec xin,PetscInt nv,const PetscScalar *alpha,Vec *yin)
+{
+  PetscErrorCode    ierr;
+  PetscInt          n = xin->map->n,j;
+  const PetscScalar **y;
+  PetscScalar       *xx;
+
+  PetscFunctionBegin;
+  ierr = PetscMalloc1(nv,&y);CHKERRQ(ierr);
+  ierr = VecGetArray(xin,&xx);CHKERRQ(ierr);
+  for (j=0; j<nv; j++) {ierr = VecGetArrayRead(yin[j],&y[j]);CHKERRQ(ierr);}
+#pragma omp parallel num_threads((int)PetscNumOMPThreads)
+  {
+    PetscInt          i,k,lo,hi;
+    PetscScalar       alpha0,alpha1,alpha2,alpha3;
+    const PetscScalar *yy0,*yy1,*yy2,*yy3;
+
+    VecOMPGetChunk(n,omp_get_thread_num(),omp_get_num_threads(),lo,hi);
+    for (k=0; k+3<nv; k+=4) {
+      yy0    = y[k]; yy1 = y[k+1]; yy2 = y[k+2]; yy3 = y[k+3];
+      alpha0 = alpha[k]; alpha1 = alpha[k+1]; alpha2 = alpha[k+2]; alpha3 = alpha[k+3];
+      for (i=lo; i<hi; i++) xx[i] += alpha0*yy0[i] + alpha1*yy1[i] + alpha2*yy2[i] + alpha3*yy3[i];
+    }
+    for (; k<nv; k++) {
+      yy0    = y[k];
+      alpha0 = alpha[k];
+      for (i=lo; i<hi; i++) xx[i] += alpha0*yy0[i];
+    }
+  }
+  for (j=0; j<nv; j++) {ierr = VecRestoreArrayRead(yin[j],&y[j]);CHKERRQ(ierr);}
+  ierr = VecRestoreArray(xin,&xx);CHKERRQ(ierr);
+  ierr = PetscFree(y);CHKERRQ(ierr);
+  ierr = PetscLogFlops(nv*2.0*n);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+#endif
 
 #if defined(PETSC_USE_FORTRAN_KERNEL_MDOT)
 #include <../src/vec/vec/impls/seq/ftn-kernels/fmdot.h>
@@ -17,6 +109,12 @@ PetscErrorCode VecMDot_Seq(Vec xin,PetscInt nv,const Vec yin[],PetscScalar *z)
   Vec               *yy;
 
   PetscFunctionBegin;
+#if defined(PETSC_HAVE_OPENMP)
+  if (VecOMPUseThreads(n)) {
+    ierr = VecMDot_Seq_OMP(xin,nv,yin,z);CHKERRQ(ierr);
+    PetscFunctionReturn(0);
+  }
+#endif
   sum0 = 0.0;
   sum1 = 0.0;
   sum2 = 0.0;
@@ -98,6 +196,12 @@ PetscErrorCode VecMDot_Seq(Vec xin,PetscInt nv,const Vec yin[],PetscScalar *z)
   Vec               *yy;
 
   PetscFunctionBegin;
+#if defined(PETSC_HAVE_OPENMP)
+  if (VecOMPUseThreads(n)) {
+    ierr = VecMDot_Seq_OMP(xin,nv,yin,z);CHKERRQ(ierr);
+    PetscFunctionReturn(0);
+  }
+#endif
   sum0 = 0.;
   sum1 = 0.;
   sum2 = 0.;
@@ -541,6 +645,17 @@ PetscErrorCode VecSet_Seq(Vec xin,PetscScalar alpha)
 
   PetscFunctionBegin;
   ierr = VecGetArrayWrite(xin,&xx);CHKERRQ(ierr);
+#if defined(PETSC_HAVE_OPENMP)
+  if (VecOMPUseThreads(n)) {
+#pragma omp parallel num_threads((int)PetscNumOMPThreads)
+    {
+      PetscInt j,lo,hi;
+
+      VecOMPGetChunk(n,omp_get_thread_num(),omp_get_num_threads(),lo,hi);
+      for (j=lo; j<hi; j++) xx[j] = alpha;
+    }
+  } else
+#endif
   if (alpha == (PetscScalar)0.0) {
     ierr = PetscArrayzero(xx,n);CHKERRQ(ierr);
   } else {
@@ -562,6 +677,12 @@ PetscErrorCode VecMAXPY_Seq(Vec xin, PetscInt nv,const PetscScalar *alpha,Vec *y
 #endif
 
   PetscFunctionBegin;
+#if defined(PETSC_HAVE_OPENMP)
+  if (VecOMPUseThreads(n)) {
+    ierr = VecMAXPY_Seq_OMP(xin,nv,alpha,y);CHKERRQ(ierr);
+    PetscFunctionReturn(0);
+  }
+#endif
   ierr = PetscLogFlops(nv*2.0*n);CHKERRQ(ierr);
   ierr = VecGetArray(xin,&xx);CHKERRQ(ierr);
   switch (j_rem=nv&0x3) {
@@ -708,6 +829,249 @@ PetscErrorCode VecWAXPY_Seq(Vec win, PetscScalar alpha,Vec xin,Vec yin)
   PetscFunctionReturn(0);
 }
 
+/*
+   Fused kernels for the Krylov inner loops. Each works on the index range [lo,hi) so the same code serves the
+   serial path and the OpenMP path; the MAXPY based kernels walk the range in tiles so the second sweep (the norm
+   or the dot products) reads y while it is still in cache.
+*/
+#define VEC_FUSED_TILE 512
+
+static void VecAXPYNormKernel_Private(PetscScalar *yy,PetscScalar alpha,const PetscScalar *xx,PetscInt lo,PetscInt hi,PetscReal *sum)
+{
+  PetscInt  i;
+  PetscReal s = 0.0;
+
+  for (i=lo; i<hi; i++) {
+    yy[i] += alpha*xx[i];
+    s     += PetscRealPart(yy[i]*PetscConj(yy[i]));
+  }
+  *sum = s;
+}
+
+static void VecWAXPYNormKernel_Private(PetscScalar *ww,PetscScalar alpha,const PetscScalar *xx,const PetscScalar *yy,PetscInt lo,PetscInt hi,PetscReal *sum)
+{
+  PetscInt  i;
+  PetscReal s = 0.0;
+
+  for (i=lo; i<hi; i++) {
+    ww[i] = yy[i] + alpha*xx[i];
+    s    += PetscRealPart(ww[i]*PetscConj(ww[i]));
+  }
+  *sum = s;
+}
+
+static void VecMAXPYTile_Private(PetscScalar *yy,PetscInt nv,const PetscScalar *alpha,const PetscScalar **x,PetscInt lo,PetscInt hi)
+{
+  PetscInt          i,k;
+  PetscScalar       alpha0,alpha1,alpha2,alpha3;
+  const PetscScalar *xx0,*xx1,*xx2,*xx3;
+
+  for (k=0; k+3<nv; k+=4) {
+    xx0    = x[k]; xx1 = x[k+1]; xx2 = x[k+2]; xx3 = x[k+3];
+    alpha0 = alpha[k]; alpha1 = alpha[k+1]; alpha2 = alpha[k+2]; alpha3 = alpha[k+3];
+    for (i=lo; i<hi; i++) yy[i] += alpha0*xx0[i] + alpha1*xx1[i] + alpha2*xx2[i] + alpha3*xx3[i];
+  }
+  for (; k<nv; k++) {
+    xx0    = x[k];
+    alpha0 = alpha[k];
+    for (i=lo; i<hi; i++) yy[i] += alpha0*xx0[i];
+  }
+}
+
+static void VecMAXPYNormKernel_Private(PetscScalar *yy,PetscInt nv,const PetscScalar *alpha,const PetscScalar **x,PetscInt lo,PetscInt hi,PetscReal *sum)
+{
+  PetscInt  i,tlo,thi;
+  PetscReal s = 0.0;
+
+  for (tlo=lo; tlo<hi; tlo=thi) {
+    thi = PetscMin(tlo+VEC_FUSED_TILE,hi);
+    VecMAXPYTile_Private(yy,nv,alpha,x,tlo,thi);
+    for (i=tlo; i<thi; i++) s += PetscRealPart(yy[i]*PetscConj(yy[i]));
+  }
+  *sum = s;
+}
+
+/* z must hold nv entries and is accumulated into */
+static void VecMAXPYMDotKernel_Private(PetscScalar *yy,PetscInt nv,const PetscScalar *alpha,const PetscScalar **x,PetscInt lo,PetscInt hi,PetscScalar *z)
+{
+  PetscInt          i,k,tlo,thi;
+  PetscScalar       sum0,sum1,sum2,sum3;
+  const PetscScalar *xx0,*xx1,*xx2,*xx3;
+
+  for (tlo=lo; tlo<hi; tlo=thi) {
+    thi = PetscMin(tlo+VEC_FUSED_TILE,hi);
+    VecMAXPYTile_Private(yy,nv,alpha,x,tlo,thi);
+    for (k=0; k+3<nv; k+=4) {
+      xx0  = x[k]; xx1 = x[k+1]; xx2 = x[k+2]; xx3 = x[k+3];
+      sum0 = sum1 = sum2 = sum3 = 0.0;
+      for (i=tlo; i<thi; i++) {
+        sum0 += yy[i]*PetscConj(xx0[i]);
+        sum1 += yy[i]*PetscConj(xx1[i]);
+        sum2 += yy[i]*PetscConj(xx2[i]);
+        sum3 += yy[i]*PetscConj(xx3[i]);
+      }
+      z[k] += sum0; z[k+1] += sum1; z[k+2] += sum2; z[k+3] += sum3;
+    }
+    for (; k<nv; k++) {
+      xx0  = x[k];
+      sum0 = 0.0;
+      for (i=tlo; i<thi; i++) sum0 += yy[i]*PetscConj(xx0[i]);
+      z[k] += sum0;
+    }
+  }
+}
+
+PetscErrorCode VecAXPYNorm_Seq(Vec yin,PetscScalar alpha,Vec xin,PetscReal *nrm)
+{
+  PetscErrorCode    ierr;
+  PetscInt          n = yin->map->n;
+  PetscScalar       *yy;
+  const PetscScalar *xx;
+  PetscReal         sum;
+
+  PetscFunctionBegin;
+  ierr = VecGetArrayRead(xin,&xx);CHKERRQ(ierr);
+  ierr = VecGetArray(yin,&yy);CHKERRQ(ierr);
+#if defined(PETSC_HAVE_OPENMP)
+  if (VecOMPUseThreads(n)) {
+    PetscInt  nt = PetscNumOMPThreads,t;
+    PetscReal *part;
+
+    ierr = PetscCalloc1(nt,&part);CHKERRQ(ierr);
+#pragma omp parallel num_threads((int)nt)
+    {
+      PetscInt lo,hi;
+
+      VecOMPGetChunk(n,omp_get_thread_num(),omp_get_num_threads(),lo,hi);
+      VecAXPYNormKernel_Private(yy,alpha,xx,lo,hi,&part[omp_get_thread_num()]);
+    }
+    for (t=0,sum=0.0; t<nt; t++) sum += part[t];
+    ierr = PetscFree(part);CHKERRQ(ierr);
+  } else
+#endif
+  VecAXPYNormKernel_Private(yy,alpha,xx,0,n,&sum);
+  ierr = VecRestoreArray(yin,&yy);CHKERRQ(ierr);
+  ierr = VecRestoreArrayRead(xin,&xx);CHKERRQ(ierr);
+  *nrm = PetscSqrtReal(sum);
+  ierr = PetscLogFlops(4.0*n);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+PetscErrorCode VecWAXPYNorm_Seq(Vec win,PetscScalar alpha,Vec xin,Vec yin,PetscReal *nrm)
+{
+  PetscErrorCode    ierr;
+  PetscInt          n = win->map->n;
+  PetscScalar       *ww;
+  const PetscScalar *xx,*yy;
+  PetscReal         sum;
+
+  PetscFunctionBegin;
+  ierr = VecGetArrayRead(xin,&xx);CHKERRQ(ierr);
+  ierr = VecGetArrayRead(yin,&yy);CHKERRQ(ierr);
+  ierr = VecGetArray(win,&ww);CHKERRQ(ierr);
+#if defined(PETSC_HAVE_OPENMP)
+  if (VecOMPUseThreads(n)) {
+    PetscInt  nt = PetscNumOMPThreads,t;
+    PetscReal *part;
+
+    ierr = PetscCalloc1(nt,&part);CHKERRQ(ierr);
+#pragma omp parallel num_threads((int)nt)
+    {
+      PetscInt lo,hi;
+
+      VecOMPGetChunk(n,omp_get_thread_num(),omp_get_num_threads(),lo,hi);
+      VecWAXPYNormKernel_Private(ww,alpha,xx,yy,lo,hi,&part[omp_get_thread_num()]);
+    }
+    for (t=0,sum=0.0; t<nt; t++) sum += part[t];
+    ierr = PetscFree(part);CHKERRQ(ierr);
+  } else
+#endif
+  VecWAXPYNormKernel_Private(ww,alpha,xx,yy,0,n,&sum);
+  ierr = VecRestoreArray(win,&ww);CHKERRQ(ierr);
+  ierr = VecRestoreArrayRead(yin,&yy);CHKERRQ(ierr);
+  ierr = VecRestoreArrayRead(xin,&xx);CHKERRQ(ierr);
+  *nrm = PetscSqrtReal(sum);
+  ierr = PetscLogFlops(4.0*n);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+PetscErrorCode VecMAXPYNorm_Seq(Vec yin,PetscInt nv,const PetscScalar *alpha,Vec *x,PetscReal *nrm)
+{
+  PetscErrorCode    ierr;
+  PetscInt          n = yin->map->n,j;
+  PetscScalar       *yy;
+  const PetscScalar **xx;
+  PetscReal         sum;
+
+  PetscFunctionBegin;
+  ierr = PetscMalloc1(nv,&xx);CHKERRQ(ierr);
+  for (j=0; j<nv; j++) {ierr = VecGetArrayRead(x[j],&xx[j]);CHKERRQ(ierr);}
+  ierr = VecGetArray(yin,&yy);CHKERRQ(ierr);
+#if defined(PETSC_HAVE_OPENMP)
+  if (VecOMPUseThreads(n)) {
+    PetscInt  nt = PetscNumOMPThreads,t;
+    PetscReal *part;
+
+    ierr = PetscCalloc1(nt,&part);CHKERRQ(ierr);
+#pragma omp parallel num_threads((int)nt)
+    {
+      PetscInt lo,hi;
+
+      VecOMPGetChunk(n,omp_get_thread_num(),omp_get_num_threads(),lo,hi);
+      VecMAXPYNormKernel_Private(yy,nv,alpha,xx,lo,hi,&part[omp_get_thread_num()]);
+    }
+    for (t=0,sum=0.0; t<nt; t++) sum += part[t];
+    ierr = PetscFree(part);CHKERRQ(ierr);
+  } else
+#endif
+  VecMAXPYNormKernel_Private(yy,nv,alpha,xx,0,n,&sum);
+  ierr = VecRestoreArray(yin,&yy);CHKERRQ(ierr);
+  for (j=0; j<nv; j++) {ierr = VecRestoreArrayRead(x[j],&xx[j]);CHKERRQ(ierr);}
+  ierr = PetscFree(xx);CHKERRQ(ierr);
+  *nrm = PetscSqrtReal(sum);
+  ierr = PetscLogFlops(nv*2.0*n + 2.0*n);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+PetscErrorCode VecMAXPYMDot_Seq(Vec yin,PetscInt nv,const PetscScalar *alpha,Vec *x,PetscScalar *z)
+{
+  PetscErrorCode    ierr;
+  PetscInt          n = yin->map->n,j;
+  PetscScalar       *yy;
+  const PetscScalar **xx;
+
+  PetscFunctionBegin;
+  ierr = PetscMalloc1(nv,&xx);CHKERRQ(ierr);
+  for (j=0; j<nv; j++) {ierr = VecGetArrayRead(x[j],&xx[j]);CHKERRQ(ierr);}
+  ierr = VecGetArray(yin,&yy);CHKERRQ(ierr);
+  ierr = PetscArrayzero(z,nv);CHKERRQ(ierr);
+#if defined(PETSC_HAVE_OPENMP)
+  if (VecOMPUseThreads(n)) {
+    PetscInt    nt = PetscNumOMPThreads,t;
+    PetscScalar *part;
+
+    ierr = PetscCalloc1(nt*nv,&part);CHKERRQ(ierr);
+#pragma omp parallel num_threads((int)nt)
+    {
+      PetscInt lo,hi;
+
+      VecOMPGetChunk(n,omp_get_thread_num(),omp_get_num_threads(),lo,hi);
+      VecMAXPYMDotKernel_Private(yy,nv,alpha,xx,lo,hi,part+omp_get_thread_num()*nv);
+    }
+    for (t=0; t<nt; t++) {
+      for (j=0; j<nv; j++) z[j] += part[t*nv+j];
+    }
+    ierr = PetscFree(part);CHKERRQ(ierr);
+  } else
+#endif
+  VecMAXPYMDotKernel_Private(yy,nv,alpha,xx,0,n,z);
+  ierr = VecRestoreArray(yin,&yy);CHKERRQ(ierr);
+  for (j=0; j<nv; j++) {ierr = VecRestoreArrayRead(x[j],&xx[j]);CHKERRQ(ierr);}
+  ierr = PetscFree(xx);CHKERRQ(ierr);
+  ierr = PetscLogFlops(nv*2.0*n + PetscMax(nv*(2.0*n-1),0.0));CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
 PetscErrorCode VecMaxPointwiseDivide_Seq(Vec xin,Vec yin,PetscReal *max)
 {
   PetscErrorCode    ierr;
@@ -941,6 +941,10 @@ static PetscErrorCode VecSetOps_SeqKokkos(Vec v)
   v->ops->aypx                   = VecAYPX_SeqKokkos;
   v->ops->waxpy                  = VecWAXPY_SeqKokkos;
   v->ops->dotnorm2               = VecDotNorm2_SeqKokkos;
+  v->ops->axpynorm               = NULL;
+  v->ops->waxpynorm              = NULL;
+  v->ops->maxpynorm              = NULL;
+  v->ops->maxpymdot              = NULL;
   v->ops->placearray             = VecPlaceArray_SeqKokkos;
   v->ops->replacearray           = VecReplaceArray_SeqKokkos;
   v->ops->resetarray             = VecResetArray_SeqKokkos;
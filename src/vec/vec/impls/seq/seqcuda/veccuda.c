@@ -444,6 +444,10 @@ PetscErrorCode VecBindToCPU_SeqCUDA(Vec V,PetscBool pin)
     V->ops->aypx                   = VecAYPX_Seq;
     V->ops->waxpy                  = VecWAXPY_Seq;
     V->ops->dotnorm2               = NULL;
+    V->ops->axpynorm               = VecAXPYNorm_Seq;
+    V->ops->waxpynorm              = VecWAXPYNorm_Seq;
+    V->ops->maxpynorm              = VecMAXPYNorm_Seq;
+    V->ops->maxpymdot              = VecMAXPYMDot_Seq;
     V->ops->placearray             = VecPlaceArray_Seq;
     V->ops->replacearray           = VecReplaceArray_SeqCUDA;
     V->ops->resetarray             = VecResetArray_Seq;
@@ -485,6 +489,10 @@ PetscErrorCode VecBindToCPU_SeqCUDA(Vec V,PetscBool pin)
     V->ops->aypx                   = VecAYPX_SeqCUDA;
     V->ops->waxpy                  = VecWAXPY_SeqCUDA;
     V->ops->dotnorm2               = VecDotNorm2_SeqCUDA;
+    V->ops->axpynorm               = NULL;
+    V->ops->waxpynorm              = NULL;
+    V->ops->maxpynorm              = NULL;
+    V->ops->maxpymdot              = NULL;
     V->ops->placearray             = VecPlaceArray_SeqCUDA;
     V->ops->replacearray           = VecReplaceArray_SeqCUDA;
     V->ops->resetarray             = VecResetArray_SeqCUDA;
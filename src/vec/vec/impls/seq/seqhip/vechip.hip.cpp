@@ -434,6 +434,10 @@ PetscErrorCode VecBindToCPU_SeqHIP(Vec V,PetscBool pin)
     V->ops->aypx                   = VecAYPX_Seq;
     V->ops->waxpy                  = VecWAXPY_Seq;
     V->ops->dotnorm2               = NULL;
+    V->ops->axpynorm               = VecAXPYNorm_Seq;
+    V->ops->waxpynorm              = VecWAXPYNorm_Seq;
+    V->ops->maxpynorm              = VecMAXPYNorm_Seq;
+    V->ops->maxpymdot              = VecMAXPYMDot_Seq;
     V->ops->placearray             = VecPlaceArray_Seq;
     V->ops->replacearray           = VecReplaceArray_SeqHIP;
     V->ops->resetarray             = VecResetArray_Seq;
@@ -472,6 +476,10 @@ PetscErrorCode VecBindToCPU_SeqHIP(Vec V,PetscBool pin)
     V->ops->aypx                   = VecAYPX_SeqHIP;
     V->ops->waxpy                  = VecWAXPY_SeqHIP;
     V->ops->dotnorm2               = VecDotNorm2_SeqHIP;
+    V->ops->axpynorm               = NULL;
+    V->ops->waxpynorm              = NULL;
+    V->ops->maxpynorm              = NULL;
+    V->ops->maxpymdot              = NULL;
     V->ops->placearray             = VecPlaceArray_SeqHIP;
     V->ops->replacearray           = VecReplaceArray_SeqHIP;
     V->ops->resetarray             = VecResetArray_SeqHIP;
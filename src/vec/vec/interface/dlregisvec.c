@@ -7,6 +7,10 @@
 #include <petscao.h>
 
 static PetscBool         ISPackageInitialized = PETSC_FALSE;
+#if defined(PETSC_HAVE_OPENMP)
+PetscBool VecOMPUse     = PETSC_FALSE;
+PetscInt  VecOMPMinSize = 10000;
+#endif
 extern PetscFunctionList ISLocalToGlobalMappingList;
 const char       *ISInfos[] = {"SORTED", "UNIQUE", "PERMUTATION", "INTERVAL", "IDENTITY", "ISInfo", "IS_",NULL};
 
@@ -191,6 +195,10 @@ PetscErrorCode  VecInitializePackage(void)
   ierr = PetscLogEventRegister("VecAXPBYCZ",       VEC_CLASSID,&VEC_AXPBYPCZ);CHKERRQ(ierr);
   ierr = PetscLogEventRegister("VecWAXPY",         VEC_CLASSID,&VEC_WAXPY);CHKERRQ(ierr);
   ierr = PetscLogEventRegister("VecMAXPY",         VEC_CLASSID,&VEC_MAXPY);CHKERRQ(ierr);
+  ierr = PetscLogEventRegister("VecAXPYNorm",      VEC_CLASSID,&VEC_AXPYNorm);CHKERRQ(ierr);
+  ierr = PetscLogEventRegister("VecWAXPYNorm",     VEC_CLASSID,&VEC_WAXPYNorm);CHKERRQ(ierr);
+  ierr = PetscLogEventRegister("VecMAXPYNorm",     VEC_CLASSID,&VEC_MAXPYNorm);CHKERRQ(ierr);
+  ierr = PetscLogEventRegister("VecMAXPYMDot",     VEC_CLASSID,&VEC_MAXPYMDot);CHKERRQ(ierr);
   ierr = PetscLogEventRegister("VecSwap",          VEC_CLASSID,&VEC_Swap);CHKERRQ(ierr);
   ierr = PetscLogEventRegister("VecOps",           VEC_CLASSID,&VEC_Ops);CHKERRQ(ierr);
   ierr = PetscLogEventRegister("VecAssemblyBegin", VEC_CLASSID,&VEC_AssemblyBegin);CHKERRQ(ierr);
@@ -265,6 +273,11 @@ PetscErrorCode  VecInitializePackage(void)
   ierr = MPI_Op_create(MPIU_MaxIndex_Local,1,&MPIU_MAXLOC);CHKERRMPI(ierr);
   ierr = MPI_Op_create(MPIU_MinIndex_Local,1,&MPIU_MINLOC);CHKERRMPI(ierr);
 
+#if defined(PETSC_HAVE_OPENMP)
+  ierr = PetscOptionsGetBool(NULL,NULL,"-vec_omp",&VecOMPUse,NULL);CHKERRQ(ierr);
+  ierr = PetscOptionsGetInt(NULL,NULL,"-vec_omp_min_size",&VecOMPMinSize,NULL);CHKERRQ(ierr);
+#endif
+
   /* Register the different norm types for cached norms */
   for (i=0; i<4; i++) {
     ierr = PetscObjectComposedDataRegister(NormIds+i);CHKERRQ(ierr);
@@ -297,6 +310,10 @@ PetscErrorCode  VecFinalizePackage(void)
   }
   VecPackageInitialized = PETSC_FALSE;
   VecRegisterAllCalled  = PETSC_FALSE;
+#if defined(PETSC_HAVE_OPENMP)
+  VecOMPUse             = PETSC_FALSE;
+  VecOMPMinSize         = 10000;
+#endif
   PetscFunctionReturn(0);
 }
 
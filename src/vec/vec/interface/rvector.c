@@ -1199,6 +1199,230 @@ PetscErrorCode  VecMAXPY(Vec y,PetscInt nv,const PetscScalar alpha[],Vec x[])
   PetscFunctionReturn(0);
 }
 
+/*@
+   VecAXPYNorm - Computes y = alpha x + y and the 2-norm of the result in a single pass over the data
+
+   Collective on Vec
+
+   Input Parameters:
++  alpha - the scalar
+-  x, y  - the vectors
+
+   Output Parameters:
++  y   - output vector
+-  nrm - the 2-norm of the updated y
+
+   Level: intermediate
+
+   Notes:
+    x and y MUST be different vectors
+
+    The norm is cached in y so a following VecNorm(y,NORM_2,...) or VecNormalize(y,...) does not touch the data again.
+    Vector types that do not provide a fused kernel fall back to VecAXPY() followed by VecNorm().
+
+.seealso:  VecAXPY(), VecNorm(), VecWAXPYNorm(), VecMAXPYNorm(), VecMAXPYMDot()
+@*/
+PetscErrorCode  VecAXPYNorm(Vec y,PetscScalar alpha,Vec x,PetscReal *nrm)
+{
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  PetscValidHeaderSpecific(x,VEC_CLASSID,3);
+  PetscValidHeaderSpecific(y,VEC_CLASSID,1);
+  PetscValidType(x,3);
+  PetscValidType(y,1);
+  PetscValidRealPointer(nrm,4);
+  PetscCheckSameTypeAndComm(x,3,y,1);
+  VecCheckSameSize(x,3,y,1);
+  if (x == y) SETERRQ(PetscObjectComm((PetscObject)x),PETSC_ERR_ARG_IDN,"x and y cannot be the same vector");
+  PetscValidLogicalCollectiveScalar(y,alpha,2);
+  if (!y->ops->axpynorm || alpha == (PetscScalar)0.0) {
+    ierr = VecAXPY(y,alpha,x);CHKERRQ(ierr);
+    ierr = VecNorm(y,NORM_2,nrm);CHKERRQ(ierr);
+    PetscFunctionReturn(0);
+  }
+  ierr = VecSetErrorIfLocked(y,1);CHKERRQ(ierr);
+
+  ierr = VecLockReadPush(x);CHKERRQ(ierr);
+  ierr = PetscLogEventBegin(VEC_AXPYNorm,x,y,0,0);CHKERRQ(ierr);
+  ierr = (*y->ops->axpynorm)(y,alpha,x,nrm);CHKERRQ(ierr);
+  ierr = PetscLogEventEnd(VEC_AXPYNorm,x,y,0,0);CHKERRQ(ierr);
+  ierr = VecLockReadPop(x);CHKERRQ(ierr);
+  ierr = PetscObjectStateIncrease((PetscObject)y);CHKERRQ(ierr);
+  ierr = PetscObjectComposedDataSetReal((PetscObject)y,NormIds[NORM_2],*nrm);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+/*@
+   VecWAXPYNorm - Computes w = alpha x + y and the 2-norm of w in a single pass over the data
+
+   Collective on Vec
+
+   Input Parameters:
++  w - the result vector
+.  alpha - the scalar
+-  x, y  - the vectors
+
+   Output Parameters:
++  w   - the result
+-  nrm - the 2-norm of w
+
+   Level: intermediate
+
+   Notes:
+    w cannot be either x or y, but x and y can be the same
+
+    The norm is cached in w. Vector types that do not provide a fused kernel fall back to VecWAXPY() followed by VecNorm().
+
+.seealso: VecWAXPY(), VecNorm(), VecAXPYNorm(), VecMAXPYNorm()
+@*/
+PetscErrorCode  VecWAXPYNorm(Vec w,PetscScalar alpha,Vec x,Vec y,PetscReal *nrm)
+{
+  PetscErrorCode ierr;
+
+  PetscFunctionBegin;
+  PetscValidHeaderSpecific(w,VEC_CLASSID,1);
+  PetscValidHeaderSpecific(x,VEC_CLASSID,3);
+  PetscValidHeaderSpecific(y,VEC_CLASSID,4);
+  PetscValidType(w,1);
+  PetscValidType(x,3);
+  PetscValidType(y,4);
+  PetscValidRealPointer(nrm,5);
+  PetscCheckSameTypeAndComm(x,3,y,4);
+  PetscCheckSameTypeAndComm(y,4,w,1);
+  VecCheckSameSize(x,3,y,4);
+  VecCheckSameSize(x,3,w,1);
+  if (w == y) SETERRQ(PETSC_COMM_SELF,PETSC_ERR_SUP,"Result vector w cannot be same as input vector y, suggest VecAXPYNorm()");
+  if (w == x) SETERRQ(PETSC_COMM_SELF,PETSC_ERR_SUP,"Result vector w cannot be same as input vector x");
+  PetscValidLogicalCollectiveScalar(y,alpha,2);
+  if (!w->ops->waxpynorm) {
+    ierr = VecWAXPY(w,alpha,x,y);CHKERRQ(ierr);
+    ierr = VecNorm(w,NORM_2,nrm);CHKERRQ(ierr);
+    PetscFunctionReturn(0);
+  }
+  ierr = VecSetErrorIfLocked(w,1);CHKERRQ(ierr);
+
+  ierr = PetscLogEventBegin(VEC_WAXPYNorm,x,y,w,0);CHKERRQ(ierr);
+  ierr = (*w->ops->waxpynorm)(w,alpha,x,y,nrm);CHKERRQ(ierr);
+  ierr = PetscLogEventEnd(VEC_WAXPYNorm,x,y,w,0);CHKERRQ(ierr);
+  ierr = PetscObjectStateIncrease((PetscObject)w);CHKERRQ(ierr);
+  ierr = PetscObjectComposedDataSetReal((PetscObject)w,NormIds[NORM_2],*nrm);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+/*@
+   VecMAXPYNorm - Computes y = y + sum alpha[i] x[i] and the 2-norm of the result in a single pass over y
+
+   Collective on Vec
+
+   Input Parameters:
++  y - one vector
+.  nv - number of scalars and x-vectors
+.  alpha - array of scalars
+-  x - array of vectors
+
+   Output Parameter:
+.  nrm - the 2-norm of the updated y
+
+   Level: intermediate
+
+   Notes:
+    y cannot be any of the x vectors
+
+    This is the update at the end of a classical Gram-Schmidt step. The norm is cached in y.
+    Vector types that do not provide a fused kernel fall back to VecMAXPY() followed by VecNorm().
+
+.seealso:  VecMAXPY(), VecNorm(), VecMAXPYMDot(), VecAXPYNorm()
+@*/
+PetscErrorCode  VecMAXPYNorm(Vec y,PetscInt nv,const PetscScalar alpha[],Vec x[],PetscReal *nrm)
+{
+  PetscErrorCode ierr;
+  PetscInt       i;
+
+  PetscFunctionBegin;
+  PetscValidHeaderSpecific(y,VEC_CLASSID,1);
+  PetscValidLogicalCollectiveInt(y,nv,2);
+  PetscValidRealPointer(nrm,5);
+  if (nv < 0) SETERRQ1(PETSC_COMM_SELF,PETSC_ERR_ARG_OUTOFRANGE,"Number of vectors (given %D) cannot be negative",nv);
+  if (!nv || !y->ops->maxpynorm) {
+    ierr = VecMAXPY(y,nv,alpha,x);CHKERRQ(ierr);
+    ierr = VecNorm(y,NORM_2,nrm);CHKERRQ(ierr);
+    PetscFunctionReturn(0);
+  }
+  PetscValidScalarPointer(alpha,3);
+  PetscValidPointer(x,4);
+  PetscValidHeaderSpecific(*x,VEC_CLASSID,4);
+  PetscValidType(y,1);
+  PetscValidType(*x,4);
+  PetscCheckSameTypeAndComm(y,1,*x,4);
+  VecCheckSameSize(y,1,*x,4);
+  for (i=0; i<nv; i++) PetscValidLogicalCollectiveScalar(y,alpha[i],3);
+  ierr = VecSetErrorIfLocked(y,1);CHKERRQ(ierr);
+  ierr = PetscLogEventBegin(VEC_MAXPYNorm,*x,y,0,0);CHKERRQ(ierr);
+  ierr = (*y->ops->maxpynorm)(y,nv,alpha,x,nrm);CHKERRQ(ierr);
+  ierr = PetscLogEventEnd(VEC_MAXPYNorm,*x,y,0,0);CHKERRQ(ierr);
+  ierr = PetscObjectStateIncrease((PetscObject)y);CHKERRQ(ierr);
+  ierr = PetscObjectComposedDataSetReal((PetscObject)y,NormIds[NORM_2],*nrm);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
+/*@
+   VecMAXPYMDot - Computes y = y + sum alpha[i] x[i] followed by the dot products of the updated y with the same x[i]
+
+   Collective on Vec
+
+   Input Parameters:
++  y - one vector
+.  nv - number of scalars and x-vectors
+.  alpha - array of scalars
+-  x - array of vectors
+
+   Output Parameter:
+.  val - array of the dot products, val[i] = x[i]^H y, as computed by VecMDot(y,nv,x,val) after the update
+
+   Level: intermediate
+
+   Notes:
+    y cannot be any of the x vectors
+
+    This is the update and the reorthogonalization dot products of one classical Gram-Schmidt step with refinement;
+    the x vectors are read once instead of twice. Vector types that do not provide a fused kernel fall back to
+    VecMAXPY() followed by VecMDot().
+
+.seealso:  VecMAXPY(), VecMDot(), VecMAXPYNorm()
+@*/
+PetscErrorCode  VecMAXPYMDot(Vec y,PetscInt nv,const PetscScalar alpha[],Vec x[],PetscScalar val[])
+{
+  PetscErrorCode ierr;
+  PetscInt       i;
+
+  PetscFunctionBegin;
+  PetscValidHeaderSpecific(y,VEC_CLASSID,1);
+  PetscValidLogicalCollectiveInt(y,nv,2);
+  if (!nv) PetscFunctionReturn(0);
+  if (nv < 0) SETERRQ1(PETSC_COMM_SELF,PETSC_ERR_ARG_OUTOFRANGE,"Number of vectors (given %D) cannot be negative",nv);
+  if (!y->ops->maxpymdot) {
+    ierr = VecMAXPY(y,nv,alpha,x);CHKERRQ(ierr);
+    ierr = VecMDot(y,nv,x,val);CHKERRQ(ierr);
+    PetscFunctionReturn(0);
+  }
+  PetscValidScalarPointer(alpha,3);
+  PetscValidPointer(x,4);
+  PetscValidHeaderSpecific(*x,VEC_CLASSID,4);
+  PetscValidScalarPointer(val,5);
+  PetscValidType(y,1);
+  PetscValidType(*x,4);
+  PetscCheckSameTypeAndComm(y,1,*x,4);
+  VecCheckSameSize(y,1,*x,4);
+  for (i=0; i<nv; i++) PetscValidLogicalCollectiveScalar(y,alpha[i],3);
+  ierr = VecSetErrorIfLocked(y,1);CHKERRQ(ierr);
+  ierr = PetscLogEventBegin(VEC_MAXPYMDot,*x,y,0,0);CHKERRQ(ierr);
+  ierr = (*y->ops->maxpymdot)(y,nv,alpha,x,val);CHKERRQ(ierr);
+  ierr = PetscLogEventEnd(VEC_MAXPYMDot,*x,y,0,0);CHKERRQ(ierr);
+  ierr = PetscObjectStateIncrease((PetscObject)y);CHKERRQ(ierr);
+  PetscFunctionReturn(0);
+}
+
 /*@
    VecConcatenate - Creates a new vector that is a vertical concatenation of all the given array of vectors
                     in the order they appear in the array. The concatenated vector resides on the same
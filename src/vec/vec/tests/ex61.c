@@ -0,0 +1,102 @@
+static char help[] = "Tests the fused VecAXPYNorm(), VecWAXPYNorm(), VecMAXPYNorm() and VecMAXPYMDot() against the separate operations.\n\n";
+
+#include <petscvec.h>
+
+int main(int argc,char **argv)
+{
+  PetscErrorCode ierr;
+  PetscInt       n = 1037,nv = 7,i,j;
+  PetscScalar    alpha[7],val[7],cval[7];
+  PetscReal      nrm,cnrm,tol = 100*PETSC_MACHINE_EPSILON;
+  Vec            *x,y,w,c;
+  PetscRandom    rctx;
+
+  ierr = PetscInitialize(&argc,&argv,(char*)0,help);if (ierr) return ierr;
+  ierr = PetscOptionsGetInt(NULL,NULL,"-n",&n,NULL);CHKERRQ(ierr);
+  ierr = PetscRandomCreate(PETSC_COMM_WORLD,&rctx);CHKERRQ(ierr);
+  ierr = PetscRandomSetFromOptions(rctx);CHKERRQ(ierr);
+  ierr = VecCreate(PETSC_COMM_WORLD,&y);CHKERRQ(ierr);
+  ierr = VecSetSizes(y,PETSC_DECIDE,n);CHKERRQ(ierr);
+  ierr = VecSetFromOptions(y);CHKERRQ(ierr);
+  ierr = VecDuplicate(y,&w);CHKERRQ(ierr);
+  ierr = VecDuplicate(y,&c);CHKERRQ(ierr);
+  ierr = VecDuplicateVecs(y,nv,&x);CHKERRQ(ierr);
+  for (j=0; j<nv; j++) {
+    ierr     = VecSetRandom(x[j],rctx);CHKERRQ(ierr);
+    alpha[j] = -0.25*(j+1);
+  }
+
+  /* every number of vectors exercises a different remainder of the unrolled loops */
+  for (i=1; i<=nv; i++) {
+    ierr = VecSetRandom(y,rctx);CHKERRQ(ierr);
+    ierr = VecCopy(y,c);CHKERRQ(ierr);
+    ierr = VecMAXPYNorm(y,i,alpha,x,&nrm);CHKERRQ(ierr);
+    ierr = VecMAXPY(c,i,alpha,x);CHKERRQ(ierr);
+    ierr = VecNorm(c,NORM_2,&cnrm);CHKERRQ(ierr);
+    if (PetscAbsReal(nrm-cnrm) > tol*cnrm) {ierr = PetscPrintf(PETSC_COMM_WORLD,"VecMAXPYNorm() %D: norm %g expected %g\n",i,(double)nrm,(double)cnrm);CHKERRQ(ierr);}
+    ierr = VecAXPY(c,-1.0,y);CHKERRQ(ierr);
+    ierr = VecNorm(c,NORM_INFINITY,&cnrm);CHKERRQ(ierr);
+    if (cnrm > tol) {ierr = PetscPrintf(PETSC_COMM_WORLD,"VecMAXPYNorm() %D: wrong vector, error %g\n",i,(double)cnrm);CHKERRQ(ierr);}
+    /* the norm is cached */
+    ierr = VecNorm(y,NORM_2,&cnrm);CHKERRQ(ierr);
+    if (nrm != cnrm) {ierr = PetscPrintf(PETSC_COMM_WORLD,"VecMAXPYNorm() %D: norm not cached\n",i);CHKERRQ(ierr);}
+
+    ierr = VecSetRandom(y,rctx);CHKERRQ(ierr);
+    ierr = VecCopy(y,c);CHKERRQ(ierr);
+    ierr = VecMAXPYMDot(y,i,alpha,x,val);CHKERRQ(ierr);
+    ierr = VecMAXPY(c,i,alpha,x);CHKERRQ(ierr);
+    ierr = VecMDot(c,i,x,cval);CHKERRQ(ierr);
+    for (j=0; j<i; j++) {
+      if (PetscAbsScalar(val[j]-cval[j]) > tol*PetscAbsScalar(cval[j])) {ierr = PetscPrintf(PETSC_COMM_WORLD,"VecMAXPYMDot() %D: dot %D %g expected %g\n",i,j,(double)PetscRealPart(val[j]),(double)PetscRealPart(cval[j]));CHKERRQ(ierr);}
+    }
+    ierr = VecAXPY(c,-1.0,y);CHKERRQ(ierr);
+    ierr = VecNorm(c,NORM_INFINITY,&cnrm);CHKERRQ(ierr);
+    if (cnrm > tol) {ierr = PetscPrintf(PETSC_COMM_WORLD,"VecMAXPYMDot() %D: wrong vector, error %g\n",i,(double)cnrm);CHKERRQ(ierr);}
+  }
+
+  ierr = VecSetRandom(y,rctx);CHKERRQ(ierr);
+  ierr = VecCopy(y,c);CHKERRQ(ierr);
+  ierr = VecAXPYNorm(y,alpha[2],x[0],&nrm);CHKERRQ(ierr);
+  ierr = VecAXPY(c,alpha[2],x[0]);CHKERRQ(ierr);
+  ierr = VecNorm(c,NORM_2,&cnrm);CHKERRQ(ierr);
+  if (PetscAbsReal(nrm-cnrm) > tol*cnrm) {ierr = PetscPrintf(PETSC_COMM_WORLD,"VecAXPYNorm(): norm %g expected %g\n",(double)nrm,(double)cnrm);CHKERRQ(ierr);}
+  ierr = VecAXPY(c,-1.0,y);CHKERRQ(ierr);
+  ierr = VecNorm(c,NORM_INFINITY,&cnrm);CHKERRQ(ierr);
+  if (cnrm > tol) {ierr = PetscPrintf(PETSC_COMM_WORLD,"VecAXPYNorm(): wrong vector, error %g\n",(double)cnrm);CHKERRQ(ierr);}
+
+  ierr = VecWAXPYNorm(w,alpha[3],x[1],x[2],&nrm);CHKERRQ(ierr);
+  ierr = VecWAXPY(c,alpha[3],x[1],x[2]);CHKERRQ(ierr);
+  ierr = VecNorm(c,NORM_2,&cnrm);CHKERRQ(ierr);
+  if (PetscAbsReal(nrm-cnrm) > tol*cnrm) {ierr = PetscPrintf(PETSC_COMM_WORLD,"VecWAXPYNorm(): norm %g expected %g\n",(double)nrm,(double)cnrm);CHKERRQ(ierr);}
+  ierr = VecAXPY(c,-1.0,w);CHKERRQ(ierr);
+  ierr = VecNorm(c,NORM_INFINITY,&cnrm);CHKERRQ(ierr);
+  if (cnrm > tol) {ierr = PetscPrintf(PETSC_COMM_WORLD,"VecWAXPYNorm(): wrong vector, error %g\n",(double)cnrm);CHKERRQ(ierr);}
+
+  ierr = VecDestroyVecs(nv,&x);CHKERRQ(ierr);
+  ierr = VecDestroy(&c);CHKERRQ(ierr);
+  ierr = VecDestroy(&w);CHKERRQ(ierr);
+  ierr = VecDestroy(&y);CHKERRQ(ierr);
+  ierr = PetscRandomDestroy(&rctx);CHKERRQ(ierr);
+  ierr = PetscFinalize();
+  return ierr;
+}
+
+/*TEST
+
+   testset:
+     output_file: output/ex61_1.out
+
+     test:
+       suffix: 1
+
+     test:
+       suffix: 2
+       nsize: 2
+
+     test:
+       suffix: omp
+       nsize: {{1 2}}
+       requires: openmp
+       args: -vec_omp -vec_omp_min_size 0 -omp_num_threads 3
+
+TEST*/
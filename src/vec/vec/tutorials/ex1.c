@@ -206,4 +206,15 @@ int main(int argc,char **argv)
         args: -vec_type hip
         requires: hip
 
+    test:
+        suffix: omp
+        args: -vec_omp -vec_omp_min_size 0 -omp_num_threads 3
+        requires: openmp
+
+    test:
+        suffix: 2_omp
+        nsize: 2
+        args: -vec_omp -vec_omp_min_size 0 -omp_num_threads 3
+        requires: openmp
+
 TEST*/